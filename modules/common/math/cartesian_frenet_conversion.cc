@@ -85,6 +85,33 @@ void CartesianFrenetConverter::cartesian_to_frenet(
   return;
 }
 
+void CartesianFrenetConverter::cartesian_to_frenet(
+    const std::vector<double>& rs, const std::vector<double>& rx,
+    const std::vector<double>& ry, const std::vector<double>& rtheta,
+    const std::vector<double>& x, const std::vector<double>& y,
+    std::vector<double>* ptr_s, std::vector<double>* ptr_d) {
+  CHECK_NOTNULL(ptr_s);
+  CHECK_NOTNULL(ptr_d);
+  const size_t size = rs.size();
+  CHECK_EQ(size, rx.size());
+  CHECK_EQ(size, ry.size());
+  CHECK_EQ(size, rtheta.size());
+  CHECK_EQ(size, x.size());
+  CHECK_EQ(size, y.size());
+  ptr_s->resize(size);
+  ptr_d->resize(size);
+  double* s = ptr_s->data();
+  double* d = ptr_d->data();
+  for (size_t i = 0; i < size; ++i) {
+    const double dx = x[i] - rx[i];
+    const double dy = y[i] - ry[i];
+    const double cross_rd_nd =
+        std::cos(rtheta[i]) * dy - std::sin(rtheta[i]) * dx;
+    d[i] = std::copysign(std::sqrt(dx * dx + dy * dy), cross_rd_nd);
+    s[i] = rs[i];
+  }
+}
+
 void CartesianFrenetConverter::frenet_to_cartesian(
     const double rs, const double rx, const double ry, const double rtheta,
     const double rkappa, const double rdkappa,
@@ -160,6 +187,26 @@ Vec2d CartesianFrenetConverter::CalculateCartesianPoint(const double rtheta,
   return Vec2d(x, y);
 }
 
+void CartesianFrenetConverter::CalculateCartesianPoints(
+    const std::vector<double>& rtheta, const std::vector<double>& rx,
+    const std::vector<double>& ry, const std::vector<double>& l,
+    std::vector<double>* ptr_x, std::vector<double>* ptr_y) {
+  CHECK_NOTNULL(ptr_x);
+  CHECK_NOTNULL(ptr_y);
+  const size_t size = rtheta.size();
+  CHECK_EQ(size, rx.size());
+  CHECK_EQ(size, ry.size());
+  CHECK_EQ(size, l.size());
+  ptr_x->resize(size);
+  ptr_y->resize(size);
+  double* x = ptr_x->data();
+  double* y = ptr_y->data();
+  for (size_t i = 0; i < size; ++i) {
+    x[i] = rx[i] - l[i] * std::sin(rtheta[i]);
+    y[i] = ry[i] + l[i] * std::cos(rtheta[i]);
+  }
+}
+
 double CartesianFrenetConverter::CalculateLateralDerivative(
     const double rtheta, const double theta, const double l,
     const double rkappa) {
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <array>
+#include <vector>
 
 #include "modules/common/math/vec2d.h"
 
@@ -62,6 +63,20 @@ class CartesianFrenetConverter {
                                   const double x, const double y, double* ptr_s,
                                   double* ptr_d);
 
+  /**
+   * Batch version of the position only conversion. Reference point i is
+   * matched with cartesian point (x[i], y[i]); all inputs have the same size.
+   * The loop is branch free so that it can be vectorized.
+   */
+  static void cartesian_to_frenet(const std::vector<double>& rs,
+                                  const std::vector<double>& rx,
+                                  const std::vector<double>& ry,
+                                  const std::vector<double>& rtheta,
+                                  const std::vector<double>& x,
+                                  const std::vector<double>& y,
+                                  std::vector<double>* ptr_s,
+                                  std::vector<double>* ptr_d);
+
   /**
    * Convert a vehicle state in Frenet frame to Cartesian frame.
    * Combine two independent 1d movement w.r.t. reference line to a 2d movement.
@@ -86,6 +101,15 @@ class CartesianFrenetConverter {
 
   static Vec2d CalculateCartesianPoint(const double rtheta, const Vec2d& rpoint,
                                        const double l);
+
+  // batch version of CalculateCartesianPoint, all inputs have the same size.
+  static void CalculateCartesianPoints(const std::vector<double>& rtheta,
+                                       const std::vector<double>& rx,
+                                       const std::vector<double>& ry,
+                                       const std::vector<double>& l,
+                                       std::vector<double>* ptr_x,
+                                       std::vector<double>* ptr_y);
+
   /**
    * @brief: given sl, theta, and road's theta, kappa, extract derivative l,
    *second order derivative l:
@@ -18,6 +18,7 @@
 
 #include <array>
 #include <cmath>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -65,6 +66,51 @@ TEST(TestCartesianFrenetConversion, cartesian_to_frenet_test) {
   EXPECT_NEAR(a, a_out, 1.0e-6);
 }
 
+TEST(TestCartesianFrenetConversion, batch_conversion_test) {
+  std::vector<double> rs;
+  std::vector<double> rx;
+  std::vector<double> ry;
+  std::vector<double> rtheta;
+  std::vector<double> x;
+  std::vector<double> y;
+  for (int i = 0; i < 100; ++i) {
+    rs.push_back(0.5 * i);
+    rx.push_back(0.4 * i);
+    ry.push_back(0.3 * i);
+    rtheta.push_back(std::atan2(0.3, 0.4) + 0.01 * i);
+    x.push_back(0.4 * i + std::sin(0.1 * i));
+    y.push_back(0.3 * i - std::cos(0.2 * i));
+  }
+
+  std::vector<double> s;
+  std::vector<double> d;
+  CartesianFrenetConverter::cartesian_to_frenet(rs, rx, ry, rtheta, x, y, &s,
+                                                &d);
+  ASSERT_EQ(rs.size(), s.size());
+  ASSERT_EQ(rs.size(), d.size());
+  for (size_t i = 0; i < rs.size(); ++i) {
+    double expected_s = 0.0;
+    double expected_d = 0.0;
+    CartesianFrenetConverter::cartesian_to_frenet(
+        rs[i], rx[i], ry[i], rtheta[i], x[i], y[i], &expected_s, &expected_d);
+    EXPECT_DOUBLE_EQ(expected_s, s[i]);
+    EXPECT_DOUBLE_EQ(expected_d, d[i]);
+  }
+
+  std::vector<double> x_out;
+  std::vector<double> y_out;
+  CartesianFrenetConverter::CalculateCartesianPoints(rtheta, rx, ry, d, &x_out,
+                                                     &y_out);
+  ASSERT_EQ(rs.size(), x_out.size());
+  ASSERT_EQ(rs.size(), y_out.size());
+  for (size_t i = 0; i < rs.size(); ++i) {
+    const Vec2d point = CartesianFrenetConverter::CalculateCartesianPoint(
+        rtheta[i], Vec2d(rx[i], ry[i]), d[i]);
+    EXPECT_DOUBLE_EQ(point.x(), x_out[i]);
+    EXPECT_DOUBLE_EQ(point.y(), y_out[i]);
+  }
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
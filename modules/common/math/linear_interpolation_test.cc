@@ -72,6 +72,24 @@ TEST(LinearInterpolationTest, SlerpCaseTwo) {
   EXPECT_NEAR(slerp(a0, t0, a1, t1, 0.5001), -3.1416, 1e-3);
 }
 
+TEST(LinearInterpolationTest, TrajectoryPointSteer) {
+  TrajectoryPoint tp0;
+  tp0.mutable_path_point()->set_x(1.0);
+  tp0.set_steer(0.1);
+  tp0.set_relative_time(0.0);
+  TrajectoryPoint tp1;
+  tp1.mutable_path_point()->set_x(3.0);
+  tp1.set_steer(0.3);
+  tp1.set_relative_time(1.0);
+
+  TrajectoryPoint tp = InterpolateUsingLinearApproximation(tp0, tp1, 0.5);
+  EXPECT_NEAR(tp.path_point().x(), 2.0, 1e-6);
+  EXPECT_NEAR(tp.steer(), 0.2, 1e-6);
+
+  tp = InterpolateUsingLinearApproximation(tp0, tp1, 0.75);
+  EXPECT_NEAR(tp.steer(), 0.25, 1e-6);
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
@@ -240,29 +240,28 @@ class LRUCache {
     return true;
   }
 
+  // A silent get only calls map_.find(), so silent gets from several threads
+  // are safe as long as nothing modifies the cache meanwhile.
   V* Get(const K& key, bool silent) {
-    if (Contains(key)) {
-      auto* node = &map_[key];
-      if (!silent) {
-        Detach(node);
-        Attach(node);
-      }
-      return &node->val;
+    auto it = map_.find(key);
+    if (it == map_.end()) {
+      return nullptr;
     }
-    return nullptr;
+    auto* node = &it->second;
+    if (!silent) {
+      Detach(node);
+      Attach(node);
+    }
+    return &node->val;
   }
 
   bool GetCopy(const K& key, V* const val, bool silent) {
-    if (Contains(key)) {
-      auto* node = &map_[key];
-      if (!silent) {
-        Detach(node);
-        Attach(node);
-      }
-      *val = node->val;
-      return true;
+    V* node_val = Get(key, silent);
+    if (node_val == nullptr) {
+      return false;
     }
-    return false;
+    *val = *node_val;
+    return true;
   }
 
   bool GetObsolete(K* key) {
@@ -18,7 +18,9 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <unordered_map>
+#include <utility>
 
 #include "modules/common/math/line_segment2d.h"
 #include "modules/common/math/math_utils.h"
@@ -42,6 +44,11 @@ using std::placeholders::_1;
 namespace {
 
 const double kSampleDistance = 0.25;
+// The s window searched around the previous projection in GetProjections, as
+// a multiple of the largest possible distance from the point to the path.
+const double kProjectionSearchRangeRatio = 4.0;
+// Number of consecutive segments sharing one bounding box.
+const int kSegmentBoxSize = 16;
 
 bool FindLaneSegment(const MapPathPoint& p1, const MapPathPoint& p2,
                      LaneSegment* const lane_segment) {
@@ -742,42 +749,16 @@ bool Path::GetProjectionWithHueristicParams(const Vec2d& point,
     return false;
   }
   CHECK_GE(num_points_, 2);
-  *min_distance = std::numeric_limits<double>::infinity();
 
   int start_interpolation_index = GetIndexFromS(hueristic_start_s).id;
   int end_interpolation_index = static_cast<int>(
       std::fmin(num_segments_, GetIndexFromS(hueristic_end_s).id + 1));
-  int min_index = start_interpolation_index;
-  for (int i = start_interpolation_index; i < end_interpolation_index; ++i) {
-    const double distance = segments_[i].DistanceSquareTo(point);
-    if (distance < *min_distance) {
-      min_index = i;
-      *min_distance = distance;
-    }
-  }
-  *min_distance = std::sqrt(*min_distance);
-  const auto& nearest_seg = segments_[min_index];
-  const auto prod = nearest_seg.ProductOntoUnit(point);
-  const auto proj = nearest_seg.ProjectOntoUnit(point);
-  if (min_index == 0) {
-    *accumulate_s = std::min(proj, nearest_seg.length());
-    if (proj < 0) {
-      *lateral = prod;
-    } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-    }
-  } else if (min_index == num_segments_ - 1) {
-    *accumulate_s = accumulated_s_[min_index] + std::max(0.0, proj);
-    if (proj > 0) {
-      *lateral = prod;
-    } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-    }
-  } else {
-    *accumulate_s = accumulated_s_[min_index] +
-                    std::max(0.0, std::min(proj, nearest_seg.length()));
-    *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-  }
+  double min_sqr_distance = 0.0;
+  const int min_index = FindNearestSegment(
+      *segment_arrays_.Get(*this), point, start_interpolation_index,
+      end_interpolation_index, &min_sqr_distance);
+  ComputeProjection(point, min_index, min_sqr_distance, accumulate_s, lateral,
+                    min_distance);
   return true;
 }
 
@@ -795,16 +776,246 @@ bool Path::GetProjection(const Vec2d& point, double* accumulate_s,
                                         min_distance);
   }
   CHECK_GE(num_points_, 2);
-  *min_distance = std::numeric_limits<double>::infinity();
-  int min_index = 0;
+  double min_sqr_distance = 0.0;
+  const int min_index = FindNearestSegment(*segment_arrays_.Get(*this), point,
+                                           0, num_segments_, &min_sqr_distance);
+  ComputeProjection(point, min_index, min_sqr_distance, accumulate_s, lateral,
+                    min_distance);
+  return true;
+}
+
+bool Path::GetProjections(const std::vector<Vec2d>& points,
+                          std::vector<double>* accumulate_s,
+                          std::vector<double>* lateral) const {
+  std::vector<double> distances;
+  return GetProjections(points, accumulate_s, lateral, &distances);
+}
+
+bool Path::GetProjections(const std::vector<Vec2d>& points,
+                          std::vector<double>* accumulate_s,
+                          std::vector<double>* lateral,
+                          std::vector<double>* distances) const {
+  if (segments_.empty()) {
+    return false;
+  }
+  if (accumulate_s == nullptr || lateral == nullptr || distances == nullptr) {
+    return false;
+  }
+  const size_t num_query_points = points.size();
+  accumulate_s->resize(num_query_points);
+  lateral->resize(num_query_points);
+  distances->resize(num_query_points);
+  if (use_path_approximation_) {
+    for (size_t i = 0; i < num_query_points; ++i) {
+      if (!approximation_.GetProjection(*this, points[i], &(*accumulate_s)[i],
+                                        &(*lateral)[i], &(*distances)[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+  CHECK_GE(num_points_, 2);
+  const auto arrays = segment_arrays_.Get(*this);
+  for (size_t i = 0; i < num_query_points; ++i) {
+    const auto& point = points[i];
+    double min_sqr_distance = std::numeric_limits<double>::infinity();
+    int min_index = -1;
+    if (i > 0) {
+      // The distance to the path changes at most as much as the query point
+      // moves, so the nearest point is no farther than max_distance. Look for
+      // it in an s window around the previous projection first.
+      const double max_distance =
+          (*distances)[i - 1] + point.DistanceTo(points[i - 1]);
+      const double last_s =
+          common::math::Clamp((*accumulate_s)[i - 1], 0.0, length_);
+      const double search_range = kProjectionSearchRangeRatio * max_distance;
+      const int begin_index = static_cast<int>(
+          std::lower_bound(accumulated_s_.begin() + 1, accumulated_s_.end(),
+                           last_s - search_range) -
+          (accumulated_s_.begin() + 1));
+      const int end_index = std::min(
+          num_segments_,
+          static_cast<int>(std::upper_bound(accumulated_s_.begin(),
+                                            accumulated_s_.end(),
+                                            last_s + search_range) -
+                           accumulated_s_.begin()));
+      if (begin_index < end_index) {
+        min_index = FindNearestSegment(*arrays, point, begin_index,
+                                       end_index, &min_sqr_distance);
+      }
+      if (min_sqr_distance > Sqr(max_distance) + kMathEpsilon) {
+        // The window missed the nearest segment.
+        min_index = -1;
+      } else {
+        // The path may come back close to the point outside of the window,
+        // e.g. on a hairpin.
+        RefineNearestSegment(*arrays, point, begin_index, end_index,
+                             &min_index, &min_sqr_distance);
+      }
+    }
+    if (min_index < 0) {
+      min_index = FindNearestSegment(*arrays, point, 0, num_segments_,
+                                     &min_sqr_distance);
+    }
+    ComputeProjection(point, min_index, min_sqr_distance, &(*accumulate_s)[i],
+                      &(*lateral)[i], &(*distances)[i]);
+  }
+  return true;
+}
+
+Path::SegmentArraysCache::SegmentArraysCache(const SegmentArraysCache& other)
+    : arrays_(std::atomic_load(&other.arrays_)) {}
+
+Path::SegmentArraysCache& Path::SegmentArraysCache::operator=(
+    const SegmentArraysCache& other) {
+  std::atomic_store(&arrays_, std::atomic_load(&other.arrays_));
+  return *this;
+}
+
+std::shared_ptr<const Path::SegmentArrays> Path::SegmentArraysCache::Get(
+    const Path& path) const {
+  auto arrays = std::atomic_load(&arrays_);
+  if (arrays == nullptr) {
+    // Concurrent first searches may each build the arrays. They are equal,
+    // so whichever is stored last is kept.
+    arrays = path.BuildSegmentArrays();
+    std::atomic_store(&arrays_, arrays);
+  }
+  return arrays;
+}
+
+std::shared_ptr<const Path::SegmentArrays> Path::BuildSegmentArrays() const {
+  auto arrays = std::make_shared<SegmentArrays>();
+  arrays->start_x.resize(num_segments_);
+  arrays->start_y.resize(num_segments_);
+  arrays->end_x.resize(num_segments_);
+  arrays->end_y.resize(num_segments_);
+  arrays->unit_x.resize(num_segments_);
+  arrays->unit_y.resize(num_segments_);
+  arrays->length.resize(num_segments_);
   for (int i = 0; i < num_segments_; ++i) {
-    const double distance = segments_[i].DistanceSquareTo(point);
-    if (distance < *min_distance) {
-      min_index = i;
-      *min_distance = distance;
+    const auto& segment = segments_[i];
+    arrays->start_x[i] = segment.start().x();
+    arrays->start_y[i] = segment.start().y();
+    arrays->end_x[i] = segment.end().x();
+    arrays->end_y[i] = segment.end().y();
+    arrays->unit_x[i] = segment.unit_direction().x();
+    arrays->unit_y[i] = segment.unit_direction().y();
+    arrays->length[i] = segment.length();
+  }
+
+  const int num_boxes = (num_segments_ + kSegmentBoxSize - 1) / kSegmentBoxSize;
+  arrays->box_min_x.assign(num_boxes, std::numeric_limits<double>::max());
+  arrays->box_min_y.assign(num_boxes, std::numeric_limits<double>::max());
+  arrays->box_max_x.assign(num_boxes, std::numeric_limits<double>::lowest());
+  arrays->box_max_y.assign(num_boxes, std::numeric_limits<double>::lowest());
+  for (int i = 0; i < num_segments_; ++i) {
+    const int box = i / kSegmentBoxSize;
+    arrays->box_min_x[box] = std::min(
+        {arrays->box_min_x[box], arrays->start_x[i], arrays->end_x[i]});
+    arrays->box_min_y[box] = std::min(
+        {arrays->box_min_y[box], arrays->start_y[i], arrays->end_y[i]});
+    arrays->box_max_x[box] = std::max(
+        {arrays->box_max_x[box], arrays->start_x[i], arrays->end_x[i]});
+    arrays->box_max_y[box] = std::max(
+        {arrays->box_max_y[box], arrays->start_y[i], arrays->end_y[i]});
+  }
+  return arrays;
+}
+
+int Path::FindNearestSegment(const SegmentArrays& arrays, const Vec2d& point,
+                             const int begin_index, const int end_index,
+                             double* min_sqr_distance) const {
+  // Distances are computed chunk by chunk in a branch free loop over the
+  // segment arrays, which the compiler vectorizes. The arg min is a separate
+  // pass so that the first nearest segment is picked, as in
+  // LineSegment2d::DistanceSquareTo based searches.
+  static constexpr int kChunkSize = 64;
+  double sqr_distances[kChunkSize];
+  const double x = point.x();
+  const double y = point.y();
+  const double* start_x = arrays.start_x.data();
+  const double* start_y = arrays.start_y.data();
+  const double* end_x = arrays.end_x.data();
+  const double* end_y = arrays.end_y.data();
+  const double* unit_x = arrays.unit_x.data();
+  const double* unit_y = arrays.unit_y.data();
+  const double* length = arrays.length.data();
+
+  int min_index = begin_index;
+  *min_sqr_distance = std::numeric_limits<double>::infinity();
+  for (int chunk_begin = begin_index; chunk_begin < end_index;
+       chunk_begin += kChunkSize) {
+    const int chunk_size = std::min(kChunkSize, end_index - chunk_begin);
+    for (int k = 0; k < chunk_size; ++k) {
+      const int i = chunk_begin + k;
+      const double x0 = x - start_x[i];
+      const double y0 = y - start_y[i];
+      const double x1 = x - end_x[i];
+      const double y1 = y - end_y[i];
+      const double proj = x0 * unit_x[i] + y0 * unit_y[i];
+      const double prod = x0 * unit_y[i] - y0 * unit_x[i];
+      const double start_sqr_distance = x0 * x0 + y0 * y0;
+      const double end_sqr_distance = x1 * x1 + y1 * y1;
+      // Degenerated segments have a zero unit direction, hence proj == 0.
+      sqr_distances[k] =
+          proj <= 0.0 ? start_sqr_distance
+                      : (proj >= length[i] ? end_sqr_distance : prod * prod);
+    }
+    for (int k = 0; k < chunk_size; ++k) {
+      if (sqr_distances[k] < *min_sqr_distance) {
+        min_index = chunk_begin + k;
+        *min_sqr_distance = sqr_distances[k];
+      }
     }
   }
-  *min_distance = std::sqrt(*min_distance);
+  return min_index;
+}
+
+void Path::RefineNearestSegment(const SegmentArrays& arrays,
+                                const Vec2d& point, const int begin_index,
+                                const int end_index, int* min_index,
+                                double* min_sqr_distance) const {
+  const int num_boxes = static_cast<int>(arrays.box_min_x.size());
+  for (int box = 0; box < num_boxes; ++box) {
+    const int box_begin = box * kSegmentBoxSize;
+    const int box_end = std::min(num_segments_, box_begin + kSegmentBoxSize);
+    if (box_begin >= begin_index && box_end <= end_index) {
+      continue;
+    }
+    const double dx = std::max({arrays.box_min_x[box] - point.x(), 0.0,
+                                point.x() - arrays.box_max_x[box]});
+    const double dy = std::max({arrays.box_min_y[box] - point.y(), 0.0,
+                                point.y() - arrays.box_max_y[box]});
+    if (dx * dx + dy * dy > *min_sqr_distance + kMathEpsilon) {
+      continue;
+    }
+    // Segments of the box before and after the window.
+    const std::pair<int, int> ranges[] = {
+        {box_begin, std::min(box_end, begin_index)},
+        {std::max(box_begin, end_index), box_end}};
+    for (const auto& range : ranges) {
+      if (range.first >= range.second) {
+        continue;
+      }
+      double sqr_distance = 0.0;
+      const int index = FindNearestSegment(arrays, point, range.first,
+                                           range.second, &sqr_distance);
+      // Ties go to the first segment, as in the search over the whole path.
+      if (sqr_distance < *min_sqr_distance ||
+          (sqr_distance == *min_sqr_distance && index < *min_index)) {
+        *min_index = index;
+        *min_sqr_distance = sqr_distance;
+      }
+    }
+  }
+}
+
+void Path::ComputeProjection(const Vec2d& point, const int min_index,
+                             const double min_sqr_distance,
+                             double* accumulate_s, double* lateral,
+                             double* min_distance) const {
+  *min_distance = std::sqrt(min_sqr_distance);
   const auto& nearest_seg = segments_[min_index];
   const auto prod = nearest_seg.ProductOntoUnit(point);
   const auto proj = nearest_seg.ProjectOntoUnit(point);
@@ -827,7 +1038,6 @@ bool Path::GetProjection(const Vec2d& point, double* accumulate_s,
                     std::max(0.0, std::min(proj, nearest_seg.length()));
     *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
   }
-  return true;
 }
 
 bool Path::GetHeadingAlongPath(const Vec2d& point, double* heading) const {
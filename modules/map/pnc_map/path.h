@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -261,6 +262,18 @@ class Path {
   bool GetProjection(const common::math::Vec2d& point, double* accumulate_s,
                      double* lateral, double* distance) const;
 
+  // Project a sequence of points onto the path. Consecutive points are
+  // expected to be close to each other (e.g. polygon corners or trajectory
+  // points), so the projection of the previous point is used to narrow down
+  // the segment search of the next one.
+  bool GetProjections(const std::vector<common::math::Vec2d>& points,
+                      std::vector<double>* accumulate_s,
+                      std::vector<double>* lateral) const;
+  bool GetProjections(const std::vector<common::math::Vec2d>& points,
+                      std::vector<double>* accumulate_s,
+                      std::vector<double>* lateral,
+                      std::vector<double>* distances) const;
+
   bool GetHeadingAlongPath(const common::math::Vec2d& point,
                            double* heading) const;
 
@@ -341,6 +354,58 @@ class Path {
 
   double GetSample(const std::vector<double>& samples, const double s) const;
 
+  // Structure-of-arrays copy of segments_ for the nearest segment search.
+  struct SegmentArrays {
+    std::vector<double> start_x;
+    std::vector<double> start_y;
+    std::vector<double> end_x;
+    std::vector<double> end_y;
+    std::vector<double> unit_x;
+    std::vector<double> unit_y;
+    std::vector<double> length;
+    // Bounding boxes of consecutive groups of segments, which bound the
+    // distance to the segments outside of a searched window from below.
+    std::vector<double> box_min_x;
+    std::vector<double> box_min_y;
+    std::vector<double> box_max_x;
+    std::vector<double> box_max_y;
+  };
+
+  // The segment arrays are only needed by the segment search, and paths
+  // projected with the path approximation or not at all never search. So
+  // they are built by the first search and then shared by copies of the
+  // path. Copies and builds may run concurrently.
+  class SegmentArraysCache {
+   public:
+    SegmentArraysCache() = default;
+    SegmentArraysCache(const SegmentArraysCache& other);
+    SegmentArraysCache& operator=(const SegmentArraysCache& other);
+
+    std::shared_ptr<const SegmentArrays> Get(const Path& path) const;
+
+   private:
+    mutable std::shared_ptr<const SegmentArrays> arrays_;
+  };
+
+  std::shared_ptr<const SegmentArrays> BuildSegmentArrays() const;
+
+  // Find the segment in [begin_index, end_index) nearest to the point.
+  int FindNearestSegment(const SegmentArrays& arrays,
+                         const common::math::Vec2d& point,
+                         const int begin_index, const int end_index,
+                         double* min_sqr_distance) const;
+  // Check the segments in [0, num_segments_) but not in
+  // [begin_index, end_index) whose bounding boxes are not farther than
+  // min_sqr_distance, so that the nearest segment found in the window becomes
+  // the nearest segment of the whole path.
+  void RefineNearestSegment(const SegmentArrays& arrays,
+                            const common::math::Vec2d& point,
+                            const int begin_index, const int end_index,
+                            int* min_index, double* min_sqr_distance) const;
+  void ComputeProjection(const common::math::Vec2d& point, const int min_index,
+                         const double min_sqr_distance, double* accumulate_s,
+                         double* lateral, double* min_distance) const;
+
   using GetOverlapFromLaneFunc =
       std::function<const std::vector<OverlapInfoConstPtr>&(const LaneInfo&)>;
   void GetAllOverlaps(GetOverlapFromLaneFunc GetOverlaps_from_lane,
@@ -357,6 +422,7 @@ class Path {
   double length_ = 0.0;
   std::vector<double> accumulated_s_;
   std::vector<common::math::LineSegment2d> segments_;
+  SegmentArraysCache segment_arrays_;
   bool use_path_approximation_ = false;
   PathApproximation approximation_;
 
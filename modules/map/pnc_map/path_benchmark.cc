@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <cmath>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "modules/map/pnc_map/path.h"
+
+namespace apollo {
+namespace hdmap {
+namespace {
+
+using common::math::Vec2d;
+
+// a straight lane of the given length and 3.5 m width, which provides the
+// path widths. LaneInfo refers to the lane, so the lane must outlive it.
+LaneInfoConstPtr MakeLane(const double length, Lane* lane) {
+  lane->mutable_id()->set_id("lane");
+  auto* segment =
+      lane->mutable_central_curve()->add_segment()->mutable_line_segment();
+  for (const double x : {0.0, length}) {
+    auto* point = segment->add_point();
+    point->set_x(x);
+    point->set_y(0.0);
+    auto* left_sample = lane->add_left_sample();
+    left_sample->set_s(x);
+    left_sample->set_width(1.75);
+    *lane->add_right_sample() = *left_sample;
+  }
+  return LaneInfoConstPtr(new LaneInfo(*lane));
+}
+
+// a wavy path with 0.5 m segments along the lane
+std::vector<MapPathPoint> MakePathPoints(const int num_segments, Lane* lane) {
+  const auto lane_info =
+      MakeLane(0.5 * static_cast<double>(num_segments), lane);
+  std::vector<MapPathPoint> points;
+  for (int i = 0; i <= num_segments; ++i) {
+    const double x = 0.5 * static_cast<double>(i);
+    points.push_back(MapPathPoint({x, 10.0 * std::sin(x / 20.0)}, 0.0,
+                                  LaneWaypoint(lane_info, x)));
+  }
+  return points;
+}
+
+// trajectory like points evenly spread along the path, 1.5 m off it
+std::vector<Vec2d> MakeQueryPoints(const int num_points, const Path& path) {
+  const double end_x = path.path_points().back().x();
+  std::vector<Vec2d> points;
+  for (int i = 0; i < num_points; ++i) {
+    const double x = end_x * static_cast<double>(i) / num_points;
+    points.emplace_back(x, 10.0 * std::sin(x / 20.0) + 1.5);
+  }
+  return points;
+}
+
+void BM_PathConstruction(benchmark::State& state) {  // NOLINT
+  Lane lane;
+  const auto points = MakePathPoints(static_cast<int>(state.range(0)), &lane);
+  while (state.KeepRunning()) {
+    Path path(points, {});
+    benchmark::DoNotOptimize(path.length());
+  }
+}
+BENCHMARK(BM_PathConstruction)->Arg(200)->Arg(2000);
+
+void BM_PathGetProjection(benchmark::State& state) {  // NOLINT
+  Lane lane;
+  const Path path(MakePathPoints(static_cast<int>(state.range(0)), &lane), {});
+  const auto query_points = MakeQueryPoints(5000, path);
+  while (state.KeepRunning()) {
+    for (const auto& point : query_points) {
+      double s = 0.0;
+      double l = 0.0;
+      path.GetProjection(point, &s, &l);
+      benchmark::DoNotOptimize(s);
+      benchmark::DoNotOptimize(l);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * query_points.size());
+}
+BENCHMARK(BM_PathGetProjection)->Arg(200)->Arg(2000);
+
+void BM_PathGetProjections(benchmark::State& state) {  // NOLINT
+  Lane lane;
+  const Path path(MakePathPoints(static_cast<int>(state.range(0)), &lane), {});
+  const auto query_points = MakeQueryPoints(5000, path);
+  std::vector<double> s;
+  std::vector<double> l;
+  while (state.KeepRunning()) {
+    path.GetProjections(query_points, &s, &l);
+    benchmark::DoNotOptimize(s.data());
+    benchmark::DoNotOptimize(l.data());
+  }
+  state.SetItemsProcessed(state.iterations() * query_points.size());
+}
+BENCHMARK(BM_PathGetProjections)->Arg(200)->Arg(2000);
+
+}  // namespace
+}  // namespace hdmap
+}  // namespace apollo
+
+BENCHMARK_MAIN();
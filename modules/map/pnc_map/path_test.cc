@@ -654,6 +654,122 @@ TEST(TestSuite, hdmap_s_path) {
   }
 }
 
+TEST(TestSuite, hdmap_path_get_projections) {
+  std::vector<MapPathPoint> points;
+  const double kRadius = 50.0;
+  const int kNumSegments = 1000;
+  for (int i = 0; i <= kNumSegments; ++i) {
+    const double p = 4.0 * M_PI * static_cast<double>(i) /
+                     static_cast<double>(kNumSegments);
+    points.push_back(MakeMapPathPoint(kRadius * p, kRadius * sin(p)));
+  }
+  const Path path(points, {});
+
+  // Monotone query points along the path, followed by random jumps.
+  std::vector<Vec2d> query_points;
+  for (int i = 0; i < 2000; ++i) {
+    const double p = -0.2 + 4.4 * M_PI * static_cast<double>(i) / 2000.0;
+    query_points.emplace_back(kRadius * p + RandomDouble(-2.0, 2.0),
+                              kRadius * sin(p) + RandomDouble(-5.0, 5.0));
+  }
+  for (int i = 0; i < 200; ++i) {
+    query_points.emplace_back(RandomDouble(-kRadius, kRadius * 14.0),
+                              RandomDouble(-kRadius * 2.0, kRadius * 2.0));
+  }
+
+  std::vector<double> accumulate_s;
+  std::vector<double> lateral;
+  std::vector<double> distances;
+  EXPECT_TRUE(
+      path.GetProjections(query_points, &accumulate_s, &lateral, &distances));
+  ASSERT_EQ(query_points.size(), accumulate_s.size());
+  ASSERT_EQ(query_points.size(), lateral.size());
+  ASSERT_EQ(query_points.size(), distances.size());
+  for (size_t i = 0; i < query_points.size(); ++i) {
+    double expected_s = 0.0;
+    double expected_l = 0.0;
+    double expected_distance = 0.0;
+    EXPECT_TRUE(path.GetProjection(query_points[i], &expected_s, &expected_l,
+                                   &expected_distance));
+    EXPECT_NEAR(expected_s, accumulate_s[i], 1e-6);
+    EXPECT_NEAR(expected_l, lateral[i], 1e-6);
+    EXPECT_NEAR(expected_distance, distances[i], 1e-6);
+  }
+
+  Path empty_path;
+  EXPECT_FALSE(
+      empty_path.GetProjections(query_points, &accumulate_s, &lateral));
+  EXPECT_FALSE(path.GetProjections(query_points, nullptr, &lateral));
+}
+
+TEST(TestSuite, hdmap_path_get_projections_hairpin) {
+  // Out along y = 0, a U-turn of radius 1, then back along y = 2.
+  std::vector<MapPathPoint> points;
+  for (int i = 0; i <= 100; ++i) {
+    points.push_back(MakeMapPathPoint(static_cast<double>(i), 0.0));
+  }
+  for (int i = 1; i < 10; ++i) {
+    const double p = M_PI * static_cast<double>(i) / 10.0 - M_PI_2;
+    points.push_back(MakeMapPathPoint(100.0 + cos(p), 1.0 + sin(p)));
+  }
+  for (int i = 100; i >= 0; --i) {
+    points.push_back(MakeMapPathPoint(static_cast<double>(i), 2.0));
+  }
+  const Path path(points, {});
+
+  // The second point of each pair is nearer to the way back, far away in s
+  // from the projection of the first point.
+  const std::vector<Vec2d> query_points = {
+      {50.0, 0.5}, {50.0, 1.6}, {30.0, 0.2}, {30.0, 1.3}, {70.0, 1.9},
+      {70.0, 0.4}, {10.5, 0.1}, {10.5, 1.05}};
+  std::vector<double> accumulate_s;
+  std::vector<double> lateral;
+  std::vector<double> distances;
+  EXPECT_TRUE(
+      path.GetProjections(query_points, &accumulate_s, &lateral, &distances));
+  ASSERT_EQ(query_points.size(), accumulate_s.size());
+  for (size_t i = 0; i < query_points.size(); ++i) {
+    double expected_s = 0.0;
+    double expected_l = 0.0;
+    double expected_distance = 0.0;
+    EXPECT_TRUE(path.GetProjection(query_points[i], &expected_s, &expected_l,
+                                   &expected_distance));
+    EXPECT_NEAR(expected_s, accumulate_s[i], 1e-6);
+    EXPECT_NEAR(expected_l, lateral[i], 1e-6);
+    EXPECT_NEAR(expected_distance, distances[i], 1e-6);
+  }
+  EXPECT_NEAR(0.4, distances[1], 1e-6);
+  EXPECT_GT(accumulate_s[1], 100.0);
+}
+
+TEST(TestSuite, hdmap_path_projection_after_copy) {
+  std::vector<MapPathPoint> points;
+  for (int i = 0; i <= 100; ++i) {
+    const double x = static_cast<double>(i);
+    points.push_back(MakeMapPathPoint(x, 5.0 * sin(x / 10.0)));
+  }
+  const Path path(points, {});
+  const Vec2d point(42.3, 1.7);
+
+  // The segment arrays are built by the first search. Copies made before and
+  // after it must project the same way.
+  const Path copy_before_search = path;
+  double expected_s = 0.0;
+  double expected_l = 0.0;
+  EXPECT_TRUE(path.GetProjection(point, &expected_s, &expected_l));
+  Path copy_after_search;
+  copy_after_search = path;
+  const std::vector<const Path*> copies = {&copy_before_search,
+                                           &copy_after_search};
+  for (const Path* copy : copies) {
+    double s = 0.0;
+    double l = 0.0;
+    EXPECT_TRUE(copy->GetProjection(point, &s, &l));
+    EXPECT_DOUBLE_EQ(expected_s, s);
+    EXPECT_DOUBLE_EQ(expected_l, l);
+  }
+}
+
 TEST(TestSuite, hdmap_path_get_smooth_point) {
   const double kRadius = 50.0;
   const int kNumSegments = 100;
@@ -49,9 +49,79 @@ using apollo::prediction::PredictionObstacles;
 
 constexpr double kMathEpsilon = 1e-8;
 
+namespace {
+// free frames kept by the pool; one is enough for the steady state in which
+// every cycle evicts exactly one frame from the history.
+constexpr size_t kMaxFreeFrames = 2;
+}  // namespace
+
 FrameHistory::FrameHistory()
     : IndexedQueue<uint32_t, Frame>(FLAGS_max_history_frame_num) {}
 
+bool FrameHistory::Add(const uint32_t id, std::unique_ptr<Frame> frame) {
+  std::unique_ptr<Frame> evicted;
+  if (!IndexedQueue<uint32_t, Frame>::Add(id, std::move(frame), &evicted)) {
+    return false;
+  }
+  if (evicted != nullptr) {
+    FramePool::Instance()->Release(std::move(evicted));
+  }
+  return true;
+}
+
+FramePool::FramePool() {}
+
+std::unique_ptr<Frame> FramePool::Acquire(
+    uint32_t sequence_num, const LocalView &local_view,
+    const common::TrajectoryPoint &planning_start_point,
+    const common::VehicleState &vehicle_state,
+    ReferenceLineProvider *reference_line_provider) {
+  std::unique_ptr<Frame> frame;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_frames_.empty()) {
+      ++num_allocated_;
+    } else {
+      frame = std::move(free_frames_.back());
+      free_frames_.pop_back();
+      ++num_reused_;
+    }
+  }
+  if (frame == nullptr) {
+    return std::make_unique<Frame>(sequence_num, local_view,
+                                   planning_start_point, vehicle_state,
+                                   reference_line_provider);
+  }
+  frame->Reset(sequence_num, local_view, planning_start_point, vehicle_state,
+               reference_line_provider);
+  return frame;
+}
+
+void FramePool::Release(std::unique_ptr<Frame> frame) {
+  if (frame == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (free_frames_.size() < kMaxFreeFrames) {
+    free_frames_.push_back(std::move(frame));
+  }
+}
+
+void FramePool::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  free_frames_.clear();
+}
+
+size_t FramePool::num_allocated() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_allocated_;
+}
+
+size_t FramePool::num_reused() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_reused_;
+}
+
 Frame::Frame(uint32_t sequence_num)
     : sequence_num_(sequence_num),
       monitor_logger_buffer_(common::monitor::MonitorMessageItem::PLANNING) {}
@@ -73,6 +143,30 @@ Frame::Frame(uint32_t sequence_num, const LocalView &local_view,
     : Frame(sequence_num, local_view, planning_start_point, vehicle_state,
             nullptr) {}
 
+void Frame::Reset(uint32_t sequence_num, const LocalView &local_view,
+                  const common::TrajectoryPoint &planning_start_point,
+                  const common::VehicleState &vehicle_state,
+                  ReferenceLineProvider *reference_line_provider) {
+  sequence_num_ = sequence_num;
+  local_view_ = local_view;
+  hdmap_ = nullptr;
+  planning_start_point_ = planning_start_point;
+  vehicle_state_ = vehicle_state;
+  reference_line_provider_ = reference_line_provider;
+
+  drive_reference_line_info_ = nullptr;
+  reference_line_info_.clear();
+  is_near_destination_ = false;
+  obstacles_.Clear();
+  obstacle_box_cache_.Clear();
+  // protobuf Clear() keeps the allocated repeated fields for reuse
+  current_frame_planned_trajectory_.Clear();
+  open_space_debug_.Clear();
+  stitching_trajectory_.clear();
+  open_space_info_.reset();
+  future_route_waypoints_.clear();
+}
+
 const common::TrajectoryPoint &Frame::PlanningStartPoint() const {
   return planning_start_point_;
 }
@@ -315,6 +409,9 @@ const Obstacle *Frame::CreateStaticObstacle(
 
 const Obstacle *Frame::CreateStaticVirtualObstacle(const std::string &id,
                                                    const Box2d &box) {
+  // reference lines may be planned concurrently and create the same virtual
+  // obstacle, so look up and add under one lock.
+  std::lock_guard<std::mutex> lock(virtual_obstacle_mutex_);
   const auto *object = obstacles_.Find(id);
   if (object) {
     AWARN << "obstacle " << id << " already exist.";
@@ -363,9 +460,8 @@ Status Frame::InitFrameData() {
          << FLAGS_align_prediction_time;
 
   if (FLAGS_align_prediction_time) {
-    auto prediction = *(local_view_.prediction_obstacles);
-    AlignPredictionTime(vehicle_state_.timestamp(), &prediction);
-    local_view_.prediction_obstacles->CopyFrom(prediction);
+    AlignPredictionTime(vehicle_state_.timestamp(),
+                        local_view_.prediction_obstacles.get());
   }
   for (auto &ptr :
        Obstacle::CreateObstacles(*local_view_.prediction_obstacles)) {
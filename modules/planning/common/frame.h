@@ -23,6 +23,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -43,6 +44,7 @@
 #include "modules/planning/common/indexed_queue.h"
 #include "modules/planning/common/local_view.h"
 #include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/obstacle_box_cache.h"
 #include "modules/planning/common/open_space_info.h"
 #include "modules/planning/common/reference_line_info.h"
 #include "modules/planning/common/trajectory/publishable_trajectory.h"
@@ -70,6 +72,15 @@ class Frame {
         const common::TrajectoryPoint &planning_start_point,
         const common::VehicleState &vehicle_state);
 
+  /**
+   * @brief Re-initialize a recycled frame for a new planning cycle. All
+   * per-cycle state is dropped while the containers keep their capacity.
+   */
+  void Reset(uint32_t sequence_num, const LocalView &local_view,
+             const common::TrajectoryPoint &planning_start_point,
+             const common::VehicleState &vehicle_state,
+             ReferenceLineProvider *reference_line_provider);
+
   const common::TrajectoryPoint &PlanningStartPoint() const;
 
   common::Status Init(
@@ -162,6 +173,10 @@ class Frame {
 
   ThreadSafeIndexedObstacles *GetObstacleList() { return &obstacles_; }
 
+  ObstacleBoxCache *mutable_obstacle_box_cache() {
+    return &obstacle_box_cache_;
+  }
+
   const OpenSpaceInfo &open_space_info() const { return *open_space_info_; }
 
   OpenSpaceInfo *mutable_open_space_info() { return open_space_info_.get(); }
@@ -204,6 +219,8 @@ class Frame {
   const ReferenceLineInfo *drive_reference_line_info_ = nullptr;
 
   ThreadSafeIndexedObstacles obstacles_;
+  std::mutex virtual_obstacle_mutex_;
+  ObstacleBoxCache obstacle_box_cache_;
   ChangeLaneDecider change_lane_decider_;
   ADCTrajectory current_frame_planned_trajectory_;  // last published trajectory
 
@@ -221,7 +238,48 @@ class Frame {
   common::monitor::MonitorLogBuffer monitor_logger_buffer_;
 };
 
+/**
+ * @class FramePool
+ *
+ * @brief FramePool recycles the frames evicted from FrameHistory, so that a
+ * planning cycle reuses a previous Frame and its containers instead of
+ * allocating a new one.
+ */
+class FramePool {
+ public:
+  std::unique_ptr<Frame> Acquire(
+      uint32_t sequence_num, const LocalView &local_view,
+      const common::TrajectoryPoint &planning_start_point,
+      const common::VehicleState &vehicle_state,
+      ReferenceLineProvider *reference_line_provider);
+
+  void Release(std::unique_ptr<Frame> frame);
+
+  void Clear();
+
+  // number of frames newly allocated by Acquire()
+  size_t num_allocated() const;
+
+  // number of frames recycled by Acquire()
+  size_t num_reused() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<Frame>> free_frames_;
+  size_t num_allocated_ = 0;
+  size_t num_reused_ = 0;
+
+  DECLARE_SINGLETON(FramePool)
+};
+
 class FrameHistory : public IndexedQueue<uint32_t, Frame> {
+ public:
+  /**
+   * @brief Add a frame to the history. The frame evicted from a full history
+   * is handed back to FramePool.
+   */
+  bool Add(const uint32_t id, std::unique_ptr<Frame> frame);
+
  private:
   DECLARE_SINGLETON(FrameHistory)
 };
@@ -63,5 +63,35 @@ TEST_F(FrameTest, AlignPredictionTime) {
                    .trajectory_point_size());
 }
 
+TEST(FramePoolTest, RecycleFrame) {
+  auto *frame_pool = FramePool::Instance();
+  frame_pool->Clear();
+  const size_t num_allocated = frame_pool->num_allocated();
+  const size_t num_reused = frame_pool->num_reused();
+
+  LocalView local_view;
+  common::TrajectoryPoint planning_start_point;
+  common::VehicleState vehicle_state;
+  auto frame = frame_pool->Acquire(1, local_view, planning_start_point,
+                                   vehicle_state, nullptr);
+  ASSERT_NE(nullptr, frame);
+  EXPECT_EQ(1, frame->SequenceNum());
+  EXPECT_EQ(num_allocated + 1, frame_pool->num_allocated());
+  EXPECT_EQ(num_reused, frame_pool->num_reused());
+  frame->mutable_last_stitching_trajectory()->resize(10);
+
+  const Frame *recycled = frame.get();
+  frame_pool->Release(std::move(frame));
+  frame = frame_pool->Acquire(2, local_view, planning_start_point,
+                              vehicle_state, nullptr);
+  EXPECT_EQ(recycled, frame.get());
+  EXPECT_EQ(2, frame->SequenceNum());
+  EXPECT_TRUE(frame->last_stitching_trajectory().empty());
+  EXPECT_TRUE(frame->reference_line_info().empty());
+  EXPECT_TRUE(frame->obstacles().empty());
+  EXPECT_EQ(num_allocated + 1, frame_pool->num_allocated());
+  EXPECT_EQ(num_reused + 1, frame_pool->num_reused());
+}
+
 }  // namespace planning
 }  // namespace apollo
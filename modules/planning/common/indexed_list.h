@@ -88,6 +88,15 @@ class IndexedList {
    */
   const std::unordered_map<I, T>& Dict() const { return object_dict_; }
 
+  /**
+   * @brief Remove all objects but keep the allocated buckets and list
+   * capacity, so that a recycled container does not reallocate them.
+   */
+  void Clear() {
+    object_list_.clear();
+    object_dict_.clear();
+  }
+
   /**
    * @brief Copy the container with objects.
    */
@@ -123,6 +132,11 @@ class ThreadSafeIndexedList : public IndexedList<I, T> {
     return IndexedList<I, T>::Items();
   }
 
+  void Clear() {
+    boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
+    IndexedList<I, T>::Clear();
+  }
+
  private:
   mutable boost::shared_mutex mutex_;
 };
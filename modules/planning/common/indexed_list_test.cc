@@ -77,5 +77,17 @@ TEST(IndexedList, Copy) {
   ASSERT_EQ(nullptr, a_object.Find(4));
 }
 
+TEST(IndexedList, Clear) {
+  StringIndexedList object;
+  object.Add(1, "one");
+  object.Add(2, "two");
+  object.Clear();
+  ASSERT_TRUE(object.Items().empty());
+  ASSERT_EQ(nullptr, object.Find(1));
+  ASSERT_NE(nullptr, object.Add(3, "three"));
+  ASSERT_EQ(1, object.Items().size());
+  ASSERT_EQ("three", *object.Items()[0]);
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -48,12 +48,19 @@ class IndexedQueue {
     return Find(queue_.back().first);
   }
 
-  bool Add(const I id, std::unique_ptr<T> ptr) {
+  // If evicted is not null, the object pushed out of a full queue is moved
+  // into it instead of being destroyed.
+  bool Add(const I id, std::unique_ptr<T> ptr,
+           std::unique_ptr<T> *evicted = nullptr) {
     if (Find(id)) {
       return false;
     }
     if (capacity_ > 0 && queue_.size() == capacity_) {
-      map_.erase(queue_.front().first);
+      auto iter = map_.find(queue_.front().first);
+      if (evicted != nullptr) {
+        *evicted = std::move(iter->second);
+      }
+      map_.erase(iter);
       queue_.pop();
     }
     queue_.push(std::make_pair(id, ptr.get()));
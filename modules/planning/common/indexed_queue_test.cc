@@ -59,5 +59,17 @@ TEST(IndexedQueue, QueueSize2) {
   ASSERT_EQ("three", *object.Latest());
 }
 
+TEST(IndexedQueue, Evicted) {
+  StringIndexedQueue object(1);
+  std::unique_ptr<std::string> evicted;
+  ASSERT_TRUE(object.Add(1, std::make_unique<std::string>("one"), &evicted));
+  ASSERT_TRUE(evicted == nullptr);
+  ASSERT_TRUE(object.Add(2, std::make_unique<std::string>("two"), &evicted));
+  ASSERT_TRUE(evicted != nullptr);
+  ASSERT_EQ("one", *evicted);
+  ASSERT_TRUE(object.Find(1) == nullptr);
+  ASSERT_EQ("two", *object.Latest());
+}
+
 }  // namespace planning
 }  // namespace apollo
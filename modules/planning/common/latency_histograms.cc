@@ -0,0 +1,157 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/latency_histograms.h"
+
+#include <algorithm>
+
+#include "cyber/common/log.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+// buckets grow geometrically from 10 us to about 1 s.
+constexpr double kFirstBucketUpperMs = 0.01;
+constexpr double kBucketGrowth = 1.25;
+constexpr int kNumBoundedBuckets = 52;
+}  // namespace
+
+constexpr int LatencyHistograms::kNumLevels;
+
+LatencyHistograms::LatencyHistograms() {}
+
+LatencyHistograms::Timer::Timer(const Level level, const std::string& name)
+    : enabled_(FLAGS_enable_latency_histograms), level_(level) {
+  if (enabled_) {
+    name_ = name;
+    start_ = std::chrono::steady_clock::now();
+  }
+}
+
+LatencyHistograms::Timer::~Timer() {
+  if (!enabled_) {
+    return;
+  }
+  const std::chrono::duration<double, std::milli> time_ms =
+      std::chrono::steady_clock::now() - start_;
+  LatencyHistograms::Instance()->Record(level_, name_, time_ms.count());
+}
+
+const std::vector<double>& LatencyHistograms::BucketUpperBounds() {
+  static const std::vector<double> bounds = [] {
+    std::vector<double> upper_bounds;
+    double upper_bound = kFirstBucketUpperMs;
+    for (int i = 0; i < kNumBoundedBuckets; ++i) {
+      upper_bounds.push_back(upper_bound);
+      upper_bound *= kBucketGrowth;
+    }
+    return upper_bounds;
+  }();
+  return bounds;
+}
+
+void LatencyHistograms::Record(const Level level, const std::string& name,
+                               const double time_ms) {
+  if (!FLAGS_enable_latency_histograms) {
+    return;
+  }
+  const auto& bounds = BucketUpperBounds();
+  const int bucket = static_cast<int>(
+      std::lower_bound(bounds.begin(), bounds.end(), time_ms) - bounds.begin());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& histogram = histograms_[level][name];
+  if (histogram.count == 0) {
+    histogram.bucket_count.assign(bounds.size() + 1, 0);
+    histogram.min_ms = time_ms;
+    histogram.max_ms = time_ms;
+  }
+  ++histogram.count;
+  histogram.sum_ms += time_ms;
+  histogram.min_ms = std::min(histogram.min_ms, time_ms);
+  histogram.max_ms = std::max(histogram.max_ms, time_ms);
+  ++histogram.bucket_count[bucket];
+}
+
+double LatencyHistograms::Percentile(const Histogram& histogram,
+                                     const double ratio) {
+  const auto& bounds = BucketUpperBounds();
+  const double rank = ratio * histogram.count;
+  int cumulative_count = 0;
+  for (size_t i = 0; i < histogram.bucket_count.size(); ++i) {
+    const int bucket_count = histogram.bucket_count[i];
+    if (bucket_count == 0 || cumulative_count + bucket_count < rank) {
+      cumulative_count += bucket_count;
+      continue;
+    }
+    // interpolate linearly inside the bucket.
+    const double lower = i == 0 ? 0.0 : bounds[i - 1];
+    const double upper = i < bounds.size() ? bounds[i] : histogram.max_ms;
+    const double value =
+        lower + (upper - lower) * (rank - cumulative_count) / bucket_count;
+    return std::max(histogram.min_ms, std::min(histogram.max_ms, value));
+  }
+  return histogram.max_ms;
+}
+
+void LatencyHistograms::ToProto(const std::string& name,
+                                const Histogram& histogram,
+                                LatencyHistogram* histogram_pb) {
+  histogram_pb->set_name(name);
+  histogram_pb->set_count(histogram.count);
+  histogram_pb->set_mean_ms(histogram.sum_ms / histogram.count);
+  histogram_pb->set_min_ms(histogram.min_ms);
+  histogram_pb->set_max_ms(histogram.max_ms);
+  histogram_pb->set_p50_ms(Percentile(histogram, 0.5));
+  histogram_pb->set_p99_ms(Percentile(histogram, 0.99));
+  for (const int bucket_count : histogram.bucket_count) {
+    histogram_pb->add_bucket_count(bucket_count);
+  }
+}
+
+void LatencyHistograms::GetLatency(PlanningLatency* latency) const {
+  CHECK_NOTNULL(latency);
+  for (const double upper_bound : BucketUpperBounds()) {
+    latency->add_bucket_upper_ms(upper_bound);
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& histogram : histograms_[SCENARIO]) {
+    ToProto(histogram.first, histogram.second, latency->add_scenario());
+  }
+  for (const auto& histogram : histograms_[STAGE]) {
+    ToProto(histogram.first, histogram.second, latency->add_stage());
+  }
+  for (const auto& histogram : histograms_[TASK]) {
+    ToProto(histogram.first, histogram.second, latency->add_task());
+  }
+}
+
+void LatencyHistograms::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& histograms : histograms_) {
+    histograms.clear();
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cyber/common/macros.h"
+
+#include "modules/planning/proto/planning_stats.pb.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class LatencyHistograms
+ * @brief Latency histograms of the scenarios, stages and tasks run by the
+ * planner. Scenarios are keyed by name, stages by "scenario/stage" and tasks
+ * by "stage/task". All methods are thread safe.
+ */
+class LatencyHistograms {
+ public:
+  enum Level {
+    SCENARIO = 0,
+    STAGE = 1,
+    TASK = 2,
+  };
+
+  /**
+   * @class Timer
+   * @brief Records the wall time between its construction and destruction.
+   * Does not read the clock when the histograms are disabled.
+   */
+  class Timer {
+   public:
+    Timer(const Level level, const std::string& name);
+    ~Timer();
+
+   private:
+    const bool enabled_;
+    const Level level_;
+    std::string name_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  void Record(const Level level, const std::string& name,
+              const double time_ms);
+
+  /**
+   * @brief Fills latency with the histograms recorded since the last Clear().
+   */
+  void GetLatency(PlanningLatency* latency) const;
+
+  void Clear();
+
+  /**
+   * @brief Upper bounds (ms) of the histogram buckets. Samples above the
+   * last bound go to one more, unbounded bucket.
+   */
+  static const std::vector<double>& BucketUpperBounds();
+
+ private:
+  struct Histogram {
+    int count = 0;
+    double sum_ms = 0.0;
+    double min_ms = 0.0;
+    double max_ms = 0.0;
+    std::vector<int> bucket_count;
+  };
+
+  static double Percentile(const Histogram& histogram, const double ratio);
+
+  static void ToProto(const std::string& name, const Histogram& histogram,
+                      LatencyHistogram* histogram_pb);
+
+  static constexpr int kNumLevels = 3;
+
+  mutable std::mutex mutex_;
+  std::map<std::string, Histogram> histograms_[kNumLevels];
+
+  DECLARE_SINGLETON(LatencyHistograms)
+};
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/latency_histograms.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(LatencyHistogramsTest, Record) {
+  FLAGS_enable_latency_histograms = true;
+  auto* histograms = LatencyHistograms::Instance();
+  histograms->Clear();
+  for (int i = 1; i <= 100; ++i) {
+    histograms->Record(LatencyHistograms::TASK, "stage/task", i * 0.1);
+  }
+  histograms->Record(LatencyHistograms::STAGE, "scenario/stage", 20.0);
+
+  PlanningLatency latency;
+  histograms->GetLatency(&latency);
+  EXPECT_EQ(LatencyHistograms::BucketUpperBounds().size(),
+            latency.bucket_upper_ms_size());
+  EXPECT_EQ(0, latency.scenario_size());
+  ASSERT_EQ(1, latency.stage_size());
+  ASSERT_EQ(1, latency.task_size());
+
+  const auto& stage = latency.stage(0);
+  EXPECT_EQ("scenario/stage", stage.name());
+  EXPECT_EQ(1, stage.count());
+  EXPECT_DOUBLE_EQ(20.0, stage.p50_ms());
+  EXPECT_DOUBLE_EQ(20.0, stage.p99_ms());
+
+  const auto& task = latency.task(0);
+  EXPECT_EQ("stage/task", task.name());
+  EXPECT_EQ(100, task.count());
+  EXPECT_NEAR(5.05, task.mean_ms(), 1e-9);
+  EXPECT_DOUBLE_EQ(0.1, task.min_ms());
+  EXPECT_DOUBLE_EQ(10.0, task.max_ms());
+  // buckets are 25% wide.
+  EXPECT_NEAR(5.0, task.p50_ms(), 5.0 * 0.25);
+  EXPECT_NEAR(9.9, task.p99_ms(), 9.9 * 0.25);
+  EXPECT_LE(task.p50_ms(), task.p99_ms());
+  int count = 0;
+  for (const int bucket_count : task.bucket_count()) {
+    count += bucket_count;
+  }
+  EXPECT_EQ(100, count);
+
+  histograms->Clear();
+  PlanningLatency cleared;
+  histograms->GetLatency(&cleared);
+  EXPECT_EQ(0, cleared.task_size());
+}
+
+TEST(LatencyHistogramsTest, Timer) {
+  FLAGS_enable_latency_histograms = true;
+  auto* histograms = LatencyHistograms::Instance();
+  histograms->Clear();
+  { LatencyHistograms::Timer timer(LatencyHistograms::SCENARIO, "scenario"); }
+  PlanningLatency latency;
+  histograms->GetLatency(&latency);
+  ASSERT_EQ(1, latency.scenario_size());
+  EXPECT_EQ(1, latency.scenario(0).count());
+  EXPECT_GE(latency.scenario(0).min_ms(), 0.0);
+}
+
+TEST(LatencyHistogramsTest, Disabled) {
+  FLAGS_enable_latency_histograms = false;
+  auto* histograms = LatencyHistograms::Instance();
+  histograms->Clear();
+  histograms->Record(LatencyHistograms::TASK, "stage/task", 1.0);
+  { LatencyHistograms::Timer timer(LatencyHistograms::SCENARIO, "scenario"); }
+  PlanningLatency latency;
+  histograms->GetLatency(&latency);
+  EXPECT_EQ(0, latency.scenario_size());
+  EXPECT_EQ(0, latency.task_size());
+}
+
+}  // namespace planning
+}  // namespace apollo
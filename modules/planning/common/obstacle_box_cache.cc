@@ -0,0 +1,84 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/obstacle_box_cache.h"
+
+#include <utility>
+
+namespace apollo {
+namespace planning {
+
+using common::math::Box2d;
+
+const std::vector<Box2d>& ObstacleBoxCache::GetTrajectoryBoxes(
+    const Obstacle& obstacle) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& entry = entries_[obstacle.Id()];
+    if (entry.has_trajectory_boxes) {
+      return entry.trajectory_boxes;
+    }
+  }
+
+  // computed outside of the lock; a concurrent caller computing the same
+  // boxes gets an identical result, and the first one stored wins.
+  const auto& trajectory_points = obstacle.Trajectory().trajectory_point();
+  std::vector<Box2d> boxes;
+  boxes.reserve(trajectory_points.size());
+  for (const auto& trajectory_point : trajectory_points) {
+    boxes.push_back(obstacle.GetBoundingBox(trajectory_point));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& entry = entries_[obstacle.Id()];
+  if (!entry.has_trajectory_boxes) {
+    entry.trajectory_boxes = std::move(boxes);
+    entry.has_trajectory_boxes = true;
+  }
+  return entry.trajectory_boxes;
+}
+
+const Box2d& ObstacleBoxCache::GetBoundingBoxAtTime(
+    const Obstacle& obstacle, const double relative_time) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& boxes_at_time = entries_[obstacle.Id()].boxes_at_time;
+    auto iter = boxes_at_time.find(relative_time);
+    if (iter != boxes_at_time.end()) {
+      return iter->second;
+    }
+  }
+
+  const Box2d box =
+      obstacle.GetBoundingBox(obstacle.GetPointAtTime(relative_time));
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& boxes_at_time = entries_[obstacle.Id()].boxes_at_time;
+  return boxes_at_time.emplace(relative_time, box).first->second;
+}
+
+void ObstacleBoxCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+}
+
+}  // namespace planning
+}  // namespace apollo
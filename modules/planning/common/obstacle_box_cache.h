@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "modules/common/math/box2d.h"
+#include "modules/planning/common/obstacle.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class ObstacleBoxCache
+ * @brief Bounding boxes of the obstacles of one frame, computed on first use
+ * and shared by every task and reference line of that frame. Obstacles are
+ * keyed by id, so the copies held by each PathDecision hit the same entries.
+ * Only boxes are cached: SL and ST boundaries depend on the reference line
+ * and are already computed once per reference line in
+ * ReferenceLineInfo::AddObstacle.
+ * All methods are thread safe; returned references stay valid until Clear().
+ */
+class ObstacleBoxCache {
+ public:
+  /**
+   * @brief The bounding box of the obstacle at each point of its predicted
+   * trajectory, in trajectory order. Empty if there is no trajectory.
+   */
+  const std::vector<common::math::Box2d>& GetTrajectoryBoxes(
+      const Obstacle& obstacle);
+
+  /**
+   * @brief The bounding box of the obstacle at relative_time, as given by
+   * Obstacle::GetPointAtTime. Entries are keyed on the exact relative_time,
+   * so callers sharing a time grid share entries and get the same box as
+   * without the cache.
+   */
+  const common::math::Box2d& GetBoundingBoxAtTime(const Obstacle& obstacle,
+                                                  const double relative_time);
+
+  void Clear();
+
+ private:
+  struct Entry {
+    bool has_trajectory_boxes = false;
+    std::vector<common::math::Box2d> trajectory_boxes;
+    std::unordered_map<double, common::math::Box2d> boxes_at_time;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+}  // namespace planning
+}  // namespace apollo
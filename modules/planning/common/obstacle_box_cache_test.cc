@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/obstacle_box_cache.h"
+
+#include <list>
+#include <memory>
+
+#include "cyber/common/file.h"
+#include "gtest/gtest.h"
+
+#include "modules/prediction/proto/prediction_obstacle.pb.h"
+
+namespace apollo {
+namespace planning {
+
+using common::math::Box2d;
+
+class ObstacleBoxCacheTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    prediction::PredictionObstacles prediction_obstacles;
+    ASSERT_TRUE(cyber::common::GetProtoFromFile(
+        "/apollo/modules/planning/testdata/common/sample_prediction.pb.txt",
+        &prediction_obstacles));
+    obstacles_ = Obstacle::CreateObstacles(prediction_obstacles);
+    ASSERT_EQ(5, obstacles_.size());
+  }
+
+ protected:
+  std::list<std::unique_ptr<Obstacle>> obstacles_;
+  ObstacleBoxCache cache_;
+};
+
+void ExpectSameBox(const Box2d& expected, const Box2d& box) {
+  constexpr double kEpsilon = 1e-9;
+  EXPECT_NEAR(expected.center_x(), box.center_x(), kEpsilon);
+  EXPECT_NEAR(expected.center_y(), box.center_y(), kEpsilon);
+  EXPECT_NEAR(expected.heading(), box.heading(), kEpsilon);
+  EXPECT_NEAR(expected.length(), box.length(), kEpsilon);
+  EXPECT_NEAR(expected.width(), box.width(), kEpsilon);
+}
+
+TEST_F(ObstacleBoxCacheTest, TrajectoryBoxes) {
+  for (const auto& obstacle : obstacles_) {
+    const auto& boxes = cache_.GetTrajectoryBoxes(*obstacle);
+    const auto& trajectory_points = obstacle->Trajectory().trajectory_point();
+    ASSERT_EQ(trajectory_points.size(), boxes.size());
+    for (int i = 0; i < trajectory_points.size(); ++i) {
+      ExpectSameBox(obstacle->GetBoundingBox(trajectory_points[i]), boxes[i]);
+    }
+    // a copy of the obstacle, as held by a PathDecision, hits the same entry.
+    const Obstacle copy = *obstacle;
+    EXPECT_EQ(&boxes, &cache_.GetTrajectoryBoxes(copy));
+  }
+}
+
+TEST_F(ObstacleBoxCacheTest, BoundingBoxAtTime) {
+  for (const auto& obstacle : obstacles_) {
+    for (int t = 0; t < 160; ++t) {
+      // off the millisecond grid too, to check no time rounding is done.
+      const double relative_time = t * 0.05 + (t % 2) * 3.7e-4;
+      const auto& box = cache_.GetBoundingBoxAtTime(*obstacle, relative_time);
+      ExpectSameBox(
+          obstacle->GetBoundingBox(obstacle->GetPointAtTime(relative_time)),
+          box);
+      EXPECT_EQ(&box, &cache_.GetBoundingBoxAtTime(*obstacle, relative_time));
+    }
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
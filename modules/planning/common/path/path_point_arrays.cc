@@ -0,0 +1,188 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/path/path_point_arrays.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "cyber/common/log.h"
+#include "modules/common/math/linear_interpolation.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::PathPoint;
+
+PathPointArrays::PathPointArrays(const std::vector<PathPoint>& path_points) {
+  Reserve(path_points.size());
+  for (const auto& path_point : path_points) {
+    Append(path_point);
+  }
+}
+
+void PathPointArrays::Reserve(const size_t size) {
+  x_.reserve(size);
+  y_.reserve(size);
+  z_.reserve(size);
+  theta_.reserve(size);
+  kappa_.reserve(size);
+  dkappa_.reserve(size);
+  ddkappa_.reserve(size);
+  s_.reserve(size);
+}
+
+void PathPointArrays::Append(const PathPoint& path_point) {
+  Append(path_point.x(), path_point.y(), path_point.z(), path_point.theta(),
+         path_point.kappa(), path_point.dkappa(), path_point.ddkappa(),
+         path_point.s());
+}
+
+void PathPointArrays::Append(const double x, const double y, const double z,
+                             const double theta, const double kappa,
+                             const double dkappa, const double ddkappa,
+                             const double s) {
+  x_.push_back(x);
+  y_.push_back(y);
+  z_.push_back(z);
+  theta_.push_back(theta);
+  kappa_.push_back(kappa);
+  dkappa_.push_back(dkappa);
+  ddkappa_.push_back(ddkappa);
+  s_.push_back(s);
+}
+
+void PathPointArrays::Clear() {
+  x_.clear();
+  y_.clear();
+  z_.clear();
+  theta_.clear();
+  kappa_.clear();
+  dkappa_.clear();
+  ddkappa_.clear();
+  s_.clear();
+}
+
+double PathPointArrays::Length() const {
+  if (empty()) {
+    return 0.0;
+  }
+  return s_.back() - s_.front();
+}
+
+size_t PathPointArrays::QueryLowerBound(const double path_s) const {
+  return std::lower_bound(s_.begin(), s_.end(), path_s) - s_.begin();
+}
+
+PathPoint PathPointArrays::Evaluate(const double path_s) const {
+  CHECK(!empty());
+  PathPoint path_point;
+  Interpolate(QueryLowerBound(path_s), path_s,
+              [&path_point](const double x, const double y, const double z,
+                            const double theta, const double kappa,
+                            const double dkappa, const double ddkappa,
+                            const double s) {
+                path_point.set_x(x);
+                path_point.set_y(y);
+                path_point.set_z(z);
+                path_point.set_theta(theta);
+                path_point.set_kappa(kappa);
+                path_point.set_dkappa(dkappa);
+                path_point.set_ddkappa(ddkappa);
+                path_point.set_s(s);
+              });
+  return path_point;
+}
+
+void PathPointArrays::Evaluate(const std::vector<double>& path_s,
+                               PathPointArrays* const evaluated_path) const {
+  CHECK(!empty());
+  CHECK_NOTNULL(evaluated_path);
+  evaluated_path->Clear();
+  evaluated_path->Reserve(path_s.size());
+  const auto append = [evaluated_path](
+                          const double x, const double y, const double z,
+                          const double theta, const double kappa,
+                          const double dkappa, const double ddkappa,
+                          const double s) {
+    evaluated_path->Append(x, y, z, theta, kappa, dkappa, ddkappa, s);
+  };
+  size_t lower = 0;
+  double prev_s = -std::numeric_limits<double>::infinity();
+  for (const double s : path_s) {
+    if (s < prev_s) {
+      lower = 0;
+    }
+    // the lower bound of s is at or after the one of prev_s.
+    lower = std::lower_bound(s_.begin() + lower, s_.end(), s) - s_.begin();
+    Interpolate(lower, s, append);
+    prev_s = s;
+  }
+}
+
+template <typename Output>
+void PathPointArrays::Interpolate(const size_t lower, const double path_s,
+                                  const Output& output) const {
+  if (lower == 0 || lower == size()) {
+    const size_t index = lower == 0 ? 0 : size() - 1;
+    output(x_[index], y_[index], z_[index], theta_[index], kappa_[index],
+           dkappa_[index], ddkappa_[index], s_[index]);
+    return;
+  }
+  // same as common::math::InterpolateUsingLinearApproximation for PathPoint.
+  const size_t i0 = lower - 1;
+  const size_t i1 = lower;
+  const double weight = (path_s - s_[i0]) / (s_[i1] - s_[i0]);
+  const auto interpolate = [weight](const double v0, const double v1) {
+    return (1 - weight) * v0 + weight * v1;
+  };
+  output(interpolate(x_[i0], x_[i1]), interpolate(y_[i0], y_[i1]), 0.0,
+         common::math::slerp(theta_[i0], s_[i0], theta_[i1], s_[i1], path_s),
+         interpolate(kappa_[i0], kappa_[i1]),
+         interpolate(dkappa_[i0], dkappa_[i1]),
+         interpolate(ddkappa_[i0], ddkappa_[i1]), path_s);
+}
+
+PathPoint PathPointArrays::PathPointAt(const size_t index) const {
+  CHECK_LT(index, size());
+  PathPoint path_point;
+  path_point.set_x(x_[index]);
+  path_point.set_y(y_[index]);
+  path_point.set_z(z_[index]);
+  path_point.set_theta(theta_[index]);
+  path_point.set_kappa(kappa_[index]);
+  path_point.set_dkappa(dkappa_[index]);
+  path_point.set_ddkappa(ddkappa_[index]);
+  path_point.set_s(s_[index]);
+  return path_point;
+}
+
+std::vector<PathPoint> PathPointArrays::ToPathPoints() const {
+  std::vector<PathPoint> path_points;
+  path_points.reserve(size());
+  for (size_t i = 0; i < size(); ++i) {
+    path_points.push_back(PathPointAt(i));
+  }
+  return path_points;
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <vector>
+
+#include "modules/common/proto/pnc_point.pb.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class PathPointArrays
+ * @brief A discretized path stored as one contiguous array per field, for
+ * lookups and interpolation in hot loops. Evaluation gives the same results
+ * as DiscretizedPath. Only x, y, z, theta, kappa, dkappa, ddkappa and s are
+ * kept; convert with ToPathPoints() where a protobuf is required.
+ */
+class PathPointArrays {
+ public:
+  PathPointArrays() = default;
+
+  explicit PathPointArrays(const std::vector<common::PathPoint>& path_points);
+
+  void Reserve(const size_t size);
+
+  /**
+   * @brief Appends a point; s must not decrease along the path.
+   */
+  void Append(const common::PathPoint& path_point);
+
+  void Append(const double x, const double y, const double z,
+              const double theta, const double kappa, const double dkappa,
+              const double ddkappa, const double s);
+
+  void Clear();
+
+  size_t size() const { return s_.size(); }
+
+  bool empty() const { return s_.empty(); }
+
+  double Length() const;
+
+  /**
+   * @brief Index of the first point with s not less than path_s, or size().
+   */
+  size_t QueryLowerBound(const double path_s) const;
+
+  common::PathPoint Evaluate(const double path_s) const;
+
+  /**
+   * @brief Evaluates the path at every s of path_s into evaluated_path.
+   * Non-decreasing queries are answered with one forward sweep.
+   */
+  void Evaluate(const std::vector<double>& path_s,
+                PathPointArrays* const evaluated_path) const;
+
+  common::PathPoint PathPointAt(const size_t index) const;
+
+  std::vector<common::PathPoint> ToPathPoints() const;
+
+  const std::vector<double>& x() const { return x_; }
+  const std::vector<double>& y() const { return y_; }
+  const std::vector<double>& z() const { return z_; }
+  const std::vector<double>& theta() const { return theta_; }
+  const std::vector<double>& kappa() const { return kappa_; }
+  const std::vector<double>& dkappa() const { return dkappa_; }
+  const std::vector<double>& ddkappa() const { return ddkappa_; }
+  const std::vector<double>& s() const { return s_; }
+
+ private:
+  // calls output(x, y, z, theta, kappa, dkappa, ddkappa, s) with the point
+  // interpolated at path_s, where lower is the result of
+  // QueryLowerBound(path_s).
+  template <typename Output>
+  void Interpolate(const size_t lower, const double path_s,
+                   const Output& output) const;
+
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<double> z_;
+  std::vector<double> theta_;
+  std::vector<double> kappa_;
+  std::vector<double> dkappa_;
+  std::vector<double> ddkappa_;
+  std::vector<double> s_;
+};
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/planning/common/path/path_point_arrays.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/common/util/util.h"
+#include "modules/planning/common/path/discretized_path.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::PathPoint;
+using apollo::common::util::MakePathPoint;
+
+namespace {
+
+std::vector<PathPoint> MakeArc() {
+  std::vector<PathPoint> path_points;
+  double s = 0.0;
+  for (int i = 0; i < 50; ++i) {
+    const double theta = 0.05 * i;
+    PathPoint point =
+        MakePathPoint(10.0 * std::sin(theta), 10.0 * (1.0 - std::cos(theta)),
+                      0.0, theta, 0.1, 0.0, 0.0);
+    point.set_s(s);
+    path_points.push_back(point);
+    s += 0.5;
+  }
+  return path_points;
+}
+
+void ExpectSamePoint(const PathPoint& expected, const PathPoint& actual) {
+  EXPECT_DOUBLE_EQ(expected.x(), actual.x());
+  EXPECT_DOUBLE_EQ(expected.y(), actual.y());
+  EXPECT_DOUBLE_EQ(expected.theta(), actual.theta());
+  EXPECT_DOUBLE_EQ(expected.kappa(), actual.kappa());
+  EXPECT_DOUBLE_EQ(expected.s(), actual.s());
+}
+
+}  // namespace
+
+TEST(PathPointArraysTest, basic_test) {
+  const auto path_points = MakeArc();
+  PathPointArrays path(path_points);
+  EXPECT_EQ(path.size(), 50);
+  EXPECT_DOUBLE_EQ(path.Length(), 24.5);
+  EXPECT_EQ(path.QueryLowerBound(0.0), 0);
+  EXPECT_EQ(path.QueryLowerBound(0.7), 2);
+  EXPECT_EQ(path.QueryLowerBound(100.0), 50);
+
+  const auto round_trip = path.ToPathPoints();
+  ASSERT_EQ(round_trip.size(), path_points.size());
+  for (size_t i = 0; i < path_points.size(); ++i) {
+    ExpectSamePoint(path_points[i], round_trip[i]);
+  }
+}
+
+TEST(PathPointArraysTest, matches_discretized_path) {
+  const auto path_points = MakeArc();
+  DiscretizedPath discretized_path(path_points);
+  PathPointArrays path(path_points);
+
+  std::vector<double> path_s;
+  for (double s = -1.0; s < 26.0; s += 0.3) {
+    path_s.push_back(s);
+    ExpectSamePoint(discretized_path.Evaluate(s), path.Evaluate(s));
+  }
+
+  PathPointArrays evaluated;
+  path.Evaluate(path_s, &evaluated);
+  ASSERT_EQ(evaluated.size(), path_s.size());
+  for (size_t i = 0; i < path_s.size(); ++i) {
+    ExpectSamePoint(discretized_path.Evaluate(path_s[i]),
+                    evaluated.PathPointAt(i));
+  }
+
+  // unsorted queries fall back to a fresh search.
+  const std::vector<double> unsorted_s = {12.3, 0.2, 7.7};
+  path.Evaluate(unsorted_s, &evaluated);
+  for (size_t i = 0; i < unsorted_s.size(); ++i) {
+    ExpectSamePoint(discretized_path.Evaluate(unsorted_s[i]),
+                    evaluated.PathPointAt(i));
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
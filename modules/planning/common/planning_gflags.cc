@@ -114,6 +114,10 @@ DEFINE_double(look_forward_extend_distance, 50,
 DEFINE_double(reference_line_stitch_overlap_distance, 20,
               "The overlap distance with the existing reference line when "
               "stitching the existing reference line");
+DEFINE_bool(enable_reference_line_incremental_update, false,
+            "Keep the previously smoothed reference line while the route is "
+            "unchanged, only smoothing the newly needed tail and trimming the "
+            "passed head");
 DEFINE_double(reference_line_lateral_buffer, 0.5,
               "When creating reference line, the minimum distance with road "
               "curb for a vehicle driving on this line.");
@@ -315,6 +319,19 @@ DEFINE_bool(
     "Enable multiple thread to calculation curve cost in dp_poly_path.");
 DEFINE_bool(enable_multi_thread_in_dp_st_graph, false,
             "Enable multiple thread to calculation curve cost in dp_st_graph.");
+DEFINE_bool(enable_multi_thread_in_lattice_planner, false,
+            "Enable multiple thread to evaluate and check trajectory "
+            "candidates in lattice planner.");
+DEFINE_bool(enable_multi_thread_in_lane_follow_stage, false,
+            "Enable multiple thread to plan on the reference lines of the "
+            "lane follow stage concurrently.");
+DEFINE_bool(enable_multi_thread_in_piecewise_jerk_path_optimizer, false,
+            "Enable multiple thread to solve the regular and fallback paths "
+            "of piecewise jerk path optimizer concurrently. Ignored when "
+            "enable_multi_thread_in_lane_follow_stage is on.");
+DEFINE_int32(lattice_candidate_batch_size, 8,
+             "Number of top trajectory pairs combined and checked "
+             "concurrently in lattice planner.");
 
 /// Lattice Planner
 DEFINE_double(lattice_epsilon, 1e-6, "Epsilon in lattice planner.");
@@ -462,6 +479,11 @@ DEFINE_bool(enable_osqp_debug, false,
 DEFINE_bool(export_chart, false, "export chart in planning");
 DEFINE_bool(enable_record_debug, true,
             "True to enable record debug info in chart format");
+DEFINE_bool(enable_latency_histograms, false,
+            "True to record scenario, stage and task latency histograms");
+DEFINE_int32(latency_histograms_publish_interval, 100,
+             "Number of planning cycles covered by each published latency "
+             "histogram message; 0 disables publishing");
 
 DEFINE_double(
     default_front_clear_distance, 300.0,
@@ -52,6 +52,7 @@ DECLARE_double(rtk_trajectory_resolution);
 DECLARE_bool(enable_reference_line_stitching);
 DECLARE_double(look_forward_extend_distance);
 DECLARE_double(reference_line_stitch_overlap_distance);
+DECLARE_bool(enable_reference_line_incremental_update);
 DECLARE_double(reference_line_lateral_buffer);
 
 DECLARE_bool(enable_smooth_reference_line);
@@ -156,6 +157,10 @@ DECLARE_uint32(max_planning_thread_pool_size);
 DECLARE_bool(use_multi_thread_to_add_obstacles);
 DECLARE_bool(enable_multi_thread_in_dp_poly_path);
 DECLARE_bool(enable_multi_thread_in_dp_st_graph);
+DECLARE_bool(enable_multi_thread_in_lattice_planner);
+DECLARE_bool(enable_multi_thread_in_lane_follow_stage);
+DECLARE_bool(enable_multi_thread_in_piecewise_jerk_path_optimizer);
+DECLARE_int32(lattice_candidate_batch_size);
 
 // lattice planner
 DECLARE_double(lattice_epsilon);
@@ -236,6 +241,8 @@ DECLARE_bool(use_osqp_optimizer_for_reference_line);
 DECLARE_bool(enable_osqp_debug);
 DECLARE_bool(export_chart);
 DECLARE_bool(enable_record_debug);
+DECLARE_bool(enable_latency_histograms);
+DECLARE_int32(latency_histograms_publish_interval);
 
 DECLARE_double(default_front_clear_distance);
 
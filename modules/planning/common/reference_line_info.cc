@@ -44,6 +44,11 @@ using apollo::common::VehicleSignal;
 using apollo::common::math::Box2d;
 using apollo::common::math::Vec2d;
 
+namespace {
+// obstacles added by one task in AddObstacles.
+constexpr size_t kObstaclesPerTask = 8;
+}  // namespace
+
 ReferenceLineInfo::ReferenceLineInfo(const common::VehicleState& vehicle_state,
                                      const TrajectoryPoint& adc_planning_point,
                                      const ReferenceLine& reference_line,
@@ -361,16 +366,32 @@ Obstacle* ReferenceLineInfo::AddObstacle(const Obstacle* obstacle) {
 bool ReferenceLineInfo::AddObstacles(
     const std::vector<const Obstacle*>& obstacles) {
   if (FLAGS_use_multi_thread_to_add_obstacles) {
-    std::vector<std::future<Obstacle*>> results;
-    for (const auto* obstacle : obstacles) {
-      results.push_back(
-          cyber::Async(&ReferenceLineInfo::AddObstacle, this, obstacle));
+    // adding one obstacle costs less than scheduling a task for it, so each
+    // task adds a batch of obstacles and this thread adds the first batch.
+    auto add_obstacles = [this, &obstacles](const size_t begin,
+                                            const size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        if (!AddObstacle(obstacles[i])) {
+          return false;
+        }
+      }
+      return true;
+    };
+    std::vector<std::future<bool>> results;
+    for (size_t begin = kObstaclesPerTask; begin < obstacles.size();
+         begin += kObstaclesPerTask) {
+      results.push_back(cyber::Async(
+          add_obstacles, begin,
+          std::min(begin + kObstaclesPerTask, obstacles.size())));
     }
+    bool success =
+        add_obstacles(0, std::min(kObstaclesPerTask, obstacles.size()));
     for (auto& result : results) {
-      if (!result.get()) {
-        AERROR << "Fail to add obstacles.";
-        return false;
-      }
+      success = result.get() && success;
+    }
+    if (!success) {
+      AERROR << "Fail to add obstacles.";
+      return false;
     }
   } else {
     for (const auto* obstacle : obstacles) {
@@ -159,7 +159,7 @@ std::vector<TrajectoryPoint> TrajectoryStitcher::ComputeStitchingTrajectory(
     return ComputeReinitStitchingTrajectory(planning_cycle_time, vehicle_state);
   }
 
-  auto time_matched_point = prev_trajectory->TrajectoryPointAt(
+  const auto& time_matched_point = prev_trajectory->TrajectoryPointAt(
       static_cast<uint32_t>(time_matched_index));
 
   if (!time_matched_point.has_path_point()) {
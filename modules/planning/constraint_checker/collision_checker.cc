@@ -82,32 +82,49 @@ bool CollisionChecker::InCollision(
   return false;
 }
 
+constexpr uint64_t CollisionChecker::kNoCollision;
+
 bool CollisionChecker::InCollision(
-    const DiscretizedTrajectory& discretized_trajectory) {
+    const DiscretizedTrajectory& discretized_trajectory) const {
   CHECK_LE(discretized_trajectory.NumOfPoints(),
-           predicted_bounding_rectangles_.size());
+           predicted_obstacle_index_.num_slices());
   const auto& vehicle_config =
       common::VehicleConfigHelper::Instance()->GetConfig();
   double ego_length = vehicle_config.vehicle_param().length();
   double ego_width = vehicle_config.vehicle_param().width();
 
-  for (size_t i = 0; i < discretized_trajectory.NumOfPoints(); ++i) {
+  const double shift_distance =
+      ego_length / 2.0 - vehicle_config.vehicle_param().back_edge_to_center();
+  auto ego_box_at = [&](const size_t i) {
     const auto& trajectory_point =
         discretized_trajectory.TrajectoryPointAt(static_cast<std::uint32_t>(i));
     double ego_theta = trajectory_point.path_point().theta();
     Box2d ego_box(
         {trajectory_point.path_point().x(), trajectory_point.path_point().y()},
         ego_theta, ego_length, ego_width);
-    double shift_distance =
-        ego_length / 2.0 - vehicle_config.vehicle_param().back_edge_to_center();
     Vec2d shift_vec{shift_distance * std::cos(ego_theta),
                     shift_distance * std::sin(ego_theta)};
     ego_box.Shift(shift_vec);
+    return ego_box;
+  };
+
+  const uint64_t last_collision = last_collision_.load();
+  if (last_collision != kNoCollision) {
+    const size_t last_slice = static_cast<size_t>(last_collision >> 32);
+    const size_t last_box = static_cast<size_t>(last_collision & 0xffffffff);
+    if (last_slice < discretized_trajectory.NumOfPoints() &&
+        predicted_obstacle_index_.HasOverlapWith(last_slice, last_box,
+                                                 ego_box_at(last_slice))) {
+      return true;
+    }
+  }
 
-    for (const auto& obstacle_box : predicted_bounding_rectangles_[i]) {
-      if (ego_box.HasOverlap(obstacle_box)) {
-        return true;
-      }
+  for (size_t i = 0; i < discretized_trajectory.NumOfPoints(); ++i) {
+    size_t box_index = 0;
+    if (predicted_obstacle_index_.HasOverlap(i, ego_box_at(i), &box_index)) {
+      last_collision_.store((static_cast<uint64_t>(i) << 32) |
+                            static_cast<uint64_t>(box_index));
+      return true;
     }
   }
   return false;
@@ -117,7 +134,7 @@ void CollisionChecker::BuildPredictedEnvironment(
     const std::vector<const Obstacle*>& obstacles, const double ego_vehicle_s,
     const double ego_vehicle_d,
     const std::vector<PathPoint>& discretized_reference_line) {
-  CHECK(predicted_bounding_rectangles_.empty());
+  CHECK_EQ(predicted_obstacle_index_.num_slices(), 0U);
 
   // If the ego vehicle is in lane,
   // then, ignore all obstacles from the same lane.
@@ -137,6 +154,7 @@ void CollisionChecker::BuildPredictedEnvironment(
     obstacles_considered.push_back(obstacle);
   }
 
+  std::vector<std::vector<Box2d>> predicted_bounding_rectangles;
   double relative_time = 0.0;
   while (relative_time < FLAGS_trajectory_time_length) {
     std::vector<Box2d> predicted_env;
@@ -149,9 +167,11 @@ void CollisionChecker::BuildPredictedEnvironment(
       box.LateralExtend(2.0 * FLAGS_lat_collision_buffer);
       predicted_env.push_back(std::move(box));
     }
-    predicted_bounding_rectangles_.push_back(std::move(predicted_env));
+    predicted_bounding_rectangles.push_back(std::move(predicted_env));
     relative_time += FLAGS_trajectory_time_resolution;
   }
+  predicted_obstacle_index_ =
+      PredictedObstacleIndex(predicted_bounding_rectangles);
 }
 
 bool CollisionChecker::IsEgoVehicleInLane(const double ego_vehicle_s,
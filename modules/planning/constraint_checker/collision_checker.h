@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -27,6 +29,7 @@
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/common/reference_line_info.h"
 #include "modules/planning/common/trajectory/discretized_trajectory.h"
+#include "modules/planning/constraint_checker/predicted_obstacle_index.h"
 #include "modules/planning/lattice/behavior/path_time_graph.h"
 
 namespace apollo {
@@ -41,7 +44,8 @@ class CollisionChecker {
       const ReferenceLineInfo* ptr_reference_line_info,
       const std::shared_ptr<PathTimeGraph>& ptr_path_time_graph);
 
-  bool InCollision(const DiscretizedTrajectory& discretized_trajectory);
+  // thread safe, candidates may be checked concurrently
+  bool InCollision(const DiscretizedTrajectory& discretized_trajectory) const;
 
   static bool InCollision(const std::vector<const Obstacle*>& obstacles,
                           const DiscretizedTrajectory& ego_trajectory,
@@ -64,7 +68,13 @@ class CollisionChecker {
  private:
   const ReferenceLineInfo* ptr_reference_line_info_;
   std::shared_ptr<PathTimeGraph> ptr_path_time_graph_;
-  std::vector<std::vector<common::math::Box2d>> predicted_bounding_rectangles_;
+  PredictedObstacleIndex predicted_obstacle_index_;
+
+  // slice (high 32 bits) and box (low 32 bits) of the last collision found.
+  // Consecutive candidate trajectories are similar, so it is checked first to
+  // reject the next candidate early.
+  static constexpr uint64_t kNoCollision = UINT64_MAX;
+  mutable std::atomic<uint64_t> last_collision_{kNoCollision};
 };
 
 }  // namespace planning
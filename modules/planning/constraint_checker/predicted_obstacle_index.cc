@@ -0,0 +1,269 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/constraint_checker/predicted_obstacle_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+
+namespace {
+
+// side length of the grid cells, a few car lengths
+constexpr double kCellSize = 16.0;
+
+// slices with fewer boxes are scanned without a grid
+constexpr size_t kMinNumBoxesForGrid = 8;
+
+// candidates that pass the pre-filter are tested in batches of this size
+constexpr size_t kBatchSize = 16;
+
+// margin of the bounding circle test, keeps touching boxes for the exact test
+constexpr double kCircleMargin = 1e-6;
+
+int64_t CellIndex(const double coordinate) {
+  return static_cast<int64_t>(std::floor(coordinate / kCellSize));
+}
+
+}  // namespace
+
+PredictedObstacleIndex::PredictedObstacleIndex(
+    const std::vector<std::vector<Box2d>>& boxes) {
+  slices_.resize(boxes.size());
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    Slice& slice = slices_[i];
+    const size_t num_boxes = boxes[i].size();
+    slice.center_x.reserve(num_boxes);
+    slice.center_y.reserve(num_boxes);
+    slice.cos_heading.reserve(num_boxes);
+    slice.sin_heading.reserve(num_boxes);
+    slice.half_length.reserve(num_boxes);
+    slice.half_width.reserve(num_boxes);
+    slice.radius.reserve(num_boxes);
+    slice.min_x.reserve(num_boxes);
+    slice.max_x.reserve(num_boxes);
+    slice.min_y.reserve(num_boxes);
+    slice.max_y.reserve(num_boxes);
+    for (const auto& box : boxes[i]) {
+      slice.center_x.push_back(box.center_x());
+      slice.center_y.push_back(box.center_y());
+      slice.cos_heading.push_back(box.cos_heading());
+      slice.sin_heading.push_back(box.sin_heading());
+      slice.half_length.push_back(box.half_length());
+      slice.half_width.push_back(box.half_width());
+      slice.radius.push_back(std::hypot(box.half_length(), box.half_width()));
+      slice.min_x.push_back(box.min_x());
+      slice.max_x.push_back(box.max_x());
+      slice.min_y.push_back(box.min_y());
+      slice.max_y.push_back(box.max_y());
+    }
+    BuildGrid(&slice);
+  }
+}
+
+int64_t PredictedObstacleIndex::CellKey(const int64_t ix, const int64_t iy) {
+  return (ix << 32) ^ (iy & 0xffffffff);
+}
+
+void PredictedObstacleIndex::BuildGrid(Slice* slice) {
+  const size_t num_boxes = slice->center_x.size();
+  slice->cell_keys.clear();
+  slice->cell_offsets.clear();
+  slice->cell_boxes.clear();
+  if (num_boxes < kMinNumBoxesForGrid) {
+    // a single bucket with all boxes
+    slice->cell_boxes.resize(num_boxes);
+    for (size_t i = 0; i < num_boxes; ++i) {
+      slice->cell_boxes[i] = i;
+    }
+    slice->cell_offsets = {0, num_boxes};
+    return;
+  }
+
+  std::vector<std::pair<int64_t, size_t>> key_boxes;
+  key_boxes.reserve(num_boxes * 4);
+  for (size_t i = 0; i < num_boxes; ++i) {
+    const int64_t ix_begin = CellIndex(slice->min_x[i]);
+    const int64_t ix_end = CellIndex(slice->max_x[i]);
+    const int64_t iy_begin = CellIndex(slice->min_y[i]);
+    const int64_t iy_end = CellIndex(slice->max_y[i]);
+    for (int64_t ix = ix_begin; ix <= ix_end; ++ix) {
+      for (int64_t iy = iy_begin; iy <= iy_end; ++iy) {
+        key_boxes.emplace_back(CellKey(ix, iy), i);
+      }
+    }
+  }
+  std::sort(key_boxes.begin(), key_boxes.end());
+
+  slice->cell_boxes.reserve(key_boxes.size());
+  for (size_t i = 0; i < key_boxes.size(); ++i) {
+    if (i == 0 || key_boxes[i].first != key_boxes[i - 1].first) {
+      slice->cell_keys.push_back(key_boxes[i].first);
+      slice->cell_offsets.push_back(i);
+    }
+    slice->cell_boxes.push_back(key_boxes[i].second);
+  }
+  slice->cell_offsets.push_back(key_boxes.size());
+}
+
+bool PredictedObstacleIndex::HasOverlap(const size_t slice_index,
+                                        const Box2d& ego_box,
+                                        size_t* box_index) const {
+  const Slice& slice = slices_[slice_index];
+  if (slice.cell_keys.empty()) {
+    return HasOverlapWithCandidates(slice, ego_box, slice.cell_boxes.data(),
+                                    slice.cell_boxes.size(), box_index);
+  }
+
+  const int64_t ix_begin = CellIndex(ego_box.min_x());
+  const int64_t ix_end = CellIndex(ego_box.max_x());
+  const int64_t iy_begin = CellIndex(ego_box.min_y());
+  const int64_t iy_end = CellIndex(ego_box.max_y());
+  for (int64_t ix = ix_begin; ix <= ix_end; ++ix) {
+    for (int64_t iy = iy_begin; iy <= iy_end; ++iy) {
+      const int64_t key = CellKey(ix, iy);
+      auto it =
+          std::lower_bound(slice.cell_keys.begin(), slice.cell_keys.end(), key);
+      if (it == slice.cell_keys.end() || *it != key) {
+        continue;
+      }
+      const size_t cell = it - slice.cell_keys.begin();
+      const size_t begin = slice.cell_offsets[cell];
+      const size_t end = slice.cell_offsets[cell + 1];
+      if (HasOverlapWithCandidates(slice, ego_box,
+                                   slice.cell_boxes.data() + begin,
+                                   end - begin, box_index)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool PredictedObstacleIndex::HasOverlapWith(const size_t slice_index,
+                                            const size_t box_index,
+                                            const Box2d& ego_box) const {
+  const Slice& slice = slices_[slice_index];
+  if (box_index >= slice.center_x.size()) {
+    return false;
+  }
+  return HasOverlapWithCandidates(slice, ego_box, &box_index, 1, nullptr);
+}
+
+bool PredictedObstacleIndex::HasOverlapWithCandidates(
+    const Slice& slice, const Box2d& ego_box, const size_t* candidates,
+    const size_t num_candidates, size_t* box_index) {
+  const double ego_x = ego_box.center_x();
+  const double ego_y = ego_box.center_y();
+  const double ego_cos = ego_box.cos_heading();
+  const double ego_sin = ego_box.sin_heading();
+  const double ego_half_length = ego_box.half_length();
+  const double ego_half_width = ego_box.half_width();
+  const double ego_radius = std::hypot(ego_half_length, ego_half_width);
+  const double dx1 = ego_cos * ego_half_length;
+  const double dy1 = ego_sin * ego_half_length;
+  const double dx2 = ego_sin * ego_half_width;
+  const double dy2 = -ego_cos * ego_half_width;
+
+  // candidates passing the pre-filter, gathered into contiguous arrays
+  size_t ids[kBatchSize];
+  double shift_x[kBatchSize];
+  double shift_y[kBatchSize];
+  double cos_heading[kBatchSize];
+  double sin_heading[kBatchSize];
+  double half_length[kBatchSize];
+  double half_width[kBatchSize];
+  int overlap[kBatchSize];
+
+  size_t i = 0;
+  while (i < num_candidates) {
+    size_t num_batch = 0;
+    for (; i < num_candidates && num_batch < kBatchSize; ++i) {
+      const size_t id = candidates[i];
+      if (slice.max_x[id] < ego_box.min_x() ||
+          slice.min_x[id] > ego_box.max_x() ||
+          slice.max_y[id] < ego_box.min_y() ||
+          slice.min_y[id] > ego_box.max_y()) {
+        continue;
+      }
+      const double sx = slice.center_x[id] - ego_x;
+      const double sy = slice.center_y[id] - ego_y;
+      const double max_distance = slice.radius[id] + ego_radius + kCircleMargin;
+      if (sx * sx + sy * sy > max_distance * max_distance) {
+        continue;
+      }
+      ids[num_batch] = id;
+      shift_x[num_batch] = sx;
+      shift_y[num_batch] = sy;
+      cos_heading[num_batch] = slice.cos_heading[id];
+      sin_heading[num_batch] = slice.sin_heading[id];
+      half_length[num_batch] = slice.half_length[id];
+      half_width[num_batch] = slice.half_width[id];
+      ++num_batch;
+    }
+
+    // separating axis test, the same arithmetic as Box2d::HasOverlap without
+    // branches so that the loop can be vectorized
+    for (size_t j = 0; j < num_batch; ++j) {
+      const double sx = shift_x[j];
+      const double sy = shift_y[j];
+      const double c = cos_heading[j];
+      const double s = sin_heading[j];
+      const double dx3 = c * half_length[j];
+      const double dy3 = s * half_length[j];
+      const double dx4 = s * half_width[j];
+      const double dy4 = -c * half_width[j];
+      const bool axis1 = std::abs(sx * ego_cos + sy * ego_sin) <=
+                         std::abs(dx3 * ego_cos + dy3 * ego_sin) +
+                             std::abs(dx4 * ego_cos + dy4 * ego_sin) +
+                             ego_half_length;
+      const bool axis2 = std::abs(sx * ego_sin - sy * ego_cos) <=
+                         std::abs(dx3 * ego_sin - dy3 * ego_cos) +
+                             std::abs(dx4 * ego_sin - dy4 * ego_cos) +
+                             ego_half_width;
+      const bool axis3 = std::abs(sx * c + sy * s) <=
+                         std::abs(dx1 * c + dy1 * s) +
+                             std::abs(dx2 * c + dy2 * s) + half_length[j];
+      const bool axis4 = std::abs(sx * s - sy * c) <=
+                         std::abs(dx1 * s - dy1 * c) +
+                             std::abs(dx2 * s - dy2 * c) + half_width[j];
+      overlap[j] = axis1 & axis2 & axis3 & axis4;
+    }
+
+    for (size_t j = 0; j < num_batch; ++j) {
+      if (overlap[j]) {
+        if (box_index != nullptr) {
+          *box_index = ids[j];
+        }
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "modules/common/math/box2d.h"
+
+namespace apollo {
+namespace planning {
+
+/*
+ * @brief:
+ * Spatial index of predicted obstacle footprints, one set of boxes per time
+ * slice of the planning horizon.
+ *
+ * The boxes of each slice are bucketed into a uniform grid. A query only
+ * tests the boxes sharing a cell with the ego box; they are filtered by
+ * bounding circles and bounding boxes and the remaining ones go through a
+ * batched separating axis test. The result is the same as testing
+ * Box2d::HasOverlap against every box of the slice.
+ */
+class PredictedObstacleIndex {
+ public:
+  PredictedObstacleIndex() = default;
+
+  // boxes[i] are the obstacle footprints at time slice i
+  explicit PredictedObstacleIndex(
+      const std::vector<std::vector<common::math::Box2d>>& boxes);
+
+  size_t num_slices() const { return slices_.size(); }
+
+  size_t num_boxes(const size_t slice) const {
+    return slices_[slice].center_x.size();
+  }
+
+  /*
+   * @brief: checks whether ego_box overlaps any obstacle box of the slice.
+   * @param box_index: if not null, the index of the overlapping box
+   */
+  bool HasOverlap(const size_t slice, const common::math::Box2d& ego_box,
+                  size_t* box_index = nullptr) const;
+
+  // checks ego_box against a single obstacle box of the slice
+  bool HasOverlapWith(const size_t slice, const size_t box_index,
+                      const common::math::Box2d& ego_box) const;
+
+ private:
+  // obstacle boxes of one time slice in structure of arrays layout, with a
+  // grid stored as sorted cell keys and the boxes of each cell
+  struct Slice {
+    std::vector<double> center_x;
+    std::vector<double> center_y;
+    std::vector<double> cos_heading;
+    std::vector<double> sin_heading;
+    std::vector<double> half_length;
+    std::vector<double> half_width;
+    std::vector<double> radius;
+    std::vector<double> min_x;
+    std::vector<double> max_x;
+    std::vector<double> min_y;
+    std::vector<double> max_y;
+
+    std::vector<int64_t> cell_keys;
+    // boxes of cell_keys[i] are cell_boxes[cell_offsets[i],
+    // cell_offsets[i + 1])
+    std::vector<size_t> cell_offsets;
+    std::vector<size_t> cell_boxes;
+  };
+
+  static void BuildGrid(Slice* slice);
+
+  static int64_t CellKey(const int64_t ix, const int64_t iy);
+
+  static bool HasOverlapWithCandidates(const Slice& slice,
+                                       const common::math::Box2d& ego_box,
+                                       const size_t* candidates,
+                                       const size_t num_candidates,
+                                       size_t* box_index);
+
+ private:
+  std::vector<Slice> slices_;
+};
+
+}  // namespace planning
+}  // namespace apollo
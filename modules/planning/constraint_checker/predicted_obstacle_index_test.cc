@@ -0,0 +1,188 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/constraint_checker/predicted_obstacle_index.h"
+
+#include <chrono>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+using apollo::common::math::Vec2d;
+
+namespace {
+
+// reference implementation: test the ego box against every obstacle box
+bool InCollisionReference(const std::vector<std::vector<Box2d>>& boxes,
+                          const std::vector<Box2d>& ego_boxes) {
+  for (size_t i = 0; i < ego_boxes.size(); ++i) {
+    for (const auto& obstacle_box : boxes[i]) {
+      if (ego_boxes[i].HasOverlap(obstacle_box)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool InCollision(const PredictedObstacleIndex& index,
+                 const std::vector<Box2d>& ego_boxes) {
+  for (size_t i = 0; i < ego_boxes.size(); ++i) {
+    if (index.HasOverlap(i, ego_boxes[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// obstacles moving along straight lines on a 400m x 60m area
+std::vector<std::vector<Box2d>> RandomObstacleBoxes(const size_t num_obstacles,
+                                                    const size_t num_slices,
+                                                    std::mt19937* gen) {
+  std::uniform_real_distribution<double> x_dist(0.0, 400.0);
+  std::uniform_real_distribution<double> y_dist(-30.0, 30.0);
+  std::uniform_real_distribution<double> heading_dist(-M_PI, M_PI);
+  std::uniform_real_distribution<double> speed_dist(0.0, 15.0);
+  std::vector<std::vector<Box2d>> boxes(num_slices);
+  for (size_t i = 0; i < num_obstacles; ++i) {
+    const Vec2d start(x_dist(*gen), y_dist(*gen));
+    const double heading = heading_dist(*gen);
+    const double speed = speed_dist(*gen);
+    for (size_t t = 0; t < num_slices; ++t) {
+      const Vec2d center =
+          start + Vec2d::CreateUnitVec2d(heading) * (speed * 0.1 * t);
+      boxes[t].emplace_back(center, heading, 4.5, 2.0);
+    }
+  }
+  return boxes;
+}
+
+// ego trajectory along the road with a lateral offset
+std::vector<Box2d> EgoBoxes(const double lateral_offset, const double speed,
+                            const size_t num_slices) {
+  std::vector<Box2d> ego_boxes;
+  for (size_t t = 0; t < num_slices; ++t) {
+    const double x = speed * 0.1 * t;
+    const double y = lateral_offset * std::sin(x / 40.0);
+    ego_boxes.emplace_back(Vec2d(x, y), std::atan(lateral_offset / 40.0), 4.9,
+                           2.1);
+  }
+  return ego_boxes;
+}
+
+}  // namespace
+
+TEST(PredictedObstacleIndexTest, overlap) {
+  std::vector<std::vector<Box2d>> boxes(2);
+  boxes[0].emplace_back(Vec2d(10.0, 0.0), 0.0, 4.0, 2.0);
+  boxes[1].emplace_back(Vec2d(20.0, 0.0), M_PI_4, 4.0, 2.0);
+  const PredictedObstacleIndex index(boxes);
+  EXPECT_EQ(index.num_slices(), 2);
+  EXPECT_EQ(index.num_boxes(1), 1);
+
+  size_t box_index = 1;
+  EXPECT_TRUE(
+      index.HasOverlap(0, Box2d(Vec2d(12.0, 1.0), 0.0, 4.0, 2.0), &box_index));
+  EXPECT_EQ(box_index, 0);
+  EXPECT_FALSE(index.HasOverlap(0, Box2d(Vec2d(10.0, 3.1), 0.0, 4.0, 2.0)));
+  EXPECT_FALSE(index.HasOverlap(1, Box2d(Vec2d(12.0, 1.0), 0.0, 4.0, 2.0)));
+  EXPECT_TRUE(index.HasOverlapWith(1, 0, Box2d(Vec2d(21.0, 1.0), 0.0, 1.0,
+                                                1.0)));
+  EXPECT_FALSE(index.HasOverlapWith(1, 1, Box2d(Vec2d(21.0, 1.0), 0.0, 1.0,
+                                                 1.0)));
+}
+
+TEST(PredictedObstacleIndexTest, same_as_reference) {
+  std::mt19937 gen(0);
+  constexpr size_t kNumSlices = 80;
+  std::uniform_real_distribution<double> offset_dist(-15.0, 15.0);
+  std::uniform_real_distribution<double> speed_dist(0.0, 25.0);
+  std::uniform_real_distribution<double> heading_dist(-M_PI, M_PI);
+  for (const size_t num_obstacles : {0, 3, 20, 100}) {
+    const auto boxes = RandomObstacleBoxes(num_obstacles, kNumSlices, &gen);
+    const PredictedObstacleIndex index(boxes);
+    for (int i = 0; i < 200; ++i) {
+      const auto ego_boxes =
+          EgoBoxes(offset_dist(gen), speed_dist(gen), kNumSlices);
+      EXPECT_EQ(InCollisionReference(boxes, ego_boxes),
+                InCollision(index, ego_boxes));
+      // single slices, including near misses
+      for (size_t t = 0; t < kNumSlices; t += 7) {
+        for (const auto& obstacle_box : boxes[t]) {
+          const Box2d ego_box(
+              obstacle_box.center() + Vec2d(offset_dist(gen) * 0.3, 0.0),
+              heading_dist(gen), 4.9, 2.1);
+          bool expected = false;
+          for (const auto& box : boxes[t]) {
+            expected = expected || ego_box.HasOverlap(box);
+          }
+          EXPECT_EQ(expected, index.HasOverlap(t, ego_box));
+        }
+      }
+    }
+  }
+}
+
+TEST(PredictedObstacleIndexTest, benchmark) {
+  std::mt19937 gen(0);
+  constexpr size_t kNumSlices = 80;
+  constexpr int kNumCandidates = 2000;
+  const auto boxes = RandomObstacleBoxes(60, kNumSlices, &gen);
+  std::uniform_real_distribution<double> offset_dist(-15.0, 15.0);
+  std::uniform_real_distribution<double> speed_dist(0.0, 25.0);
+  std::vector<std::vector<Box2d>> candidates;
+  for (int i = 0; i < kNumCandidates; ++i) {
+    candidates.push_back(
+        EgoBoxes(offset_dist(gen), speed_dist(gen), kNumSlices));
+  }
+
+  const auto reference_start = std::chrono::steady_clock::now();
+  int reference_collisions = 0;
+  for (const auto& ego_boxes : candidates) {
+    reference_collisions += InCollisionReference(boxes, ego_boxes);
+  }
+  const auto index_start = std::chrono::steady_clock::now();
+  const PredictedObstacleIndex index(boxes);
+  int index_collisions = 0;
+  for (const auto& ego_boxes : candidates) {
+    index_collisions += InCollision(index, ego_boxes);
+  }
+  const auto index_end = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(reference_collisions, index_collisions);
+  const std::chrono::duration<double, std::milli> reference_time =
+      index_start - reference_start;
+  const std::chrono::duration<double, std::milli> index_time =
+      index_end - index_start;
+  AINFO << "Checked " << kNumCandidates << " candidates, "
+        << index_collisions << " in collision, nested loop: "
+        << reference_time.count() << " ms, index: " << index_time.count()
+        << " ms.";
+}
+
+}  // namespace planning
+}  // namespace apollo
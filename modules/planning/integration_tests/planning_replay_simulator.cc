@@ -0,0 +1,441 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Closed-loop planning simulator. Every scene is planned for a number
+ * of cycles on a mocked clock: the planned trajectory drives the kinematic
+ * vehicle model of modules/common/vehicle_model, whose state is fed back as
+ * the next localization and chassis. The recorded obstacles move along
+ * their most likely predicted trajectories as the simulated time advances.
+ * Cycles run back to back, much faster than real time, and the per-cycle
+ * latency, heap allocations and frame allocations are reported as a
+ * performance regression suite.
+ *
+ * bazel run //modules/planning/integration_tests:planning_replay_simulator
+ *     -- --replay_cycles=200 --replay_output_file=/tmp/replay.csv
+ **/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "modules/canbus/proto/chassis.pb.h"
+#include "modules/localization/proto/localization.pb.h"
+#include "modules/prediction/proto/prediction_obstacle.pb.h"
+
+#include "modules/common/math/math_utils.h"
+#include "modules/common/math/quaternion.h"
+#include "modules/common/time/time.h"
+#include "modules/common/vehicle_model/vehicle_model.h"
+#include "modules/common/vehicle_state/vehicle_state_provider.h"
+#include "modules/planning/common/frame.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/trajectory/discretized_trajectory.h"
+#include "modules/planning/integration_tests/sunnyvale_big_loop_benchmark_base.h"
+
+DEFINE_int32(replay_cycles, 100,
+             "Number of closed-loop planning cycles run on each scene");
+DEFINE_string(replay_scenes, "1,2,3,5,8,12,14,101,102,103,200,300,400",
+              "Comma separated sequence numbers of the scenes to replay");
+DEFINE_string(replay_output_file, "",
+              "If set, the per-cycle metrics are written to this file as "
+              "comma separated values");
+
+namespace {
+
+// every heap allocation of the process, counted by the operator new below
+std::atomic<size_t> num_heap_allocations(0);
+std::atomic<size_t> heap_allocated_bytes(0);
+
+}  // namespace
+
+// the array, nothrow and sized forms of operator new and delete forward to
+// these two, so replacing them counts every allocation made with new
+void* operator new(size_t size) {
+  num_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  heap_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+namespace apollo {
+namespace planning {
+
+using apollo::canbus::Chassis;
+using apollo::common::TrajectoryPoint;
+using apollo::common::VehicleModel;
+using apollo::common::VehicleState;
+using apollo::common::VehicleStateProvider;
+using apollo::common::time::Clock;
+using apollo::localization::LocalizationEstimate;
+using apollo::prediction::PredictionObstacle;
+using apollo::prediction::PredictionObstacles;
+
+namespace {
+
+struct CycleMetrics {
+  std::string scene;
+  int cycle = 0;
+  double timestamp = 0.0;
+  double latency_ms = 0.0;
+  size_t heap_allocations = 0;
+  size_t heap_allocated_bytes = 0;
+  size_t frames_allocated = 0;
+  size_t frames_reused = 0;
+  int num_trajectory_points = 0;
+  double speed = 0.0;
+};
+
+/**
+ * @brief Writes the simulated vehicle state into the localization and chassis
+ * messages which feed the next planning cycle.
+ */
+void FeedVehicleState(const VehicleState& vehicle_state, const double timestamp,
+                      LocalizationEstimate* localization, Chassis* chassis) {
+  localization->mutable_header()->set_timestamp_sec(timestamp);
+  localization->set_measurement_time(timestamp);
+  auto* pose = localization->mutable_pose();
+  pose->mutable_position()->set_x(vehicle_state.x());
+  pose->mutable_position()->set_y(vehicle_state.y());
+  pose->mutable_position()->set_z(vehicle_state.z());
+
+  const double heading = vehicle_state.heading();
+  pose->set_heading(heading);
+  const auto orientation = common::math::HeadingToQuaternion(heading);
+  pose->mutable_orientation()->set_qw(orientation.w());
+  pose->mutable_orientation()->set_qx(orientation.x());
+  pose->mutable_orientation()->set_qy(orientation.y());
+  pose->mutable_orientation()->set_qz(orientation.z());
+
+  const double v = vehicle_state.linear_velocity();
+  const double a = vehicle_state.linear_acceleration();
+  const double angular_velocity = v * vehicle_state.kappa();
+  pose->mutable_linear_velocity()->set_x(v * std::cos(heading));
+  pose->mutable_linear_velocity()->set_y(v * std::sin(heading));
+  pose->mutable_linear_velocity()->set_z(0.0);
+  pose->mutable_linear_acceleration()->set_x(a * std::cos(heading));
+  pose->mutable_linear_acceleration()->set_y(a * std::sin(heading));
+  pose->mutable_linear_acceleration()->set_z(0.0);
+  pose->mutable_angular_velocity()->set_x(0.0);
+  pose->mutable_angular_velocity()->set_y(0.0);
+  pose->mutable_angular_velocity()->set_z(angular_velocity);
+  pose->mutable_linear_acceleration_vrf()->set_x(0.0);
+  pose->mutable_linear_acceleration_vrf()->set_y(a);
+  pose->mutable_linear_acceleration_vrf()->set_z(0.0);
+  pose->mutable_angular_velocity_vrf()->set_x(0.0);
+  pose->mutable_angular_velocity_vrf()->set_y(0.0);
+  pose->mutable_angular_velocity_vrf()->set_z(angular_velocity);
+
+  chassis->mutable_header()->set_timestamp_sec(timestamp);
+  chassis->set_speed_mps(static_cast<float>(v));
+}
+
+/**
+ * @brief Moves a recorded obstacle along its most likely predicted trajectory
+ * by elapsed_time seconds. The pose, polygon and velocity of the obstacle are
+ * taken from the trajectory at that time and the trajectories are cut to
+ * start there. Obstacles without trajectories do not move.
+ */
+void MovePredictionObstacle(const PredictionObstacle& recorded,
+                            const double elapsed_time,
+                            const double timestamp,
+                            PredictionObstacle* obstacle) {
+  *obstacle = recorded;
+  obstacle->set_timestamp(timestamp);
+  auto* perception_obstacle = obstacle->mutable_perception_obstacle();
+  perception_obstacle->set_timestamp(timestamp);
+
+  const prediction::Trajectory* most_likely = nullptr;
+  for (const auto& trajectory : recorded.trajectory()) {
+    if (trajectory.trajectory_point_size() > 0 &&
+        (most_likely == nullptr ||
+         trajectory.probability() > most_likely->probability())) {
+      most_likely = &trajectory;
+    }
+  }
+  if (most_likely == nullptr || elapsed_time <= 0.0) {
+    return;
+  }
+
+  const DiscretizedTrajectory trajectory(std::vector<TrajectoryPoint>(
+      most_likely->trajectory_point().begin(),
+      most_likely->trajectory_point().end()));
+  const double start_time = trajectory.front().relative_time();
+  const double end_time = trajectory.back().relative_time();
+  const TrajectoryPoint trajectory_point =
+      trajectory.Evaluate(std::min(start_time + elapsed_time, end_time));
+  const auto& start = trajectory.front().path_point();
+  const auto& point = trajectory_point.path_point();
+
+  // move the recorded pose by the displacement along the trajectory, the
+  // polygon turns with the heading around the obstacle position
+  const double dx = point.x() - start.x();
+  const double dy = point.y() - start.y();
+  const double dtheta = point.theta() - start.theta();
+  const double cos_dtheta = std::cos(dtheta);
+  const double sin_dtheta = std::sin(dtheta);
+  const auto& position = recorded.perception_obstacle().position();
+  for (auto& polygon_point : *perception_obstacle->mutable_polygon_point()) {
+    const double x = polygon_point.x() - position.x();
+    const double y = polygon_point.y() - position.y();
+    polygon_point.set_x(position.x() + dx + x * cos_dtheta - y * sin_dtheta);
+    polygon_point.set_y(position.y() + dy + x * sin_dtheta + y * cos_dtheta);
+  }
+  perception_obstacle->mutable_position()->set_x(position.x() + dx);
+  perception_obstacle->mutable_position()->set_y(position.y() + dy);
+  const double theta = common::math::NormalizeAngle(
+      recorded.perception_obstacle().theta() + dtheta);
+  perception_obstacle->set_theta(theta);
+  const double speed = trajectory_point.v();
+  perception_obstacle->mutable_velocity()->set_x(speed * std::cos(theta));
+  perception_obstacle->mutable_velocity()->set_y(speed * std::sin(theta));
+
+  // the trajectories now start at the current time, the last point is kept
+  // so that none of them becomes empty
+  for (auto& obstacle_trajectory : *obstacle->mutable_trajectory()) {
+    auto* points = obstacle_trajectory.mutable_trajectory_point();
+    if (points->empty()) {
+      continue;
+    }
+    const double cut_time = points->Get(0).relative_time() + elapsed_time;
+    int first = 0;
+    while (first + 1 < points->size() &&
+           points->Get(first).relative_time() < cut_time) {
+      ++first;
+    }
+    points->DeleteSubrange(0, first);
+    for (auto& trajectory_point : *points) {
+      trajectory_point.set_relative_time(
+          std::max(0.0, trajectory_point.relative_time() - elapsed_time));
+    }
+  }
+}
+
+/**
+ * @brief Moves the vehicle along the planned trajectory for one cycle. The
+ * acceleration and curvature of the trajectory point at the current time are
+ * held constant over the cycle, as a perfect controller would command them.
+ */
+VehicleState AdvanceVehicleState(const ADCTrajectory& trajectory,
+                                 const double cycle_time,
+                                 VehicleState vehicle_state) {
+  if (trajectory.trajectory_point_size() == 0 ||
+      trajectory.estop().is_estop()) {
+    vehicle_state.set_linear_velocity(0.0);
+    vehicle_state.set_linear_acceleration(0.0);
+    return vehicle_state;
+  }
+  const DiscretizedTrajectory discretized_trajectory(trajectory);
+  const auto& point = discretized_trajectory.TrajectoryPointAt(
+      discretized_trajectory.QueryLowerBoundPoint(0.0));
+  vehicle_state.set_linear_acceleration(point.a());
+  vehicle_state.set_kappa(point.path_point().kappa());
+
+  VehicleState next_state = VehicleModel::Predict(cycle_time, vehicle_state);
+  if (next_state.linear_velocity() < 0.0) {
+    // the vehicle model does not handle reverse driving, stop the vehicle
+    next_state.set_linear_velocity(0.0);
+    next_state.set_linear_acceleration(0.0);
+  }
+  next_state.set_gear(vehicle_state.gear());
+  next_state.set_driving_mode(vehicle_state.driving_mode());
+  return next_state;
+}
+
+}  // namespace
+
+class PlanningReplaySimulator : public SunnyvaleBigLoopBenchmarkBase {
+ protected:
+  void SimulateScene(const std::string& scene,
+                     std::vector<CycleMetrics>* metrics);
+};
+
+void PlanningReplaySimulator::SimulateScene(
+    const std::string& scene, std::vector<CycleMetrics>* metrics) {
+  const double cycle_time = 1.0 / static_cast<double>(FLAGS_planning_loop_rate);
+  const double start_timestamp = Clock::NowInSeconds();
+  double timestamp = start_timestamp;
+
+  ASSERT_TRUE(VehicleStateProvider::Instance()
+                  ->Update(*local_view_.localization_estimate,
+                           *local_view_.chassis)
+                  .ok());
+  VehicleState vehicle_state =
+      VehicleStateProvider::Instance()->vehicle_state();
+
+  const LocalizationEstimate recorded_localization =
+      *local_view_.localization_estimate;
+  const Chassis recorded_chassis = *local_view_.chassis;
+  const PredictionObstacles recorded_prediction =
+      *local_view_.prediction_obstacles;
+
+  for (int i = 0; i < FLAGS_replay_cycles; ++i) {
+    Clock::SetNowInSeconds(timestamp);
+
+    // planning may keep the messages of the last cycle, so every cycle gets
+    // its own copies
+    auto localization =
+        std::make_shared<LocalizationEstimate>(recorded_localization);
+    auto chassis = std::make_shared<Chassis>(recorded_chassis);
+    FeedVehicleState(vehicle_state, timestamp, localization.get(),
+                     chassis.get());
+    auto prediction = std::make_shared<PredictionObstacles>();
+    *prediction->mutable_header() = recorded_prediction.header();
+    prediction->mutable_header()->set_timestamp_sec(timestamp);
+    prediction->set_perception_error_code(
+        recorded_prediction.perception_error_code());
+    for (const auto& recorded_obstacle :
+         recorded_prediction.prediction_obstacle()) {
+      MovePredictionObstacle(recorded_obstacle, timestamp - start_timestamp,
+                             timestamp,
+                             prediction->add_prediction_obstacle());
+    }
+    local_view_.localization_estimate = localization;
+    local_view_.chassis = chassis;
+    local_view_.prediction_obstacles = prediction;
+
+    const size_t frames_allocated = FramePool::Instance()->num_allocated();
+    const size_t frames_reused = FramePool::Instance()->num_reused();
+    const size_t heap_allocations = num_heap_allocations.load();
+    const size_t heap_bytes = heap_allocated_bytes.load();
+
+    ADCTrajectory adc_trajectory;
+    const auto start = std::chrono::steady_clock::now();
+    planning_->RunOnce(local_view_, &adc_trajectory);
+    const std::chrono::duration<double, std::milli> time_ms =
+        std::chrono::steady_clock::now() - start;
+    // planning threads and cyber tasks running during the cycle are counted
+    // too, the counters are process wide
+    const size_t cycle_heap_allocations =
+        num_heap_allocations.load() - heap_allocations;
+    const size_t cycle_heap_bytes = heap_allocated_bytes.load() - heap_bytes;
+
+    CycleMetrics cycle_metrics;
+    cycle_metrics.scene = scene;
+    cycle_metrics.cycle = i;
+    cycle_metrics.timestamp = timestamp;
+    cycle_metrics.latency_ms = time_ms.count();
+    cycle_metrics.heap_allocations = cycle_heap_allocations;
+    cycle_metrics.heap_allocated_bytes = cycle_heap_bytes;
+    cycle_metrics.frames_allocated =
+        FramePool::Instance()->num_allocated() - frames_allocated;
+    cycle_metrics.frames_reused =
+        FramePool::Instance()->num_reused() - frames_reused;
+    cycle_metrics.num_trajectory_points =
+        adc_trajectory.trajectory_point_size();
+    cycle_metrics.speed = vehicle_state.linear_velocity();
+    metrics->push_back(cycle_metrics);
+
+    vehicle_state =
+        AdvanceVehicleState(adc_trajectory, cycle_time, vehicle_state);
+    timestamp += cycle_time;
+  }
+}
+
+TEST_F(PlanningReplaySimulator, closed_loop) {
+  std::vector<CycleMetrics> metrics;
+  const auto start = std::chrono::steady_clock::now();
+  const size_t num_scenes =
+      RunScenes(FLAGS_replay_scenes, [&](const std::string& scene) {
+        SimulateScene(scene, &metrics);
+      });
+  const std::chrono::duration<double> wall_time =
+      std::chrono::steady_clock::now() - start;
+  ASSERT_GT(num_scenes, 0);
+  ASSERT_FALSE(metrics.empty());
+
+  std::vector<double> latency_ms;
+  latency_ms.reserve(metrics.size());
+  std::vector<double> heap_allocations;
+  heap_allocations.reserve(metrics.size());
+  size_t heap_bytes = 0;
+  size_t frames_allocated = 0;
+  size_t frames_reused = 0;
+  int num_empty_trajectories = 0;
+  for (const auto& cycle_metrics : metrics) {
+    latency_ms.push_back(cycle_metrics.latency_ms);
+    heap_allocations.push_back(
+        static_cast<double>(cycle_metrics.heap_allocations));
+    heap_bytes += cycle_metrics.heap_allocated_bytes;
+    frames_allocated += cycle_metrics.frames_allocated;
+    frames_reused += cycle_metrics.frames_reused;
+    if (cycle_metrics.num_trajectory_points == 0) {
+      ++num_empty_trajectories;
+    }
+  }
+  std::sort(latency_ms.begin(), latency_ms.end());
+  std::sort(heap_allocations.begin(), heap_allocations.end());
+
+  const double simulated_time =
+      static_cast<double>(metrics.size()) /
+      static_cast<double>(FLAGS_planning_loop_rate);
+  std::cout << "scenes " << num_scenes << "  cycles " << metrics.size()
+            << "  simulated " << simulated_time << " s  wall "
+            << wall_time.count() << " s" << std::endl;
+  std::cout << "planning cycle: p50 " << Percentile(latency_ms, 0.5)
+            << " ms  p99 " << Percentile(latency_ms, 0.99) << " ms  max "
+            << latency_ms.back() << " ms" << std::endl;
+  std::cout << "heap allocations per cycle: p50 "
+            << Percentile(heap_allocations, 0.5) << "  p99 "
+            << Percentile(heap_allocations, 0.99) << "  max "
+            << heap_allocations.back() << "  mean bytes "
+            << heap_bytes / metrics.size() << std::endl;
+  std::cout << "frames: allocated " << frames_allocated << "  reused "
+            << frames_reused << std::endl;
+  std::cout << "empty trajectories: " << num_empty_trajectories << std::endl;
+
+  if (!FLAGS_replay_output_file.empty()) {
+    std::ofstream output(FLAGS_replay_output_file);
+    ASSERT_TRUE(output.is_open())
+        << "failed to open " << FLAGS_replay_output_file;
+    output << "scene,cycle,timestamp,latency_ms,heap_allocations,"
+              "heap_allocated_bytes,frames_allocated,frames_reused,"
+              "num_trajectory_points,speed"
+           << std::endl;
+    output.precision(12);
+    for (const auto& cycle_metrics : metrics) {
+      output << cycle_metrics.scene << "," << cycle_metrics.cycle << ","
+             << cycle_metrics.timestamp << "," << cycle_metrics.latency_ms
+             << "," << cycle_metrics.heap_allocations << ","
+             << cycle_metrics.heap_allocated_bytes << ","
+             << cycle_metrics.frames_allocated << ","
+             << cycle_metrics.frames_reused << ","
+             << cycle_metrics.num_trajectory_points << ","
+             << cycle_metrics.speed << std::endl;
+    }
+  }
+  EXPECT_EQ(num_empty_trajectories, 0);
+}
+
+}  // namespace planning
+}  // namespace apollo
+
+TMAIN;
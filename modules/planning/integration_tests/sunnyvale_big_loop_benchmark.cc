@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Replays the sunnyvale_big_loop scenes many times and reports the
+ * latency percentiles of every scenario, stage and task, so that performance
+ * regressions show up before deployment.
+ *
+ * bazel run //modules/planning/integration_tests:sunnyvale_big_loop_benchmark
+ *     -- --benchmark_iterations=100 --benchmark_output_file=/tmp/latency.txt
+ *
+ * Scene 400 is a lane change with more than one reference line. Running it
+ * with and without --enable_multi_thread_in_lane_follow_stage compares serial
+ * and concurrent reference line planning:
+ *     -- --benchmark_scenes=400 --enable_multi_thread_in_lane_follow_stage
+ **/
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "cyber/common/file.h"
+#include "modules/planning/common/latency_histograms.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/integration_tests/sunnyvale_big_loop_benchmark_base.h"
+
+DEFINE_int32(benchmark_iterations, 100,
+             "Number of planning cycles run on each scene");
+DEFINE_string(benchmark_scenes,
+              "1,2,3,5,8,12,14,101,102,103,200,201,300,400,500,600,601",
+              "Comma separated sequence numbers of the scenes to replay");
+DEFINE_string(benchmark_output_file, "",
+              "If set, the latency histograms are written to this file in "
+              "text format, for comparing two builds");
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+void PrintHistograms(
+    const std::string& title,
+    const google::protobuf::RepeatedPtrField<LatencyHistogram>& histograms) {
+  std::cout << title << std::endl;
+  for (const auto& histogram : histograms) {
+    std::cout << "  " << std::left << std::setw(64) << histogram.name()
+              << std::right << std::fixed << std::setprecision(3)
+              << " count " << std::setw(7) << histogram.count() << "  p50 "
+              << std::setw(9) << histogram.p50_ms() << " ms  p99 "
+              << std::setw(9) << histogram.p99_ms() << " ms  max "
+              << std::setw(9) << histogram.max_ms() << " ms" << std::endl;
+  }
+}
+
+}  // namespace
+
+class SunnyvaleBigLoopBenchmark : public SunnyvaleBigLoopBenchmarkBase {
+ public:
+  virtual void SetUp() {
+    SunnyvaleBigLoopBenchmarkBase::SetUp();
+    FLAGS_enable_latency_histograms = true;
+  }
+};
+
+TEST_F(SunnyvaleBigLoopBenchmark, replay) {
+  LatencyHistograms::Instance()->Clear();
+  std::vector<double> cycle_time_ms;
+  const size_t num_scenes =
+      RunScenes(FLAGS_benchmark_scenes, [&](const std::string&) {
+        for (int i = 0; i < FLAGS_benchmark_iterations; ++i) {
+          ADCTrajectory adc_trajectory;
+          const auto start = std::chrono::steady_clock::now();
+          planning_->RunOnce(local_view_, &adc_trajectory);
+          const std::chrono::duration<double, std::milli> time_ms =
+              std::chrono::steady_clock::now() - start;
+          cycle_time_ms.push_back(time_ms.count());
+        }
+      });
+  ASSERT_GT(num_scenes, 0);
+
+  PlanningLatency latency;
+  LatencyHistograms::Instance()->GetLatency(&latency);
+  ASSERT_GT(latency.task_size(), 0);
+
+  std::sort(cycle_time_ms.begin(), cycle_time_ms.end());
+  std::cout << "planning cycle: count " << cycle_time_ms.size() << "  p50 "
+            << Percentile(cycle_time_ms, 0.5) << " ms  p99 "
+            << Percentile(cycle_time_ms, 0.99) << " ms  max "
+            << cycle_time_ms.back() << " ms" << std::endl;
+  PrintHistograms("scenarios:", latency.scenario());
+  PrintHistograms("stages:", latency.stage());
+  PrintHistograms("tasks:", latency.task());
+
+  if (!FLAGS_benchmark_output_file.empty()) {
+    EXPECT_TRUE(cyber::common::SetProtoToASCIIFile(
+        latency, FLAGS_benchmark_output_file));
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
+
+TMAIN;
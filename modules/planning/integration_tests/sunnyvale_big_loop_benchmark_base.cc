@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/planning/integration_tests/sunnyvale_big_loop_benchmark_base.h"
+
+#include <algorithm>
+
+#include "cyber/common/log.h"
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/util/string_tokenizer.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+void SunnyvaleBigLoopBenchmarkBase::SetUp() {
+  FLAGS_use_navigation_mode = false;
+  FLAGS_map_dir = "modules/map/data/sunnyvale_big_loop";
+  FLAGS_test_base_map_filename = "base_map.bin";
+  FLAGS_test_data_dir = "modules/planning/testdata/sunnyvale_big_loop_test";
+  FLAGS_planning_upper_speed_limit = 12.5;
+  FLAGS_enable_rss_info = false;
+}
+
+size_t SunnyvaleBigLoopBenchmarkBase::RunScenes(
+    const std::string& scenes,
+    const std::function<void(const std::string&)>& run_scene) {
+  const auto seq_nums = common::util::StringTokenizer::Split(scenes, ",");
+  for (const auto& seq_num : seq_nums) {
+    FLAGS_test_routing_response_file = seq_num + "_routing.pb.txt";
+    FLAGS_test_prediction_file = seq_num + "_prediction.pb.txt";
+    FLAGS_test_localization_file = seq_num + "_localization.pb.txt";
+    FLAGS_test_chassis_file = seq_num + "_chassis.pb.txt";
+    // loads the recorded messages and sets the mocked clock to the
+    // localization timestamp
+    PlanningTestBase::SetUp();
+    run_scene(seq_num);
+  }
+  return seq_nums.size();
+}
+
+double Percentile(const std::vector<double>& sorted_values,
+                  const double ratio) {
+  CHECK(!sorted_values.empty());
+  const size_t index = std::min(
+      sorted_values.size() - 1,
+      static_cast<size_t>(ratio * static_cast<double>(sorted_values.size())));
+  return sorted_values[index];
+}
+
+}  // namespace planning
+}  // namespace apollo
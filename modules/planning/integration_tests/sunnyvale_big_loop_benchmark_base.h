@@ -0,0 +1,55 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Shared setup of the binaries that replay the sunnyvale_big_loop
+ * scenes for performance measurements.
+ **/
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "modules/planning/integration_tests/planning_test_base.h"
+
+namespace apollo {
+namespace planning {
+
+class SunnyvaleBigLoopBenchmarkBase : public PlanningTestBase {
+ public:
+  virtual void SetUp();
+
+ protected:
+  /**
+   * @brief Loads every scene of the comma separated sequence numbers into the
+   * planning module and calls run_scene with its sequence number.
+   * @return the number of scenes run.
+   */
+  size_t RunScenes(const std::string& scenes,
+                   const std::function<void(const std::string&)>& run_scene);
+};
+
+/**
+ * @brief Returns the value at ratio (in [0, 1]) of sorted_values, which must
+ * be sorted in ascending order and not empty.
+ */
+double Percentile(const std::vector<double>& sorted_values, const double ratio);
+
+}  // namespace planning
+}  // namespace apollo
@@ -141,6 +141,35 @@ bool LateralOSQPOptimizer::optimize(
     }
   }
 
+  if (workspace_ != nullptr) {
+    OSQPSettings settings;
+    osqp_set_default_settings(&settings);
+    settings.alpha = 1.0;
+    settings.eps_abs = 1.0e-05;
+    settings.eps_rel = 1.0e-05;
+    settings.max_iter = 5000;
+    settings.polish = true;
+    settings.verbose = FLAGS_enable_osqp_debug;
+    workspace_->SetSettings(settings);
+    if (!workspace_->Solve(
+            kNumParam, kNumConstraint, P_data, P_indices, P_indptr, A_data,
+            A_indices, A_indptr, std::vector<c_float>(q, q + kNumParam),
+            std::vector<c_float>(lower_bounds, lower_bounds + kNumConstraint),
+            std::vector<c_float>(upper_bounds,
+                                 upper_bounds + kNumConstraint))) {
+      return false;
+    }
+    const auto& x = workspace_->primal_solution();
+    for (int i = 0; i < num_var; ++i) {
+      opt_d_.push_back(x[i]);
+      opt_d_prime_.push_back(x[i + num_var]);
+      opt_d_pprime_.push_back(x[i + 2 * num_var]);
+    }
+    opt_d_prime_[num_var - 1] = 0.0;
+    opt_d_pprime_[num_var - 1] = 0.0;
+    return true;
+  }
+
   // Problem settings
   OSQPSettings* settings =
       reinterpret_cast<OSQPSettings*>(c_malloc(sizeof(OSQPSettings)));
@@ -27,6 +27,7 @@
 
 #include "modules/planning/common/trajectory1d/piecewise_jerk_trajectory1d.h"
 #include "modules/planning/lattice/trajectory_generation/lateral_qp_optimizer.h"
+#include "modules/planning/math/osqp_workspace.h"
 
 namespace apollo {
 namespace planning {
@@ -41,6 +42,9 @@ class LateralOSQPOptimizer : public LateralQPOptimizer {
       const std::array<double, 3>& d_state, const double delta_s,
       const std::vector<std::pair<double, double>>& d_bounds) override;
 
+  // solve with a persistent workspace owned by the caller
+  void SetWorkspace(OsqpWorkspace* workspace) { workspace_ = workspace; }
+
  private:
   void CalculateKernel(const std::vector<std::pair<double, double>>& d_bounds,
                        std::vector<c_float>* P_data,
@@ -48,6 +52,8 @@ class LateralOSQPOptimizer : public LateralQPOptimizer {
                        std::vector<c_int>* P_indptr);
 
   double delta_s_ = 0.0;
+
+  OsqpWorkspace* workspace_ = nullptr;
 };
 
 }  // namespace planning
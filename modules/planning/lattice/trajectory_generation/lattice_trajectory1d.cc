@@ -20,6 +20,8 @@
 
 #include "modules/planning/lattice/trajectory_generation/lattice_trajectory1d.h"
 
+#include <algorithm>
+
 #include "cyber/common/log.h"
 
 namespace apollo {
@@ -57,6 +59,42 @@ double LatticeTrajectory1d::Evaluate(const std::uint32_t order,
   }
 }
 
+void LatticeTrajectory1d::EvaluateBatch(const std::vector<double>& params,
+                                        const std::uint32_t max_order,
+                                        Curve1dSamples* const samples) const {
+  // evaluates the params beyond the param length at the end of the
+  // trajectory, then extrapolates them as Evaluate() does.
+  const double param_length = ptr_trajectory1d_->ParamLength();
+  const std::uint32_t trajectory_order = std::max<std::uint32_t>(max_order, 2);
+  std::vector<double> clamped_params(params);
+  bool has_extrapolation = false;
+  for (auto& param : clamped_params) {
+    if (param >= param_length) {
+      param = param_length;
+      has_extrapolation = true;
+    }
+  }
+  ptr_trajectory1d_->EvaluateBatch(clamped_params, trajectory_order, samples);
+  if (!has_extrapolation) {
+    return;
+  }
+
+  auto& p = (*samples)[0];
+  auto& v = (*samples)[1];
+  auto& a = (*samples)[2];
+  for (size_t i = 0; i < params.size(); ++i) {
+    if (params[i] < param_length) {
+      continue;
+    }
+    const double t = params[i] - param_length;
+    p[i] = p[i] + v[i] * t + 0.5 * a[i] * t * t;
+    v[i] = v[i] + a[i] * t;
+    if (max_order >= 3) {
+      (*samples)[3][i] = 0.0;
+    }
+  }
+}
+
 double LatticeTrajectory1d::ParamLength() const {
   return ptr_trajectory1d_->ParamLength();
 }
@@ -22,6 +22,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "modules/planning/math/curve1d/curve1d.h"
 
@@ -36,6 +37,10 @@ class LatticeTrajectory1d : public Curve1d {
 
   virtual double Evaluate(const std::uint32_t order, const double param) const;
 
+  virtual void EvaluateBatch(const std::vector<double>& params,
+                             const std::uint32_t max_order,
+                             Curve1dSamples* const samples) const;
+
   virtual double ParamLength() const;
 
   virtual std::string ToString() const;
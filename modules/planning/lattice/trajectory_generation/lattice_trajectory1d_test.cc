@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/lattice/trajectory_generation/lattice_trajectory1d.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "modules/planning/math/curve1d/cubic_polynomial_curve1d.h"
+#include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
+#include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// Checks EvaluateBatch against Evaluate for every order up to max_order, on
+// params inside the curve and beyond its end, where the trajectory is
+// extrapolated with constant acceleration.
+void ExpectBatchMatchesEvaluate(const LatticeTrajectory1d& trajectory) {
+  const double param_length = trajectory.ParamLength();
+  std::vector<double> params;
+  for (double t = 0.0; t < param_length + 4.0; t += 0.1) {
+    params.push_back(t);
+  }
+  params.push_back(param_length);
+  params.push_back(param_length + 10.0);
+
+  for (std::uint32_t max_order = 0; max_order <= 3; ++max_order) {
+    Curve1dSamples samples;
+    trajectory.EvaluateBatch(params, max_order, &samples);
+    for (std::uint32_t order = 0; order <= max_order; ++order) {
+      ASSERT_EQ(params.size(), samples[order].size());
+      for (size_t i = 0; i < params.size(); ++i) {
+        EXPECT_NEAR(trajectory.Evaluate(order, params[i]), samples[order][i],
+                    1e-9)
+            << "order " << order << " at " << params[i];
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(LatticeTrajectory1dTest, EvaluateBatchQuartic) {
+  LatticeTrajectory1d trajectory(std::make_shared<QuarticPolynomialCurve1d>(
+      0.0, 5.0, 0.5, 10.0, 0.0, 8.0));
+  ExpectBatchMatchesEvaluate(trajectory);
+}
+
+TEST(LatticeTrajectory1dTest, EvaluateBatchQuintic) {
+  LatticeTrajectory1d trajectory(std::make_shared<QuinticPolynomialCurve1d>(
+      0.5, 0.1, 0.0, 0.0, 0.0, 0.0, 30.0));
+  ExpectBatchMatchesEvaluate(trajectory);
+}
+
+TEST(LatticeTrajectory1dTest, EvaluateBatchCubic) {
+  LatticeTrajectory1d trajectory(
+      std::make_shared<CubicPolynomialCurve1d>(1.0, 2.0, 3.0, 5.0, 3.0));
+  ExpectBatchMatchesEvaluate(trajectory);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -136,8 +136,9 @@ void Trajectory1dGenerator::GenerateLateralTrajectoryBundle(
         ptr_path_time_graph_->GetLateralBounds(s_min, s_max, delta_s);
 
     // LateralTrajectoryOptimizer lateral_optimizer;
-    std::unique_ptr<LateralQPOptimizer> lateral_optimizer(
+    std::unique_ptr<LateralOSQPOptimizer> lateral_optimizer(
         new LateralOSQPOptimizer);
+    lateral_optimizer->SetWorkspace(lateral_qp_workspace_);
 
     lateral_optimizer->optimize(init_lat_state_, delta_s, lateral_bounds);
 
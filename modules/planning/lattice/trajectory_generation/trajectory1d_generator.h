@@ -33,6 +33,7 @@
 #include "modules/planning/math/curve1d/curve1d.h"
 #include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
 #include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
+#include "modules/planning/math/osqp_workspace.h"
 
 namespace apollo {
 namespace planning {
@@ -55,6 +56,11 @@ class Trajectory1dGenerator {
   void GenerateLateralTrajectoryBundle(
       std::vector<std::shared_ptr<Curve1d>>* ptr_lat_trajectory_bundle) const;
 
+  // qp workspace reused by the lateral optimization across planning cycles
+  void SetLateralQpWorkspace(OsqpWorkspace* workspace) {
+    lateral_qp_workspace_ = workspace;
+  }
+
  private:
   void GenerateSpeedProfilesForCruising(
       const double target_speed,
@@ -86,6 +92,8 @@ class Trajectory1dGenerator {
   EndConditionSampler end_condition_sampler_;
 
   std::shared_ptr<PathTimeGraph> ptr_path_time_graph_;
+
+  OsqpWorkspace* lateral_qp_workspace_ = nullptr;
 };
 
 template <>
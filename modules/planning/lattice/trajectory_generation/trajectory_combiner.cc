@@ -17,6 +17,7 @@
 #include "modules/planning/lattice/trajectory_generation/trajectory_combiner.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "modules/common/math/cartesian_frenet_conversion.h"
 #include "modules/common/math/path_matcher.h"
@@ -40,30 +41,46 @@ DiscretizedTrajectory TrajectoryCombiner::Combine(
   double accumulated_trajectory_s = 0.0;
   PathPoint prev_trajectory_point;
 
+  std::vector<double> t_params;
+  for (double t_param = 0.0; t_param < FLAGS_trajectory_time_length;
+       t_param += FLAGS_trajectory_time_resolution) {
+    t_params.push_back(t_param);
+  }
+  // linear extrapolation is handled internally in LatticeTrajectory1d;
+  // no worry about t_param > lon_trajectory.ParamLength() situation
+  Curve1dSamples lon_samples;
+  lon_trajectory.EvaluateBatch(t_params, 2, &lon_samples);
+
+  // the combined trajectory ends where s leaves the reference line
+  std::vector<double> s_values;
+  std::vector<double> relative_s_values;
   double last_s = -FLAGS_lattice_epsilon;
-  double t_param = 0.0;
-  while (t_param < FLAGS_trajectory_time_length) {
-    // linear extrapolation is handled internally in LatticeTrajectory1d;
-    // no worry about t_param > lon_trajectory.ParamLength() situation
-    double s = lon_trajectory.Evaluate(0, t_param);
+  for (size_t i = 0; i < t_params.size(); ++i) {
+    double s = lon_samples[0][i];
     if (last_s > 0.0) {
       s = std::max(last_s, s);
     }
     last_s = s;
-
-    double s_dot =
-        std::max(FLAGS_lattice_epsilon, lon_trajectory.Evaluate(1, t_param));
-    double s_ddot = lon_trajectory.Evaluate(2, t_param);
     if (s > s_ref_max) {
       break;
     }
+    s_values.push_back(s);
+    relative_s_values.push_back(s - s0);
+  }
+  // linear extrapolation is handled internally in LatticeTrajectory1d;
+  // no worry about s_param > lat_trajectory.ParamLength() situation
+  Curve1dSamples lat_samples;
+  lat_trajectory.EvaluateBatch(relative_s_values, 2, &lat_samples);
 
-    double relative_s = s - s0;
-    // linear extrapolation is handled internally in LatticeTrajectory1d;
-    // no worry about s_param > lat_trajectory.ParamLength() situation
-    double d = lat_trajectory.Evaluate(0, relative_s);
-    double d_prime = lat_trajectory.Evaluate(1, relative_s);
-    double d_pprime = lat_trajectory.Evaluate(2, relative_s);
+  for (size_t i = 0; i < s_values.size(); ++i) {
+    const double t_param = t_params[i];
+    double s = s_values[i];
+    double s_dot = std::max(FLAGS_lattice_epsilon, lon_samples[1][i]);
+    double s_ddot = lon_samples[2][i];
+
+    double d = lat_samples[0][i];
+    double d_prime = lat_samples[1][i];
+    double d_pprime = lat_samples[2][i];
 
     PathPoint matched_ref_point = PathMatcher::MatchToPath(reference_line, s);
 
@@ -106,8 +123,6 @@ DiscretizedTrajectory TrajectoryCombiner::Combine(
 
     combined_trajectory.AppendTrajectoryPoint(trajectory_point);
 
-    t_param = t_param + FLAGS_trajectory_time_resolution;
-
     prev_trajectory_point = trajectory_point.path_point();
   }
   return combined_trajectory;
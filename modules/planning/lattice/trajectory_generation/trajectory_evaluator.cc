@@ -21,9 +21,11 @@
 #include "modules/planning/lattice/trajectory_generation/trajectory_evaluator.h"
 
 #include <algorithm>
+#include <functional>
 #include <limits>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/math/path_matcher.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/common/trajectory1d/piecewise_acceleration_trajectory1d.h"
@@ -58,12 +60,27 @@ TrajectoryEvaluator::TrajectoryEvaluator(
 
   reference_s_dot_ = ComputeLongitudinalGuideVelocity(planning_target);
 
+  // the time grids on which every longitudinal trajectory is sampled, built
+  // the same way as the time loops of the cost terms.
+  for (double t = 0.0; t < FLAGS_trajectory_time_length;
+       t += FLAGS_trajectory_time_resolution) {
+    time_grid_.push_back(t);
+  }
+  const size_t num_indexed_times =
+      std::max(reference_s_dot_.size(), path_time_intervals_.size());
+  indexed_time_grid_.reserve(num_indexed_times);
+  for (size_t i = 0; i < num_indexed_times; ++i) {
+    indexed_time_grid_.push_back(static_cast<double>(i) *
+                                 FLAGS_trajectory_time_resolution);
+  }
+
   // if we have a stop point along the reference line,
   // filter out the lon. trajectories that pass the stop point.
   double stop_point = std::numeric_limits<double>::max();
   if (planning_target.has_stop_point()) {
     stop_point = planning_target.stop_point().s();
   }
+  std::vector<PtrTrajectory1d> valid_lon_trajectories;
   for (const auto& lon_trajectory : lon_trajectories) {
     double lon_end_s = lon_trajectory->Evaluate(0, end_time);
     if (init_s[0] < stop_point &&
@@ -74,6 +91,63 @@ TrajectoryEvaluator::TrajectoryEvaluator(
     if (!ConstraintChecker1d::IsValidLongitudinalTrajectory(*lon_trajectory)) {
       continue;
     }
+    valid_lon_trajectories.push_back(lon_trajectory);
+  }
+
+  // costs[i][j] is the cost of the i-th lon. and the j-th lat. trajectory.
+  std::vector<std::vector<double>> costs(valid_lon_trajectories.size());
+  const size_t num_tasks = std::min<size_t>(
+      valid_lon_trajectories.size(), FLAGS_max_planning_thread_pool_size);
+  if (FLAGS_enable_multi_thread_in_lattice_planner && num_tasks > 1) {
+    const size_t num_per_task =
+        (valid_lon_trajectories.size() + num_tasks - 1) / num_tasks;
+    std::vector<std::future<void>> results;
+    for (size_t begin = num_per_task; begin < valid_lon_trajectories.size();
+         begin += num_per_task) {
+      const size_t end =
+          std::min(begin + num_per_task, valid_lon_trajectories.size());
+      results.push_back(cyber::Async(
+          &TrajectoryEvaluator::EvaluateLongitudinalTrajectories, this,
+          std::cref(planning_target), std::cref(valid_lon_trajectories),
+          std::cref(lat_trajectories), begin, end, &costs));
+    }
+    EvaluateLongitudinalTrajectories(planning_target, valid_lon_trajectories,
+                                     lat_trajectories, 0, num_per_task, &costs);
+    for (auto& result : results) {
+      result.get();
+    }
+  } else {
+    EvaluateLongitudinalTrajectories(planning_target, valid_lon_trajectories,
+                                     lat_trajectories, 0,
+                                     valid_lon_trajectories.size(), &costs);
+  }
+
+  size_t index = 0;
+  for (size_t i = 0; i < valid_lon_trajectories.size(); ++i) {
+    for (size_t j = 0; j < lat_trajectories.size(); ++j) {
+      cost_queue_.emplace(
+          PairCost(Trajectory1dPair(valid_lon_trajectories[i],
+                                    lat_trajectories[j]),
+                   costs[i][j]),
+          index++);
+    }
+  }
+  ADEBUG << "Number of valid 1d trajectory pairs: " << cost_queue_.size();
+}
+
+void TrajectoryEvaluator::EvaluateLongitudinalTrajectories(
+    const PlanningTarget& planning_target,
+    const std::vector<PtrTrajectory1d>& lon_trajectories,
+    const std::vector<PtrTrajectory1d>& lat_trajectories, const size_t begin,
+    const size_t end, std::vector<std::vector<double>>* costs) const {
+  LonSamples lon_samples;
+  Curve1dSamples lat_samples;
+  for (size_t i = begin; i < end; ++i) {
+    const auto& lon_trajectory = lon_trajectories[i];
+    const double lon_cost =
+        EvaluateLongitudinal(planning_target, lon_trajectory, &lon_samples);
+    auto& lon_costs = (*costs)[i];
+    lon_costs.reserve(lat_trajectories.size());
     for (const auto& lat_trajectory : lat_trajectories) {
       /**
        * The validity of the code needs to be verified.
@@ -82,12 +156,10 @@ TrajectoryEvaluator::TrajectoryEvaluator(
         continue;
       }
       */
-      double cost = Evaluate(planning_target, lon_trajectory, lat_trajectory);
-      cost_queue_.emplace(Trajectory1dPair(lon_trajectory, lat_trajectory),
-                          cost);
+      lon_costs.push_back(EvaluateWithLongitudinalCost(
+          lon_cost, lon_samples, lat_trajectory, &lat_samples));
     }
   }
-  ADEBUG << "Number of valid 1d trajectory pairs: " << cost_queue_.size();
 }
 
 bool TrajectoryEvaluator::has_more_trajectory_pairs() const {
@@ -103,11 +175,11 @@ TrajectoryEvaluator::next_top_trajectory_pair() {
   CHECK(has_more_trajectory_pairs());
   auto top = cost_queue_.top();
   cost_queue_.pop();
-  return top.first;
+  return top.first.first;
 }
 
 double TrajectoryEvaluator::top_trajectory_pair_cost() const {
-  return cost_queue_.top().second;
+  return cost_queue_.top().first.second;
 }
 
 double TrajectoryEvaluator::Evaluate(
@@ -121,31 +193,26 @@ double TrajectoryEvaluator::Evaluate(
   // 3. Cost of logitudinal collision
   // 4. Cost of lateral offsets
   // 5. Cost of lateral comfort
+  LonSamples lon_samples;
+  SampleLongitudinal(lon_trajectory, &lon_samples);
 
   // Longitudinal costs
-  double lon_objective_cost =
-      LonObjectiveCost(lon_trajectory, planning_target, reference_s_dot_);
+  double lon_objective_cost = LonObjectiveCost(
+      lon_trajectory, lon_samples, planning_target, reference_s_dot_);
 
-  double lon_jerk_cost = LonComfortCost(lon_trajectory);
+  double lon_jerk_cost = LonComfortCost(lon_samples);
 
-  double lon_collision_cost = LonCollisionCost(lon_trajectory);
+  double lon_collision_cost = LonCollisionCost(lon_samples);
 
-  double centripetal_acc_cost = CentripetalAccelerationCost(lon_trajectory);
-
-  // decides the longitudinal evaluation horizon for lateral trajectories.
-  double evaluation_horizon =
-      std::min(FLAGS_decision_horizon,
-               lon_trajectory->Evaluate(0, lon_trajectory->ParamLength()));
-  std::vector<double> s_values;
-  for (double s = 0.0; s < evaluation_horizon;
-       s += FLAGS_trajectory_space_resolution) {
-    s_values.emplace_back(s);
-  }
+  double centripetal_acc_cost = CentripetalAccelerationCost(lon_samples);
 
   // Lateral costs
-  double lat_offset_cost = LatOffsetCost(lat_trajectory, s_values);
+  Curve1dSamples lat_samples;
+  double lat_offset_cost =
+      LatOffsetCost(lat_trajectory, lon_samples.s_values, &lat_samples);
 
-  double lat_comfort_cost = LatComfortCost(lon_trajectory, lat_trajectory);
+  double lat_comfort_cost =
+      LatComfortCost(lon_samples, lat_trajectory, &lat_samples);
 
   if (cost_components != nullptr) {
     cost_components->emplace_back(lon_objective_cost);
@@ -162,14 +229,75 @@ double TrajectoryEvaluator::Evaluate(
          lat_comfort_cost * FLAGS_weight_lat_comfort;
 }
 
-double TrajectoryEvaluator::LatOffsetCost(
+void TrajectoryEvaluator::SampleLongitudinal(
+    const PtrTrajectory1d& lon_trajectory, LonSamples* lon_samples) const {
+  lon_trajectory->EvaluateBatch(time_grid_, 3, &lon_samples->time_samples);
+  lon_trajectory->EvaluateBatch(indexed_time_grid_, 1,
+                                &lon_samples->indexed_samples);
+
+  const auto& s = lon_samples->time_samples[0];
+  auto& relative_s = lon_samples->relative_s;
+  relative_s.resize(s.size());
+  for (size_t i = 0; i < s.size(); ++i) {
+    relative_s[i] = s[i] - init_s_[0];
+  }
+
+  // decides the longitudinal evaluation horizon for lateral trajectories.
+  double evaluation_horizon =
+      std::min(FLAGS_decision_horizon,
+               lon_trajectory->Evaluate(0, lon_trajectory->ParamLength()));
+  auto& s_values = lon_samples->s_values;
+  s_values.clear();
+  for (double s = 0.0; s < evaluation_horizon;
+       s += FLAGS_trajectory_space_resolution) {
+    s_values.emplace_back(s);
+  }
+}
+
+double TrajectoryEvaluator::EvaluateLongitudinal(
+    const PlanningTarget& planning_target,
+    const PtrTrajectory1d& lon_trajectory, LonSamples* lon_samples) const {
+  SampleLongitudinal(lon_trajectory, lon_samples);
+
+  double lon_objective_cost = LonObjectiveCost(
+      lon_trajectory, *lon_samples, planning_target, reference_s_dot_);
+
+  double lon_jerk_cost = LonComfortCost(*lon_samples);
+
+  double lon_collision_cost = LonCollisionCost(*lon_samples);
+
+  double centripetal_acc_cost = CentripetalAccelerationCost(*lon_samples);
+
+  // summed in the same order as in Evaluate()
+  return lon_objective_cost * FLAGS_weight_lon_objective +
+         lon_jerk_cost * FLAGS_weight_lon_jerk +
+         lon_collision_cost * FLAGS_weight_lon_collision +
+         centripetal_acc_cost * FLAGS_weight_centripetal_acceleration;
+}
+
+double TrajectoryEvaluator::EvaluateWithLongitudinalCost(
+    const double lon_cost, const LonSamples& lon_samples,
     const PtrTrajectory1d& lat_trajectory,
-    const std::vector<double>& s_values) const {
+    Curve1dSamples* lat_samples) const {
+  double lat_offset_cost =
+      LatOffsetCost(lat_trajectory, lon_samples.s_values, lat_samples);
+
+  double lat_comfort_cost =
+      LatComfortCost(lon_samples, lat_trajectory, lat_samples);
+
+  return lon_cost + lat_offset_cost * FLAGS_weight_lat_offset +
+         lat_comfort_cost * FLAGS_weight_lat_comfort;
+}
+
+double TrajectoryEvaluator::LatOffsetCost(
+    const PtrTrajectory1d& lat_trajectory, const std::vector<double>& s_values,
+    Curve1dSamples* lat_samples) const {
   double lat_offset_start = lat_trajectory->Evaluate(0, 0.0);
+  lat_trajectory->EvaluateBatch(s_values, 0, lat_samples);
+  const auto& lat_offsets = (*lat_samples)[0];
   double cost_sqr_sum = 0.0;
   double cost_abs_sum = 0.0;
-  for (const auto& s : s_values) {
-    double lat_offset = lat_trajectory->Evaluate(0, s);
+  for (const double lat_offset : lat_offsets) {
     double cost = lat_offset / FLAGS_lat_offset_bound;
     if (lat_offset * lat_offset_start < 0.0) {
       cost_sqr_sum += cost * cost * FLAGS_weight_opposite_side_offset;
@@ -183,31 +311,27 @@ double TrajectoryEvaluator::LatOffsetCost(
 }
 
 double TrajectoryEvaluator::LatComfortCost(
-    const PtrTrajectory1d& lon_trajectory,
-    const PtrTrajectory1d& lat_trajectory) const {
+    const LonSamples& lon_samples, const PtrTrajectory1d& lat_trajectory,
+    Curve1dSamples* lat_samples) const {
+  lat_trajectory->EvaluateBatch(lon_samples.relative_s, 2, lat_samples);
+  const auto& s_dots = lon_samples.time_samples[1];
+  const auto& s_dotdots = lon_samples.time_samples[2];
+  const auto& l_primes = (*lat_samples)[1];
+  const auto& l_primeprimes = (*lat_samples)[2];
   double max_cost = 0.0;
-  for (double t = 0.0; t < FLAGS_trajectory_time_length;
-       t += FLAGS_trajectory_time_resolution) {
-    double s = lon_trajectory->Evaluate(0, t);
-    double s_dot = lon_trajectory->Evaluate(1, t);
-    double s_dotdot = lon_trajectory->Evaluate(2, t);
-
-    double relative_s = s - init_s_[0];
-    double l_prime = lat_trajectory->Evaluate(1, relative_s);
-    double l_primeprime = lat_trajectory->Evaluate(2, relative_s);
-    double cost = l_primeprime * s_dot * s_dot + l_prime * s_dotdot;
+  for (size_t i = 0; i < s_dots.size(); ++i) {
+    double s_dot = s_dots[i];
+    double cost = l_primeprimes[i] * s_dot * s_dot + l_primes[i] * s_dotdots[i];
     max_cost = std::max(max_cost, std::fabs(cost));
   }
   return max_cost;
 }
 
 double TrajectoryEvaluator::LonComfortCost(
-    const PtrTrajectory1d& lon_trajectory) const {
+    const LonSamples& lon_samples) const {
   double cost_sqr_sum = 0.0;
   double cost_abs_sum = 0.0;
-  for (double t = 0.0; t < FLAGS_trajectory_time_length;
-       t += FLAGS_trajectory_time_resolution) {
-    double jerk = lon_trajectory->Evaluate(3, t);
+  for (const double jerk : lon_samples.time_samples[3]) {
     double cost = jerk / FLAGS_longitudinal_jerk_upper_bound;
     cost_sqr_sum += cost * cost;
     cost_abs_sum += std::fabs(cost);
@@ -216,18 +340,19 @@ double TrajectoryEvaluator::LonComfortCost(
 }
 
 double TrajectoryEvaluator::LonObjectiveCost(
-    const PtrTrajectory1d& lon_trajectory,
+    const PtrTrajectory1d& lon_trajectory, const LonSamples& lon_samples,
     const PlanningTarget& planning_target,
     const std::vector<double>& ref_s_dots) const {
   double t_max = lon_trajectory->ParamLength();
   double dist_s =
       lon_trajectory->Evaluate(0, t_max) - lon_trajectory->Evaluate(0, 0.0);
 
+  const auto& s_dots = lon_samples.indexed_samples[1];
   double speed_cost_sqr_sum = 0.0;
   double speed_cost_weight_sum = 0.0;
   for (size_t i = 0; i < ref_s_dots.size(); ++i) {
-    double t = static_cast<double>(i) * FLAGS_trajectory_time_resolution;
-    double cost = ref_s_dots[i] - lon_trajectory->Evaluate(1, t);
+    double t = indexed_time_grid_[i];
+    double cost = ref_s_dots[i] - s_dots[i];
     speed_cost_sqr_sum += t * t * std::fabs(cost);
     speed_cost_weight_sum += t * t;
   }
@@ -242,7 +367,8 @@ double TrajectoryEvaluator::LonObjectiveCost(
 // TODO(all): consider putting pointer of reference_line_info and frame
 // while constructing trajectory evaluator
 double TrajectoryEvaluator::LonCollisionCost(
-    const PtrTrajectory1d& lon_trajectory) const {
+    const LonSamples& lon_samples) const {
+  const auto& trajectory_s = lon_samples.indexed_samples[0];
   double cost_sqr_sum = 0.0;
   double cost_abs_sum = 0.0;
   for (size_t i = 0; i < path_time_intervals_.size(); ++i) {
@@ -250,8 +376,7 @@ double TrajectoryEvaluator::LonCollisionCost(
     if (pt_interval.empty()) {
       continue;
     }
-    double t = static_cast<double>(i) * FLAGS_trajectory_time_resolution;
-    double traj_s = lon_trajectory->Evaluate(0, t);
+    double traj_s = trajectory_s[i];
     double sigma = FLAGS_lon_collision_cost_std;
     for (const auto& m : pt_interval) {
       double dist = 0.0;
@@ -270,14 +395,15 @@ double TrajectoryEvaluator::LonCollisionCost(
 }
 
 double TrajectoryEvaluator::CentripetalAccelerationCost(
-    const PtrTrajectory1d& lon_trajectory) const {
+    const LonSamples& lon_samples) const {
   // Assumes the vehicle is not obviously deviate from the reference line.
+  const auto& s_values = lon_samples.time_samples[0];
+  const auto& v_values = lon_samples.time_samples[1];
   double centripetal_acc_sum = 0.0;
   double centripetal_acc_sqr_sum = 0.0;
-  for (double t = 0.0; t < FLAGS_trajectory_time_length;
-       t += FLAGS_trajectory_time_resolution) {
-    double s = lon_trajectory->Evaluate(0, t);
-    double v = lon_trajectory->Evaluate(1, t);
+  for (size_t i = 0; i < s_values.size(); ++i) {
+    double s = s_values[i];
+    double v = v_values[i];
     PathPoint ref_point = PathMatcher::MatchToPath(*reference_line_, s);
     CHECK(ref_point.has_kappa());
     double centripetal_acc = v * v * ref_point.kappa();
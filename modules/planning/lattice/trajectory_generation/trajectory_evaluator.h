@@ -69,27 +69,65 @@ class TrajectoryEvaluator {
   std::vector<double> top_trajectory_pair_component_cost() const;
 
  private:
+  // A longitudinal trajectory sampled once, and shared by the cost terms of
+  // all the pairs containing it.
+  struct LonSamples {
+    // s, ds, dds and jerk on time_grid_
+    Curve1dSamples time_samples;
+    // s and ds on indexed_time_grid_
+    Curve1dSamples indexed_samples;
+    // s relative to the initial s on time_grid_
+    std::vector<double> relative_s;
+    // the longitudinal stations of the lateral offset cost
+    std::vector<double> s_values;
+  };
+
   double Evaluate(const PlanningTarget& planning_target,
                   const std::shared_ptr<Curve1d>& lon_trajectory,
                   const std::shared_ptr<Curve1d>& lat_trajectory,
                   std::vector<double>* cost_components = nullptr) const;
 
+  // The weighted longitudinal part of Evaluate(), it only depends on the
+  // longitudinal trajectory and is shared by all pairs containing it.
+  double EvaluateLongitudinal(const PlanningTarget& planning_target,
+                              const std::shared_ptr<Curve1d>& lon_trajectory,
+                              LonSamples* lon_samples) const;
+
+  // Evaluate() from the shared longitudinal part, lat_samples is scratch
+  // space for sampling the lateral trajectory.
+  double EvaluateWithLongitudinalCost(
+      const double lon_cost, const LonSamples& lon_samples,
+      const std::shared_ptr<Curve1d>& lat_trajectory,
+      Curve1dSamples* lat_samples) const;
+
+  void SampleLongitudinal(const std::shared_ptr<Curve1d>& lon_trajectory,
+                          LonSamples* lon_samples) const;
+
+  void EvaluateLongitudinalTrajectories(
+      const PlanningTarget& planning_target,
+      const std::vector<std::shared_ptr<Curve1d>>& lon_trajectories,
+      const std::vector<std::shared_ptr<Curve1d>>& lat_trajectories,
+      const size_t begin, const size_t end,
+      std::vector<std::vector<double>>* costs) const;
+
   double LatOffsetCost(const std::shared_ptr<Curve1d>& lat_trajectory,
-                       const std::vector<double>& s_values) const;
+                       const std::vector<double>& s_values,
+                       Curve1dSamples* lat_samples) const;
 
-  double LatComfortCost(const std::shared_ptr<Curve1d>& lon_trajectory,
-                        const std::shared_ptr<Curve1d>& lat_trajectory) const;
+  double LatComfortCost(const LonSamples& lon_samples,
+                        const std::shared_ptr<Curve1d>& lat_trajectory,
+                        Curve1dSamples* lat_samples) const;
 
-  double LonComfortCost(const std::shared_ptr<Curve1d>& lon_trajectory) const;
+  double LonComfortCost(const LonSamples& lon_samples) const;
 
-  double LonCollisionCost(const std::shared_ptr<Curve1d>& lon_trajectory) const;
+  double LonCollisionCost(const LonSamples& lon_samples) const;
 
   double LonObjectiveCost(const std::shared_ptr<Curve1d>& lon_trajectory,
+                          const LonSamples& lon_samples,
                           const PlanningTarget& planning_target,
                           const std::vector<double>& ref_s_dot) const;
 
-  double CentripetalAccelerationCost(
-      const std::shared_ptr<Curve1d>& lon_trajectory) const;
+  double CentripetalAccelerationCost(const LonSamples& lon_samples) const;
 
   std::vector<double> ComputeLongitudinalGuideVelocity(
       const PlanningTarget& planning_target) const;
@@ -98,14 +136,25 @@ class TrajectoryEvaluator {
       const std::vector<apollo::common::SpeedPoint>& st_points, double t,
       double* traj_s) const;
 
-  struct CostComparator
-      : public std::binary_function<const PairCost&, const PairCost&, bool> {
-    bool operator()(const PairCost& left, const PairCost& right) const {
+  // pair with its cost and evaluation order
+  typedef std::pair<PairCost, size_t> IndexedPairCost;
+
+  // pairs of equal cost are ordered by evaluation order, so the ranking does
+  // not depend on how the evaluation was scheduled
+  struct CostComparator : public std::binary_function<const IndexedPairCost&,
+                                                      const IndexedPairCost&,
+                                                      bool> {
+    bool operator()(const IndexedPairCost& left,
+                    const IndexedPairCost& right) const {
+      if (left.first.second != right.first.second) {
+        return left.first.second > right.first.second;
+      }
       return left.second > right.second;
     }
   };
 
-  std::priority_queue<PairCost, std::vector<PairCost>, CostComparator>
+  std::priority_queue<IndexedPairCost, std::vector<IndexedPairCost>,
+                      CostComparator>
       cost_queue_;
 
   std::shared_ptr<PathTimeGraph> path_time_graph_;
@@ -117,6 +166,13 @@ class TrajectoryEvaluator {
   std::array<double, 3> init_s_;
 
   std::vector<double> reference_s_dot_;
+
+  // t every trajectory_time_resolution, accumulated
+  std::vector<double> time_grid_;
+
+  // t = i * trajectory_time_resolution, for reference_s_dot_ and
+  // path_time_intervals_
+  std::vector<double> indexed_time_grid_;
 };
 
 }  // namespace planning
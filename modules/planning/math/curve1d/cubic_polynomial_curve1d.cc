@@ -72,6 +72,12 @@ double CubicPolynomialCurve1d::Evaluate(const std::uint32_t order,
   }
 }
 
+void CubicPolynomialCurve1d::EvaluateBatch(
+    const std::vector<double>& params, const std::uint32_t max_order,
+    Curve1dSamples* const samples) const {
+  EvaluatePolynomial(coef_, params, max_order, samples);
+}
+
 std::string CubicPolynomialCurve1d::ToString() const {
   return apollo::common::util::StrCat(
       apollo::common::util::PrintIter(coef_, "\t"), param_, "\n");
@@ -22,6 +22,7 @@
 
 #include <array>
 #include <string>
+#include <vector>
 
 #include "modules/planning/math/curve1d/polynomial_curve1d.h"
 
@@ -49,6 +50,10 @@ class CubicPolynomialCurve1d : public PolynomialCurve1d {
 
   double Evaluate(const std::uint32_t order, const double p) const override;
 
+  void EvaluateBatch(const std::vector<double>& params,
+                     const std::uint32_t max_order,
+                     Curve1dSamples* const samples) const override;
+
   double ParamLength() const override { return param_; }
   std::string ToString() const override;
 
@@ -20,6 +20,8 @@
 
 #include "modules/planning/math/curve1d/cubic_polynomial_curve1d.h"
 
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
 
@@ -85,5 +87,23 @@ TEST(CubicPolynomialCurve1dTest, derived_from_quartic_curve) {
                 cubic_curve.Evaluate(3, value), 1e-8);
   }
 }
+TEST(CubicPolynomialCurve1dTest, EvaluateBatch) {
+  CubicPolynomialCurve1d curve(1.0, 2.0, 3.0, 5.0, 3.0);
+  std::vector<double> params;
+  for (double t = 0.0; t < 3.0; t += 0.1) {
+    params.push_back(t);
+  }
+  for (std::uint32_t max_order = 0; max_order <= 3; ++max_order) {
+    Curve1dSamples samples;
+    curve.EvaluateBatch(params, max_order, &samples);
+    for (std::uint32_t order = 0; order <= max_order; ++order) {
+      ASSERT_EQ(params.size(), samples[order].size());
+      for (size_t i = 0; i < params.size(); ++i) {
+        EXPECT_DOUBLE_EQ(curve.Evaluate(order, params[i]), samples[order][i]);
+      }
+    }
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
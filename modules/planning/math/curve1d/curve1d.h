@@ -20,11 +20,18 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace apollo {
 namespace planning {
 
+// Samples of a curve and of its first three derivatives on a grid of params:
+// samples[order][i] is the order-th derivative at the i-th param.
+typedef std::array<std::vector<double>, 4> Curve1dSamples;
+
 // Base type for various types of 1-dimensional curves
 
 class Curve1d {
@@ -36,6 +43,24 @@ class Curve1d {
   virtual double Evaluate(const std::uint32_t order,
                           const double param) const = 0;
 
+  /**
+   * @brief Evaluates the orders 0 to max_order, at most 3, at every param.
+   * (*samples)[order] is resized to params.size(); the higher orders may be
+   * used as scratch space. Curves which can evaluate a whole grid faster
+   * than one param at a time override it.
+   */
+  virtual void EvaluateBatch(const std::vector<double>& params,
+                             const std::uint32_t max_order,
+                             Curve1dSamples* const samples) const {
+    for (std::uint32_t order = 0; order <= max_order; ++order) {
+      auto& values = (*samples)[order];
+      values.resize(params.size());
+      for (size_t i = 0; i < params.size(); ++i) {
+        values[i] = Evaluate(order, params[i]);
+      }
+    }
+  }
+
   virtual double ParamLength() const = 0;
 
   virtual std::string ToString() const = 0;
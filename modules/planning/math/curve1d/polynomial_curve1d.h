@@ -20,6 +20,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 #include "modules/planning/math/curve1d/curve1d.h"
 
 namespace apollo {
@@ -34,8 +38,56 @@ class PolynomialCurve1d : public Curve1d {
   virtual size_t Order() const = 0;
 
  protected:
+  /**
+   * @brief Evaluates f = sum(coef[i] * p^i) and its derivatives up to
+   * max_order at every param by Horner's rule. The number of coefficients is
+   * known at compile time, so the loops over coefficients are unrolled and
+   * the innermost loop over params is vectorized. The results are the same as
+   * evaluating one param at a time with the same factored coefficients.
+   */
+  template <size_t N>
+  static void EvaluatePolynomial(const std::array<double, N>& coef,
+                                 const std::vector<double>& params,
+                                 const std::uint32_t max_order,
+                                 Curve1dSamples* const samples);
+
   double param_ = 0.0;
 };
 
+template <size_t N>
+void PolynomialCurve1d::EvaluatePolynomial(const std::array<double, N>& coef,
+                                           const std::vector<double>& params,
+                                           const std::uint32_t max_order,
+                                           Curve1dSamples* const samples) {
+  const size_t num_params = params.size();
+  const double* p = params.data();
+  for (std::uint32_t order = 0; order <= max_order; ++order) {
+    auto& values = (*samples)[order];
+    values.resize(num_params);
+    if (order >= N) {
+      std::fill(values.begin(), values.end(), 0.0);
+      continue;
+    }
+    // coefficients of the order-th derivative, d[i] = i!/(i - order)! * coef[i]
+    std::array<double, N> d{};
+    for (size_t i = order; i < N; ++i) {
+      double factor = 1.0;
+      for (size_t k = i - order + 1; k <= i; ++k) {
+        factor *= static_cast<double>(k);
+      }
+      d[i - order] = factor * coef[i];
+    }
+    const size_t degree = N - 1 - order;
+    double* value = values.data();
+    std::fill(values.begin(), values.end(), d[degree]);
+    for (size_t k = degree; k-- > 0;) {
+      const double c = d[k];
+      for (size_t i = 0; i < num_params; ++i) {
+        value[i] = value[i] * p[i] + c;
+      }
+    }
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
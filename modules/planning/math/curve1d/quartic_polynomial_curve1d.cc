@@ -75,6 +75,12 @@ double QuarticPolynomialCurve1d::Evaluate(const std::uint32_t order,
   }
 }
 
+void QuarticPolynomialCurve1d::EvaluateBatch(
+    const std::vector<double>& params, const std::uint32_t max_order,
+    Curve1dSamples* const samples) const {
+  EvaluatePolynomial(coef_, params, max_order, samples);
+}
+
 QuarticPolynomialCurve1d& QuarticPolynomialCurve1d::FitWithEndPointFirstOrder(
     const double x0, const double dx0, const double ddx0, const double x1,
     const double dx1, const double p) {
@@ -20,6 +20,8 @@
 
 #include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
 
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "modules/planning/math/curve1d/cubic_polynomial_curve1d.h"
 #include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
@@ -76,6 +78,23 @@ TEST(QuarticPolynomialCurve1dTest, Evaluate) {
   }
 }
 
+TEST(QuarticPolynomialCurve1dTest, EvaluateBatch) {
+  QuarticPolynomialCurve1d curve(0.0, 1.0, 0.8, 5.0, 0.0, 8.0);
+  std::vector<double> params;
+  for (double t = 0.0; t < 8.0; t += 0.1) {
+    params.push_back(t);
+  }
+  Curve1dSamples samples;
+  curve.EvaluateBatch(params, 2, &samples);
+  for (std::uint32_t order = 0; order <= 2; ++order) {
+    ASSERT_EQ(params.size(), samples[order].size());
+    for (size_t i = 0; i < params.size(); ++i) {
+      EXPECT_DOUBLE_EQ(curve.Evaluate(order, params[i]), samples[order][i]);
+    }
+  }
+  EXPECT_TRUE(samples[3].empty());
+}
+
 TEST(QuarticPolynomialCurve1dTest, IntegratedFromCubicCurve) {
   CubicPolynomialCurve1d cubic_curve(1, 2, 3, 2, 5);
   QuarticPolynomialCurve1d quartic_curve;
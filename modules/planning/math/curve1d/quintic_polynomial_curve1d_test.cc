@@ -16,6 +16,8 @@
 
 #include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
 
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
 
@@ -70,5 +72,22 @@ TEST(QuinticPolynomialCurve1dTest, IntegratedFromQuarticCurve) {
                 quintic_curve.Evaluate(4, value), 1e-8);
   }
 }
+
+TEST(QuinticPolynomialCurve1dTest, EvaluateBatch) {
+  QuinticPolynomialCurve1d curve(0.0, 1.0, 0.8, 10.0, 5.0, 0.0, 8.0);
+  std::vector<double> params;
+  for (double t = 0.0; t < 8.0; t += 0.1) {
+    params.push_back(t);
+  }
+  Curve1dSamples samples;
+  curve.EvaluateBatch(params, 3, &samples);
+  for (std::uint32_t order = 0; order <= 3; ++order) {
+    ASSERT_EQ(params.size(), samples[order].size());
+    for (size_t i = 0; i < params.size(); ++i) {
+      EXPECT_DOUBLE_EQ(curve.Evaluate(order, params[i]), samples[order][i]);
+    }
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -108,6 +108,19 @@ bool Fem1dQpProblem::OptimizeWithOsqp(
   return true;
 }
 
+void Fem1dQpProblem::ExtractSolution(const c_float* solution) {
+  x_.resize(num_of_knots_);
+  dx_.resize(num_of_knots_);
+  ddx_.resize(num_of_knots_);
+  for (size_t i = 0; i < num_of_knots_; ++i) {
+    x_.at(i) = solution[i];
+    dx_.at(i) = solution[i + num_of_knots_];
+    ddx_.at(i) = solution[i + 2 * num_of_knots_];
+  }
+  dx_.back() = 0.0;
+  ddx_.back() = 0.0;
+}
+
 void Fem1dQpProblem::SetZeroOrderBounds(
     std::vector<std::pair<double, double>> x_bounds) {
   CHECK_EQ(x_bounds.size(), num_of_knots_);
@@ -218,6 +231,25 @@ bool Fem1dQpProblem::Optimize() {
   diff = end_time3 - end_time2;
   ADEBUG << "CalculateOffset used time: " << diff.count() * 1000 << " ms.";
 
+  if (workspace_ != nullptr) {
+    OSQPSettings settings;
+    osqp_set_default_settings(&settings);
+    settings.polish = true;
+    settings.verbose = FLAGS_enable_osqp_debug;
+    workspace_->SetSettings(settings);
+    if (!workspace_->Solve(3 * num_of_knots_, lower_bounds.size(), P_data,
+                           P_indices, P_indptr, A_data, A_indices, A_indptr,
+                           q, lower_bounds, upper_bounds)) {
+      AERROR << "Failed to find solution.";
+      return false;
+    }
+    ExtractSolution(workspace_->primal_solution().data());
+    diff = std::chrono::system_clock::now() - end_time3;
+    ADEBUG << "Run OptimizeWithOsqp used time: " << diff.count() * 1000
+           << " ms.";
+    return true;
+  }
+
   OSQPData* data = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
   OSQPSettings* settings =
       reinterpret_cast<OSQPSettings*>(c_malloc(sizeof(OSQPSettings)));
@@ -240,16 +272,7 @@ bool Fem1dQpProblem::Optimize() {
   }
 
   // extract primal results
-  x_.resize(num_of_knots_);
-  dx_.resize(num_of_knots_);
-  ddx_.resize(num_of_knots_);
-  for (size_t i = 0; i < num_of_knots_; ++i) {
-    x_.at(i) = work->solution->x[i];
-    dx_.at(i) = work->solution->x[i + num_of_knots_];
-    ddx_.at(i) = work->solution->x[i + 2 * num_of_knots_];
-  }
-  dx_.back() = 0.0;
-  ddx_.back() = 0.0;
+  ExtractSolution(work->solution->x);
 
   // Cleanup
   osqp_cleanup(work);
@@ -26,6 +26,8 @@
 
 #include "osqp/include/osqp.h"
 
+#include "modules/planning/math/osqp_workspace.h"
+
 namespace apollo {
 namespace planning {
 
@@ -104,6 +106,10 @@ class Fem1dQpProblem {
 
   virtual void PreSetKernel() {}
 
+  // solve with a persistent workspace owned by the caller instead of setting
+  // up a new one in every Optimize() call
+  void SetWorkspace(OsqpWorkspace* workspace) { workspace_ = workspace; }
+
   virtual bool Optimize();
 
   const std::vector<double>& x() const { return x_; }
@@ -140,6 +146,8 @@ class Fem1dQpProblem {
       const std::vector<std::tuple<double, double, double>>& src,
       std::vector<std::pair<double, double>>* dst);
 
+  void ExtractSolution(const c_float* solution);
+
  protected:
   size_t num_of_knots_ = 0;
 
@@ -165,6 +173,8 @@ class Fem1dQpProblem {
 
   double delta_s_ = 1.0;
   double delta_s_sq_ = 1.0;
+
+  OsqpWorkspace* workspace_ = nullptr;
 };
 
 }  // namespace planning
@@ -0,0 +1,260 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/math/osqp_workspace.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// keep the upper triangular part of a square CSC matrix
+void ToUpperTriangular(const std::vector<c_float>& data,
+                       const std::vector<c_int>& indices,
+                       const std::vector<c_int>& indptr,
+                       std::vector<c_float>* triu_data,
+                       std::vector<c_int>* triu_indices,
+                       std::vector<c_int>* triu_indptr) {
+  triu_data->clear();
+  triu_indices->clear();
+  triu_indptr->clear();
+  triu_data->reserve(data.size());
+  triu_indices->reserve(indices.size());
+  triu_indptr->reserve(indptr.size());
+  triu_indptr->push_back(0);
+  for (size_t col = 0; col + 1 < indptr.size(); ++col) {
+    for (c_int k = indptr[col]; k < indptr[col + 1]; ++k) {
+      if (indices[k] <= static_cast<c_int>(col)) {
+        triu_data->push_back(data[k]);
+        triu_indices->push_back(indices[k]);
+      }
+    }
+    triu_indptr->push_back(static_cast<c_int>(triu_indices->size()));
+  }
+}
+
+bool IsSameSettings(const OSQPSettings& lhs, const OSQPSettings& rhs) {
+  return lhs.rho == rhs.rho && lhs.sigma == rhs.sigma &&
+         lhs.scaling == rhs.scaling && lhs.adaptive_rho == rhs.adaptive_rho &&
+         lhs.max_iter == rhs.max_iter && lhs.eps_abs == rhs.eps_abs &&
+         lhs.eps_rel == rhs.eps_rel && lhs.eps_prim_inf == rhs.eps_prim_inf &&
+         lhs.eps_dual_inf == rhs.eps_dual_inf && lhs.alpha == rhs.alpha &&
+         lhs.polish == rhs.polish && lhs.verbose == rhs.verbose &&
+         lhs.scaled_termination == rhs.scaled_termination &&
+         lhs.check_termination == rhs.check_termination &&
+         lhs.warm_start == rhs.warm_start;
+}
+
+}  // namespace
+
+OsqpWorkspace::OsqpWorkspace(const std::string& name) : name_(name) {
+  osqp_set_default_settings(&settings_);
+}
+
+OsqpWorkspace::~OsqpWorkspace() { Reset(); }
+
+void OsqpWorkspace::SetSettings(const OSQPSettings& settings) {
+  if (IsSameSettings(settings_, settings)) {
+    return;
+  }
+  settings_ = settings;
+  // settings are consumed by osqp_setup
+  Reset();
+}
+
+void OsqpWorkspace::Reset() {
+  if (work_ != nullptr) {
+    osqp_cleanup(work_);
+    work_ = nullptr;
+  }
+  num_var_ = 0;
+  num_constraint_ = 0;
+}
+
+bool OsqpWorkspace::IsSameStructure(const size_t num_var,
+                                    const size_t num_constraint,
+                                    const std::vector<c_int>& P_triu_indices,
+                                    const std::vector<c_int>& P_triu_indptr,
+                                    const std::vector<c_int>& A_indices,
+                                    const std::vector<c_int>& A_indptr) const {
+  return work_ != nullptr && num_var == num_var_ &&
+         num_constraint == num_constraint_ &&
+         P_triu_indices == P_triu_indices_ && P_triu_indptr == P_triu_indptr_ &&
+         A_indices == A_indices_ && A_indptr == A_indptr_;
+}
+
+bool OsqpWorkspace::Solve(const size_t num_var, const size_t num_constraint,
+                          const std::vector<c_float>& P_data,
+                          const std::vector<c_int>& P_indices,
+                          const std::vector<c_int>& P_indptr,
+                          const std::vector<c_float>& A_data,
+                          const std::vector<c_int>& A_indices,
+                          const std::vector<c_int>& A_indptr,
+                          const std::vector<c_float>& q,
+                          const std::vector<c_float>& lower_bounds,
+                          const std::vector<c_float>& upper_bounds) {
+  CHECK_EQ(P_indptr.size(), num_var + 1);
+  CHECK_EQ(A_indptr.size(), num_var + 1);
+  CHECK_EQ(q.size(), num_var);
+  CHECK_EQ(lower_bounds.size(), num_constraint);
+  CHECK_EQ(upper_bounds.size(), num_constraint);
+
+  const auto start_time = std::chrono::steady_clock::now();
+
+  std::vector<c_float> P_triu_data;
+  std::vector<c_int> P_triu_indices;
+  std::vector<c_int> P_triu_indptr;
+  ToUpperTriangular(P_data, P_indices, P_indptr, &P_triu_data,
+                    &P_triu_indices, &P_triu_indptr);
+
+  bool ready = false;
+  if (IsSameStructure(num_var, num_constraint, P_triu_indices, P_triu_indptr,
+                      A_indices, A_indptr)) {
+    ready = Update(P_triu_data, A_data, q, lower_bounds, upper_bounds);
+    if (ready) {
+      P_triu_data_ = std::move(P_triu_data);
+    } else {
+      AWARN << name_ << ": failed to update osqp workspace, set it up again.";
+    }
+  }
+  if (!ready) {
+    Reset();
+    num_var_ = num_var;
+    num_constraint_ = num_constraint;
+    P_triu_data_ = std::move(P_triu_data);
+    P_triu_indices_ = std::move(P_triu_indices);
+    P_triu_indptr_ = std::move(P_triu_indptr);
+    A_indices_ = A_indices;
+    A_indptr_ = A_indptr;
+    if (!Setup(A_data, A_indices, A_indptr, q, lower_bounds, upper_bounds)) {
+      AERROR << name_ << ": failed to set up osqp workspace.";
+      Reset();
+      return false;
+    }
+    ++stats_.num_setups;
+  }
+  if (warm_start_x_.size() == num_var_) {
+    osqp_warm_start_x(work_, warm_start_x_.data());
+  }
+  warm_start_x_.clear();
+
+  osqp_solve(work_);
+
+  const auto end_time = std::chrono::steady_clock::now();
+  const std::chrono::duration<double, std::milli> diff = end_time - start_time;
+  ++stats_.num_solves;
+  stats_.last_iterations = static_cast<int>(work_->info->iter);
+  stats_.total_iterations += stats_.last_iterations;
+  stats_.last_solve_time_ms = diff.count();
+  stats_.total_solve_time_ms += diff.count();
+  ADEBUG << name_ << ": solved in " << stats_.last_solve_time_ms << " ms, "
+         << stats_.last_iterations << " iterations, " << stats_.num_setups
+         << " setups in " << stats_.num_solves << " solves.";
+
+  if (work_->info->status_val < 0 || work_->solution == nullptr) {
+    AERROR << name_ << ": failed optimization status:\t"
+           << work_->info->status;
+    // do not warm start the next solve from a failed one
+    const std::vector<c_float> x_zeros(num_var_, 0.0);
+    const std::vector<c_float> y_zeros(num_constraint_, 0.0);
+    osqp_warm_start(work_, x_zeros.data(), y_zeros.data());
+    x_.clear();
+    return false;
+  }
+  x_.assign(work_->solution->x, work_->solution->x + num_var_);
+  return true;
+}
+
+bool OsqpWorkspace::Setup(const std::vector<c_float>& A_data,
+                          const std::vector<c_int>& A_indices,
+                          const std::vector<c_int>& A_indptr,
+                          const std::vector<c_float>& q,
+                          const std::vector<c_float>& lower_bounds,
+                          const std::vector<c_float>& upper_bounds) {
+  // osqp_setup copies the problem data, the const_casts only adapt to the
+  // non-const pointers of the csc and OSQPData structs.
+  OSQPData data;
+  data.n = static_cast<c_int>(num_var_);
+  data.m = static_cast<c_int>(num_constraint_);
+  data.P = csc_matrix(data.n, data.n, P_triu_data_.size(),
+                      P_triu_data_.data(), P_triu_indices_.data(),
+                      P_triu_indptr_.data());
+  data.q = const_cast<c_float*>(q.data());
+  data.A = csc_matrix(data.m, data.n, A_data.size(),
+                      const_cast<c_float*>(A_data.data()),
+                      const_cast<c_int*>(A_indices.data()),
+                      const_cast<c_int*>(A_indptr.data()));
+  data.l = const_cast<c_float*>(lower_bounds.data());
+  data.u = const_cast<c_float*>(upper_bounds.data());
+
+  work_ = osqp_setup(&data, &settings_);
+
+  c_free(data.A);
+  c_free(data.P);
+  return work_ != nullptr;
+}
+
+bool OsqpWorkspace::Update(const std::vector<c_float>& P_triu_data,
+                           const std::vector<c_float>& A_data,
+                           const std::vector<c_float>& q,
+                           const std::vector<c_float>& lower_bounds,
+                           const std::vector<c_float>& upper_bounds) {
+  if (osqp_update_P_A(work_, P_triu_data.data(), OSQP_NULL,
+                      static_cast<c_int>(P_triu_data.size()), A_data.data(),
+                      OSQP_NULL, static_cast<c_int>(A_data.size())) != 0) {
+    return false;
+  }
+  if (osqp_update_lin_cost(work_, q.data()) != 0) {
+    return false;
+  }
+  if (osqp_update_bounds(work_, lower_bounds.data(), upper_bounds.data()) !=
+      0) {
+    return false;
+  }
+  return true;
+}
+
+void OsqpWorkspace::ShiftWarmStart(const size_t num_blocks, const int shift) {
+  warm_start_x_.clear();
+  if (num_blocks == 0 || x_.empty() || x_.size() % num_blocks != 0) {
+    return;
+  }
+  const size_t block_size = x_.size() / num_blocks;
+  if (shift <= 0 || static_cast<size_t>(shift) >= block_size) {
+    return;
+  }
+  warm_start_x_.resize(x_.size());
+  for (size_t block = 0; block < num_blocks; ++block) {
+    const size_t offset = block * block_size;
+    for (size_t i = 0; i < block_size; ++i) {
+      const size_t src = std::min(i + shift, block_size - 1);
+      warm_start_x_[offset + i] = x_[offset + src];
+    }
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,140 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "osqp/include/osqp.h"
+
+namespace apollo {
+namespace planning {
+
+struct OsqpSolveStats {
+  int num_solves = 0;
+  // number of solves that needed a full osqp_setup (and factorization)
+  int num_setups = 0;
+  int last_iterations = 0;
+  double last_solve_time_ms = 0.0;
+  double total_solve_time_ms = 0.0;
+  int total_iterations = 0;
+};
+
+/*
+ * @brief:
+ * A persistent OSQP workspace shared by consecutive solves of QPs with the
+ * same structure, e.g. the same optimizer in consecutive planning cycles.
+ *
+ * The workspace is only set up (with a full KKT factorization) when the
+ * dimensions or the sparsity pattern of P or A change. Otherwise the matrix
+ * values and the q, l, u vectors are updated in place and OSQP warm starts
+ * from the previous solution, optionally shifted by ShiftWarmStart().
+ *
+ * Matrices are given in CSC format following the osqp naming convention.
+ * Only the upper triangular part of P is used.
+ */
+class OsqpWorkspace {
+ public:
+  explicit OsqpWorkspace(const std::string& name);
+
+  ~OsqpWorkspace();
+
+  OsqpWorkspace(const OsqpWorkspace&) = delete;
+  OsqpWorkspace& operator=(const OsqpWorkspace&) = delete;
+
+  // settings are applied when the workspace is set up
+  void SetSettings(const OSQPSettings& settings);
+
+  bool Solve(const size_t num_var, const size_t num_constraint,
+             const std::vector<c_float>& P_data,
+             const std::vector<c_int>& P_indices,
+             const std::vector<c_int>& P_indptr,
+             const std::vector<c_float>& A_data,
+             const std::vector<c_int>& A_indices,
+             const std::vector<c_int>& A_indptr,
+             const std::vector<c_float>& q,
+             const std::vector<c_float>& lower_bounds,
+             const std::vector<c_float>& upper_bounds);
+
+  /*
+   * @brief: shift the previous primal solution before the next solve. The
+   * variables are laid out in num_blocks consecutive blocks of equal size,
+   * e.g. [x, x', x''] over the same knots; each block is moved forward by
+   * shift knots and padded with its last value. A negative or too large
+   * shift keeps the unshifted solution.
+   */
+  void ShiftWarmStart(const size_t num_blocks, const int shift);
+
+  // discard the workspace, the next solve sets it up again
+  void Reset();
+
+  const std::vector<c_float>& primal_solution() const { return x_; }
+
+  const OsqpSolveStats& stats() const { return stats_; }
+
+  const std::string& name() const { return name_; }
+
+ private:
+  bool IsSameStructure(const size_t num_var, const size_t num_constraint,
+                       const std::vector<c_int>& P_triu_indices,
+                       const std::vector<c_int>& P_triu_indptr,
+                       const std::vector<c_int>& A_indices,
+                       const std::vector<c_int>& A_indptr) const;
+
+  bool Setup(const std::vector<c_float>& A_data,
+             const std::vector<c_int>& A_indices,
+             const std::vector<c_int>& A_indptr,
+             const std::vector<c_float>& q,
+             const std::vector<c_float>& lower_bounds,
+             const std::vector<c_float>& upper_bounds);
+
+  // the workspace keeps its previous P values if the update fails
+  bool Update(const std::vector<c_float>& P_triu_data,
+              const std::vector<c_float>& A_data,
+              const std::vector<c_float>& q,
+              const std::vector<c_float>& lower_bounds,
+              const std::vector<c_float>& upper_bounds);
+
+ private:
+  std::string name_;
+  OSQPSettings settings_;
+  OSQPWorkspace* work_ = nullptr;
+
+  // structure of the current workspace, P is kept upper triangular
+  size_t num_var_ = 0;
+  size_t num_constraint_ = 0;
+  std::vector<c_float> P_triu_data_;
+  std::vector<c_int> P_triu_indices_;
+  std::vector<c_int> P_triu_indptr_;
+  std::vector<c_int> A_indices_;
+  std::vector<c_int> A_indptr_;
+
+  // last primal solution
+  std::vector<c_float> x_;
+  // shifted primal solution to warm start the next solve with
+  std::vector<c_float> warm_start_x_;
+
+  OsqpSolveStats stats_;
+};
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/math/osqp_workspace.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// min 0.5 * x' * P * x + q' * x, s.t. l <= A * x <= u
+// with P = [4, 1; 1, 2] and A = [1, 1; 1, 0; 0, 1]
+class OsqpWorkspaceTest : public ::testing::Test {
+ protected:
+  bool Solve(const std::vector<c_float>& q, const std::vector<c_float>& l,
+             const std::vector<c_float>& u) {
+    return workspace_.Solve(2, 3, P_data_, P_indices_, P_indptr_, A_data_,
+                            A_indices_, A_indptr_, q, l, u);
+  }
+
+  OsqpWorkspace workspace_{"test"};
+
+  // full P, the workspace keeps the upper triangular part
+  std::vector<c_float> P_data_ = {4.0, 1.0, 1.0, 2.0};
+  std::vector<c_int> P_indices_ = {0, 1, 0, 1};
+  std::vector<c_int> P_indptr_ = {0, 2, 4};
+  std::vector<c_float> A_data_ = {1.0, 1.0, 1.0, 1.0};
+  std::vector<c_int> A_indices_ = {0, 1, 0, 2};
+  std::vector<c_int> A_indptr_ = {0, 2, 4};
+};
+
+}  // namespace
+
+TEST_F(OsqpWorkspaceTest, reuse_workspace) {
+  EXPECT_TRUE(Solve({1.0, 1.0}, {1.0, 0.0, 0.0}, {1.0, 0.7, 0.7}));
+  ASSERT_EQ(2, workspace_.primal_solution().size());
+  EXPECT_NEAR(0.3, workspace_.primal_solution()[0], 1e-2);
+  EXPECT_NEAR(0.7, workspace_.primal_solution()[1], 1e-2);
+  EXPECT_EQ(1, workspace_.stats().num_solves);
+  EXPECT_EQ(1, workspace_.stats().num_setups);
+
+  // same structure, only vectors change
+  EXPECT_TRUE(Solve({2.0, 3.0}, {2.0, -1.0, -1.0}, {2.0, 2.5, 2.5}));
+  EXPECT_NEAR(0.75, workspace_.primal_solution()[0], 1e-2);
+  EXPECT_NEAR(1.25, workspace_.primal_solution()[1], 1e-2);
+  EXPECT_EQ(2, workspace_.stats().num_solves);
+  EXPECT_EQ(1, workspace_.stats().num_setups);
+  EXPECT_GT(workspace_.stats().total_iterations, 0);
+
+  // same structure, matrix values change
+  P_data_ = {2.0, 0.5, 0.5, 1.0};
+  EXPECT_TRUE(Solve({2.0, 3.0}, {2.0, -1.0, -1.0}, {2.0, 2.5, 2.5}));
+  EXPECT_NEAR(0.75, workspace_.primal_solution()[0], 1e-2);
+  EXPECT_NEAR(1.25, workspace_.primal_solution()[1], 1e-2);
+  EXPECT_EQ(1, workspace_.stats().num_setups);
+
+  // structure changes
+  A_data_ = {1.0, 1.0, 1.0, 1.0, 1.0};
+  A_indices_ = {0, 1, 0, 1, 2};
+  A_indptr_ = {0, 2, 5};
+  EXPECT_TRUE(Solve({1.0, 1.0}, {1.0, 0.0, 0.0}, {1.0, 1.7, 0.7}));
+  EXPECT_EQ(2, workspace_.stats().num_setups);
+}
+
+TEST_F(OsqpWorkspaceTest, shift_warm_start) {
+  EXPECT_TRUE(Solve({1.0, 1.0}, {1.0, 0.0, 0.0}, {1.0, 0.7, 0.7}));
+  workspace_.ShiftWarmStart(1, 1);
+  EXPECT_TRUE(Solve({1.0, 1.0}, {1.0, 0.0, 0.0}, {1.0, 0.7, 0.7}));
+  EXPECT_NEAR(0.3, workspace_.primal_solution()[0], 1e-2);
+  EXPECT_NEAR(0.7, workspace_.primal_solution()[1], 1e-2);
+  EXPECT_EQ(1, workspace_.stats().num_setups);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -39,7 +39,7 @@ using apollo::common::time::Clock;
 using Eigen::MatrixXd;
 
 bool ActiveSetSpline1dSolver::Solve() {
-  const MatrixXd& kernel_matrix = kernel_.kernel_matrix();
+  const MatrixXd kernel_matrix = kernel_.ToDenseKernelMatrix();
   const MatrixXd& offset = kernel_.offset();
   const MatrixXd& inequality_constraint_matrix =
       constraint_.inequality_constraint().constraint_matrix();
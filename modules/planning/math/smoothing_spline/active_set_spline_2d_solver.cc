@@ -59,7 +59,7 @@ Spline2dKernel* ActiveSetSpline2dSolver::mutable_kernel() { return &kernel_; }
 Spline2d* ActiveSetSpline2dSolver::mutable_spline() { return &spline_; }
 
 bool ActiveSetSpline2dSolver::Solve() {
-  const MatrixXd& kernel_matrix = kernel_.kernel_matrix();
+  const MatrixXd kernel_matrix = kernel_.ToDenseKernelMatrix();
   const MatrixXd& offset = kernel_.offset();
   const MatrixXd& inequality_constraint_matrix =
       constraint_.inequality_constraint().constraint_matrix();
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file : block_diagonal_kernel.cc
+ **/
+
+#include "modules/planning/math/smoothing_spline/block_diagonal_kernel.h"
+
+namespace apollo {
+namespace planning {
+
+BlockDiagonalKernel::BlockDiagonalKernel(const uint32_t num_blocks,
+                                         const uint32_t block_size)
+    : num_blocks_(num_blocks),
+      block_size_(block_size),
+      blocks_(Eigen::MatrixXd::Zero(block_size, num_blocks * block_size)) {}
+
+Eigen::Block<Eigen::MatrixXd> BlockDiagonalKernel::mutable_block(
+    const uint32_t k) {
+  return blocks_.block(0, k * block_size_, block_size_, block_size_);
+}
+
+void BlockDiagonalKernel::AddToDiagonal(const double value) {
+  for (uint32_t i = 0; i < num_params(); ++i) {
+    blocks_(i % block_size_, i) += value;
+  }
+}
+
+void BlockDiagonalKernel::AddEntry(const uint32_t row, const uint32_t col,
+                                   const double value) {
+  if (row / block_size_ == col / block_size_) {
+    blocks_(row % block_size_, col) += value;
+  } else {
+    off_block_entries_.emplace_back(row, col, value);
+  }
+}
+
+bool BlockDiagonalKernel::AddKernel(const Eigen::MatrixXd& kernel,
+                                    const double weight) {
+  if (kernel.rows() != kernel.cols() ||
+      kernel.rows() != static_cast<int>(num_params())) {
+    return false;
+  }
+  for (uint32_t c = 0; c < num_params(); ++c) {
+    for (uint32_t r = 0; r < num_params(); ++r) {
+      if (kernel(r, c) != 0.0) {
+        AddEntry(r, c, kernel(r, c) * weight);
+      }
+    }
+  }
+  return true;
+}
+
+Eigen::MatrixXd BlockDiagonalKernel::ToDense(const double scale) const {
+  Eigen::MatrixXd dense = Eigen::MatrixXd::Zero(num_params(), num_params());
+  for (uint32_t k = 0; k < num_blocks_; ++k) {
+    const uint32_t offset = k * block_size_;
+    dense.block(offset, offset, block_size_, block_size_) =
+        scale * blocks_.block(0, offset, block_size_, block_size_);
+  }
+  for (const auto& entry : off_block_entries_) {
+    dense(entry.row(), entry.col()) += scale * entry.value();
+  }
+  return dense;
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,133 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file : block_diagonal_kernel.h
+ * @brief: kernel matrix of a piecewise spline, stored as one dense block per
+ *         spline segment so that it can be assembled in CSC format without a
+ *         dense intermediate.
+ **/
+
+#pragma once
+
+#include <vector>
+
+#include "Eigen/Core"
+#include "Eigen/SparseCore"
+
+namespace apollo {
+namespace planning {
+
+class BlockDiagonalKernel {
+ public:
+  BlockDiagonalKernel(const uint32_t num_blocks, const uint32_t block_size);
+
+  uint32_t num_params() const { return num_blocks_ * block_size_; }
+
+  // the k-th diagonal block, a block_size x block_size matrix
+  Eigen::Block<Eigen::MatrixXd> mutable_block(const uint32_t k);
+
+  void AddToDiagonal(const double value);
+
+  // an entry outside of the diagonal blocks is stored as a triplet
+  void AddEntry(const uint32_t row, const uint32_t col, const double value);
+
+  bool AddKernel(const Eigen::MatrixXd& kernel, const double weight);
+
+  Eigen::MatrixXd ToDense(const double scale) const;
+
+  /**
+   * @brief Assemble the upper triangular part of scale * kernel in CSC
+   * format. Every diagonal block contributes its full upper triangle, so the
+   * sparsity pattern only depends on the number and size of the blocks.
+   */
+  template <typename T, typename D>
+  void ToUpperTriangularCSC(const double scale, std::vector<T>* data,
+                            std::vector<D>* indices,
+                            std::vector<D>* indptr) const;
+
+ private:
+  uint32_t num_blocks_ = 0;
+  uint32_t block_size_ = 0;
+  // the diagonal blocks side by side, block_size x (num_blocks * block_size)
+  Eigen::MatrixXd blocks_;
+  std::vector<Eigen::Triplet<double>> off_block_entries_;
+};
+
+template <typename T, typename D>
+void BlockDiagonalKernel::ToUpperTriangularCSC(const double scale,
+                                               std::vector<T>* data,
+                                               std::vector<D>* indices,
+                                               std::vector<D>* indptr) const {
+  data->clear();
+  indices->clear();
+  indptr->clear();
+  indptr->reserve(num_params() + 1);
+
+  if (off_block_entries_.empty()) {
+    const size_t nnz = static_cast<size_t>(num_blocks_) * block_size_ *
+                       (block_size_ + 1) / 2;
+    data->reserve(nnz);
+    indices->reserve(nnz);
+    for (uint32_t k = 0; k < num_blocks_; ++k) {
+      const uint32_t offset = k * block_size_;
+      for (uint32_t c = 0; c < block_size_; ++c) {
+        indptr->push_back(static_cast<D>(data->size()));
+        for (uint32_t r = 0; r <= c; ++r) {
+          indices->push_back(static_cast<D>(offset + r));
+          data->push_back(static_cast<T>(scale * blocks_(r, offset + c)));
+        }
+      }
+    }
+    indptr->push_back(static_cast<D>(data->size()));
+    return;
+  }
+
+  // merge the few entries off the diagonal blocks into the block pattern
+  std::vector<Eigen::Triplet<double>> triplets;
+  triplets.reserve(static_cast<size_t>(num_blocks_) * block_size_ *
+                       (block_size_ + 1) / 2 +
+                   off_block_entries_.size());
+  for (uint32_t k = 0; k < num_blocks_; ++k) {
+    const uint32_t offset = k * block_size_;
+    for (uint32_t c = 0; c < block_size_; ++c) {
+      for (uint32_t r = 0; r <= c; ++r) {
+        triplets.emplace_back(offset + r, offset + c, blocks_(r, offset + c));
+      }
+    }
+  }
+  for (const auto& entry : off_block_entries_) {
+    if (entry.row() <= entry.col()) {
+      triplets.push_back(entry);
+    }
+  }
+  Eigen::SparseMatrix<double> kernel(num_params(), num_params());
+  kernel.setFromTriplets(triplets.begin(), triplets.end());
+  data->reserve(kernel.nonZeros());
+  indices->reserve(kernel.nonZeros());
+  for (int c = 0; c < kernel.outerSize(); ++c) {
+    indptr->push_back(static_cast<D>(data->size()));
+    for (Eigen::SparseMatrix<double>::InnerIterator it(kernel, c); it; ++it) {
+      indices->push_back(static_cast<D>(it.row()));
+      data->push_back(static_cast<T>(scale * it.value()));
+    }
+  }
+  indptr->push_back(static_cast<D>(data->size()));
+}
+
+}  // namespace planning
+}  // namespace apollo
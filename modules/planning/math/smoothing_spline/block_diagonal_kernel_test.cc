@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+#include "modules/planning/math/smoothing_spline/block_diagonal_kernel.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+Eigen::MatrixXd CSCToDense(const int num_params,
+                           const std::vector<double>& data,
+                           const std::vector<int>& indices,
+                           const std::vector<int>& indptr) {
+  Eigen::MatrixXd dense = Eigen::MatrixXd::Zero(num_params, num_params);
+  EXPECT_EQ(num_params + 1, static_cast<int>(indptr.size()));
+  for (int c = 0; c < num_params; ++c) {
+    for (int i = indptr[c]; i < indptr[c + 1]; ++i) {
+      dense(indices[i], c) += data[i];
+    }
+  }
+  return dense;
+}
+
+}  // namespace
+
+TEST(BlockDiagonalKernel, ToDense) {
+  BlockDiagonalKernel kernel(3, 2);
+  EXPECT_EQ(6, kernel.num_params());
+  auto block = kernel.mutable_block(1);
+  block << 1.0, 2.0, 2.0, 3.0;
+  kernel.AddToDiagonal(0.5);
+  kernel.AddEntry(5, 5, 1.0);
+  kernel.AddEntry(0, 4, 7.0);
+
+  const Eigen::MatrixXd dense = kernel.ToDense(2.0);
+  Eigen::MatrixXd ref_dense = Eigen::MatrixXd::Zero(6, 6);
+  // clang-format off
+  ref_dense <<
+      1.0, 0.0, 0.0, 0.0, 14.0, 0.0,
+      0.0, 1.0, 0.0, 0.0,  0.0, 0.0,
+      0.0, 0.0, 3.0, 4.0,  0.0, 0.0,
+      0.0, 0.0, 4.0, 7.0,  0.0, 0.0,
+      0.0, 0.0, 0.0, 0.0,  1.0, 0.0,
+      0.0, 0.0, 0.0, 0.0,  0.0, 3.0;
+  // clang-format on
+  for (int r = 0; r < 6; ++r) {
+    for (int c = 0; c < 6; ++c) {
+      EXPECT_DOUBLE_EQ(ref_dense(r, c), dense(r, c));
+    }
+  }
+}
+
+TEST(BlockDiagonalKernel, ToUpperTriangularCSC) {
+  BlockDiagonalKernel kernel(4, 3);
+  for (uint32_t k = 0; k < 4; ++k) {
+    Eigen::MatrixXd symmetric = Eigen::MatrixXd::Random(3, 3);
+    kernel.mutable_block(k) += symmetric + symmetric.transpose();
+  }
+  kernel.AddToDiagonal(1.0);
+
+  std::vector<double> data;
+  std::vector<int> indices;
+  std::vector<int> indptr;
+  kernel.ToUpperTriangularCSC(2.0, &data, &indices, &indptr);
+  // the full upper triangle of every block
+  EXPECT_EQ(4 * 6, data.size());
+  Eigen::MatrixXd ref_dense = kernel.ToDense(2.0);
+  Eigen::MatrixXd dense = CSCToDense(12, data, indices, indptr);
+  Eigen::MatrixXd ref_upper = ref_dense.triangularView<Eigen::Upper>();
+  EXPECT_TRUE(dense.isApprox(ref_upper));
+
+  // entries off the diagonal blocks are merged into the pattern
+  Eigen::MatrixXd extra = Eigen::MatrixXd::Zero(12, 12);
+  extra(1, 7) = 3.0;
+  extra(7, 1) = 3.0;
+  extra(2, 2) = 1.5;
+  EXPECT_TRUE(kernel.AddKernel(extra, 2.0));
+  kernel.ToUpperTriangularCSC(1.0, &data, &indices, &indptr);
+  EXPECT_EQ(4 * 6 + 1, data.size());
+  ref_dense = kernel.ToDense(1.0);
+  dense = CSCToDense(12, data, indices, indptr);
+  ref_upper = ref_dense.triangularView<Eigen::Upper>();
+  EXPECT_TRUE(dense.isApprox(ref_upper));
+  EXPECT_DOUBLE_EQ(6.0, dense(1, 7));
+  for (int c = 0; c < 12; ++c) {
+    for (int i = indptr[c]; i + 1 < indptr[c + 1]; ++i) {
+      EXPECT_LT(indices[i], indices[i + 1]);
+    }
+  }
+
+  EXPECT_FALSE(kernel.AddKernel(Eigen::MatrixXd::Zero(3, 3), 1.0));
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -35,59 +35,40 @@ using Eigen::MatrixXd;
 OsqpSpline1dSolver::OsqpSpline1dSolver(const std::vector<double>& x_knots,
                                        const uint32_t order)
     : Spline1dSolver(x_knots, order) {
-  // Problem settings
-  settings_ = reinterpret_cast<OSQPSettings*>(c_malloc(sizeof(OSQPSettings)));
-
   // Define Solver settings as default
-  osqp_set_default_settings(settings_);
-  settings_->alpha = 1.0;  // Change alpha parameter
-  settings_->eps_abs = 1.0e-03;
-  settings_->eps_rel = 1.0e-03;
-  settings_->max_iter = 5000;
-  // settings_->polish = true;
-  settings_->verbose = FLAGS_enable_osqp_debug;
-  settings_->warm_start = true;
-
-  // Populate data
-  data_ = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
+  OSQPSettings settings;
+  osqp_set_default_settings(&settings);
+  settings.alpha = 1.0;  // Change alpha parameter
+  settings.eps_abs = 1.0e-03;
+  settings.eps_rel = 1.0e-03;
+  settings.max_iter = 5000;
+  // settings.polish = true;
+  settings.verbose = FLAGS_enable_osqp_debug;
+  settings.warm_start = true;
+  workspace_.SetSettings(settings);
 }
 
 OsqpSpline1dSolver::~OsqpSpline1dSolver() { CleanUp(); }
 
-void OsqpSpline1dSolver::CleanUp() {
-  osqp_cleanup(work_);
-  if (data_ != nullptr) {
-    c_free(data_->A);
-    c_free(data_->P);
-    c_free(data_);
-  }
-  if (settings_ != nullptr) {
-    c_free(settings_);
-  }
-}
+void OsqpSpline1dSolver::CleanUp() { workspace_.Reset(); }
 
-void OsqpSpline1dSolver::ResetOsqp() {
-  // Problem settings
-  settings_ = reinterpret_cast<OSQPSettings*>(c_malloc(sizeof(OSQPSettings)));
-  // Populate data
-  data_ = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
-}
+void OsqpSpline1dSolver::ResetOsqp() { workspace_.Reset(); }
 
 bool OsqpSpline1dSolver::Solve() {
   // Namings here are following osqp convention.
   // For details, visit: https://osqp.org/docs/examples/demo.html
 
-  // change P to csc format
-  const MatrixXd& P = kernel_.kernel_matrix();
-  ADEBUG << "P: " << P.rows() << ", " << P.cols();
-  if (P.rows() == 0) {
+  // change P to csc format, straight from the segment blocks of the kernel
+  const int num_param = static_cast<int>(kernel_.num_params());
+  ADEBUG << "P: " << num_param << ", " << num_param;
+  if (num_param == 0) {
     return false;
   }
 
   std::vector<c_float> P_data;
   std::vector<c_int> P_indices;
   std::vector<c_int> P_indptr;
-  DenseToCSCMatrix(P, &P_data, &P_indices, &P_indptr);
+  kernel_.KernelMatrixToUpperTriangularCSC(&P_data, &P_indices, &P_indptr);
 
   // change A to csc format
   const MatrixXd& inequality_constraint_matrix =
@@ -110,10 +91,7 @@ bool OsqpSpline1dSolver::Solve() {
 
   // set q, l, u: l < A < u
   const MatrixXd& q_eigen = kernel_.offset();
-  c_float q[q_eigen.rows()];  // NOLINT
-  for (int i = 0; i < q_eigen.size(); ++i) {
-    q[i] = q_eigen(i);
-  }
+  std::vector<c_float> q(q_eigen.data(), q_eigen.data() + q_eigen.size());
 
   const MatrixXd& inequality_constraint_boundary =
       constraint_.inequality_constraint().constraint_boundary();
@@ -125,8 +103,8 @@ bool OsqpSpline1dSolver::Solve() {
 
   constexpr double kEpsilon = 1e-9;
   constexpr float kUpperLimit = 1e9;
-  c_float l[constraint_num];  // NOLINT
-  c_float u[constraint_num];  // NOLINT
+  std::vector<c_float> l(constraint_num);
+  std::vector<c_float> u(constraint_num);
   for (int i = 0; i < constraint_num; ++i) {
     if (i < inequality_constraint_boundary.rows()) {
       l[i] = inequality_constraint_boundary(i, 0);
@@ -139,28 +117,23 @@ bool OsqpSpline1dSolver::Solve() {
     }
   }
 
-  data_->n = P.rows();
-  data_->m = constraint_num;
-  data_->P = csc_matrix(data_->n, data_->n, P_data.size(), P_data.data(),
-                        P_indices.data(), P_indptr.data());
-  data_->q = q;
-  data_->A = csc_matrix(data_->m, data_->n, A_data.size(), A_data.data(),
-                        A_indices.data(), A_indptr.data());
-  data_->l = l;
-  data_->u = u;
+  // Solve Problem, the workspace is only set up when the structure changes
+  const bool success =
+      workspace_.Solve(num_param, constraint_num, P_data, P_indices, P_indptr,
+                       A_data, A_indices, A_indptr, q, l, u);
 
-  work_ = osqp_setup(data_, settings_);
-
-  // Solve Problem
-  osqp_solve(work_);
-
-  MatrixXd solved_params = MatrixXd::Zero(P.rows(), 1);
-  for (int i = 0; i < P.rows(); ++i) {
-    solved_params(i, 0) = work_->solution->x[i];
+  last_num_param_ = num_param;
+  last_num_constraint_ = constraint_num;
+  if (!success) {
+    AERROR << "osqp spline 1d solver failed.";
+    return false;
   }
 
-  last_num_param_ = static_cast<int>(P.rows());
-  last_num_constraint_ = constraint_num;
+  const std::vector<c_float>& x = workspace_.primal_solution();
+  MatrixXd solved_params = MatrixXd::Zero(num_param, 1);
+  for (int i = 0; i < num_param; ++i) {
+    solved_params(i, 0) = x[i];
+  }
 
   return spline_.SetSplineSegs(solved_params, spline_.spline_order());
 }
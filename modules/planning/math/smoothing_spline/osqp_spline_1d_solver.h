@@ -22,9 +22,8 @@
 
 #include <vector>
 
-#include "osqp/include/osqp.h"
-
 #include "modules/common/math/qp_solver/qp_solver.h"
+#include "modules/planning/math/osqp_workspace.h"
 #include "modules/planning/math/smoothing_spline/spline_1d_solver.h"
 
 namespace apollo {
@@ -37,14 +36,15 @@ class OsqpSpline1dSolver : public Spline1dSolver {
 
   bool Solve() override;
 
+  // release the osqp workspace
   void CleanUp();
 
+  // force the next solve to set up the osqp workspace again
   void ResetOsqp();
 
  private:
-  OSQPSettings* settings_ = nullptr;
-  OSQPWorkspace* work_ = nullptr;  // Workspace
-  OSQPData* data_ = nullptr;       // OSQPData
+  // kept across solves so that problems of the same structure skip setup
+  OsqpWorkspace workspace_{"OsqpSpline1d"};
 };
 
 }  // namespace planning
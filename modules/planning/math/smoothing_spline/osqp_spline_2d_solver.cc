@@ -60,17 +60,17 @@ bool OsqpSpline2dSolver::Solve() {
   // Namings here are following osqp convention.
   // For details, visit: https://osqp.org/docs/examples/demo.html
 
-  // change P to csc format
-  const MatrixXd& P = kernel_.kernel_matrix();
-  ADEBUG << "P: " << P.rows() << ", " << P.cols();
-  if (P.rows() == 0) {
+  // change P to csc format, straight from the segment blocks of the kernel
+  const int num_param = static_cast<int>(kernel_.num_params());
+  ADEBUG << "P: " << num_param << ", " << num_param;
+  if (num_param == 0) {
     return false;
   }
 
   std::vector<c_float> P_data;
   std::vector<c_int> P_indices;
   std::vector<c_int> P_indptr;
-  DenseToCSCMatrix(P, &P_data, &P_indices, &P_indptr);
+  kernel_.KernelMatrixToUpperTriangularCSC(&P_data, &P_indices, &P_indptr);
 
   // change A to csc format
   const MatrixXd& inequality_constraint_matrix =
@@ -93,10 +93,7 @@ bool OsqpSpline2dSolver::Solve() {
 
   // set q, l, u: l < A < u
   const MatrixXd& q_eigen = kernel_.offset();
-  c_float q[q_eigen.rows()];  // NOLINT
-  for (int i = 0; i < q_eigen.size(); ++i) {
-    q[i] = q_eigen(i);
-  }
+  std::vector<c_float> q(q_eigen.data(), q_eigen.data() + q_eigen.size());
 
   const MatrixXd& inequality_constraint_boundary =
       constraint_.inequality_constraint().constraint_boundary();
@@ -108,8 +105,8 @@ bool OsqpSpline2dSolver::Solve() {
 
   constexpr float kEpsilon = 1e-9f;
   constexpr float kUpperLimit = 1e9f;
-  c_float l[constraint_num];  // NOLINT
-  c_float u[constraint_num];  // NOLINT
+  std::vector<c_float> l(constraint_num);
+  std::vector<c_float> u(constraint_num);
   for (int i = 0; i < constraint_num; ++i) {
     if (i < inequality_constraint_boundary.rows()) {
       l[i] = inequality_constraint_boundary(i, 0);
@@ -121,51 +118,35 @@ bool OsqpSpline2dSolver::Solve() {
     }
   }
 
-  // Problem settings
-  OSQPSettings* settings =
-      reinterpret_cast<OSQPSettings*>(c_malloc(sizeof(OSQPSettings)));
-
-  // Populate data
-  OSQPData* data = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
-  data->n = P.rows();
-  data->m = constraint_num;
-  data->P = csc_matrix(data->n, data->n, P_data.size(), P_data.data(),
-                       P_indices.data(), P_indptr.data());
-  data->q = q;
-  data->A = csc_matrix(data->m, data->n, A_data.size(), A_data.data(),
-                       A_indices.data(), A_indptr.data());
-  data->l = l;
-  data->u = u;
-
   // Define Solver settings as default
-  osqp_set_default_settings(settings);
-  settings->alpha = 1.0;  // Change alpha parameter
-  settings->eps_abs = 1.0e-05;
-  settings->eps_rel = 1.0e-05;
-  settings->max_iter = 5000;
-  settings->polish = true;
-  settings->verbose = FLAGS_enable_osqp_debug;
-
-  // Setup workspace
-  OSQPWorkspace* work = osqp_setup(data, settings);
-
-  // Solve Problem
-  osqp_solve(work);
-
-  MatrixXd solved_params = MatrixXd::Zero(P.rows(), 1);
-  for (int i = 0; i < P.rows(); ++i) {
-    solved_params(i, 0) = work->solution->x[i];
-  }
-
-  last_num_param_ = static_cast<int>(P.rows());
+  OSQPSettings settings;
+  osqp_set_default_settings(&settings);
+  settings.alpha = 1.0;  // Change alpha parameter
+  settings.eps_abs = 1.0e-05;
+  settings.eps_rel = 1.0e-05;
+  settings.max_iter = 5000;
+  settings.polish = true;
+  settings.verbose = FLAGS_enable_osqp_debug;
+  workspace_.SetSettings(settings);
+
+  // Solve Problem, the workspace is only set up when the structure changes
+  const bool success =
+      workspace_.Solve(num_param, constraint_num, P_data, P_indices, P_indptr,
+                       A_data, A_indices, A_indptr, q, l, u);
+
+  last_num_param_ = num_param;
   last_num_constraint_ = static_cast<int>(constraint_num);
+  last_problem_success_ = success;
+  if (!success) {
+    AERROR << "osqp spline 2d solver failed.";
+    return false;
+  }
 
-  // Cleanup
-  osqp_cleanup(work);
-  c_free(data->A);
-  c_free(data->P);
-  c_free(data);
-  c_free(settings);
+  const std::vector<c_float>& x = workspace_.primal_solution();
+  MatrixXd solved_params = MatrixXd::Zero(num_param, 1);
+  for (int i = 0; i < num_param; ++i) {
+    solved_params(i, 0) = x[i];
+  }
 
   return spline_.set_splines(solved_params, spline_.spline_order());
 }
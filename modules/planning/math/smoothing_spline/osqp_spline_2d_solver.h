@@ -23,8 +23,8 @@
 #include <vector>
 
 #include "gtest/gtest_prod.h"
-#include "osqp/include/osqp.h"
 
+#include "modules/planning/math/osqp_workspace.h"
 #include "modules/planning/math/smoothing_spline/spline_2d.h"
 #include "modules/planning/math/smoothing_spline/spline_2d_solver.h"
 
@@ -52,9 +52,8 @@ class OsqpSpline2dSolver final : public Spline2dSolver {
   FRIEND_TEST(OSQPSolverTest, basic_test);
 
  private:
-  OSQPSettings* osqp_settings_ = nullptr;
-  OSQPWorkspace* work_ = nullptr;  // Workspace
-  OSQPData* data_ = nullptr;       // OSQPData
+  // kept across solves so that problems of the same structure skip setup
+  OsqpWorkspace workspace_{"OsqpSpline2d"};
 
   int last_num_constraint_ = 0;
   int last_num_param_ = 0;
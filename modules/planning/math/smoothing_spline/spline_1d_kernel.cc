@@ -35,30 +35,26 @@ Spline1dKernel::Spline1dKernel(const Spline1d& spline1d)
 
 Spline1dKernel::Spline1dKernel(const std::vector<double>& x_knots,
                                const uint32_t spline_order)
-    : x_knots_(x_knots), spline_order_(spline_order) {
-  total_params_ =
-      (static_cast<uint32_t>(x_knots.size()) > 1
-           ? (static_cast<uint32_t>(x_knots.size()) - 1) * (1 + spline_order_)
-           : 0);
-  kernel_matrix_ = Eigen::MatrixXd::Zero(total_params_, total_params_);
+    : kernel_(x_knots.size() > 1 ? static_cast<uint32_t>(x_knots.size()) - 1
+                                 : 0,
+              spline_order + 1),
+      x_knots_(x_knots),
+      spline_order_(spline_order) {
+  total_params_ = kernel_.num_params();
   offset_ = Eigen::MatrixXd::Zero(total_params_, 1);
 }
 
 void Spline1dKernel::AddRegularization(const double regularized_param) {
-  Eigen::MatrixXd id_matrix =
-      Eigen::MatrixXd::Identity(kernel_matrix_.rows(), kernel_matrix_.cols());
-  kernel_matrix_ += 2.0 * id_matrix * regularized_param;
+  kernel_.AddToDiagonal(2.0 * regularized_param);
 }
 
 bool Spline1dKernel::AddKernel(const Eigen::MatrixXd& kernel,
                                const Eigen::MatrixXd& offset,
                                const double weight) {
-  if (kernel.rows() != kernel.cols() ||
-      kernel.rows() != kernel_matrix_.rows() || offset.cols() != 1 ||
-      offset.rows() != offset_.rows()) {
+  if (offset.cols() != 1 || offset.rows() != offset_.rows() ||
+      !kernel_.AddKernel(kernel, weight)) {
     return false;
   }
-  kernel_matrix_ += kernel * weight;
   offset_ += offset * weight;
   return true;
 }
@@ -69,14 +65,15 @@ bool Spline1dKernel::AddKernel(const Eigen::MatrixXd& kernel,
   return AddKernel(kernel, offset, weight);
 }
 
-Eigen::MatrixXd* Spline1dKernel::mutable_kernel_matrix() {
-  return &kernel_matrix_;
+void Spline1dKernel::AddKernelEntry(const uint32_t row, const uint32_t col,
+                                    const double value) {
+  kernel_.AddEntry(row, col, value);
 }
 
 Eigen::MatrixXd* Spline1dKernel::mutable_offset() { return &offset_; }
 
-const Eigen::MatrixXd& Spline1dKernel::kernel_matrix() const {
-  return kernel_matrix_;
+Eigen::MatrixXd Spline1dKernel::ToDenseKernelMatrix() const {
+  return kernel_.ToDense(1.0);
 }
 
 const Eigen::MatrixXd& Spline1dKernel::offset() const { return offset_; }
@@ -84,15 +81,10 @@ const Eigen::MatrixXd& Spline1dKernel::offset() const { return offset_; }
 // build-in kernel methods
 void Spline1dKernel::AddNthDerivativekernelMatrix(const uint32_t n,
                                                   const double weight) {
-  const uint32_t num_params = spline_order_ + 1;
   for (uint32_t i = 0; i + 1 < x_knots_.size(); ++i) {
-    Eigen::MatrixXd cur_kernel =
-        2 *
-        SplineSegKernel::Instance()->NthDerivativeKernel(
-            n, num_params, x_knots_[i + 1] - x_knots_[i]) *
-        weight;
-    kernel_matrix_.block(i * num_params, i * num_params, num_params,
-                         num_params) += cur_kernel;
+    SplineSegKernel::Instance()->AddNthDerivativeKernel(
+        n, x_knots_[i + 1] - x_knots_[i], 2.0 * weight,
+        kernel_.mutable_block(i));
   }
 }
 
@@ -116,14 +108,8 @@ void Spline1dKernel::AddNthDerivativekernelMatrixForSplineK(
            << k;
     return;
   }
-  const uint32_t num_params = spline_order_ + 1;
-  Eigen::MatrixXd cur_kernel =
-      2 *
-      SplineSegKernel::Instance()->NthDerivativeKernel(
-          n, num_params, x_knots_[k + 1] - x_knots_[k]) *
-      weight;
-  kernel_matrix_.block(k * num_params, k * num_params, num_params,
-                       num_params) += cur_kernel;
+  SplineSegKernel::Instance()->AddNthDerivativeKernel(
+      n, x_knots_[k + 1] - x_knots_[k], 2.0 * weight, kernel_.mutable_block(k));
 }
 
 void Spline1dKernel::AddDerivativeKernelMatrixForSplineK(const uint32_t k,
@@ -149,6 +135,8 @@ bool Spline1dKernel::AddReferenceLineKernelMatrix(
   }
 
   const uint32_t num_params = spline_order_ + 1;
+  std::vector<double> power_x;
+  power_x.reserve(2 * num_params);
   for (size_t i = 0; i < x_coord.size(); ++i) {
     auto cur_index = FindIndex(x_coord[i]);
     double cur_rel_x = x_coord[i] - x_knots_[cur_index];
@@ -159,23 +147,19 @@ bool Spline1dKernel::AddReferenceLineKernelMatrix(
       offset_coef *= cur_rel_x;
     }
     // update kernel matrix
-    Eigen::MatrixXd ref_kernel(num_params, num_params);
-
+    power_x.clear();
     double cur_x = 1.0;
-    std::vector<double> power_x;
     for (uint32_t n = 0; n + 1 < 2 * num_params; ++n) {
       power_x.emplace_back(cur_x);
       cur_x *= cur_rel_x;
     }
 
-    for (uint32_t r = 0; r < num_params; ++r) {
-      for (uint32_t c = 0; c < num_params; ++c) {
-        ref_kernel(r, c) = 2.0 * power_x[r + c];
+    auto ref_kernel = kernel_.mutable_block(cur_index);
+    for (uint32_t c = 0; c < num_params; ++c) {
+      for (uint32_t r = 0; r < num_params; ++r) {
+        ref_kernel(r, c) += 2.0 * weight * power_x[r + c];
       }
     }
-
-    kernel_matrix_.block(cur_index * num_params, cur_index * num_params,
-                         num_params, num_params) += weight * ref_kernel;
   }
   return true;
 }
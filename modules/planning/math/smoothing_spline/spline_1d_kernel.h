@@ -26,6 +26,7 @@
 
 #include "Eigen/Core"
 
+#include "modules/planning/math/smoothing_spline/block_diagonal_kernel.h"
 #include "modules/planning/math/smoothing_spline/spline_1d.h"
 
 namespace apollo {
@@ -42,13 +43,26 @@ class Spline1dKernel {
   bool AddKernel(const Eigen::MatrixXd& kernel, const Eigen::MatrixXd& offset,
                  const double weight);
   bool AddKernel(const Eigen::MatrixXd& kernel, const double weight);
+  void AddKernelEntry(const uint32_t row, const uint32_t col,
+                      const double value);
 
-  Eigen::MatrixXd* mutable_kernel_matrix();
   Eigen::MatrixXd* mutable_offset();
 
-  const Eigen::MatrixXd& kernel_matrix() const;
+  uint32_t num_params() const { return total_params_; }
+
+  // dense kernel matrix, assembled from the segment blocks on every call
+  Eigen::MatrixXd ToDenseKernelMatrix() const;
   const Eigen::MatrixXd& offset() const;
 
+  // upper triangular part of the kernel matrix in CSC format, assembled from
+  // the segment blocks without a dense intermediate
+  template <typename T, typename D>
+  void KernelMatrixToUpperTriangularCSC(std::vector<T>* data,
+                                        std::vector<D>* indices,
+                                        std::vector<D>* indptr) const {
+    kernel_.ToUpperTriangularCSC(1.0, data, indices, indptr);
+  }
+
   // build-in kernel methods
   void AddDerivativeKernelMatrix(const double weight);
   void AddSecondOrderDerivativeMatrix(const double weight);
@@ -78,7 +92,7 @@ class Spline1dKernel {
   uint32_t FindIndex(const double x) const;
 
  private:
-  Eigen::MatrixXd kernel_matrix_;
+  BlockDiagonalKernel kernel_;
   Eigen::MatrixXd offset_;
   std::vector<double> x_knots_;
   uint32_t spline_order_;
@@ -33,8 +33,9 @@ TEST(Spline1dKernel, add_regularization) {
   kernel.AddRegularization(0.2);
 
   const uint32_t num_params = spline_order + 1;
-  EXPECT_EQ(kernel.kernel_matrix().rows(), kernel.kernel_matrix().cols());
-  EXPECT_EQ(kernel.kernel_matrix().rows(), num_params * (x_knots.size() - 1));
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  EXPECT_EQ(kernel_matrix.rows(), kernel_matrix.cols());
+  EXPECT_EQ(kernel_matrix.rows(), num_params * (x_knots.size() - 1));
   Eigen::MatrixXd ref_kernel_matrix = Eigen::MatrixXd::Zero(12, 12);
   // clang-format off
   ref_kernel_matrix <<
@@ -53,9 +54,9 @@ TEST(Spline1dKernel, add_regularization) {
   // clang-format on
   ref_kernel_matrix *= 2.0;
 
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
-      EXPECT_DOUBLE_EQ(kernel.kernel_matrix()(i, j), ref_kernel_matrix(i, j));
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
+      EXPECT_DOUBLE_EQ(kernel_matrix(i, j), ref_kernel_matrix(i, j));
     }
   }
 
@@ -77,8 +78,9 @@ TEST(Spline1dKernel, add_derivative_kernel_matrix_01) {
   kernel.AddDerivativeKernelMatrix(1.0);
 
   const uint32_t num_params = spline_order + 1;
-  EXPECT_EQ(kernel.kernel_matrix().rows(), kernel.kernel_matrix().cols());
-  EXPECT_EQ(kernel.kernel_matrix().rows(), num_params * (x_knots.size() - 1));
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  EXPECT_EQ(kernel_matrix.rows(), kernel_matrix.cols());
+  EXPECT_EQ(kernel_matrix.rows(), num_params * (x_knots.size() - 1));
   Eigen::MatrixXd ref_kernel_matrix = Eigen::MatrixXd::Zero(6, 6);
 
   // clang-format off
@@ -92,9 +94,9 @@ TEST(Spline1dKernel, add_derivative_kernel_matrix_01) {
   // clang-format on
   ref_kernel_matrix *= 2.0;
 
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
-      EXPECT_NEAR(kernel.kernel_matrix()(i, j), ref_kernel_matrix(i, j), 1e-5);
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
+      EXPECT_NEAR(kernel_matrix(i, j), ref_kernel_matrix(i, j), 1e-5);
     }
   }
 
@@ -116,8 +118,9 @@ TEST(Spline1dKernel, add_derivative_kernel_matrix_02) {
   kernel.AddDerivativeKernelMatrix(1.0);
 
   const uint32_t num_params = spline_order + 1;
-  EXPECT_EQ(kernel.kernel_matrix().rows(), kernel.kernel_matrix().cols());
-  EXPECT_EQ(kernel.kernel_matrix().rows(), num_params * (x_knots.size() - 1));
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  EXPECT_EQ(kernel_matrix.rows(), kernel_matrix.cols());
+  EXPECT_EQ(kernel_matrix.rows(), num_params * (x_knots.size() - 1));
   Eigen::MatrixXd ref_kernel_matrix = Eigen::MatrixXd::Zero(
       num_params * (x_knots.size() - 1), num_params * (x_knots.size() - 1));
 
@@ -138,9 +141,9 @@ TEST(Spline1dKernel, add_derivative_kernel_matrix_02) {
   // clang-format on
   ref_kernel_matrix *= 2.0;
 
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
-      EXPECT_NEAR(kernel.kernel_matrix()(i, j), ref_kernel_matrix(i, j), 1e-5);
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
+      EXPECT_NEAR(kernel_matrix(i, j), ref_kernel_matrix(i, j), 1e-5);
     }
   }
 
@@ -161,8 +164,9 @@ TEST(Spline1dKernel, add_derivative_kernel_matrix_03) {
   Spline1dKernel kernel(x_knots, spline_order);
   kernel.AddDerivativeKernelMatrix(1.0);
 
-  EXPECT_EQ(kernel.kernel_matrix().rows(), kernel.kernel_matrix().cols());
-  EXPECT_EQ(kernel.kernel_matrix().rows(), 6 * (x_knots.size() - 1));
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  EXPECT_EQ(kernel_matrix.rows(), kernel_matrix.cols());
+  EXPECT_EQ(kernel_matrix.rows(), 6 * (x_knots.size() - 1));
   Eigen::MatrixXd ref_kernel_matrix = Eigen::MatrixXd::Zero(6, 6);
 
   // clang-format off
@@ -176,10 +180,10 @@ TEST(Spline1dKernel, add_derivative_kernel_matrix_03) {
   // clang-format on
   ref_kernel_matrix *= 2.0;
 
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
       double param = std::pow(0.5, i + j - 1);
-      EXPECT_NEAR(kernel.kernel_matrix()(i, j), param * ref_kernel_matrix(i, j),
+      EXPECT_NEAR(kernel_matrix(i, j), param * ref_kernel_matrix(i, j),
                   1e-5);
     }
   }
@@ -201,8 +205,9 @@ TEST(Spline1dKernel, add_derivative_kernel_matrix_04) {
   Spline1dKernel kernel(x_knots, spline_order);
   kernel.AddDerivativeKernelMatrix(1.0);
 
-  EXPECT_EQ(kernel.kernel_matrix().rows(), kernel.kernel_matrix().cols());
-  EXPECT_EQ(kernel.kernel_matrix().rows(), 4 * (x_knots.size() - 1));
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  EXPECT_EQ(kernel_matrix.rows(), kernel_matrix.cols());
+  EXPECT_EQ(kernel_matrix.rows(), 4 * (x_knots.size() - 1));
   Eigen::MatrixXd ref_kernel_matrix = Eigen::MatrixXd::Zero(4, 4);
 
   // clang-format off
@@ -214,9 +219,9 @@ TEST(Spline1dKernel, add_derivative_kernel_matrix_04) {
   // clang-format on
   ref_kernel_matrix *= 2.0;
 
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
-      EXPECT_NEAR(kernel.kernel_matrix()(i, j), ref_kernel_matrix(i, j), 1e-5);
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
+      EXPECT_NEAR(kernel_matrix(i, j), ref_kernel_matrix(i, j), 1e-5);
     }
   }
 
@@ -237,8 +242,9 @@ TEST(Spline1dKernel, add_second_derivative_kernel_matrix_01) {
   Spline1dKernel kernel(x_knots, spline_order);
   kernel.AddSecondOrderDerivativeMatrix(1.0);
 
-  EXPECT_EQ(kernel.kernel_matrix().rows(), kernel.kernel_matrix().cols());
-  EXPECT_EQ(kernel.kernel_matrix().rows(), 6 * (x_knots.size() - 1));
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  EXPECT_EQ(kernel_matrix.rows(), kernel_matrix.cols());
+  EXPECT_EQ(kernel_matrix.rows(), 6 * (x_knots.size() - 1));
   Eigen::MatrixXd ref_kernel_matrix =
       Eigen::MatrixXd::Zero(6 * (x_knots.size() - 1), 6 * (x_knots.size() - 1));
 
@@ -253,10 +259,10 @@ TEST(Spline1dKernel, add_second_derivative_kernel_matrix_01) {
   // clang-format on
   ref_kernel_matrix *= 2.0;
 
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
       const double param = std::pow(0.5, std::max(0, i + j - 3));
-      EXPECT_NEAR(kernel.kernel_matrix()(i, j), param * ref_kernel_matrix(i, j),
+      EXPECT_NEAR(kernel_matrix(i, j), param * ref_kernel_matrix(i, j),
                   1e-5);
     }
   }
@@ -279,8 +285,9 @@ TEST(Spline1dKernel, add_second_derivative_kernel_matrix_02) {
   kernel.AddSecondOrderDerivativeMatrix(1.0);
 
   const uint32_t num_params = spline_order + 1;
-  EXPECT_EQ(kernel.kernel_matrix().rows(), kernel.kernel_matrix().cols());
-  EXPECT_EQ(kernel.kernel_matrix().rows(), num_params * (x_knots.size() - 1));
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  EXPECT_EQ(kernel_matrix.rows(), kernel_matrix.cols());
+  EXPECT_EQ(kernel_matrix.rows(), num_params * (x_knots.size() - 1));
   Eigen::MatrixXd ref_kernel_matrix = Eigen::MatrixXd::Zero(
       num_params * (x_knots.size() - 1), num_params * (x_knots.size() - 1));
 
@@ -301,10 +308,10 @@ TEST(Spline1dKernel, add_second_derivative_kernel_matrix_02) {
   // clang-format on
   ref_kernel_matrix *= 2.0;
 
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
       const double param = std::pow(0.5, std::max(0, i % 6 + j % 6 - 3));
-      EXPECT_NEAR(kernel.kernel_matrix()(i, j), param * ref_kernel_matrix(i, j),
+      EXPECT_NEAR(kernel_matrix(i, j), param * ref_kernel_matrix(i, j),
                   1e-6);
     }
   }
@@ -325,8 +332,9 @@ TEST(Spline1dKernel, add_third_derivative_kernel_matrix_01) {
   kernel.AddThirdOrderDerivativeMatrix(1.0);
 
   const uint32_t num_params = spline_order + 1;
-  EXPECT_EQ(kernel.kernel_matrix().rows(), kernel.kernel_matrix().cols());
-  EXPECT_EQ(kernel.kernel_matrix().rows(), num_params * (x_knots.size() - 1));
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  EXPECT_EQ(kernel_matrix.rows(), kernel_matrix.cols());
+  EXPECT_EQ(kernel_matrix.rows(), num_params * (x_knots.size() - 1));
   Eigen::MatrixXd ref_kernel_matrix = Eigen::MatrixXd::Zero(
       num_params * (x_knots.size() - 1), num_params * (x_knots.size() - 1));
 
@@ -341,10 +349,10 @@ TEST(Spline1dKernel, add_third_derivative_kernel_matrix_01) {
   // clang-format on
   ref_kernel_matrix *= 2.0;
 
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
       const double param = std::pow(1.5, std::max(0, i % 6 + j % 6 - 5));
-      EXPECT_NEAR(kernel.kernel_matrix()(i, j), param * ref_kernel_matrix(i, j),
+      EXPECT_NEAR(kernel_matrix(i, j), param * ref_kernel_matrix(i, j),
                   1e-6);
     }
   }
@@ -365,8 +373,9 @@ TEST(Spline1dKernel, add_third_derivative_kernel_matrix_02) {
   kernel.AddThirdOrderDerivativeMatrix(1.0);
 
   const uint32_t num_params = spline_order + 1;
-  EXPECT_EQ(kernel.kernel_matrix().rows(), kernel.kernel_matrix().cols());
-  EXPECT_EQ(kernel.kernel_matrix().rows(), num_params * (x_knots.size() - 1));
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  EXPECT_EQ(kernel_matrix.rows(), kernel_matrix.cols());
+  EXPECT_EQ(kernel_matrix.rows(), num_params * (x_knots.size() - 1));
   Eigen::MatrixXd ref_kernel_matrix =
       Eigen::MatrixXd::Zero(num_params, num_params);
 
@@ -381,13 +390,13 @@ TEST(Spline1dKernel, add_third_derivative_kernel_matrix_02) {
   // clang-format on
   ref_kernel_matrix *= 2.0;
 
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
       if ((i >= 6 && j < 6) || (i < 6 && j >= 6)) {
-        EXPECT_DOUBLE_EQ(kernel.kernel_matrix()(i, j), 0.0);
+        EXPECT_DOUBLE_EQ(kernel_matrix(i, j), 0.0);
       } else {
         const double param = std::pow(1.5, std::max(0, i % 6 + j % 6 - 5));
-        EXPECT_NEAR(kernel.kernel_matrix()(i, j),
+        EXPECT_NEAR(kernel_matrix(i, j),
                     param * ref_kernel_matrix(i % 6, j % 6), 1e-6);
       }
     }
@@ -413,12 +422,13 @@ TEST(Spline1dKernel, add_reference_line_kernel_01) {
   std::vector<double> ref_x = {0.0};
   kernel.AddReferenceLineKernelMatrix(x_coord, ref_x, 1.0);
 
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
       if (i == 0 && j == 0) {
-        EXPECT_DOUBLE_EQ(kernel.kernel_matrix()(i, j), 2.0);
+        EXPECT_DOUBLE_EQ(kernel_matrix(i, j), 2.0);
       } else {
-        EXPECT_DOUBLE_EQ(kernel.kernel_matrix()(i, j), 0.0);
+        EXPECT_DOUBLE_EQ(kernel_matrix(i, j), 0.0);
       }
     }
   }
@@ -437,12 +447,13 @@ TEST(Spline1dKernel, add_reference_line_kernel_02) {
   std::vector<double> ref_x = {3.0};
   kernel.AddReferenceLineKernelMatrix(x_coord, ref_x, 1.0);
 
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
       if (i == 0 && j == 0) {
-        EXPECT_DOUBLE_EQ(kernel.kernel_matrix()(i, j), 2.0);
+        EXPECT_DOUBLE_EQ(kernel_matrix(i, j), 2.0);
       } else {
-        EXPECT_DOUBLE_EQ(kernel.kernel_matrix()(i, j), 0.0);
+        EXPECT_DOUBLE_EQ(kernel_matrix(i, j), 0.0);
       }
     }
   }
@@ -478,9 +489,10 @@ TEST(Spline1dKernel, add_reference_line_kernel_03) {
   Eigen::MatrixXd ref_offset = Eigen::MatrixXd::Zero(6, 1);
   ref_offset = -2.0 * 2.0 * res.transpose();
 
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
-      EXPECT_DOUBLE_EQ(kernel.kernel_matrix()(i, j), ref_kernel_matrix(i, j));
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
+      EXPECT_DOUBLE_EQ(kernel_matrix(i, j), ref_kernel_matrix(i, j));
     }
   }
 
@@ -510,12 +522,13 @@ TEST(Spline1dKernel, add_reference_line_kernel_04) {
   Eigen::MatrixXd ref_offset = Eigen::MatrixXd::Zero(6, 1);
   ref_offset = -2.0 * 2.0 * res.transpose();
 
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
       if (i < 6 || j < 6) {
-        EXPECT_DOUBLE_EQ(kernel.kernel_matrix()(i, j), 0.0);
+        EXPECT_DOUBLE_EQ(kernel_matrix(i, j), 0.0);
       } else {
-        EXPECT_DOUBLE_EQ(kernel.kernel_matrix()(i, j),
+        EXPECT_DOUBLE_EQ(kernel_matrix(i, j),
                          ref_kernel_matrix(i % 6, j % 6));
       }
     }
@@ -539,8 +552,9 @@ TEST(Spline1dKernel, add_derivative_kernel_matrix_for_spline_k_01) {
   kernel.AddDerivativeKernelMatrixForSplineK(0, 1.0);
 
   const uint32_t num_params = spline_order + 1;
-  EXPECT_EQ(kernel.kernel_matrix().rows(), kernel.kernel_matrix().cols());
-  EXPECT_EQ(kernel.kernel_matrix().rows(), num_params * (x_knots.size() - 1));
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  EXPECT_EQ(kernel_matrix.rows(), kernel_matrix.cols());
+  EXPECT_EQ(kernel_matrix.rows(), num_params * (x_knots.size() - 1));
   Eigen::MatrixXd ref_kernel_matrix = Eigen::MatrixXd::Zero(
       num_params * (x_knots.size() - 1), num_params * (x_knots.size() - 1));
 
@@ -559,9 +573,9 @@ TEST(Spline1dKernel, add_derivative_kernel_matrix_for_spline_k_01) {
 0,       0,       0,       0,       0,       0,       0,       0,       0,       0,       0,       0, // NOLINT
 0,       0,       0,       0,       0,       0,       0,       0,       0,       0,       0,       0; // NOLINT
   // clang-format on
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
-      EXPECT_NEAR(kernel.kernel_matrix()(i, j), ref_kernel_matrix(i, j), 1e-5);
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
+      EXPECT_NEAR(kernel_matrix(i, j), ref_kernel_matrix(i, j), 1e-5);
     }
   }
 
@@ -583,8 +597,9 @@ TEST(Spline1dKernel, add_derivative_kernel_matrix_for_spline_k_02) {
   kernel.AddDerivativeKernelMatrixForSplineK(1, 1.0);
 
   const uint32_t num_params = spline_order + 1;
-  EXPECT_EQ(kernel.kernel_matrix().rows(), kernel.kernel_matrix().cols());
-  EXPECT_EQ(kernel.kernel_matrix().rows(), num_params * (x_knots.size() - 1));
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  EXPECT_EQ(kernel_matrix.rows(), kernel_matrix.cols());
+  EXPECT_EQ(kernel_matrix.rows(), num_params * (x_knots.size() - 1));
   Eigen::MatrixXd ref_kernel_matrix = Eigen::MatrixXd::Zero(
       num_params * (x_knots.size() - 1), num_params * (x_knots.size() - 1));
 
@@ -604,9 +619,9 @@ TEST(Spline1dKernel, add_derivative_kernel_matrix_for_spline_k_02) {
 0,       0,       0,       0,       0,       0,       0,       2, 3.33333, 4.28571,       5, 5.55556; // NOLINT
 
   // clang-format on
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
-      EXPECT_NEAR(kernel.kernel_matrix()(i, j), ref_kernel_matrix(i, j), 1e-5);
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
+      EXPECT_NEAR(kernel_matrix(i, j), ref_kernel_matrix(i, j), 1e-5);
     }
   }
 
@@ -629,8 +644,9 @@ TEST(Spline1dKernel,
   kernel.AddSecondOrderDerivativeMatrixForSplineK(0, 1.0);
 
   const uint32_t num_params = spline_order + 1;
-  EXPECT_EQ(kernel.kernel_matrix().rows(), kernel.kernel_matrix().cols());
-  EXPECT_EQ(kernel.kernel_matrix().rows(), num_params * (x_knots.size() - 1));
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  EXPECT_EQ(kernel_matrix.rows(), kernel_matrix.cols());
+  EXPECT_EQ(kernel_matrix.rows(), num_params * (x_knots.size() - 1));
   Eigen::MatrixXd ref_kernel_matrix = Eigen::MatrixXd::Zero(
       num_params * (x_knots.size() - 1), num_params * (x_knots.size() - 1));
 
@@ -650,9 +666,9 @@ TEST(Spline1dKernel,
 0,       0,       0,       0,       0,       0,       0,       0,       0,       0,       0,       0; // NOLINT
 
   // clang-format on
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
-      EXPECT_NEAR(kernel.kernel_matrix()(i, j), ref_kernel_matrix(i, j), 1e-5);
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
+      EXPECT_NEAR(kernel_matrix(i, j), ref_kernel_matrix(i, j), 1e-5);
     }
   }
 
@@ -675,8 +691,9 @@ TEST(Spline1dKernel,
   kernel.AddSecondOrderDerivativeMatrixForSplineK(1, 1.0);
 
   const uint32_t num_params = spline_order + 1;
-  EXPECT_EQ(kernel.kernel_matrix().rows(), kernel.kernel_matrix().cols());
-  EXPECT_EQ(kernel.kernel_matrix().rows(), num_params * (x_knots.size() - 1));
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  EXPECT_EQ(kernel_matrix.rows(), kernel_matrix.cols());
+  EXPECT_EQ(kernel_matrix.rows(), num_params * (x_knots.size() - 1));
   Eigen::MatrixXd ref_kernel_matrix = Eigen::MatrixXd::Zero(
       num_params * (x_knots.size() - 1), num_params * (x_knots.size() - 1));
 
@@ -696,9 +713,9 @@ TEST(Spline1dKernel,
 0,       0,       0,       0,       0,       0,       0,       0,      20,      48,      80, 114.285714; // NOLINT
 
   // clang-format on
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
-      EXPECT_NEAR(kernel.kernel_matrix()(i, j), ref_kernel_matrix(i, j), 1e-5);
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
+      EXPECT_NEAR(kernel_matrix(i, j), ref_kernel_matrix(i, j), 1e-5);
     }
   }
 
@@ -27,7 +27,7 @@ using Eigen::MatrixXd;
 // converte qp problem to proto
 void Spline1dSolver::GenerateProblemProto(
     QuadraticProgrammingProblem* const qp_proto) const {
-  const MatrixXd& kernel_matrix = kernel_.kernel_matrix();
+  const MatrixXd kernel_matrix = kernel_.ToDenseKernelMatrix();
   const MatrixXd& offset = kernel_.offset();
   const MatrixXd& inequality_constraint_matrix =
       constraint_.inequality_constraint().constraint_matrix();
@@ -31,30 +31,28 @@ using apollo::common::math::Vec2d;
 
 Spline2dKernel::Spline2dKernel(const std::vector<double>& t_knots,
                                const uint32_t spline_order)
-    : t_knots_(t_knots), spline_order_(spline_order) {
-  total_params_ =
-      (t_knots_.size() > 1 ? 2 * (t_knots_.size() - 1) * (1 + spline_order_)
-                           : 0);
-  kernel_matrix_ = Eigen::MatrixXd::Zero(total_params_, total_params_);
+    : kernel_(t_knots.size() > 1
+                  ? 2 * (static_cast<uint32_t>(t_knots.size()) - 1)
+                  : 0,
+              spline_order + 1),
+      t_knots_(t_knots),
+      spline_order_(spline_order) {
+  total_params_ = kernel_.num_params();
   offset_ = Eigen::MatrixXd::Zero(total_params_, 1);
 }
 
 // customized input output
 void Spline2dKernel::AddRegularization(const double regularization_param) {
-  Eigen::MatrixXd id_matrix =
-      Eigen::MatrixXd::Identity(kernel_matrix_.rows(), kernel_matrix_.cols());
-  kernel_matrix_ += id_matrix * regularization_param;
+  kernel_.AddToDiagonal(regularization_param);
 }
 
 bool Spline2dKernel::AddKernel(const Eigen::MatrixXd& kernel,
                                const Eigen::MatrixXd& offset,
                                const double weight) {
-  if (kernel.rows() != kernel.cols() ||
-      kernel.rows() != kernel_matrix_.rows() || offset.cols() != 1 ||
-      offset.rows() != offset_.rows()) {
+  if (offset.cols() != 1 || offset.rows() != offset_.rows() ||
+      !kernel_.AddKernel(kernel, weight)) {
     return false;
   }
-  kernel_matrix_ += kernel * weight;
   offset_ += offset * weight;
   return true;
 }
@@ -65,14 +63,10 @@ bool Spline2dKernel::AddKernel(const Eigen::MatrixXd& kernel,
   return AddKernel(kernel, offset, weight);
 }
 
-Eigen::MatrixXd* Spline2dKernel::mutable_kernel_matrix() {
-  return &kernel_matrix_;
-}
-
 Eigen::MatrixXd* Spline2dKernel::mutable_offset() { return &offset_; }
 
-const Eigen::MatrixXd Spline2dKernel::kernel_matrix() const {
-  return kernel_matrix_ * 2.0;
+Eigen::MatrixXd Spline2dKernel::ToDenseKernelMatrix() const {
+  return kernel_.ToDense(2.0);
 }
 
 const Eigen::MatrixXd Spline2dKernel::offset() const { return offset_; }
@@ -82,15 +76,11 @@ const Eigen::MatrixXd Spline2dKernel::offset() const { return offset_; }
 void Spline2dKernel::AddNthDerivativeKernelMatrix(const uint32_t n,
                                                   const double weight) {
   for (uint32_t i = 0; i + 1 < t_knots_.size(); ++i) {
-    const uint32_t num_params = spline_order_ + 1;
-    Eigen::MatrixXd cur_kernel =
-        SplineSegKernel::Instance()->NthDerivativeKernel(
-            n, num_params, t_knots_[i + 1] - t_knots_[i]) *
-        weight;
-    kernel_matrix_.block(2 * i * num_params, 2 * i * num_params, num_params,
-                         num_params) += cur_kernel;
-    kernel_matrix_.block((2 * i + 1) * num_params, (2 * i + 1) * num_params,
-                         num_params, num_params) += cur_kernel;
+    const double delta_t = t_knots_[i + 1] - t_knots_[i];
+    SplineSegKernel::Instance()->AddNthDerivativeKernel(
+        n, delta_t, weight, kernel_.mutable_block(2 * i));
+    SplineSegKernel::Instance()->AddNthDerivativeKernel(
+        n, delta_t, weight, kernel_.mutable_block(2 * i + 1));
   }
 }
 
@@ -130,8 +120,6 @@ bool Spline2dKernel::AddReferenceLineKernelMatrix(
     }
 
     // update kernel matrix
-    Eigen::MatrixXd ref_kernel(num_params, num_params);
-
     double cur_t = 1.0;
     std::vector<double> power_t;
     for (uint32_t n = 0; n + 1 < 2 * num_params; ++n) {
@@ -139,17 +127,14 @@ bool Spline2dKernel::AddReferenceLineKernelMatrix(
       cur_t *= cur_rel_t;
     }
 
-    for (uint32_t r = 0; r < num_params; ++r) {
-      for (uint32_t c = 0; c < num_params; ++c) {
-        ref_kernel(r, c) = power_t[r + c];
+    auto ref_kernel_x = kernel_.mutable_block(2 * cur_index);
+    auto ref_kernel_y = kernel_.mutable_block(2 * cur_index + 1);
+    for (uint32_t c = 0; c < num_params; ++c) {
+      for (uint32_t r = 0; r < num_params; ++r) {
+        ref_kernel_x(r, c) += weight * power_t[r + c];
+        ref_kernel_y(r, c) += weight * power_t[r + c];
       }
     }
-    kernel_matrix_.block((2 * cur_index) * num_params,
-                         (2 * cur_index) * num_params, num_params,
-                         num_params) += weight * ref_kernel;
-    kernel_matrix_.block((2 * cur_index + 1) * num_params,
-                         (2 * cur_index + 1) * num_params, num_params,
-                         num_params) += weight * ref_kernel;
   }
   return true;
 }
@@ -25,6 +25,7 @@
 #include "Eigen/Core"
 
 #include "modules/common/math/vec2d.h"
+#include "modules/planning/math/smoothing_spline/block_diagonal_kernel.h"
 #include "modules/planning/math/smoothing_spline/spline_2d.h"
 
 namespace apollo {
@@ -41,12 +42,23 @@ class Spline2dKernel {
                  const double weight);
   bool AddKernel(const Eigen::MatrixXd& kernel, const double weight);
 
-  Eigen::MatrixXd* mutable_kernel_matrix();
   Eigen::MatrixXd* mutable_offset();
 
-  const Eigen::MatrixXd kernel_matrix() const;
+  size_t num_params() const { return total_params_; }
+
+  // dense kernel matrix, assembled from the segment blocks on every call
+  Eigen::MatrixXd ToDenseKernelMatrix() const;
   const Eigen::MatrixXd offset() const;
 
+  // upper triangular part of the kernel matrix in CSC format, assembled from
+  // the segment blocks without a dense intermediate
+  template <typename T, typename D>
+  void KernelMatrixToUpperTriangularCSC(std::vector<T>* data,
+                                        std::vector<D>* indices,
+                                        std::vector<D>* indptr) const {
+    kernel_.ToUpperTriangularCSC(2.0, data, indices, indptr);
+  }
+
   // build-in kernel methods
   void AddDerivativeKernelMatrix(const double weight);
   void AddSecondOrderDerivativeMatrix(const double weight);
@@ -62,7 +74,8 @@ class Spline2dKernel {
   uint32_t find_index(const double x) const;
 
  private:
-  Eigen::MatrixXd kernel_matrix_;
+  // x and y blocks of every segment, interleaved
+  BlockDiagonalKernel kernel_;
   Eigen::MatrixXd offset_;
   std::vector<double> t_knots_;
   uint32_t spline_order_;
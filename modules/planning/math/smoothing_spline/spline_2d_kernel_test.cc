@@ -33,12 +33,13 @@ TEST(Spline2dKernel, add_regularization) {
 
   kernel.AddRegularization(0.2);
 
-  for (int i = 0; i < kernel.kernel_matrix().rows(); ++i) {
-    for (int j = 0; j < kernel.kernel_matrix().cols(); ++j) {
+  const Eigen::MatrixXd kernel_matrix = kernel.ToDenseKernelMatrix();
+  for (int i = 0; i < kernel_matrix.rows(); ++i) {
+    for (int j = 0; j < kernel_matrix.cols(); ++j) {
       if (i == j) {
-        EXPECT_DOUBLE_EQ(kernel.kernel_matrix()(i, j), 0.4);
+        EXPECT_DOUBLE_EQ(kernel_matrix(i, j), 0.4);
       } else {
-        EXPECT_DOUBLE_EQ(kernel.kernel_matrix()(i, j), 0.0);
+        EXPECT_DOUBLE_EQ(kernel_matrix(i, j), 0.0);
       }
     }
   }
@@ -28,25 +28,28 @@ namespace planning {
 
 SplineSegKernel::SplineSegKernel() {
   const int reserved_num_params = reserved_order_ + 1;
-  CalculateFx(reserved_num_params);
-  CalculateDerivative(reserved_num_params);
-  CalculateSecondOrderDerivative(reserved_num_params);
-  CalculateThirdOrderDerivative(reserved_num_params);
+  kernel_fx_ = CalculateFx(reserved_num_params);
+  kernel_derivative_ = CalculateDerivative(reserved_num_params);
+  kernel_second_order_derivative_ =
+      CalculateSecondOrderDerivative(reserved_num_params);
+  kernel_third_order_derivative_ =
+      CalculateThirdOrderDerivative(reserved_num_params);
 }
 
 Eigen::MatrixXd SplineSegKernel::Kernel(const uint32_t num_params,
-                                        const double accumulated_x) {
-  if (num_params > reserved_order_ + 1) {
-    CalculateFx(num_params);
-  }
+                                        const double accumulated_x) const {
   Eigen::MatrixXd term_matrix;
   IntegratedTermMatrix(num_params, accumulated_x, "fx", &term_matrix);
+  if (num_params > reserved_order_ + 1) {
+    return CalculateFx(num_params).cwiseProduct(term_matrix);
+  }
   return kernel_fx_.block(0, 0, num_params, num_params)
       .cwiseProduct(term_matrix);
 }
 
 Eigen::MatrixXd SplineSegKernel::NthDerivativeKernel(
-    const uint32_t n, const uint32_t num_params, const double accumulated_x) {
+    const uint32_t n, const uint32_t num_params,
+    const double accumulated_x) const {
   if (n == 1) {
     return DerivativeKernel(num_params, accumulated_x);
   } else if (n == 2) {
@@ -58,35 +61,89 @@ Eigen::MatrixXd SplineSegKernel::NthDerivativeKernel(
   }
 }
 
-Eigen::MatrixXd SplineSegKernel::DerivativeKernel(const uint32_t num_params,
-                                                  const double accumulated_x) {
-  if (num_params > reserved_order_ + 1) {
-    CalculateDerivative(num_params);
+namespace {
+
+template <uint32_t kNumParams>
+bool AddSpecializedSegKernel(const uint32_t n, const double x,
+                             const double weight,
+                             Eigen::Ref<Eigen::MatrixXd> kernel) {
+  switch (n) {
+    case 1:
+      AddNthDerivativeSegKernel<kNumParams, 1>(x, weight, kernel);
+      return true;
+    case 2:
+      AddNthDerivativeSegKernel<kNumParams, 2>(x, weight, kernel);
+      return true;
+    case 3:
+      AddNthDerivativeSegKernel<kNumParams, 3>(x, weight, kernel);
+      return true;
+    default:
+      return false;
   }
+}
+
+}  // namespace
+
+void SplineSegKernel::AddNthDerivativeKernel(
+    const uint32_t n, const double accumulated_x, const double weight,
+    Eigen::Ref<Eigen::MatrixXd> kernel) const {
+  if (n < 1 || n > 3) {
+    // consistent with NthDerivativeKernel, which only supports N <= 3
+    return;
+  }
+  bool specialized = false;
+  switch (kernel.rows()) {
+    case 4:
+      specialized =
+          AddSpecializedSegKernel<4>(n, accumulated_x, weight, kernel);
+      break;
+    case 5:
+      specialized =
+          AddSpecializedSegKernel<5>(n, accumulated_x, weight, kernel);
+      break;
+    case 6:
+      specialized =
+          AddSpecializedSegKernel<6>(n, accumulated_x, weight, kernel);
+      break;
+    default:
+      break;
+  }
+  if (!specialized) {
+    const uint32_t num_params = static_cast<uint32_t>(kernel.rows());
+    kernel += weight * NthDerivativeKernel(n, num_params, accumulated_x);
+  }
+}
+
+Eigen::MatrixXd SplineSegKernel::DerivativeKernel(
+    const uint32_t num_params, const double accumulated_x) const {
   Eigen::MatrixXd term_matrix;
   IntegratedTermMatrix(num_params, accumulated_x, "derivative", &term_matrix);
+  if (num_params > reserved_order_ + 1) {
+    return CalculateDerivative(num_params).cwiseProduct(term_matrix);
+  }
   return kernel_derivative_.block(0, 0, num_params, num_params)
       .cwiseProduct(term_matrix);
 }
 
 Eigen::MatrixXd SplineSegKernel::SecondOrderDerivativeKernel(
-    const uint32_t num_params, const double accumulated_x) {
-  if (num_params > reserved_order_ + 1) {
-    CalculateSecondOrderDerivative(num_params);
-  }
+    const uint32_t num_params, const double accumulated_x) const {
   Eigen::MatrixXd term_matrix;
   IntegratedTermMatrix(num_params, accumulated_x, "second_order", &term_matrix);
+  if (num_params > reserved_order_ + 1) {
+    return CalculateSecondOrderDerivative(num_params).cwiseProduct(
+        term_matrix);
+  }
   return kernel_second_order_derivative_.block(0, 0, num_params, num_params)
       .cwiseProduct(term_matrix);
 }
 
 Eigen::MatrixXd SplineSegKernel::ThirdOrderDerivativeKernel(
-    const uint32_t num_params, const double accumulated_x) {
-  if (num_params > reserved_order_ + 1) {
-    CalculateThirdOrderDerivative(num_params);
-  }
+    const uint32_t num_params, const double accumulated_x) const {
   Eigen::MatrixXd term_matrix;
   IntegratedTermMatrix(num_params, accumulated_x, "third_order", &term_matrix);
+  if (num_params > reserved_order_ + 1) {
+    return CalculateThirdOrderDerivative(num_params).cwiseProduct(term_matrix);
+  }
   return (kernel_third_order_derivative_.block(0, 0, num_params, num_params))
       .cwiseProduct(term_matrix);
 }
@@ -147,45 +204,48 @@ void SplineSegKernel::IntegratedTermMatrix(const uint32_t num_params,
   }
 }
 
-void SplineSegKernel::CalculateFx(const uint32_t num_params) {
-  kernel_fx_ = Eigen::MatrixXd::Zero(num_params, num_params);
-  for (int r = 0; r < kernel_fx_.rows(); ++r) {
-    for (int c = 0; c < kernel_fx_.cols(); ++c) {
-      kernel_fx_(r, c) = 1.0 / (r + c + 1.0);
+Eigen::MatrixXd SplineSegKernel::CalculateFx(const uint32_t num_params) {
+  Eigen::MatrixXd kernel = Eigen::MatrixXd::Zero(num_params, num_params);
+  for (int r = 0; r < kernel.rows(); ++r) {
+    for (int c = 0; c < kernel.cols(); ++c) {
+      kernel(r, c) = 1.0 / (r + c + 1.0);
     }
   }
+  return kernel;
 }
 
-void SplineSegKernel::CalculateDerivative(const uint32_t num_params) {
-  kernel_derivative_ = Eigen::MatrixXd::Zero(num_params, num_params);
-  for (int r = 1; r < kernel_derivative_.rows(); ++r) {
-    for (int c = 1; c < kernel_derivative_.cols(); ++c) {
-      kernel_derivative_(r, c) = r * c / (r + c - 1.0);
+Eigen::MatrixXd SplineSegKernel::CalculateDerivative(
+    const uint32_t num_params) {
+  Eigen::MatrixXd kernel = Eigen::MatrixXd::Zero(num_params, num_params);
+  for (int r = 1; r < kernel.rows(); ++r) {
+    for (int c = 1; c < kernel.cols(); ++c) {
+      kernel(r, c) = r * c / (r + c - 1.0);
     }
   }
+  return kernel;
 }
 
-void SplineSegKernel::CalculateSecondOrderDerivative(
+Eigen::MatrixXd SplineSegKernel::CalculateSecondOrderDerivative(
     const uint32_t num_params) {
-  kernel_second_order_derivative_ =
-      Eigen::MatrixXd::Zero(num_params, num_params);
-  for (int r = 2; r < kernel_second_order_derivative_.rows(); ++r) {
-    for (int c = 2; c < kernel_second_order_derivative_.cols(); ++c) {
-      kernel_second_order_derivative_(r, c) =
-          (r * r - r) * (c * c - c) / (r + c - 3.0);
+  Eigen::MatrixXd kernel = Eigen::MatrixXd::Zero(num_params, num_params);
+  for (int r = 2; r < kernel.rows(); ++r) {
+    for (int c = 2; c < kernel.cols(); ++c) {
+      kernel(r, c) = (r * r - r) * (c * c - c) / (r + c - 3.0);
     }
   }
+  return kernel;
 }
 
-void SplineSegKernel::CalculateThirdOrderDerivative(const uint32_t num_params) {
-  kernel_third_order_derivative_ =
-      Eigen::MatrixXd::Zero(num_params, num_params);
-  for (int r = 3; r < kernel_third_order_derivative_.rows(); ++r) {
-    for (int c = 3; c < kernel_third_order_derivative_.cols(); ++c) {
-      kernel_third_order_derivative_(r, c) =
+Eigen::MatrixXd SplineSegKernel::CalculateThirdOrderDerivative(
+    const uint32_t num_params) {
+  Eigen::MatrixXd kernel = Eigen::MatrixXd::Zero(num_params, num_params);
+  for (int r = 3; r < kernel.rows(); ++r) {
+    for (int c = 3; c < kernel.cols(); ++c) {
+      kernel(r, c) =
           (r * r - r) * (r - 2) * (c * c - c) * (c - 2) / (r + c - 5.0);
     }
   }
+  return kernel;
 }
 
 }  // namespace planning
@@ -33,31 +33,82 @@
 namespace apollo {
 namespace planning {
 
+/**
+ * Coefficients of the n-th derivative kernel of a segment with kNumParams
+ * parameters, evaluated at compile time:
+ *   K(r, c) = coefficient(r, c) * x^(r + c - 2n + 1), r, c >= n
+ */
+template <uint32_t kNumParams, uint32_t kN>
+struct SegKernelCoefficients {
+  constexpr SegKernelCoefficients() : value() {
+    for (uint32_t r = kN; r < kNumParams; ++r) {
+      for (uint32_t c = kN; c < kNumParams; ++c) {
+        double coefficient = 1.0;
+        for (uint32_t i = 0; i < kN; ++i) {
+          coefficient *= static_cast<double>((r - i) * (c - i));
+        }
+        value[r][c] = coefficient / static_cast<double>(r + c - 2 * kN + 1);
+      }
+    }
+  }
+  double value[kNumParams][kNumParams];
+};
+
+// kernel += weight * (n-th derivative kernel of a segment of length x)
+template <uint32_t kNumParams, uint32_t kN>
+void AddNthDerivativeSegKernel(const double x, const double weight,
+                               Eigen::Ref<Eigen::MatrixXd> kernel) {
+  static constexpr SegKernelCoefficients<kNumParams, kN> kCoefficients{};
+  double x_pow[2 * kNumParams];
+  x_pow[0] = weight;
+  for (uint32_t i = 1; i < 2 * kNumParams; ++i) {
+    x_pow[i] = x_pow[i - 1] * x;
+  }
+  for (uint32_t c = kN; c < kNumParams; ++c) {
+    for (uint32_t r = kN; r < kNumParams; ++r) {
+      kernel(r, c) += kCoefficients.value[r][c] * x_pow[r + c + 1 - 2 * kN];
+    }
+  }
+}
+
+// The kernel coefficients are computed once in the constructor and never
+// modified afterwards, so the singleton can be used from several threads,
+// e.g. by reference lines planned concurrently. Splines with more than
+// reserved_order_ + 1 parameters compute their coefficients per call.
 class SplineSegKernel {
  public:
   // generating kernel matrix
-  Eigen::MatrixXd Kernel(const uint32_t num_params, const double accumulated_x);
+  Eigen::MatrixXd Kernel(const uint32_t num_params,
+                         const double accumulated_x) const;
 
   // only support N <= 3 cases
   Eigen::MatrixXd NthDerivativeKernel(const uint32_t n,
                                       const uint32_t num_params,
-                                      const double accumulated_x);
+                                      const double accumulated_x) const;
+
+  // kernel += weight * NthDerivativeKernel(n, kernel.rows(), accumulated_x),
+  // with order-specialized coefficients for splines of order 3 to 5.
+  void AddNthDerivativeKernel(const uint32_t n, const double accumulated_x,
+                              const double weight,
+                              Eigen::Ref<Eigen::MatrixXd> kernel) const;
 
  private:
   Eigen::MatrixXd DerivativeKernel(const uint32_t num_of_params,
-                                   const double accumulated_x);
-  Eigen::MatrixXd SecondOrderDerivativeKernel(const uint32_t num_of_params,
-                                              const double accumulated_x);
+                                   const double accumulated_x) const;
+  Eigen::MatrixXd SecondOrderDerivativeKernel(
+      const uint32_t num_of_params, const double accumulated_x) const;
   Eigen::MatrixXd ThirdOrderDerivativeKernel(const uint32_t num_of_params,
-                                             const double accumulated_x);
+                                             const double accumulated_x) const;
 
   void IntegratedTermMatrix(const uint32_t num_of_params, const double x,
                             const std::string& type,
                             Eigen::MatrixXd* term_matrix) const;
-  void CalculateFx(const uint32_t num_of_params);
-  void CalculateDerivative(const uint32_t num_of_params);
-  void CalculateSecondOrderDerivative(const uint32_t num_of_params);
-  void CalculateThirdOrderDerivative(const uint32_t num_of_params);
+  static Eigen::MatrixXd CalculateFx(const uint32_t num_of_params);
+  static Eigen::MatrixXd CalculateDerivative(const uint32_t num_of_params);
+  static Eigen::MatrixXd CalculateSecondOrderDerivative(
+      const uint32_t num_of_params);
+  static Eigen::MatrixXd CalculateThirdOrderDerivative(
+      const uint32_t num_of_params);
 
   const uint32_t reserved_order_ = 5;
   Eigen::MatrixXd kernel_fx_;
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+#include "modules/planning/math/smoothing_spline/spline_seg_kernel.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(SplineSegKernel, AddNthDerivativeKernel) {
+  // order-specialized kernels (4 to 6 params) and the generic fallback
+  for (uint32_t num_params = 3; num_params <= 8; ++num_params) {
+    for (uint32_t n = 1; n <= 3; ++n) {
+      const double x = 1.3;
+      const double weight = 0.7;
+      Eigen::MatrixXd kernel =
+          Eigen::MatrixXd::Constant(num_params, num_params, 1.0);
+      SplineSegKernel::Instance()->AddNthDerivativeKernel(n, x, weight,
+                                                          kernel);
+      const Eigen::MatrixXd ref_kernel =
+          Eigen::MatrixXd::Constant(num_params, num_params, 1.0) +
+          weight *
+              SplineSegKernel::Instance()->NthDerivativeKernel(n, num_params,
+                                                               x);
+      for (uint32_t r = 0; r < num_params; ++r) {
+        for (uint32_t c = 0; c < num_params; ++c) {
+          EXPECT_NEAR(ref_kernel(r, c), kernel(r, c),
+                      1e-12 * std::fabs(ref_kernel(r, c)))
+              << "num_params = " << num_params << ", n = " << n;
+        }
+      }
+    }
+  }
+}
+
+TEST(SplineSegKernel, AddNthDerivativeKernelToBlock) {
+  Eigen::MatrixXd kernel = Eigen::MatrixXd::Zero(6, 12);
+  SplineSegKernel::Instance()->AddNthDerivativeKernel(2, 2.0, 1.0,
+                                                      kernel.block(0, 6, 6, 6));
+  const Eigen::MatrixXd ref_kernel =
+      SplineSegKernel::Instance()->NthDerivativeKernel(2, 6, 2.0);
+  EXPECT_TRUE(kernel.block(0, 0, 6, 6).isZero());
+  EXPECT_TRUE(kernel.block(0, 6, 6, 6).isApprox(ref_kernel));
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -90,8 +90,11 @@ Status NaviPlanning::Init(const PlanningConfig& config) {
 Status NaviPlanning::InitFrame(const uint32_t sequence_num,
                                const TrajectoryPoint& planning_start_point,
                                const VehicleState& vehicle_state) {
-  frame_.reset(new Frame(sequence_num, local_view_, planning_start_point,
-                         vehicle_state, reference_line_provider_.get()));
+  auto* frame_pool = FramePool::Instance();
+  frame_ = frame_pool->Acquire(sequence_num, local_view_, planning_start_point,
+                               vehicle_state, reference_line_provider_.get());
+  ADEBUG << "Frame pool: " << frame_pool->num_allocated()
+         << " frames allocated, " << frame_pool->num_reused() << " reused.";
 
   std::list<ReferenceLine> reference_lines;
   std::list<hdmap::RouteSegments> segments;
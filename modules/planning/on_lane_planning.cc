@@ -110,8 +110,11 @@ Status OnLanePlanning::Init(const PlanningConfig& config) {
 Status OnLanePlanning::InitFrame(const uint32_t sequence_num,
                                  const TrajectoryPoint& planning_start_point,
                                  const VehicleState& vehicle_state) {
-  frame_.reset(new Frame(sequence_num, local_view_, planning_start_point,
-                         vehicle_state, reference_line_provider_.get()));
+  auto* frame_pool = FramePool::Instance();
+  frame_ = frame_pool->Acquire(sequence_num, local_view_, planning_start_point,
+                               vehicle_state, reference_line_provider_.get());
+  ADEBUG << "Frame pool: " << frame_pool->num_allocated()
+         << " frames allocated, " << frame_pool->num_reused() << " reused.";
 
   if (frame_ == nullptr) {
     return Status(ErrorCode::PLANNING_ERROR, "Fail to init frame: nullptr.");
@@ -343,6 +346,20 @@ void OnLanePlanning::RunOnce(const LocalView& local_view,
     ref_line_task->set_time_ms(reference_line_provider_->LastTimeDelay() *
                                1000.0);
     ref_line_task->set_name("ReferenceLineProvider");
+    auto* smoother_task =
+        trajectory_pb->mutable_latency_stats()->add_task_stats();
+    smoother_task->set_time_ms(reference_line_provider_->LastSmootherTime() *
+                               1000.0);
+    smoother_task->set_name("ReferenceLineSmoother");
+    trajectory_pb->mutable_latency_stats()
+        ->set_reference_line_smoother_estimated_saved_time_ms(
+            reference_line_provider_->LastSmootherTimeSavedEstimate() *
+            1000.0);
+    trajectory_pb->mutable_latency_stats()->set_reference_line_reused_length(
+        reference_line_provider_->LastReusedLength());
+    *trajectory_pb->mutable_latency_stats()
+         ->mutable_reference_line_smoother_stats() =
+        reference_line_provider_->LastSmootherStats();
     // TODO(all): integrate reverse gear
     trajectory_pb->set_gear(canbus::Chassis::GEAR_DRIVE);
     FillPlanningPb(start_timestamp, trajectory_pb);
@@ -34,127 +34,225 @@ double GridSearch::EuclidDistance(const double& x1, const double& y1,
   return std::sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2));
 }
 
-bool GridSearch::CheckConstraints(std::shared_ptr<Node2d> node) {
-  if (obstacles_linesegments_vec_.empty()) {
-    return true;
-  }
-  double node_grid_x = node->GetGridX();
-  double node_grid_y = node->GetGridY();
-  if (node_grid_x > max_grid_x_ || node_grid_x < 0 ||
-      node_grid_y > max_grid_y_ || node_grid_y < 0) {
-    return false;
+void GridSearch::UpdateGrid(const std::vector<double>& XYbounds) {
+  if (!blocking_counts_.empty() && XYbounds_ == XYbounds) {
+    return;
   }
-  for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
-    for (const common::math::LineSegment2d& linesegment :
-         obstacle_linesegments) {
-      if (linesegment.DistanceTo({node->GetGridX(), node->GetGridY()}) <
+  XYbounds_ = XYbounds;
+  // XYbounds with xmin, xmax, ymin, ymax
+  max_grid_y_ = static_cast<int>(
+      std::round((XYbounds_[3] - XYbounds_[2]) / xy_grid_resolution_));
+  max_grid_x_ = static_cast<int>(
+      std::round((XYbounds_[1] - XYbounds_[0]) / xy_grid_resolution_));
+  num_grid_y_ = max_grid_y_ + 1;
+  const size_t num_cells = (max_grid_x_ + 1) * num_grid_y_;
+  blocking_counts_.assign(num_cells, 0);
+  blocked_cells_.assign(num_cells, false);
+  obstacles_linesegments_vec_.clear();
+  dp_map_end_cell_ = -1;
+  cell_nodes_.assign(num_cells, -1);
+  node_pool_.clear();
+  // every cell holds at most one node, so the pool never reallocates
+  node_pool_.reserve(num_cells);
+}
+
+void GridSearch::UpdateBlockingCounts(
+    const common::math::LineSegment2d& linesegment, const int delta,
+    std::vector<int>* touched_cells) {
+  // cells are checked at their grid coordinates
+  const auto& start = linesegment.start();
+  const auto& end = linesegment.end();
+  const int min_grid_x = std::max(
+      0, static_cast<int>(
+             std::floor(std::min(start.x(), end.x()) - node_radius_)));
+  const int max_grid_x = std::min(
+      max_grid_x_, static_cast<int>(
+                       std::ceil(std::max(start.x(), end.x()) + node_radius_)));
+  const int min_grid_y = std::max(
+      0, static_cast<int>(
+             std::floor(std::min(start.y(), end.y()) - node_radius_)));
+  const int max_grid_y = std::min(
+      max_grid_y_, static_cast<int>(
+                       std::ceil(std::max(start.y(), end.y()) + node_radius_)));
+  for (int grid_x = min_grid_x; grid_x <= max_grid_x; ++grid_x) {
+    for (int grid_y = min_grid_y; grid_y <= max_grid_y; ++grid_y) {
+      if (linesegment.DistanceTo(common::math::Vec2d(grid_x, grid_y)) <
           node_radius_) {
-        return false;
+        const int cell_index = CellIndex(grid_x, grid_y);
+        blocking_counts_[cell_index] += delta;
+        touched_cells->push_back(cell_index);
       }
     }
   }
-  return true;
 }
 
-std::vector<std::shared_ptr<Node2d>> GridSearch::GenerateNextNodes(
-    std::shared_ptr<Node2d> current_node) {
-  double current_node_x = current_node->GetGridX();
-  double current_node_y = current_node->GetGridY();
-  double current_node_path_cost = current_node->GetPathCost();
-  double diagonal_distance = std::sqrt(2.0);
-  std::vector<std::shared_ptr<Node2d>> next_nodes;
-  std::shared_ptr<Node2d> up =
-      std::make_shared<Node2d>(current_node_x, current_node_y + 1.0, XYbounds_);
-  up->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> up_right = std::make_shared<Node2d>(
-      current_node_x + 1.0, current_node_y + 1.0, XYbounds_);
-  up_right->SetPathCost(current_node_path_cost + diagonal_distance);
-  std::shared_ptr<Node2d> right =
-      std::make_shared<Node2d>(current_node_x + 1.0, current_node_y, XYbounds_);
-  right->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> down_right = std::make_shared<Node2d>(
-      current_node_x + 1.0, current_node_y - 1.0, XYbounds_);
-  down_right->SetPathCost(current_node_path_cost + diagonal_distance);
-  std::shared_ptr<Node2d> down =
-      std::make_shared<Node2d>(current_node_x, current_node_y - 1.0, XYbounds_);
-  down->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> down_left = std::make_shared<Node2d>(
-      current_node_x - 1.0, current_node_y - 1.0, XYbounds_);
-  down_left->SetPathCost(current_node_path_cost + diagonal_distance);
-  std::shared_ptr<Node2d> left =
-      std::make_shared<Node2d>(current_node_x - 1.0, current_node_y, XYbounds_);
-  left->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> up_left = std::make_shared<Node2d>(
-      current_node_x - 1.0, current_node_y + 1.0, XYbounds_);
-  up_left->SetPathCost(current_node_path_cost + diagonal_distance);
-
-  next_nodes.emplace_back(up);
-  next_nodes.emplace_back(up_right);
-  next_nodes.emplace_back(right);
-  next_nodes.emplace_back(down_right);
-  next_nodes.emplace_back(down);
-  next_nodes.emplace_back(down_left);
-  next_nodes.emplace_back(left);
-  next_nodes.emplace_back(up_left);
-  return next_nodes;
+bool GridSearch::UpdateObstacles(
+    const std::vector<std::vector<common::math::LineSegment2d>>&
+        obstacles_linesegments_vec) {
+  const auto same_linesegments =
+      [](const std::vector<common::math::LineSegment2d>& left,
+         const std::vector<common::math::LineSegment2d>& right) {
+        if (left.size() != right.size()) {
+          return false;
+        }
+        for (size_t i = 0; i < left.size(); ++i) {
+          if (left[i].start().x() != right[i].start().x() ||
+              left[i].start().y() != right[i].start().y() ||
+              left[i].end().x() != right[i].end().x() ||
+              left[i].end().y() != right[i].end().y()) {
+            return false;
+          }
+        }
+        return true;
+      };
+
+  const size_t num_obstacles = std::max(obstacles_linesegments_vec_.size(),
+                                        obstacles_linesegments_vec.size());
+  bool obstacles_changed = false;
+  std::vector<int> touched_cells;
+  for (size_t i = 0; i < num_obstacles; ++i) {
+    const bool has_old = i < obstacles_linesegments_vec_.size();
+    const bool has_new = i < obstacles_linesegments_vec.size();
+    if (has_old && has_new &&
+        same_linesegments(obstacles_linesegments_vec_[i],
+                          obstacles_linesegments_vec[i])) {
+      continue;
+    }
+    obstacles_changed = true;
+    if (has_old) {
+      for (const auto& linesegment : obstacles_linesegments_vec_[i]) {
+        UpdateBlockingCounts(linesegment, -1, &touched_cells);
+      }
+    }
+    if (has_new) {
+      for (const auto& linesegment : obstacles_linesegments_vec[i]) {
+        UpdateBlockingCounts(linesegment, 1, &touched_cells);
+      }
+    }
+  }
+  if (!obstacles_changed) {
+    return false;
+  }
+  obstacles_linesegments_vec_ = obstacles_linesegments_vec;
+
+  bool blocked_cells_changed = false;
+  for (const int cell_index : touched_cells) {
+    const bool blocked = blocking_counts_[cell_index] > 0;
+    if (blocked != blocked_cells_[cell_index]) {
+      blocked_cells_[cell_index] = blocked;
+      blocked_cells_changed = true;
+    }
+  }
+  return blocked_cells_changed;
+}
+
+void GridSearch::ResetSearch() {
+  final_node_ = -1;
+  dp_map_end_cell_ = -1;
+  for (const auto& node : node_pool_) {
+    cell_nodes_[node.GetIndex()] = -1;
+  }
+  node_pool_.clear();
+}
+
+int GridSearch::CalcGridX(const double x) const {
+  return static_cast<int>((x - XYbounds_[0]) / xy_grid_resolution_);
 }
 
+int GridSearch::CalcGridY(const double y) const {
+  return static_cast<int>((y - XYbounds_[2]) / xy_grid_resolution_);
+}
+
+bool GridSearch::InGrid(const int grid_x, const int grid_y) const {
+  return grid_x >= 0 && grid_x <= max_grid_x_ && grid_y >= 0 &&
+         grid_y <= max_grid_y_;
+}
+
+bool GridSearch::CheckConstraints(const int grid_x, const int grid_y) const {
+  return InGrid(grid_x, grid_y) && !blocked_cells_[CellIndex(grid_x, grid_y)];
+}
+
+int GridSearch::AddNode(const int grid_x, const int grid_y) {
+  const int cell_index = CellIndex(grid_x, grid_y);
+  const int pool_index = static_cast<int>(node_pool_.size());
+  node_pool_.emplace_back(grid_x, grid_y, cell_index);
+  cell_nodes_[cell_index] = pool_index;
+  return pool_index;
+}
+
+namespace {
+// neighbors in the order up, up_right, right, down_right, down, down_left,
+// left, up_left
+constexpr int kNumNeighbors = 8;
+constexpr int kNeighborDx[kNumNeighbors] = {0, 1, 1, 1, 0, -1, -1, -1};
+constexpr int kNeighborDy[kNumNeighbors] = {1, 1, 0, -1, -1, -1, 0, 1};
+const double kNeighborDistance[kNumNeighbors] = {
+    1.0, std::sqrt(2.0), 1.0, std::sqrt(2.0),
+    1.0, std::sqrt(2.0), 1.0, std::sqrt(2.0)};
+}  // namespace
+
 bool GridSearch::GenerateAStarPath(
     const double& sx, const double& sy, const double& ex, const double& ey,
     const std::vector<double>& XYbounds,
     const std::vector<std::vector<common::math::LineSegment2d>>&
         obstacles_linesegments_vec,
     GridAStartResult* result) {
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
+  std::priority_queue<std::pair<int, double>,
+                      std::vector<std::pair<int, double>>, cmp>
       open_pq;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> open_set;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> close_set;
-  XYbounds_ = XYbounds;
-  std::shared_ptr<Node2d> start_node =
-      std::make_shared<Node2d>(sx, sy, xy_grid_resolution_, XYbounds_);
-  std::shared_ptr<Node2d> end_node =
-      std::make_shared<Node2d>(ex, ey, xy_grid_resolution_, XYbounds_);
-  std::shared_ptr<Node2d> final_node_ = nullptr;
-  obstacles_linesegments_vec_ = obstacles_linesegments_vec;
-  open_set.insert(std::make_pair(start_node->GetIndex(), start_node));
-  open_pq.push(std::make_pair(start_node->GetIndex(), start_node->GetCost()));
+  UpdateGrid(XYbounds);
+  UpdateObstacles(obstacles_linesegments_vec);
+  ResetSearch();
+  const int start_grid_x = CalcGridX(sx);
+  const int start_grid_y = CalcGridY(sy);
+  const int end_grid_x = CalcGridX(ex);
+  const int end_grid_y = CalcGridY(ey);
+  if (!InGrid(start_grid_x, start_grid_y) || !InGrid(end_grid_x, end_grid_y)) {
+    AERROR << "Grid A start or end point out of XYbounds";
+    return false;
+  }
+  const int end_index = CellIndex(end_grid_x, end_grid_y);
+  const int start_node = AddNode(start_grid_x, start_grid_y);
+  open_pq.push(std::make_pair(start_node, node_pool_[start_node].GetCost()));
 
   // Grid a star begins
   size_t explored_node_num = 0;
   while (!open_pq.empty()) {
-    std::string current_id = open_pq.top().first;
+    const int current_node = open_pq.top().first;
     open_pq.pop();
-    std::shared_ptr<Node2d> current_node = open_set[current_id];
     // Check destination
-    if (*(current_node) == *(end_node)) {
+    if (node_pool_[current_node].GetIndex() == end_index) {
       final_node_ = current_node;
       break;
     }
-    close_set.emplace(current_node->GetIndex(), current_node);
-    std::vector<std::shared_ptr<Node2d>> next_nodes =
-        std::move(GenerateNextNodes(current_node));
-    for (auto& next_node : next_nodes) {
-      if (!CheckConstraints(next_node)) {
+    node_pool_[current_node].SetClosed();
+    const int current_grid_x =
+        static_cast<int>(node_pool_[current_node].GetGridX());
+    const int current_grid_y =
+        static_cast<int>(node_pool_[current_node].GetGridY());
+    const double current_path_cost = node_pool_[current_node].GetPathCost();
+    for (int i = 0; i < kNumNeighbors; ++i) {
+      const int next_grid_x = current_grid_x + kNeighborDx[i];
+      const int next_grid_y = current_grid_y + kNeighborDy[i];
+      if (!CheckConstraints(next_grid_x, next_grid_y)) {
         continue;
       }
-      if (close_set.find(next_node->GetIndex()) != close_set.end()) {
+      // visited nodes, closed or still open, are not updated
+      if (cell_nodes_[CellIndex(next_grid_x, next_grid_y)] >= 0) {
         continue;
       }
-      if (open_set.find(next_node->GetIndex()) == open_set.end()) {
-        ++explored_node_num;
-        next_node->SetHeuristic(
-            EuclidDistance(next_node->GetGridX(), next_node->GetGridY(),
-                           end_node->GetGridX(), end_node->GetGridY()));
-        next_node->SetPreNode(current_node);
-        open_set.insert(std::make_pair(next_node->GetIndex(), next_node));
-        open_pq.push(
-            std::make_pair(next_node->GetIndex(), next_node->GetCost()));
-      }
+      ++explored_node_num;
+      const int next_node = AddNode(next_grid_x, next_grid_y);
+      node_pool_[next_node].SetPathCost(current_path_cost +
+                                        kNeighborDistance[i]);
+      node_pool_[next_node].SetHeuristic(EuclidDistance(
+          next_grid_x, next_grid_y, end_grid_x, end_grid_y));
+      node_pool_[next_node].SetPreNode(current_node);
+      open_pq.push(std::make_pair(next_node, node_pool_[next_node].GetCost()));
     }
   }
 
-  if (final_node_ == nullptr) {
+  if (final_node_ < 0) {
     AERROR << "Grid A searching return null ptr(open_set ran out)";
     return false;
   }
@@ -167,75 +265,96 @@ bool GridSearch::GenerateDpMap(
     const double& ex, const double& ey, const std::vector<double>& XYbounds,
     const std::vector<std::vector<common::math::LineSegment2d>>&
         obstacles_linesegments_vec) {
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
+  std::priority_queue<std::pair<int, double>,
+                      std::vector<std::pair<int, double>>, cmp>
       open_pq;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> open_set;
-  dp_map_ = decltype(dp_map_)();
-  XYbounds_ = XYbounds;
-  // XYbounds with xmin, xmax, ymin, ymax
-  max_grid_y_ = std::round((XYbounds_[3] - XYbounds_[2]) / xy_grid_resolution_);
-  max_grid_x_ = std::round((XYbounds_[1] - XYbounds_[0]) / xy_grid_resolution_);
-  std::shared_ptr<Node2d> end_node =
-      std::make_shared<Node2d>(ex, ey, xy_grid_resolution_, XYbounds_);
-  obstacles_linesegments_vec_ = obstacles_linesegments_vec;
-  open_set.insert(std::make_pair(end_node->GetIndex(), end_node));
-  open_pq.push(std::make_pair(end_node->GetIndex(), end_node->GetCost()));
+  UpdateGrid(XYbounds);
+  const bool blocked_cells_changed =
+      UpdateObstacles(obstacles_linesegments_vec);
+  const int end_grid_x = CalcGridX(ex);
+  const int end_grid_y = CalcGridY(ey);
+  if (!InGrid(end_grid_x, end_grid_y)) {
+    AERROR << "Dp map end point out of XYbounds";
+    ResetSearch();
+    return false;
+  }
+  const int end_cell = CellIndex(end_grid_x, end_grid_y);
+  if (!blocked_cells_changed && dp_map_end_cell_ == end_cell) {
+    ADEBUG << "reuse dp map";
+    return true;
+  }
+  ResetSearch();
+  const int end_node = AddNode(end_grid_x, end_grid_y);
+  open_pq.push(std::make_pair(end_node, node_pool_[end_node].GetCost()));
 
   // Grid a star begins
   size_t explored_node_num = 0;
   while (!open_pq.empty()) {
-    const std::string current_id = open_pq.top().first;
+    const int current_node = open_pq.top().first;
     open_pq.pop();
-    std::shared_ptr<Node2d> current_node = open_set[current_id];
-    dp_map_.insert(std::make_pair(current_node->GetIndex(), current_node));
-    std::vector<std::shared_ptr<Node2d>> next_nodes =
-        std::move(GenerateNextNodes(current_node));
-    for (auto& next_node : next_nodes) {
-      if (!CheckConstraints(next_node)) {
+    node_pool_[current_node].SetClosed();
+    const int current_grid_x =
+        static_cast<int>(node_pool_[current_node].GetGridX());
+    const int current_grid_y =
+        static_cast<int>(node_pool_[current_node].GetGridY());
+    const double current_path_cost = node_pool_[current_node].GetPathCost();
+    for (int i = 0; i < kNumNeighbors; ++i) {
+      const int next_grid_x = current_grid_x + kNeighborDx[i];
+      const int next_grid_y = current_grid_y + kNeighborDy[i];
+      if (!CheckConstraints(next_grid_x, next_grid_y)) {
         continue;
       }
-      if (dp_map_.find(next_node->GetIndex()) != dp_map_.end()) {
-        continue;
-      }
-      if (open_set.find(next_node->GetIndex()) == open_set.end()) {
+      const double next_path_cost = current_path_cost + kNeighborDistance[i];
+      const int next_node = cell_nodes_[CellIndex(next_grid_x, next_grid_y)];
+      if (next_node < 0) {
         ++explored_node_num;
-        next_node->SetPreNode(current_node);
-        open_set.insert(std::make_pair(next_node->GetIndex(), next_node));
-        open_pq.push(
-            std::make_pair(next_node->GetIndex(), next_node->GetCost()));
-      } else {
-        if (open_set[next_node->GetIndex()]->GetCost() > next_node->GetCost()) {
-          open_set[next_node->GetIndex()]->SetCost(next_node->GetCost());
-          open_set[next_node->GetIndex()]->SetPreNode(current_node);
-        }
+        const int new_node = AddNode(next_grid_x, next_grid_y);
+        node_pool_[new_node].SetPathCost(next_path_cost);
+        node_pool_[new_node].SetPreNode(current_node);
+        open_pq.push(std::make_pair(new_node, node_pool_[new_node].GetCost()));
+      } else if (!node_pool_[next_node].IsClosed() &&
+                 node_pool_[next_node].GetCost() > next_path_cost) {
+        node_pool_[next_node].SetCost(next_path_cost);
+        node_pool_[next_node].SetPreNode(current_node);
       }
     }
   }
+  dp_map_end_cell_ = end_cell;
   ADEBUG << "explored node num is " << explored_node_num;
   return true;
 }
 
 double GridSearch::CheckDpMap(const double& sx, const double& sy) {
-  std::string index = Node2d::CalcIndex(sx, sy, xy_grid_resolution_, XYbounds_);
-  if (dp_map_.find(index) != dp_map_.end()) {
-    return dp_map_[index]->GetCost() * xy_grid_resolution_;
+  if (dp_map_end_cell_ < 0) {
+    return std::numeric_limits<double>::infinity();
+  }
+  const int grid_x = CalcGridX(sx);
+  const int grid_y = CalcGridY(sy);
+  if (!InGrid(grid_x, grid_y)) {
+    return std::numeric_limits<double>::infinity();
+  }
+  const int node = cell_nodes_[CellIndex(grid_x, grid_y)];
+  if (node >= 0 && node_pool_[node].IsClosed()) {
+    return node_pool_[node].GetCost() * xy_grid_resolution_;
   } else {
     return std::numeric_limits<double>::infinity();
   }
 }
 
 void GridSearch::LoadGridAStarResult(GridAStartResult* result) {
-  (*result).path_cost = final_node_->GetPathCost() * xy_grid_resolution_;
-  std::shared_ptr<Node2d> current_node = final_node_;
+  (*result).path_cost =
+      node_pool_[final_node_].GetPathCost() * xy_grid_resolution_;
+  int current_node = final_node_;
   std::vector<double> grid_a_x;
   std::vector<double> grid_a_y;
-  while (current_node->GetPreNode() != nullptr) {
-    grid_a_x.push_back(current_node->GetGridX() * xy_grid_resolution_ +
+  while (node_pool_[current_node].GetPreNode() >= 0) {
+    grid_a_x.push_back(node_pool_[current_node].GetGridX() *
+                           xy_grid_resolution_ +
                        XYbounds_[0]);
-    grid_a_y.push_back(current_node->GetGridY() * xy_grid_resolution_ +
+    grid_a_y.push_back(node_pool_[current_node].GetGridY() *
+                           xy_grid_resolution_ +
                        XYbounds_[2]);
-    current_node = current_node->GetPreNode();
+    current_node = node_pool_[current_node].GetPreNode();
   }
   std::reverse(grid_a_x.begin(), grid_a_x.end());
   std::reverse(grid_a_y.begin(), grid_a_y.end());
@@ -22,10 +22,7 @@
 
 #include <algorithm>
 #include <limits>
-#include <memory>
 #include <queue>
-#include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -38,19 +35,8 @@ namespace planning {
 
 class Node2d {
  public:
-  Node2d(const double x, const double y, const double xy_resolution,
-         const std::vector<double>& XYbounds) {
-    // XYbounds with xmin, xmax, ymin, ymax
-    grid_x_ = static_cast<int>((x - XYbounds[0]) / xy_resolution);
-    grid_y_ = static_cast<int>((y - XYbounds[2]) / xy_resolution);
-    index_ = ComputeStringIndex(grid_x_, grid_y_);
-  }
-  Node2d(const int grid_x, const int grid_y,
-         const std::vector<double>& XYbounds) {
-    grid_x_ = grid_x;
-    grid_y_ = grid_y;
-    index_ = ComputeStringIndex(grid_x_, grid_y_);
-  }
+  Node2d(const int grid_x, const int grid_y, const int index)
+      : grid_x_(grid_x), grid_y_(grid_y), index_(index) {}
   void SetPathCost(const double path_cost) {
     path_cost_ = path_cost;
     cost_ = path_cost_ + heuristic_;
@@ -60,39 +46,31 @@ class Node2d {
     cost_ = path_cost_ + heuristic_;
   }
   void SetCost(const double cost) { cost_ = cost; }
-  void SetPreNode(std::shared_ptr<Node2d> pre_node) { pre_node_ = pre_node; }
+  // pre node is given by its position in the node pool of the search
+  void SetPreNode(const int pre_node) { pre_node_ = pre_node; }
+  void SetClosed() { closed_ = true; }
   double GetGridX() const { return grid_x_; }
   double GetGridY() const { return grid_y_; }
   double GetPathCost() const { return path_cost_; }
   double GetHeuCost() const { return heuristic_; }
   double GetCost() const { return cost_; }
-  const std::string& GetIndex() const { return index_; }
-  std::shared_ptr<Node2d> GetPreNode() const { return pre_node_; }
-  static std::string CalcIndex(const double x, const double y,
-                               const double xy_resolution,
-                               const std::vector<double>& XYbounds) {
-    // XYbounds with xmin, xmax, ymin, ymax
-    int grid_x = static_cast<int>((x - XYbounds[0]) / xy_resolution);
-    int grid_y = static_cast<int>((y - XYbounds[2]) / xy_resolution);
-    return ComputeStringIndex(grid_x, grid_y);
-  }
+  int GetIndex() const { return index_; }
+  int GetPreNode() const { return pre_node_; }
+  bool IsClosed() const { return closed_; }
   bool operator==(const Node2d& right) const {
     return right.GetIndex() == index_;
   }
 
- private:
-  static std::string ComputeStringIndex(int x_grid, int y_grid) {
-    return std::to_string(x_grid) + "_" + std::to_string(y_grid);
-  }
-
  private:
   int grid_x_ = 0;
   int grid_y_ = 0;
   double path_cost_ = 0.0;
   double heuristic_ = 0.0;
   double cost_ = 0.0;
-  std::string index_;
-  std::shared_ptr<Node2d> pre_node_ = nullptr;
+  // flat index of the grid cell
+  int index_ = 0;
+  int pre_node_ = -1;
+  bool closed_ = false;
 };
 
 struct GridAStartResult {
@@ -111,6 +89,9 @@ class GridSearch {
       const std::vector<std::vector<common::math::LineSegment2d>>&
           obstacles_linesegments_vec,
       GridAStartResult* result);
+  // The dp map of the last call is reused when the end cell, XYbounds and
+  // the blocked cells stay the same. Changed obstacles only update the cells
+  // around them.
   bool GenerateDpMap(
       const double& ex, const double& ey, const std::vector<double>& XYbounds,
       const std::vector<std::vector<common::math::LineSegment2d>>&
@@ -120,30 +101,57 @@ class GridSearch {
  private:
   double EuclidDistance(const double& x1, const double& y1, const double& x2,
                         const double& y2);
-  std::vector<std::shared_ptr<Node2d>> GenerateNextNodes(
-      std::shared_ptr<Node2d> node);
-  bool CheckConstraints(std::shared_ptr<Node2d> node);
+  // set up the grid over XYbounds, keeping it if XYbounds did not change
+  void UpdateGrid(const std::vector<double>& XYbounds);
+  // update the blocked cells around the changed obstacles, return true if
+  // any cell changed between blocked and free
+  bool UpdateObstacles(
+      const std::vector<std::vector<common::math::LineSegment2d>>&
+          obstacles_linesegments_vec);
+  // add delta to the blocking counts of the cells within node_radius_ of
+  // the segment and record the cells in touched_cells
+  void UpdateBlockingCounts(const common::math::LineSegment2d& linesegment,
+                            const int delta, std::vector<int>* touched_cells);
+  // clear the nodes of the last search
+  void ResetSearch();
+  int CalcGridX(const double x) const;
+  int CalcGridY(const double y) const;
+  bool InGrid(const int grid_x, const int grid_y) const;
+  int CellIndex(const int grid_x, const int grid_y) const {
+    return grid_x * num_grid_y_ + grid_y;
+  }
+  bool CheckConstraints(const int grid_x, const int grid_y) const;
+  // add a node to the pool and return its position in the pool
+  int AddNode(const int grid_x, const int grid_y);
   void LoadGridAStarResult(GridAStartResult* result);
 
  private:
   double xy_grid_resolution_ = 0.0;
   double node_radius_ = 0.0;
   std::vector<double> XYbounds_;
-  double max_grid_x_ = 0.0;
-  double max_grid_y_ = 0.0;
-  std::shared_ptr<Node2d> start_node_;
-  std::shared_ptr<Node2d> end_node_;
-  std::shared_ptr<Node2d> final_node_;
+  int max_grid_x_ = 0;
+  int max_grid_y_ = 0;
+  int num_grid_y_ = 0;
+  int final_node_ = -1;
+  // obstacles the blocking counts are built from
   std::vector<std::vector<common::math::LineSegment2d>>
       obstacles_linesegments_vec_;
+  // number of obstacle segments within node_radius_ of each cell
+  std::vector<int> blocking_counts_;
+  std::vector<bool> blocked_cells_;
+  // end cell of the dp map held by the node pool, -1 if there is none
+  int dp_map_end_cell_ = -1;
 
   struct cmp {
-    bool operator()(const std::pair<std::string, double>& left,
-                    const std::pair<std::string, double>& right) const {
+    bool operator()(const std::pair<int, double>& left,
+                    const std::pair<int, double>& right) const {
       return left.second >= right.second;
     }
   };
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> dp_map_;
+  // nodes of the last search; the capacity is kept between searches
+  std::vector<Node2d> node_pool_;
+  // position in node_pool_ of the node at each grid cell, -1 if not reached
+  std::vector<int> cell_nodes_;
 };
 }  // namespace planning
 }  // namespace apollo
@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/*
+ * @file
+ */
+
+#include "modules/planning/open_space/coarse_trajectory_generator/grid_search.h"
+
+#include "cyber/common/file.h"
+#include "gtest/gtest.h"
+#include "modules/common/time/time.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+using common::math::LineSegment2d;
+using common::math::Vec2d;
+
+class GridSearchTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    FLAGS_planner_open_space_config_filename =
+        "/apollo/modules/planning/testdata/conf/"
+        "open_space_standard_parking_lot.pb.txt";
+
+    CHECK(apollo::cyber::common::GetProtoFromFile(
+        FLAGS_planner_open_space_config_filename, &planner_open_space_config_))
+        << "Failed to load open space config file "
+        << FLAGS_planner_open_space_config_filename;
+  }
+
+ protected:
+  // closed polygon of an axis aligned box
+  static std::vector<LineSegment2d> BoxObstacle(const double min_x,
+                                                const double max_x,
+                                                const double min_y,
+                                                const double max_y) {
+    const std::vector<Vec2d> vertices = {
+        {min_x, min_y}, {max_x, min_y}, {max_x, max_y}, {min_x, max_y}};
+    std::vector<LineSegment2d> linesegments;
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      linesegments.emplace_back(vertices[i],
+                                vertices[(i + 1) % vertices.size()]);
+    }
+    return linesegments;
+  }
+
+  void ExpectSameDpMap(GridSearch* left, GridSearch* right) {
+    for (double x = XYbounds_[0]; x <= XYbounds_[1]; x += 0.5) {
+      for (double y = XYbounds_[2]; y <= XYbounds_[3]; y += 0.5) {
+        EXPECT_EQ(left->CheckDpMap(x, y), right->CheckDpMap(x, y))
+            << "x = " << x << ", y = " << y;
+      }
+    }
+  }
+
+  PlannerOpenSpaceConfig planner_open_space_config_;
+  const std::vector<double> XYbounds_ = {0.0, 60.0, 0.0, 40.0};
+};
+
+TEST_F(GridSearchTest, incremental_dp_map) {
+  std::vector<std::vector<LineSegment2d>> obstacles = {
+      BoxObstacle(10.0, 20.0, 5.0, 15.0), BoxObstacle(30.0, 35.0, 0.0, 30.0),
+      BoxObstacle(40.0, 50.0, 20.0, 25.0)};
+  GridSearch grid_search(planner_open_space_config_);
+  ASSERT_TRUE(grid_search.GenerateDpMap(55.0, 5.0, XYbounds_, obstacles));
+
+  // move one obstacle, add one and remove one
+  obstacles[0] = BoxObstacle(12.0, 22.0, 8.0, 18.0);
+  obstacles.emplace_back(BoxObstacle(5.0, 8.0, 30.0, 38.0));
+  obstacles.erase(obstacles.begin() + 2);
+  ASSERT_TRUE(grid_search.GenerateDpMap(55.0, 5.0, XYbounds_, obstacles));
+  GridSearch fresh_grid_search(planner_open_space_config_);
+  ASSERT_TRUE(
+      fresh_grid_search.GenerateDpMap(55.0, 5.0, XYbounds_, obstacles));
+  ExpectSameDpMap(&grid_search, &fresh_grid_search);
+
+  // move the end point
+  ASSERT_TRUE(grid_search.GenerateDpMap(5.0, 5.0, XYbounds_, obstacles));
+  ASSERT_TRUE(fresh_grid_search.GenerateDpMap(5.0, 5.0, XYbounds_, obstacles));
+  ExpectSameDpMap(&grid_search, &fresh_grid_search);
+}
+
+TEST_F(GridSearchTest, reuse_dp_map) {
+  std::vector<std::vector<LineSegment2d>> obstacles = {
+      BoxObstacle(10.0, 20.0, 5.0, 15.0), BoxObstacle(30.0, 35.0, 0.0, 30.0)};
+  GridSearch grid_search(planner_open_space_config_);
+  double start_time = common::time::Clock::NowInSeconds();
+  ASSERT_TRUE(grid_search.GenerateDpMap(55.0, 5.0, XYbounds_, obstacles));
+  const double first_time = common::time::Clock::NowInSeconds() - start_time;
+
+  // small obstacle jitter leaves the blocked cells unchanged
+  obstacles[0] = BoxObstacle(10.01, 20.01, 5.0, 15.0);
+  start_time = common::time::Clock::NowInSeconds();
+  ASSERT_TRUE(grid_search.GenerateDpMap(55.2, 5.0, XYbounds_, obstacles));
+  const double reuse_time = common::time::Clock::NowInSeconds() - start_time;
+  AINFO << "dp map time: first " << first_time * 1000.0 << " ms, reused "
+        << reuse_time * 1000.0 << " ms";
+
+  GridSearch fresh_grid_search(planner_open_space_config_);
+  ASSERT_TRUE(
+      fresh_grid_search.GenerateDpMap(55.2, 5.0, XYbounds_, obstacles));
+  ExpectSameDpMap(&grid_search, &fresh_grid_search);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -25,6 +25,11 @@ namespace planning {
 
 using apollo::common::time::Clock;
 
+namespace {
+// bound on the number of cached failed analytic expansions
+constexpr size_t kMaxFailedExpansions = 100000;
+}  // namespace
+
 HybridAStar::HybridAStar(const PlannerOpenSpaceConfig& open_space_conf) {
   planner_open_space_config_.CopyFrom(open_space_conf);
   reed_shepp_generator_ =
@@ -52,47 +57,57 @@ HybridAStar::HybridAStar(const PlannerOpenSpaceConfig& open_space_conf) {
 }
 
 bool HybridAStar::AnalyticExpansion(std::shared_ptr<Node3d> current_node) {
-  std::shared_ptr<ReedSheppPath> reeds_shepp_to_check =
-      std::make_shared<ReedSheppPath>();
-  if (!reed_shepp_generator_->ShortestRSP(current_node, end_node_,
-                                          reeds_shepp_to_check)) {
-    AERROR << "ShortestRSP failed";
+  const auto failed_expansion =
+      failed_expansions_.find(current_node->GetIndex());
+  if (failed_expansion != failed_expansions_.end() &&
+      failed_expansion->second.x == current_node->GetX() &&
+      failed_expansion->second.y == current_node->GetY() &&
+      failed_expansion->second.phi == current_node->GetPhi()) {
     return false;
   }
 
-  if (!RSPCheck(reeds_shepp_to_check)) {
+  bool expanded = reed_shepp_generator_->ShortestRSP(current_node, end_node_,
+                                                    reeds_shepp_to_check_);
+  if (!expanded) {
+    AERROR << "ShortestRSP failed";
+  } else {
+    expanded = RSPCheck(reeds_shepp_to_check_);
+  }
+  if (!expanded) {
+    if (failed_expansions_.size() >= kMaxFailedExpansions) {
+      failed_expansions_.clear();
+    }
+    auto& expansion = failed_expansions_[current_node->GetIndex()];
+    expansion.x = current_node->GetX();
+    expansion.y = current_node->GetY();
+    expansion.phi = current_node->GetPhi();
     return false;
   }
 
   AINFO << "Reach the end configuration with Reed Sharp";
   // load the whole RSP as nodes and add to the close set
-  final_node_ = LoadRSPinCS(reeds_shepp_to_check, current_node);
+  final_node_ = LoadRSPinCS(reeds_shepp_to_check_, current_node);
   return true;
 }
 
 bool HybridAStar::RSPCheck(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end) {
-  std::shared_ptr<Node3d> node = std::shared_ptr<Node3d>(new Node3d(
-      reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
-      XYbounds_, planner_open_space_config_));
-  return ValidityCheck(node);
+  return ValidityCheck(reeds_shepp_to_end->x, reeds_shepp_to_end->y,
+                       reeds_shepp_to_end->phi);
 }
 
 bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
+  return ValidityCheck(node->GetXs(), node->GetYs(), node->GetPhis());
+}
+
+bool HybridAStar::ValidityCheck(const std::vector<double>& traversed_x,
+                                const std::vector<double>& traversed_y,
+                                const std::vector<double>& traversed_phi) {
   if (obstacles_linesegments_vec_.empty()) {
     return true;
   }
-  size_t node_step_size = node->GetStepSize();
+  const size_t node_step_size = traversed_x.size();
   size_t last_check_index = 0;
-  std::vector<double> traversed_x;
-  std::vector<double> traversed_y;
-  std::vector<double> traversed_phi;
-  traversed_x = node->GetXs();
-  traversed_y = node->GetYs();
-  traversed_phi = node->GetPhis();
-  std::reverse(traversed_x.begin(), traversed_x.end());
-  std::reverse(traversed_y.begin(), traversed_y.end());
-  std::reverse(traversed_phi.begin(), traversed_phi.end());
   // The first {x, y, phi} is collision free unless they are start and end
   // configuration of search problem
   if (node_step_size == 1) {
@@ -100,13 +115,17 @@ bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
   } else {
     last_check_index = node_step_size - 1;
   }
-  for (size_t i = 0; i < last_check_index; ++i) {
-    if (traversed_x[i] > XYbounds_[1] || traversed_x[i] < XYbounds_[0] ||
-        traversed_y[i] > XYbounds_[3] || traversed_y[i] < XYbounds_[2]) {
+  // check from the last configuration backward
+  for (size_t i = node_step_size; i > node_step_size - last_check_index;
+       --i) {
+    const double x = traversed_x[i - 1];
+    const double y = traversed_y[i - 1];
+    if (x > XYbounds_[1] || x < XYbounds_[0] || y > XYbounds_[3] ||
+        y < XYbounds_[2]) {
       return false;
     }
-    Box2d bounding_box = Node3d::GetBoundingBox(
-        vehicle_param_, traversed_x[i], traversed_y[i], traversed_phi[i]);
+    Box2d bounding_box =
+        Node3d::GetBoundingBox(vehicle_param_, x, y, traversed_phi[i - 1]);
     for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
       for (const common::math::LineSegment2d& linesegment :
            obstacle_linesegments) {
@@ -122,14 +141,56 @@ bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
 std::shared_ptr<Node3d> HybridAStar::LoadRSPinCS(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end,
     std::shared_ptr<Node3d> current_node) {
-  std::shared_ptr<Node3d> end_node = std::shared_ptr<Node3d>(new Node3d(
-      reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
-      XYbounds_, planner_open_space_config_));
+  std::shared_ptr<Node3d> end_node = NewNode(
+      reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi);
   end_node->SetPre(current_node);
-  close_set_.insert(std::make_pair(end_node->GetIndex(), end_node));
+  node_table_.Insert(end_node->GetIndex(),
+                     static_cast<int>(node_pool_size_ - 1));
   return end_node;
 }
 
+std::shared_ptr<Node3d> HybridAStar::NewNode(
+    const std::vector<double>& traversed_x,
+    const std::vector<double>& traversed_y,
+    const std::vector<double>& traversed_phi) {
+  if (node_pool_size_ < node_pool_.size()) {
+    node_pool_[node_pool_size_]->Reset(traversed_x, traversed_y, traversed_phi,
+                                       XYbounds_, planner_open_space_config_);
+  } else {
+    node_pool_.push_back(
+        std::make_shared<Node3d>(traversed_x, traversed_y, traversed_phi,
+                                 XYbounds_, planner_open_space_config_));
+  }
+  return node_pool_[node_pool_size_++];
+}
+
+void HybridAStar::UpdateAnalyticExpansionCache(
+    double ex, double ey, double ephi, const std::vector<double>& XYbounds,
+    const std::vector<std::vector<common::math::Vec2d>>&
+        obstacles_vertices_vec) {
+  bool same_obstacles =
+      expansion_cache_obstacles_.size() == obstacles_vertices_vec.size();
+  for (size_t i = 0; same_obstacles && i < obstacles_vertices_vec.size();
+       ++i) {
+    const auto& cached_vertices = expansion_cache_obstacles_[i];
+    const auto& vertices = obstacles_vertices_vec[i];
+    same_obstacles = cached_vertices.size() == vertices.size();
+    for (size_t j = 0; same_obstacles && j < vertices.size(); ++j) {
+      same_obstacles = cached_vertices[j].x() == vertices[j].x() &&
+                       cached_vertices[j].y() == vertices[j].y();
+    }
+  }
+  const std::vector<double> end_pose = {ex, ey, ephi};
+  if (same_obstacles && expansion_cache_end_pose_ == end_pose &&
+      expansion_cache_XYbounds_ == XYbounds) {
+    return;
+  }
+  failed_expansions_.clear();
+  expansion_cache_end_pose_ = end_pose;
+  expansion_cache_XYbounds_ = XYbounds;
+  expansion_cache_obstacles_ = obstacles_vertices_vec;
+}
+
 std::shared_ptr<Node3d> HybridAStar::Next_node_generator(
     std::shared_ptr<Node3d> current_node, size_t next_node_index) {
   double steering = 0.0;
@@ -152,9 +213,12 @@ std::shared_ptr<Node3d> HybridAStar::Next_node_generator(
   // take above motion primitive to generate a curve driving the car to a
   // different grid
   double arc = std::sqrt(2) * xy_grid_resolution_;
-  std::vector<double> intermediate_x;
-  std::vector<double> intermediate_y;
-  std::vector<double> intermediate_phi;
+  std::vector<double>& intermediate_x = intermediate_x_;
+  std::vector<double>& intermediate_y = intermediate_y_;
+  std::vector<double>& intermediate_phi = intermediate_phi_;
+  intermediate_x.clear();
+  intermediate_y.clear();
+  intermediate_phi.clear();
   double last_x = current_node->GetX();
   double last_y = current_node->GetY();
   double last_phi = current_node->GetPhi();
@@ -181,9 +245,8 @@ std::shared_ptr<Node3d> HybridAStar::Next_node_generator(
       intermediate_y.back() < XYbounds_[2]) {
     return nullptr;
   }
-  std::shared_ptr<Node3d> next_node = std::shared_ptr<Node3d>(
-      new Node3d(intermediate_x, intermediate_y, intermediate_phi, XYbounds_,
-                 planner_open_space_config_));
+  std::shared_ptr<Node3d> next_node =
+      NewNode(intermediate_x, intermediate_y, intermediate_phi);
   next_node->SetPre(current_node);
   next_node->SetDirec(traveled_distance > 0);
   next_node->SetSteer(steering);
@@ -319,10 +382,11 @@ bool HybridAStar::Plan(
     const std::vector<std::vector<common::math::Vec2d>>& obstacles_vertices_vec,
     HybridAStartResult* result) {
   // clear containers
-  open_set_.clear();
-  close_set_.clear();
+  node_table_.Clear();
+  node_pool_size_ = 0;
   open_pq_ = decltype(open_pq_)();
   final_node_ = nullptr;
+  UpdateAnalyticExpansionCache(ex, ey, ephi, XYbounds, obstacles_vertices_vec);
 
   std::vector<std::vector<common::math::LineSegment2d>>
       obstacles_linesegments_vec;
@@ -341,8 +405,7 @@ bool HybridAStar::Plan(
   // load XYbounds
   XYbounds_ = XYbounds;
   // load nodes and obstacles
-  start_node_.reset(
-      new Node3d({sx}, {sy}, {sphi}, XYbounds_, planner_open_space_config_));
+  start_node_ = NewNode({sx}, {sy}, {sphi});
   end_node_.reset(
       new Node3d({ex}, {ey}, {ephi}, XYbounds_, planner_open_space_config_));
   if (!ValidityCheck(start_node_)) {
@@ -358,9 +421,8 @@ bool HybridAStar::Plan(
                                                   obstacles_linesegments_vec_);
   AINFO << "map time " << Clock::NowInSeconds() - map_time;
   // load open set, pq
-  open_set_.insert(std::make_pair(start_node_->GetIndex(), start_node_));
-  open_pq_.push(
-      std::make_pair(start_node_->GetIndex(), start_node_->GetCost()));
+  node_table_.Insert(start_node_->GetIndex(), 0);
+  open_pq_.push(std::make_pair(0, start_node_->GetCost()));
 
   // Hybrid A* begins
   size_t explored_node_num = 0;
@@ -370,9 +432,8 @@ bool HybridAStar::Plan(
   double end_time = 0.0;
   while (!open_pq_.empty()) {
     // take out the lowest cost neighboring node
-    const std::string current_id = open_pq_.top().first;
+    std::shared_ptr<Node3d> current_node = node_pool_[open_pq_.top().first];
     open_pq_.pop();
-    std::shared_ptr<Node3d> current_node = open_set_[current_id];
     // check if a analystic curve could be connected from current
     // configuration to the end configuration without collision. if so, search
     // ends.
@@ -382,30 +443,31 @@ bool HybridAStar::Plan(
     }
     end_time = Clock::NowInSeconds();
     rs_time += end_time - start_time;
-    close_set_.insert(std::make_pair(current_node->GetIndex(), current_node));
     for (size_t i = 0; i < next_node_num_; ++i) {
       std::shared_ptr<Node3d> next_node = Next_node_generator(current_node, i);
       // boundary check failure handle
       if (next_node == nullptr) {
         continue;
       }
-      // check if the node is already in the close set
-      if (close_set_.find(next_node->GetIndex()) != close_set_.end()) {
+      // check if the node is already in the close set or the open set
+      if (node_table_.Find(next_node->GetIndex()) !=
+          NodeIndexTable::kNotFound) {
+        ReleaseLastNode();
         continue;
       }
       // collision check
       if (!ValidityCheck(next_node)) {
+        ReleaseLastNode();
         continue;
       }
-      if (open_set_.find(next_node->GetIndex()) == open_set_.end()) {
-        explored_node_num++;
-        start_time = Clock::NowInSeconds();
-        CalculateNodeCost(current_node, next_node);
-        end_time = Clock::NowInSeconds();
-        heuristic_time += end_time - start_time;
-        open_set_.emplace(next_node->GetIndex(), next_node);
-        open_pq_.emplace(next_node->GetIndex(), next_node->GetCost());
-      }
+      explored_node_num++;
+      start_time = Clock::NowInSeconds();
+      CalculateNodeCost(current_node, next_node);
+      end_time = Clock::NowInSeconds();
+      heuristic_time += end_time - start_time;
+      const int next_node_position = static_cast<int>(node_pool_size_ - 1);
+      node_table_.Insert(next_node->GetIndex(), next_node_position);
+      open_pq_.emplace(next_node_position, next_node->GetCost());
     }
   }
   if (final_node_ == nullptr) {
@@ -22,13 +22,13 @@
 
 #include <memory>
 #include <queue>
-#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "modules/planning/open_space/coarse_trajectory_generator/grid_search.h"
 #include "modules/planning/open_space/coarse_trajectory_generator/node3d.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/node_index_table.h"
 #include "modules/planning/open_space/coarse_trajectory_generator/reeds_shepp_path.h"
 
 #include "cyber/common/log.h"
@@ -70,6 +70,9 @@ class HybridAStar {
   bool AnalyticExpansion(std::shared_ptr<Node3d> current_node);
   // check collision and validity
   bool ValidityCheck(std::shared_ptr<Node3d> node);
+  bool ValidityCheck(const std::vector<double>& traversed_x,
+                     const std::vector<double>& traversed_y,
+                     const std::vector<double>& traversed_phi);
   // check Reeds Shepp path collision and validity
   bool RSPCheck(const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end);
   // load the whole RSP as nodes and add to the close set
@@ -85,6 +88,18 @@ class HybridAStar {
   double HoloObstacleHeuristic(std::shared_ptr<Node3d> next_node);
   bool GetResult(HybridAStartResult* result);
   bool GenerateSpeedAcceleration(HybridAStartResult* result);
+  // take a node from the pool, the returned node is the last one in the pool
+  std::shared_ptr<Node3d> NewNode(const std::vector<double>& traversed_x,
+                                  const std::vector<double>& traversed_y,
+                                  const std::vector<double>& traversed_phi);
+  // give the last taken node back to the pool
+  void ReleaseLastNode() { --node_pool_size_; }
+  // drop the cached analytic expansions if they were done toward another end
+  // pose or within other bounds or obstacles
+  void UpdateAnalyticExpansionCache(
+      double ex, double ey, double ephi, const std::vector<double>& XYbounds,
+      const std::vector<std::vector<common::math::Vec2d>>&
+          obstacles_vertices_vec);
 
  private:
   PlannerOpenSpaceConfig planner_open_space_config_;
@@ -113,16 +128,42 @@ class HybridAStar {
       obstacles_linesegments_vec_;
 
   struct cmp {
-    bool operator()(const std::pair<std::string, double>& left,
-                    const std::pair<std::string, double>& right) const {
+    bool operator()(const std::pair<int, double>& left,
+                    const std::pair<int, double>& right) const {
       return left.second >= right.second;
     }
   };
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
+  // open nodes given by their positions in the node pool
+  std::priority_queue<std::pair<int, double>,
+                      std::vector<std::pair<int, double>>, cmp>
       open_pq_;
-  std::unordered_map<std::string, std::shared_ptr<Node3d>> open_set_;
-  std::unordered_map<std::string, std::shared_ptr<Node3d>> close_set_;
+  // pooled nodes, the first node_pool_size_ of them belong to the current
+  // search. Nodes are reset in place instead of being reallocated.
+  std::vector<std::shared_ptr<Node3d>> node_pool_;
+  size_t node_pool_size_ = 0;
+  // packed grid index to position in the node pool of every node reached by
+  // the current search, open or closed
+  NodeIndexTable node_table_;
+  // buffers for the motion primitives of Next_node_generator
+  std::vector<double> intermediate_x_;
+  std::vector<double> intermediate_y_;
+  std::vector<double> intermediate_phi_;
+  std::shared_ptr<ReedSheppPath> reeds_shepp_to_check_ =
+      std::make_shared<ReedSheppPath>();
+
+  // start poses, by node grid index, from which the analytic expansion
+  // failed. They stay valid across searches with the same end pose, bounds
+  // and obstacles, e.g. when re-planning from an unchanged start pose.
+  struct FailedExpansion {
+    double x = 0.0;
+    double y = 0.0;
+    double phi = 0.0;
+  };
+  std::unordered_map<uint64_t, FailedExpansion> failed_expansions_;
+  std::vector<double> expansion_cache_end_pose_;
+  std::vector<double> expansion_cache_XYbounds_;
+  std::vector<std::vector<common::math::Vec2d>> expansion_cache_obstacles_;
+
   std::unique_ptr<ReedShepp> reed_shepp_generator_;
   std::unique_ptr<GridSearch> grid_a_star_heuristic_generator_;
 };
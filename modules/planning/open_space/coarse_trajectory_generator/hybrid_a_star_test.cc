@@ -74,5 +74,62 @@ TEST_F(HybridATest, test1) {
   ASSERT_TRUE(hybrid_test->Plan(sx, sy, sphi, ex, ey, ephi, XYbounds_,
                                 obstacles_list, &result));
 }
+
+namespace {
+// closed polygon of an axis aligned box as obstacle vertices
+std::vector<Vec2d> BoxObstacle(const double min_x, const double max_x,
+                               const double min_y, const double max_y) {
+  return {{min_x, min_y},
+          {max_x, min_y},
+          {max_x, max_y},
+          {min_x, max_y},
+          {min_x, min_y}};
+}
+
+// a perpendicular parking spot between two parked cars below the road
+std::vector<std::vector<Vec2d>> ParkingLotObstacles() {
+  std::vector<std::vector<Vec2d>> obstacles_list;
+  obstacles_list.emplace_back(BoxObstacle(-8.0, -1.8, -8.0, -2.0));
+  obstacles_list.emplace_back(BoxObstacle(1.8, 8.0, -8.0, -2.0));
+  obstacles_list.emplace_back(BoxObstacle(-15.0, 15.0, -9.5, -9.0));
+  obstacles_list.emplace_back(BoxObstacle(-15.0, 15.0, 7.0, 7.5));
+  return obstacles_list;
+}
+}  // namespace
+
+TEST_F(HybridATest, perpendicular_parking) {
+  const std::vector<double> XYbounds = {-15.0, 15.0, -10.0, 8.0};
+  HybridAStartResult result;
+  ASSERT_TRUE(hybrid_test->Plan(-10.0, 2.5, 0.0, 0.0, -5.5, M_PI_2, XYbounds,
+                                ParkingLotObstacles(), &result));
+  EXPECT_NEAR(result.x.back(), 0.0, 1e-3);
+  EXPECT_NEAR(result.y.back(), -5.5, 1e-3);
+}
+
+TEST_F(HybridATest, repeated_parking_benchmark) {
+  const std::vector<double> XYbounds = {-15.0, 15.0, -10.0, 8.0};
+  const auto obstacles_list = ParkingLotObstacles();
+  const int kNumRuns = 20;
+  double first_time = 0.0;
+  double repeated_time = 0.0;
+  std::vector<double> first_x;
+  for (int i = 0; i < kNumRuns; ++i) {
+    HybridAStartResult result;
+    const double start_time = common::time::Clock::NowInSeconds();
+    ASSERT_TRUE(hybrid_test->Plan(-10.0, 2.5, M_PI, 0.0, -5.5, M_PI_2,
+                                  XYbounds, obstacles_list, &result));
+    const double time = common::time::Clock::NowInSeconds() - start_time;
+    if (i == 0) {
+      first_time = time;
+      first_x = result.x;
+    } else {
+      repeated_time += time;
+      EXPECT_EQ(first_x, result.x);
+    }
+  }
+  AINFO << "hybrid a star planning time: first " << first_time * 1000.0
+        << " ms, repeated " << repeated_time / (kNumRuns - 1) * 1000.0
+        << " ms";
+}
 }  // namespace planning
 }  // namespace apollo
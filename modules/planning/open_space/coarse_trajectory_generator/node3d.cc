@@ -50,7 +50,7 @@ Node3d::Node3d(double x, double y, double phi,
   phi_grid_ = static_cast<size_t>(
       (phi_ - (-M_PI)) /
       open_space_conf.warm_start_config().phi_grid_resolution());
-  index_ = ComputeStringIndex(x_grid_, y_grid_, phi_grid_);
+  index_ = ComputeIndex(x_grid_, y_grid_, phi_grid_);
   traversed_x_.push_back(x);
   traversed_y_.push_back(y);
   traversed_phi_.push_back(phi);
@@ -61,6 +61,14 @@ Node3d::Node3d(const std::vector<double>& traversed_x,
                const std::vector<double>& traversed_phi,
                const std::vector<double>& XYbounds,
                const PlannerOpenSpaceConfig& open_space_conf) {
+  Reset(traversed_x, traversed_y, traversed_phi, XYbounds, open_space_conf);
+}
+
+void Node3d::Reset(const std::vector<double>& traversed_x,
+                   const std::vector<double>& traversed_y,
+                   const std::vector<double>& traversed_phi,
+                   const std::vector<double>& XYbounds,
+                   const PlannerOpenSpaceConfig& open_space_conf) {
   CHECK(XYbounds.size() == 4)
       << "XYbounds size is not 4, but" << XYbounds.size();
   x_ = traversed_x.back();
@@ -80,11 +88,17 @@ Node3d::Node3d(const std::vector<double>& traversed_x,
   phi_grid_ = static_cast<size_t>(
       (phi_ - (-M_PI)) /
       open_space_conf.warm_start_config().phi_grid_resolution());
-  index_ = ComputeStringIndex(x_grid_, y_grid_, phi_grid_);
-  traversed_x_ = traversed_x;
-  traversed_y_ = traversed_y;
-  traversed_phi_ = traversed_phi;
+  index_ = ComputeIndex(x_grid_, y_grid_, phi_grid_);
+  traversed_x_.assign(traversed_x.begin(), traversed_x.end());
+  traversed_y_.assign(traversed_y.begin(), traversed_y.end());
+  traversed_phi_.assign(traversed_phi.begin(), traversed_phi.end());
   step_size_ = traversed_x.size();
+  traj_cost_ = 0.0;
+  heuristic_cost_ = 0.0;
+  cost_ = 0.0;
+  pre_node_ = nullptr;
+  steering_ = 0.0;
+  direction_ = true;
 }
 
 Box2d Node3d::GetBoundingBox(const common::VehicleParam& vehicle_param_,
@@ -109,10 +123,12 @@ size_t Node3d::GetSize() const {
   return traversed_x_.size();
 }
 
-std::string Node3d::ComputeStringIndex(size_t x_grid, size_t y_grid,
-                                       size_t phi_grid) {
-  return std::to_string(x_grid) + "_" + std::to_string(y_grid) + "_" +
-         std::to_string(phi_grid);
+uint64_t Node3d::ComputeIndex(size_t x_grid, size_t y_grid,
+                              size_t phi_grid) {
+  constexpr uint64_t kGridMask = (1UL << 21) - 1;
+  return ((static_cast<uint64_t>(x_grid) & kGridMask) << 42) |
+         ((static_cast<uint64_t>(y_grid) & kGridMask) << 21) |
+         (static_cast<uint64_t>(phi_grid) & kGridMask);
 }
 
 }  // namespace planning
@@ -20,8 +20,8 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
-#include <string>
 #include <vector>
 
 #include "modules/planning/proto/planner_open_space_config.pb.h"
@@ -47,6 +47,12 @@ class Node3d {
          const std::vector<double>& XYbounds,
          const PlannerOpenSpaceConfig& open_space_conf);
   virtual ~Node3d() = default;
+  // reinitialize the node in place, so a pooled node keeps its buffers
+  void Reset(const std::vector<double>& traversed_x,
+             const std::vector<double>& traversed_y,
+             const std::vector<double>& traversed_phi,
+             const std::vector<double>& XYbounds,
+             const PlannerOpenSpaceConfig& open_space_conf);
   static Box2d GetBoundingBox(const common::VehicleParam& vehicle_param_,
                               const double x, const double y, const double phi);
   double GetCost() const { return traj_cost_ + heuristic_cost_; }
@@ -59,7 +65,7 @@ class Node3d {
   double GetY() const { return y_; }
   double GetPhi() const { return phi_; }
   bool operator==(const Node3d& right) const;
-  const std::string& GetIndex() const { return index_; }
+  uint64_t GetIndex() const { return index_; }
   size_t GetStepSize() const { return step_size_; }
   bool GetDirec() const { return direction_; }
   double GetSteer() const { return steering_; }
@@ -75,8 +81,8 @@ class Node3d {
   void SetSteer(double steering) { steering_ = steering; }
 
  private:
-  static std::string ComputeStringIndex(size_t x_grid, size_t y_grid,
-                                  size_t phi_grid);
+  // pack the grid indices into one integer, 21 bits for each of them
+  static uint64_t ComputeIndex(size_t x_grid, size_t y_grid, size_t phi_grid);
 
  private:
   double x_ = 0.0;
@@ -89,7 +95,7 @@ class Node3d {
   size_t x_grid_ = 0;
   size_t y_grid_ = 0;
   size_t phi_grid_ = 0;
-  std::string index_;
+  uint64_t index_ = 0;
   double traj_cost_ = 0.0;
   double heuristic_cost_ = 0.0;
   double cost_ = 0.0;
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/*
+ * @file
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace apollo {
+namespace planning {
+
+// Open addressing hash table from packed node grid indices to positions of
+// the nodes in a node pool. Entries are never erased during a search, so
+// linear probing works without tombstones. Clear() keeps the capacity, so
+// repeated searches do not allocate once the table has grown.
+class NodeIndexTable {
+ public:
+  static constexpr int kNotFound = -1;
+
+  NodeIndexTable() { Rehash(kMinCapacity); }
+
+  void Clear() {
+    values_.assign(values_.size(), int{kNotFound});
+    size_ = 0;
+  }
+
+  size_t size() const { return size_; }
+
+  int Find(const uint64_t key) const {
+    for (size_t slot = Slot(key);; slot = (slot + 1) & mask_) {
+      if (values_[slot] == kNotFound || keys_[slot] == key) {
+        return values_[slot];
+      }
+    }
+  }
+
+  // returns false and keeps the old value if the key is already present
+  bool Insert(const uint64_t key, const int value) {
+    if ((size_ + 1) * 2 > values_.size()) {
+      Rehash(values_.size() * 2);
+    }
+    size_t slot = Slot(key);
+    while (values_[slot] != kNotFound) {
+      if (keys_[slot] == key) {
+        return false;
+      }
+      slot = (slot + 1) & mask_;
+    }
+    keys_[slot] = key;
+    values_[slot] = value;
+    ++size_;
+    return true;
+  }
+
+ private:
+  static constexpr size_t kMinCapacity = 1024;
+
+  size_t Slot(uint64_t key) const {
+    // finalizer of splitmix64, spreads the packed grid indices over all bits
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return static_cast<size_t>(key) & mask_;
+  }
+
+  void Rehash(const size_t capacity) {
+    std::vector<uint64_t> old_keys;
+    std::vector<int> old_values;
+    old_keys.swap(keys_);
+    old_values.swap(values_);
+    keys_.assign(capacity, 0);
+    values_.assign(capacity, int{kNotFound});
+    mask_ = capacity - 1;
+    size_ = 0;
+    for (size_t i = 0; i < old_values.size(); ++i) {
+      if (old_values[i] != kNotFound) {
+        Insert(old_keys[i], old_values[i]);
+      }
+    }
+  }
+
+ private:
+  std::vector<uint64_t> keys_;
+  std::vector<int> values_;
+  size_t mask_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace planning
+}  // namespace apollo
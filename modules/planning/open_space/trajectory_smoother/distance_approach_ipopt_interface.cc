@@ -107,6 +107,15 @@ DistanceApproachIPOPTInterface::DistanceApproachIPOPTInterface(
   wheelbase_ = vehicle_param_.wheel_base();
   enable_constraint_check_ =
       distance_approach_config_.enable_constraint_check();
+  enable_jacobian_ad_ = distance_approach_config_.enable_jacobian_ad();
+}
+
+DistanceApproachIPOPTInterface::~DistanceApproachIPOPTInterface() {
+  // finalize_solution is not reached when no solve is run on the tapes, so
+  // the jacobian buffers allocated by ADOL-C are released here as well.
+  free(rind_g);
+  free(cind_g);
+  free(jacval);
 }
 
 bool DistanceApproachIPOPTInterface::get_nlp_info(int& n, int& m,
@@ -152,17 +161,19 @@ bool DistanceApproachIPOPTInterface::get_nlp_info(int& n, int& m,
   m = num_of_constraints_;
   ADEBUG << "num_of_constraints_ " << num_of_constraints_;
 
-  generate_tapes(n, m, &nnz_h_lag);
-  // // number of nonzero in Jacobian.
-  int tmp = 0;
-  for (int i = 0; i < horizon_ + 1; ++i) {
-    for (int j = 0; j < obstacles_num_; ++j) {
-      int current_edges_num = obstacles_edges_num_(j, 0);
-      tmp += current_edges_num * 4 + 9 + 4;
+  generate_tapes(n, m, &nnz_jac_g, &nnz_h_lag);
+  if (!enable_jacobian_ad_) {
+    // // number of nonzero in Jacobian.
+    int tmp = 0;
+    for (int i = 0; i < horizon_ + 1; ++i) {
+      for (int j = 0; j < obstacles_num_; ++j) {
+        int current_edges_num = obstacles_edges_num_(j, 0);
+        tmp += current_edges_num * 4 + 9 + 4;
+      }
     }
+    nnz_jac_g = 24 * horizon_ + 3 * horizon_ + 2 * horizon_ + tmp - 1 +
+                (num_of_variables_ - (horizon_ + 1) + 2);
   }
-  nnz_jac_g = 24 * horizon_ + 3 * horizon_ + 2 * horizon_ + tmp - 1 +
-              (num_of_variables_ - (horizon_ + 1) + 2);
 
   index_style = IndexStyleEnum::C_STYLE;
   ADEBUG << "get_nlp_info out";
@@ -572,6 +583,23 @@ bool DistanceApproachIPOPTInterface::eval_jac_g(int n, const double* x,
                                                 bool new_x, int m, int nele_jac,
                                                 int* iRow, int* jCol,
                                                 double* values) {
+  if (enable_jacobian_ad_) {
+    if (values == nullptr) {
+      // return the structure of the jacobian
+      for (int idx = 0; idx < nnz_jac; idx++) {
+        iRow[idx] = rind_g[idx];
+        jCol[idx] = cind_g[idx];
+      }
+    } else {
+      // return the values of the jacobian of the constraints
+      sparse_jac(tag_g, m, n, 1, x, &nnz_jac, &rind_g, &cind_g, &jacval,
+                 options_g);
+      for (int idx = 0; idx < nnz_jac; idx++) {
+        values[idx] = jacval[idx];
+      }
+    }
+    return true;
+  }
   if (!FLAGS_enable_parallel_open_space_smoother) {
     return eval_jac_g_ser(n, x, new_x, m, nele_jac, iRow, jCol, values);
   } else {
@@ -2369,6 +2397,12 @@ void DistanceApproachIPOPTInterface::finalize_solution(
   }
   // memory deallocation of ADOL-C variables
   delete[] obj_lam;
+  free(rind_g);
+  free(cind_g);
+  free(jacval);
+  rind_g = nullptr;
+  cind_g = nullptr;
+  jacval = nullptr;
   free(rind_L);
   free(cind_L);
   free(hessval);
@@ -2810,6 +2844,7 @@ bool DistanceApproachIPOPTInterface::check_g(int n, const double* x, int m,
 }
 
 void DistanceApproachIPOPTInterface::generate_tapes(int n, int m,
+                                                    int* nnz_jac_g,
                                                     int* nnz_h_lag) {
   double* xp = new double[n];
   double* lamp = new double[m];
@@ -2877,6 +2912,26 @@ void DistanceApproachIPOPTInterface::generate_tapes(int n, int m,
 
   trace_off();
 
+  if (enable_jacobian_ad_) {
+    // the sparsity pattern is computed once here and reused by every
+    // repeat = 1 call in eval_jac_g
+    free(rind_g);
+    free(cind_g);
+    free(jacval);
+    rind_g = nullptr;
+    cind_g = nullptr;
+    jacval = nullptr;
+
+    options_g[0] = 0; /* sparsity pattern by index domains (default) */
+    options_g[1] = 0; /*                         safe mode (default) */
+    options_g[2] = 0;
+    options_g[3] = 0; /*                column compression (default) */
+
+    sparse_jac(tag_g, m, n, 0, xp, &nnz_jac, &rind_g, &cind_g, &jacval,
+               options_g);
+    *nnz_jac_g = nnz_jac;
+  }
+
   rind_L = NULL;
   cind_L = NULL;
 
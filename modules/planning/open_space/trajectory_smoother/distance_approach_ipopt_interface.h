@@ -62,7 +62,7 @@ class DistanceApproachIPOPTInterface : public DistanceApproachInterface {
       const Eigen::MatrixXd& obstacles_A, const Eigen::MatrixXd& obstacles_b,
       const PlannerOpenSpaceConfig& planner_open_space_config);
 
-  virtual ~DistanceApproachIPOPTInterface() = default;
+  virtual ~DistanceApproachIPOPTInterface();
 
   /** Method to return some info about the nlp */
   bool get_nlp_info(int& n, int& m, int& nnz_jac_g, int& nnz_h_lag,  // NOLINT
@@ -138,7 +138,7 @@ class DistanceApproachIPOPTInterface : public DistanceApproachInterface {
   bool eval_constraints(int n, const T* x, int m, T* g);
 
   /** Method to generate the required tapes by ADOL-C*/
-  void generate_tapes(int n, int m, int* nnz_h_lag);
+  void generate_tapes(int n, int m, int* nnz_jac_g, int* nnz_h_lag);
   //***************    end   ADOL-C part ***********************************
 
  private:
@@ -161,6 +161,9 @@ class DistanceApproachIPOPTInterface : public DistanceApproachInterface {
   // debug flag
   bool enable_constraint_check_;
 
+  // whether to evaluate the constraint jacobian with ADOL-C
+  bool enable_jacobian_ad_ = false;
+
   // penalty
   double weight_state_x_ = 0.0;
   double weight_state_y_ = 0.0;
@@ -247,6 +250,12 @@ class DistanceApproachIPOPTInterface : public DistanceApproachInterface {
  private:
   //***************    start ADOL-C part ***********************************
   double* obj_lam;
+  //** variables for sparsity exploitation
+  unsigned int* rind_g = nullptr; /* row indices    */
+  unsigned int* cind_g = nullptr; /* column indices */
+  double* jacval = nullptr;       /* values         */
+  int nnz_jac = 0;
+  int options_g[4];
   unsigned int* rind_L; /* row indices    */
   unsigned int* cind_L; /* column indices */
   double* hessval;      /* values */
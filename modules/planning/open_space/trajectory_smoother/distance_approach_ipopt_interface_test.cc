@@ -19,8 +19,15 @@
  **/
 #include "modules/planning/open_space/trajectory_smoother/distance_approach_ipopt_interface.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
 
 #include "cyber/common/file.h"
 #include "gtest/gtest.h"
@@ -169,6 +176,95 @@ TEST_F(DistanceApproachIPOPTInterfaceTest, eval_jac_g_par) {
   }
 }
 
+TEST_F(DistanceApproachIPOPTInterfaceTest, eval_jac_g_ad) {
+  int n = 1274;
+  int m = 2194;
+  int nnz_jac_hand = 0;
+  int nnz_h_lag = 0;
+  Ipopt::TNLP::IndexStyleEnum index_style;
+  bool res =
+      ptop_->get_nlp_info(n, m, nnz_jac_hand, nnz_h_lag, index_style);
+  EXPECT_TRUE(res);
+
+  // the tapes are recorded at the starting point, so compare at a random
+  // point away from it to check that the taped Jacobian still holds there
+  double x[1274];
+  std::mt19937 gen(2019);
+  std::uniform_real_distribution<double> dist(0.5, 2.0);
+  std::generate_n(x, n, [&]() { return dist(gen); });
+  std::vector<int> i_row_hand(nnz_jac_hand);
+  std::vector<int> j_col_hand(nnz_jac_hand);
+  std::vector<double> values_hand(nnz_jac_hand, 0.0);
+  EXPECT_TRUE(ptop_->eval_jac_g_ser(n, x, true, m, nnz_jac_hand,
+                                    i_row_hand.data(), j_col_hand.data(),
+                                    nullptr));
+  EXPECT_TRUE(ptop_->eval_jac_g_ser(n, x, true, m, nnz_jac_hand,
+                                    i_row_hand.data(), j_col_hand.data(),
+                                    values_hand.data()));
+
+  planner_open_space_config_.mutable_distance_approach_config()
+      ->set_enable_jacobian_ad(true);
+  ProblemSetup();
+  int nnz_jac_ad = 0;
+  res = ptop_->get_nlp_info(n, m, nnz_jac_ad, nnz_h_lag, index_style);
+  EXPECT_TRUE(res);
+  EXPECT_GT(nnz_jac_ad, 0);
+
+  std::vector<int> i_row_ad(nnz_jac_ad);
+  std::vector<int> j_col_ad(nnz_jac_ad);
+  std::vector<double> values_ad(nnz_jac_ad, 0.0);
+  EXPECT_TRUE(ptop_->eval_jac_g(n, x, true, m, nnz_jac_ad, i_row_ad.data(),
+                                j_col_ad.data(), nullptr));
+  EXPECT_TRUE(ptop_->eval_jac_g(n, x, true, m, nnz_jac_ad, i_row_ad.data(),
+                                j_col_ad.data(), values_ad.data()));
+
+  // the two backends order (and may duplicate) entries differently, so
+  // compare the accumulated value of every structural entry
+  std::map<std::pair<int, int>, double> jac_hand;
+  for (int i = 0; i < nnz_jac_hand; ++i) {
+    jac_hand[{i_row_hand[i], j_col_hand[i]}] += values_hand[i];
+  }
+  std::map<std::pair<int, int>, double> jac_ad;
+  for (int i = 0; i < nnz_jac_ad; ++i) {
+    jac_ad[{i_row_ad[i], j_col_ad[i]}] += values_ad[i];
+  }
+  for (const auto& entry : jac_ad) {
+    auto it = jac_hand.find(entry.first);
+    const double hand_value = it == jac_hand.end() ? 0.0 : it->second;
+    EXPECT_NEAR(entry.second, hand_value,
+                1e-6 * std::max(1.0, std::fabs(hand_value)))
+        << "jacobian differ at (" << entry.first.first << ", "
+        << entry.first.second << ")";
+  }
+  for (const auto& entry : jac_hand) {
+    if (jac_ad.count(entry.first) == 0) {
+      EXPECT_NEAR(entry.second, 0.0, 1e-6)
+          << "jacobian differ at (" << entry.first.first << ", "
+          << entry.first.second << ")";
+    }
+  }
+
+  constexpr int kRepeat = 20;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRepeat; ++i) {
+    ptop_->eval_jac_g(n, x, true, m, nnz_jac_ad, i_row_ad.data(),
+                      j_col_ad.data(), values_ad.data());
+  }
+  auto mid = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRepeat; ++i) {
+    ptop_->eval_jac_g_ser(n, x, true, m, nnz_jac_hand, i_row_hand.data(),
+                          j_col_hand.data(), values_hand.data());
+  }
+  auto end = std::chrono::steady_clock::now();
+  AINFO << "jacobian evaluation, ad: "
+        << std::chrono::duration<double, std::milli>(mid - start).count() /
+               kRepeat
+        << " ms (nnz " << nnz_jac_ad << "), hand: "
+        << std::chrono::duration<double, std::milli>(end - mid).count() /
+               kRepeat
+        << " ms (nnz " << nnz_jac_hand << ")";
+}
+
 TEST_F(DistanceApproachIPOPTInterfaceTest, eval_grad_f_hand) {
   int n = 1274;
   double x[1274];
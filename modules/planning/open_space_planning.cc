@@ -92,8 +92,11 @@ Status OpenSpacePlanning::Init(const PlanningConfig& config) {
 Status OpenSpacePlanning::InitFrame(const uint32_t sequence_num,
                                     const TrajectoryPoint& planning_start_point,
                                     const VehicleState& vehicle_state) {
-  frame_.reset(new Frame(sequence_num, local_view_, planning_start_point,
-                         vehicle_state));
+  auto* frame_pool = FramePool::Instance();
+  frame_ = frame_pool->Acquire(sequence_num, local_view_, planning_start_point,
+                               vehicle_state, nullptr);
+  ADEBUG << "Frame pool: " << frame_pool->num_allocated()
+         << " frames allocated, " << frame_pool->num_reused() << " reused.";
   if (frame_ == nullptr) {
     return Status(ErrorCode::PLANNING_ERROR, "Fail to init frame: nullptr.");
   }
@@ -20,6 +20,8 @@
 
 #include "modules/planning/planner/lattice/lattice_planner.h"
 
+#include <algorithm>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -27,6 +29,7 @@
 
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
+#include "cyber/task/task.h"
 #include "modules/common/math/cartesian_frenet_conversion.h"
 #include "modules/common/math/path_matcher.h"
 #include "modules/common/time/time.h"
@@ -77,6 +80,32 @@ std::vector<PathPoint> ToDiscretizedReferenceLine(
   return path_points;
 }
 
+using Trajectory1dPair =
+    std::pair<std::shared_ptr<Curve1d>, std::shared_ptr<Curve1d>>;
+
+// a trajectory combined from a pair of 1d trajectories and its check results
+struct CheckedCandidate {
+  DiscretizedTrajectory trajectory;
+  ConstraintChecker::Result result = ConstraintChecker::Result::VALID;
+  bool in_collision = false;
+};
+
+void CheckCandidate(const std::vector<PathPoint>& reference_line,
+                    const Trajectory1dPair& trajectory_pair,
+                    const double init_relative_time,
+                    const CollisionChecker& collision_checker,
+                    CheckedCandidate* candidate) {
+  // combine two 1d trajectories to one 2d trajectory
+  candidate->trajectory =
+      TrajectoryCombiner::Combine(reference_line, *trajectory_pair.first,
+                                  *trajectory_pair.second, init_relative_time);
+  candidate->result = ConstraintChecker::ValidTrajectory(candidate->trajectory);
+  if (candidate->result == ConstraintChecker::Result::VALID) {
+    candidate->in_collision =
+        collision_checker.InCollision(candidate->trajectory);
+  }
+}
+
 void ComputeInitFrenetState(const PathPoint& matched_point,
                             const TrajectoryPoint& cartesian_state,
                             std::array<double, 3>* ptr_s,
@@ -186,6 +215,7 @@ Status LatticePlanner::PlanOnReferenceLine(
   // 5. generate 1d trajectory bundle for longitudinal and lateral respectively.
   Trajectory1dGenerator trajectory1d_generator(
       init_s, init_d, ptr_path_time_graph, ptr_prediction_querier);
+  trajectory1d_generator.SetLateralQpWorkspace(&lateral_qp_workspace_);
   std::vector<std::shared_ptr<Curve1d>> lon_trajectory1d_bundle;
   std::vector<std::shared_ptr<Curve1d>> lat_trajectory1d_bundle;
   trajectory1d_generator.GenerateTrajectoryBundles(
@@ -213,9 +243,9 @@ Status LatticePlanner::PlanOnReferenceLine(
          << "  number_lat_traj = " << lat_trajectory1d_bundle.size();
 
   // Get instance of collision checker and constraint checker
-  CollisionChecker collision_checker(frame->obstacles(), init_s[0], init_d[0],
-                                     *ptr_reference_line, reference_line_info,
-                                     ptr_path_time_graph);
+  auto ptr_collision_checker = std::make_shared<CollisionChecker>(
+      frame->obstacles(), init_s[0], init_d[0], *ptr_reference_line,
+      reference_line_info, ptr_path_time_graph);
 
   // 7. always get the best pair of trajectories to combine; return the first
   // collision-free trajectory.
@@ -232,104 +262,134 @@ Status LatticePlanner::PlanOnReferenceLine(
 
   size_t num_lattice_traj = 0;
 
-  while (trajectory_evaluator.has_more_trajectory_pairs()) {
-    double trajectory_pair_cost =
-        trajectory_evaluator.top_trajectory_pair_cost();
-    auto trajectory_pair = trajectory_evaluator.next_top_trajectory_pair();
-
-    // combine two 1d trajectories to one 2d trajectory
-    auto combined_trajectory = TrajectoryCombiner::Combine(
-        *ptr_reference_line, *trajectory_pair.first, *trajectory_pair.second,
-        planning_init_point.relative_time());
-
-    // check longitudinal and lateral acceleration
-    // considering trajectory curvatures
-    auto result = ConstraintChecker::ValidTrajectory(combined_trajectory);
-    if (result != ConstraintChecker::Result::VALID) {
-      ++combined_constraint_failure_count;
-
-      switch (result) {
-        case ConstraintChecker::Result::LON_VELOCITY_OUT_OF_BOUND:
-          lon_vel_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::LON_ACCELERATION_OUT_OF_BOUND:
-          lon_acc_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::LON_JERK_OUT_OF_BOUND:
-          lon_jerk_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::CURVATURE_OUT_OF_BOUND:
-          curvature_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::LAT_ACCELERATION_OUT_OF_BOUND:
-          lat_acc_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::LAT_JERK_OUT_OF_BOUND:
-          lat_jerk_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::VALID:
-        default:
-          // Intentional empty
-          break;
-      }
-      continue;
+  const size_t batch_size =
+      FLAGS_enable_multi_thread_in_lattice_planner
+          ? static_cast<size_t>(std::max(1, FLAGS_lattice_candidate_batch_size))
+          : 1;
+  while (num_lattice_traj == 0 &&
+         trajectory_evaluator.has_more_trajectory_pairs()) {
+    // take the next top pairs and check them concurrently. They are inspected
+    // in cost order below, so the chosen trajectory is the same as when the
+    // pairs are checked one by one.
+    std::vector<double> pair_costs;
+    std::vector<Trajectory1dPair> trajectory_pairs;
+    while (trajectory_pairs.size() < batch_size &&
+           trajectory_evaluator.has_more_trajectory_pairs()) {
+      pair_costs.push_back(trajectory_evaluator.top_trajectory_pair_cost());
+      trajectory_pairs.push_back(
+          trajectory_evaluator.next_top_trajectory_pair());
     }
-
-    // check collision with other obstacles
-    if (collision_checker.InCollision(combined_trajectory)) {
-      ++collision_failure_count;
-      continue;
+    std::vector<CheckedCandidate> candidates(trajectory_pairs.size());
+    std::vector<std::future<void>> results;
+    for (size_t i = 1; i < trajectory_pairs.size(); ++i) {
+      results.push_back(cyber::Async(
+          &CheckCandidate, std::cref(*ptr_reference_line),
+          std::cref(trajectory_pairs[i]), planning_init_point.relative_time(),
+          std::cref(*ptr_collision_checker), &candidates[i]));
+    }
+    CheckCandidate(*ptr_reference_line, trajectory_pairs[0],
+                   planning_init_point.relative_time(), *ptr_collision_checker,
+                   &candidates[0]);
+    for (auto& result : results) {
+      result.get();
     }
 
-    // put combine trajectory into debug data
-    const auto& combined_trajectory_points = combined_trajectory;
-    num_lattice_traj += 1;
-    reference_line_info->SetTrajectory(combined_trajectory);
-    reference_line_info->SetCost(reference_line_info->PriorityCost() +
-                                 trajectory_pair_cost);
-    reference_line_info->SetDrivable(true);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      const double trajectory_pair_cost = pair_costs[i];
+      const auto& trajectory_pair = trajectory_pairs[i];
+      const auto& combined_trajectory = candidates[i].trajectory;
+
+      // check longitudinal and lateral acceleration
+      // considering trajectory curvatures
+      auto result = candidates[i].result;
+      if (result != ConstraintChecker::Result::VALID) {
+        ++combined_constraint_failure_count;
+
+        switch (result) {
+          case ConstraintChecker::Result::LON_VELOCITY_OUT_OF_BOUND:
+            lon_vel_failure_count += 1;
+            break;
+          case ConstraintChecker::Result::LON_ACCELERATION_OUT_OF_BOUND:
+            lon_acc_failure_count += 1;
+            break;
+          case ConstraintChecker::Result::LON_JERK_OUT_OF_BOUND:
+            lon_jerk_failure_count += 1;
+            break;
+          case ConstraintChecker::Result::CURVATURE_OUT_OF_BOUND:
+            curvature_failure_count += 1;
+            break;
+          case ConstraintChecker::Result::LAT_ACCELERATION_OUT_OF_BOUND:
+            lat_acc_failure_count += 1;
+            break;
+          case ConstraintChecker::Result::LAT_JERK_OUT_OF_BOUND:
+            lat_jerk_failure_count += 1;
+            break;
+          case ConstraintChecker::Result::VALID:
+          default:
+            // Intentional empty
+            break;
+        }
+        continue;
+      }
 
-    // Print the chosen end condition and start condition
-    ADEBUG << "Starting Lon. State: s = " << init_s[0] << " ds = " << init_s[1]
-           << " dds = " << init_s[2];
-    // cast
-    auto lattice_traj_ptr =
-        std::dynamic_pointer_cast<LatticeTrajectory1d>(trajectory_pair.first);
-    if (!lattice_traj_ptr) {
-      ADEBUG << "Dynamically casting trajectory1d ptr. failed.";
-    }
+      // check collision with other obstacles
+      if (candidates[i].in_collision) {
+        ++collision_failure_count;
+        continue;
+      }
 
-    if (lattice_traj_ptr->has_target_position()) {
-      ADEBUG << "Ending Lon. State s = " << lattice_traj_ptr->target_position()
-             << " ds = " << lattice_traj_ptr->target_velocity()
-             << " t = " << lattice_traj_ptr->target_time();
-    }
+      // put combine trajectory into debug data
+      const auto& combined_trajectory_points = combined_trajectory;
+      num_lattice_traj += 1;
+      reference_line_info->SetTrajectory(combined_trajectory);
+      reference_line_info->SetCost(reference_line_info->PriorityCost() +
+                                   trajectory_pair_cost);
+      reference_line_info->SetDrivable(true);
 
-    ADEBUG << "InputPose";
-    ADEBUG << "XY: " << planning_init_point.ShortDebugString();
-    ADEBUG << "S: (" << init_s[0] << ", " << init_s[1] << "," << init_s[2]
-           << ")";
-    ADEBUG << "L: (" << init_d[0] << ", " << init_d[1] << "," << init_d[2]
-           << ")";
-
-    ADEBUG << "Reference_line_priority_cost = "
-           << reference_line_info->PriorityCost();
-    ADEBUG << "Total_Trajectory_Cost = " << trajectory_pair_cost;
-    ADEBUG << "OutputTrajectory";
-    for (uint i = 0; i < 10; ++i) {
-      ADEBUG << combined_trajectory_points[i].ShortDebugString();
-    }
+      // Print the chosen end condition and start condition
+      ADEBUG << "Starting Lon. State: s = " << init_s[0]
+             << " ds = " << init_s[1] << " dds = " << init_s[2];
+      // cast
+      auto lattice_traj_ptr =
+          std::dynamic_pointer_cast<LatticeTrajectory1d>(trajectory_pair.first);
+      if (!lattice_traj_ptr) {
+        ADEBUG << "Dynamically casting trajectory1d ptr. failed.";
+      }
 
-    break;
-    /*
-    auto combined_trajectory_path =
-        ptr_debug->mutable_planning_data()->add_trajectory_path();
-    for (uint i = 0; i < combined_trajectory_points.size(); ++i) {
-      combined_trajectory_path->add_trajectory_point()->CopyFrom(
-          combined_trajectory_points[i]);
+      if (lattice_traj_ptr->has_target_position()) {
+        ADEBUG << "Ending Lon. State s = "
+               << lattice_traj_ptr->target_position() << " ds = "
+               << lattice_traj_ptr->target_velocity()
+               << " t = " << lattice_traj_ptr->target_time();
+      }
+
+      ADEBUG << "InputPose";
+      ADEBUG << "XY: " << planning_init_point.ShortDebugString();
+      ADEBUG << "S: (" << init_s[0] << ", " << init_s[1] << "," << init_s[2]
+             << ")";
+      ADEBUG << "L: (" << init_d[0] << ", " << init_d[1] << "," << init_d[2]
+             << ")";
+
+      ADEBUG << "Reference_line_priority_cost = "
+             << reference_line_info->PriorityCost();
+      ADEBUG << "Total_Trajectory_Cost = " << trajectory_pair_cost;
+      ADEBUG << "OutputTrajectory";
+      for (uint i = 0; i < 10; ++i) {
+        ADEBUG << combined_trajectory_points[i].ShortDebugString();
+      }
+
+      break;
+      /*
+      auto combined_trajectory_path =
+          ptr_debug->mutable_planning_data()->add_trajectory_path();
+      for (uint i = 0; i < combined_trajectory_points.size(); ++i) {
+        combined_trajectory_path->add_trajectory_point()->CopyFrom(
+            combined_trajectory_points[i]);
+      }
+      combined_trajectory_path->set_lattice_trajectory_cost(
+          trajectory_pair_cost);
+      */
     }
-    combined_trajectory_path->set_lattice_trajectory_cost(trajectory_pair_cost);
-    */
   }
 
   ADEBUG << "Trajectory_Evaluation_Time = "
@@ -357,8 +417,7 @@ Status LatticePlanner::PlanOnReferenceLine(
       AERROR << "Use backup trajectory";
       BackupTrajectoryGenerator backup_trajectory_generator(
           init_s, init_d, planning_init_point.relative_time(),
-          std::make_shared<CollisionChecker>(collision_checker),
-          &trajectory1d_generator);
+          ptr_collision_checker, &trajectory1d_generator);
       DiscretizedTrajectory trajectory =
           backup_trajectory_generator.GenerateTrajectory(*ptr_reference_line);
 
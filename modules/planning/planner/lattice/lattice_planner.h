@@ -25,6 +25,7 @@
 #include "modules/common/status/status.h"
 #include "modules/planning/common/frame.h"
 #include "modules/planning/common/reference_line_info.h"
+#include "modules/planning/math/osqp_workspace.h"
 #include "modules/planning/planner/planner.h"
 #include "modules/planning/proto/planning_config.pb.h"
 
@@ -65,6 +66,9 @@ class LatticePlanner : public PlannerWithReferenceLine {
   common::Status PlanOnReferenceLine(
       const common::TrajectoryPoint& planning_init_point, Frame* frame,
       ReferenceLineInfo* reference_line_info) override;
+
+ private:
+  OsqpWorkspace lateral_qp_workspace_{"LatticeLateral"};
 };
 
 }  // namespace planning
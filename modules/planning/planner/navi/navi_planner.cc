@@ -33,6 +33,7 @@
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/planning/common/ego_info.h"
 #include "modules/planning/common/frame.h"
+#include "modules/planning/common/latency_histograms.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/constraint_checker/constraint_checker.h"
 #include "modules/planning/navi/decider/navi_obstacle_decider.h"
@@ -161,13 +162,15 @@ Status NaviPlanner::PlanOnReferenceLine(
   for (auto& task : tasks_) {
     const double start_timestamp = Clock::NowInSeconds();
     ret = task->Execute(frame, reference_line_info);
+    const double end_timestamp = Clock::NowInSeconds();
+    const double time_diff_ms = (end_timestamp - start_timestamp) * 1000;
+    LatencyHistograms::Instance()->Record(
+        LatencyHistograms::TASK, "NaviPlanner/" + task->Name(), time_diff_ms);
     if (!ret.ok()) {
       AERROR << "Failed to run tasks[" << task->Name()
              << "], Error message: " << ret.error_message();
       break;
     }
-    const double end_timestamp = Clock::NowInSeconds();
-    const double time_diff_ms = (end_timestamp - start_timestamp) * 1000;
 
     ADEBUG << "after task " << task->Name() << ":"
            << reference_line_info->PathSpeedDebugString() << std::endl;
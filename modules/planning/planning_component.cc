@@ -22,6 +22,7 @@
 #include "modules/common/util/util.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/map/pnc_map/pnc_map.h"
+#include "modules/planning/common/latency_histograms.h"
 #include "modules/planning/common/planning_context.h"
 #include "modules/planning/navi_planning.h"
 #include "modules/planning/on_lane_planning.h"
@@ -93,6 +94,9 @@ bool PlanningComponent::Init() {
   rerouting_writer_ =
       node_->CreateWriter<RoutingRequest>(FLAGS_routing_request_topic);
 
+  latency_writer_ =
+      node_->CreateWriter<PlanningLatency>(FLAGS_planning_latency_topic);
+
   return true;
 }
 
@@ -145,9 +149,27 @@ bool PlanningComponent::Proc(
     p.set_relative_time(p.relative_time() + dt);
   }
   planning_writer_->Write(std::make_shared<ADCTrajectory>(adc_trajectory_pb));
+  PublishLatency();
   return true;
 }
 
+void PlanningComponent::PublishLatency() {
+  if (!FLAGS_enable_latency_histograms ||
+      FLAGS_latency_histograms_publish_interval <= 0) {
+    return;
+  }
+  if (++num_cycles_since_latency_published_ <
+      FLAGS_latency_histograms_publish_interval) {
+    return;
+  }
+  num_cycles_since_latency_published_ = 0;
+  auto latency = std::make_shared<PlanningLatency>();
+  LatencyHistograms::Instance()->GetLatency(latency.get());
+  LatencyHistograms::Instance()->Clear();
+  common::util::FillHeader(node_->Name(), latency.get());
+  latency_writer_->Write(latency);
+}
+
 void PlanningComponent::CheckRerouting() {
   auto* rerouting =
       PlanningContext::MutablePlanningStatus()->mutable_rerouting();
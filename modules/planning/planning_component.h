@@ -30,6 +30,7 @@
 #include "modules/planning/proto/pad_msg.pb.h"
 #include "modules/planning/proto/planning.pb.h"
 #include "modules/planning/proto/planning_config.pb.h"
+#include "modules/planning/proto/planning_stats.pb.h"
 #include "modules/prediction/proto/prediction_obstacle.pb.h"
 #include "modules/routing/proto/routing.pb.h"
 
@@ -56,6 +57,7 @@ class PlanningComponent final
  private:
   void CheckRerouting();
   bool CheckInput();
+  void PublishLatency();
 
   std::shared_ptr<cyber::Reader<perception::TrafficLightDetection>>
       traffic_light_reader_;
@@ -65,6 +67,8 @@ class PlanningComponent final
 
   std::shared_ptr<cyber::Writer<ADCTrajectory>> planning_writer_;
   std::shared_ptr<cyber::Writer<routing::RoutingRequest>> rerouting_writer_;
+  std::shared_ptr<cyber::Writer<PlanningLatency>> latency_writer_;
+  int num_cycles_since_latency_published_ = 0;
 
   std::mutex mutex_;
   perception::TrafficLightDetection traffic_light_;
@@ -16,6 +16,8 @@
 
 #include "modules/planning/reference_line/cos_theta_reference_line_smoother.h"
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 #include "IpIpoptApplication.hpp"
@@ -23,6 +25,7 @@
 
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
+#include "modules/common/math/math_utils.h"
 #include "modules/common/time/time.h"
 #include "modules/common/util/util.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -57,12 +60,24 @@ CosThetaReferenceLineSmoother::CosThetaReferenceLineSmoother(
   relax_ = config.cos_theta().relax();
 
   reopt_qp_bound_ = config.cos_theta().reopt_qp_bound();
+
+  if (config.cos_theta().use_sqp()) {
+    sqp_solver_.reset(new CosThetaSqpSolver(config.cos_theta()));
+  }
 }
 
 bool CosThetaReferenceLineSmoother::Smooth(
     const ReferenceLine& raw_reference_line,
     ReferenceLine* const smoothed_reference_line) {
   const double start_timestamp = Clock::NowInSeconds();
+  ++num_smoothed_;
+  last_sqp_solved_ = false;
+  last_warm_started_ = false;
+  lane_ids_.clear();
+  for (const auto& lane_segment :
+       raw_reference_line.map_path().lane_segments()) {
+    lane_ids_.push_back(lane_segment.lane->id().id());
+  }
 
   std::vector<common::PathPoint> smoothed_point2d;
   std::vector<Eigen::Vector2d> raw_point2d;
@@ -130,6 +145,63 @@ bool CosThetaReferenceLineSmoother::Smooth(
   std::vector<double> x;
   std::vector<double> y;
 
+  const bool solved =
+      sqp_solver_ != nullptr
+          ? SqpSmooth(scaled_point2d, lateral_bounds, &x, &y)
+          : IpoptSmooth(scaled_point2d, lateral_bounds, &x, &y);
+
+  // load the point position and estimated derivatives at each point
+  if (x.size() < 2 || y.size() < 2) {
+    AINFO << "Return by the solver is wrong. Size smaller than 2 ";
+    return false;
+  }
+  for (size_t i = 0; i < x.size(); ++i) {
+    // reverse back to the unscaled points
+    double start_x = x[i] + zero_x_;
+    double start_y = y[i] + zero_y_;
+    double x_derivative = 0.0;
+    double y_derivative = 0.0;
+    if (i == 0) {
+      x_derivative = (x[i + 1] - x[i]);
+      y_derivative = (y[i + 1] - y[i]);
+      if (has_start_point_constraint_) {
+        x_derivative = 0.5 * (start_x_derivative_ + x_derivative);
+        y_derivative = 0.5 * (start_y_derivative_ + y_derivative);
+      }
+    } else if (i == x.size() - 1) {
+      x_derivative = (x[i] - x[i - 1]);
+      y_derivative = (y[i] - y[i - 1]);
+    } else {
+      x_derivative = 0.5 * (x[i + 1] - x[i - 1]);
+      y_derivative = 0.5 * (y[i + 1] - y[i - 1]);
+    }
+    ptr_smoothed_point2d->emplace_back(
+        to_path_point(start_x, start_y, x_derivative, y_derivative));
+  }
+  // load the accumulated s at each point
+  ptr_smoothed_point2d->front().set_s(0.0);
+  double accumulated_s = 0.0;
+  double Fx = ptr_smoothed_point2d->front().x();
+  double Fy = ptr_smoothed_point2d->front().y();
+  double Nx = 0.0;
+  double Ny = 0.0;
+  for (size_t i = 1; i < ptr_smoothed_point2d->size(); i++) {
+    Nx = ptr_smoothed_point2d->at(i).x();
+    Ny = ptr_smoothed_point2d->at(i).y();
+    double end_segment_s =
+        std::sqrt((Fx - Nx) * (Fx - Nx) + (Fy - Ny) * (Fy - Ny));
+    ptr_smoothed_point2d->at(i).set_s(end_segment_s + accumulated_s);
+    accumulated_s += end_segment_s;
+    Fx = Nx;
+    Fy = Ny;
+  }
+  return solved;
+}
+
+bool CosThetaReferenceLineSmoother::IpoptSmooth(
+    const std::vector<Eigen::Vector2d>& scaled_point2d,
+    const std::vector<double>& lateral_bounds, std::vector<double>* ptr_x,
+    std::vector<double>* ptr_y) {
   CosThetaProbleminterface* ptop =
       new CosThetaProbleminterface(scaled_point2d, lateral_bounds);
 
@@ -172,54 +244,156 @@ bool CosThetaReferenceLineSmoother::Smooth(
     AINFO << "Return status: " << int(status);
   }
 
-  ptop->get_optimization_results(&x, &y);
-  // load the point position and estimated derivatives at each point
-  if (x.size() < 2 || y.size() < 2) {
-    AINFO << "Return by IPOPT is wrong. Size smaller than 2 ";
+  ptop->get_optimization_results(ptr_x, ptr_y);
+  return status == Ipopt::Solve_Succeeded ||
+         status == Ipopt::Solved_To_Acceptable_Level;
+}
+
+bool CosThetaReferenceLineSmoother::SqpSmooth(
+    const std::vector<Eigen::Vector2d>& scaled_point2d,
+    const std::vector<double>& lateral_bounds, std::vector<double>* ptr_x,
+    std::vector<double>* ptr_y) {
+  auto* warm_start_line = FindWarmStartLine();
+  std::vector<Eigen::Vector2d> initial_points;
+  if (config_.cos_theta().sqp_warm_start() && warm_start_line != nullptr) {
+    ProjectOnPreviousSmoothedLine(scaled_point2d, warm_start_line->points,
+                                  &initial_points);
+  }
+  last_warm_started_ = !initial_points.empty();
+
+  std::vector<Eigen::Vector2d> smoothed_points;
+  if (!sqp_solver_->Solve(scaled_point2d, lateral_bounds,
+                          has_start_point_constraint_,
+                          has_end_point_constraint_, initial_points,
+                          &smoothed_points)) {
+    if (warm_start_line != nullptr) {
+      warm_start_lines_.erase(warm_start_lines_.begin() +
+                              (warm_start_line - warm_start_lines_.data()));
+    }
     return false;
   }
-  for (size_t i = 0; i < x.size(); ++i) {
-    // reverse back to the unscaled points
-    double start_x = x[i] + zero_x_;
-    double start_y = y[i] + zero_y_;
-    double x_derivative = 0.0;
-    double y_derivative = 0.0;
-    if (i == 0) {
-      x_derivative = (x[i + 1] - x[i]);
-      y_derivative = (y[i + 1] - y[i]);
-      if (has_start_point_constraint_) {
-        x_derivative = 0.5 * (start_x_derivative_ + x_derivative);
-        y_derivative = 0.5 * (start_y_derivative_ + y_derivative);
+  last_sqp_solved_ = true;
+  last_sqp_stats_ = sqp_solver_->stats();
+  ADEBUG << "cos_theta sqp smoother: " << last_sqp_stats_.sqp_iterations
+         << " sqp iterations, " << last_sqp_stats_.qp_iterations
+         << " osqp iterations, " << last_sqp_stats_.time_ms
+         << " ms, warm started: " << last_warm_started_
+         << ", converged: " << last_sqp_stats_.converged;
+
+  for (const auto& point : smoothed_points) {
+    ptr_x->push_back(point.x());
+    ptr_y->push_back(point.y());
+  }
+  UpdateWarmStartLine(smoothed_points, warm_start_line);
+  return true;
+}
+
+CosThetaReferenceLineSmoother::WarmStartLine*
+CosThetaReferenceLineSmoother::FindWarmStartLine() {
+  if (lane_ids_.empty()) {
+    return nullptr;
+  }
+  WarmStartLine* found = nullptr;
+  for (auto& line : warm_start_lines_) {
+    if (line.lane_ids.count(lane_ids_.front()) != 0 &&
+        (found == nullptr || line.last_used > found->last_used)) {
+      found = &line;
+    }
+  }
+  return found;
+}
+
+void CosThetaReferenceLineSmoother::UpdateWarmStartLine(
+    const std::vector<Eigen::Vector2d>& scaled_smoothed_points,
+    WarmStartLine* warm_start_line) {
+  if (lane_ids_.empty()) {
+    return;
+  }
+  if (warm_start_line == nullptr) {
+    if (warm_start_lines_.size() < kMaxWarmStartLines) {
+      warm_start_lines_.emplace_back();
+      warm_start_line = &warm_start_lines_.back();
+    } else {
+      warm_start_line = &*std::min_element(
+          warm_start_lines_.begin(), warm_start_lines_.end(),
+          [](const WarmStartLine& a, const WarmStartLine& b) {
+            return a.last_used < b.last_used;
+          });
+    }
+  }
+  warm_start_line->lane_ids.clear();
+  warm_start_line->lane_ids.insert(lane_ids_.begin(), lane_ids_.end());
+  warm_start_line->points.clear();
+  for (const auto& point : scaled_smoothed_points) {
+    warm_start_line->points.emplace_back(point.x() + zero_x_,
+                                         point.y() + zero_y_);
+  }
+  warm_start_line->last_used = num_smoothed_;
+}
+
+void CosThetaReferenceLineSmoother::ProjectOnPreviousSmoothedLine(
+    const std::vector<Eigen::Vector2d>& scaled_point2d,
+    const std::vector<Eigen::Vector2d>& prev_smoothed_points,
+    std::vector<Eigen::Vector2d>* initial_points) const {
+  initial_points->clear();
+  if (prev_smoothed_points.size() < 2) {
+    return;
+  }
+  // a point is matched within this many segments after the nearest segment
+  // found so far, which keeps the projection linear in the number of points.
+  constexpr size_t kSegmentWindow = 8;
+  const Eigen::Vector2d zero(zero_x_, zero_y_);
+  const double max_distance = config_.cos_theta().max_point_deviation();
+  // both lines run in the same direction, so the matched segment never goes
+  // backward.
+  size_t first_segment = 0;
+  for (const auto& scaled_point : scaled_point2d) {
+    const Eigen::Vector2d point = scaled_point + zero;
+    double min_distance_sqr = std::numeric_limits<double>::max();
+    Eigen::Vector2d nearest = point;
+    size_t nearest_segment = first_segment;
+    for (size_t i = first_segment; i + 1 < prev_smoothed_points.size() &&
+                                   i <= nearest_segment + kSegmentWindow;
+         ++i) {
+      const Eigen::Vector2d& start = prev_smoothed_points[i];
+      const Eigen::Vector2d segment = prev_smoothed_points[i + 1] - start;
+      const double ratio = common::math::Clamp(
+          segment.dot(point - start) / std::max(segment.squaredNorm(), 1e-9),
+          0.0, 1.0);
+      const Eigen::Vector2d projection = start + ratio * segment;
+      const double distance_sqr = (projection - point).squaredNorm();
+      if (distance_sqr < min_distance_sqr) {
+        min_distance_sqr = distance_sqr;
+        nearest = projection;
+        nearest_segment = i;
       }
-    } else if (i == x.size() - 1) {
-      x_derivative = (x[i] - x[i - 1]);
-      y_derivative = (y[i] - y[i - 1]);
+    }
+    if (min_distance_sqr > max_distance * max_distance) {
+      nearest = point;
     } else {
-      x_derivative = 0.5 * (x[i + 1] - x[i - 1]);
-      y_derivative = 0.5 * (y[i + 1] - y[i - 1]);
+      first_segment = nearest_segment;
     }
-    ptr_smoothed_point2d->emplace_back(
-        to_path_point(start_x, start_y, x_derivative, y_derivative));
+    initial_points->push_back(nearest - zero);
   }
-  // load the accumulated s at each point
-  ptr_smoothed_point2d->front().set_s(0.0);
-  double accumulated_s = 0.0;
-  double Fx = ptr_smoothed_point2d->front().x();
-  double Fy = ptr_smoothed_point2d->front().y();
-  double Nx = 0.0;
-  double Ny = 0.0;
-  for (size_t i = 1; i < ptr_smoothed_point2d->size(); i++) {
-    Nx = ptr_smoothed_point2d->at(i).x();
-    Ny = ptr_smoothed_point2d->at(i).y();
-    double end_segment_s =
-        std::sqrt((Fx - Nx) * (Fx - Nx) + (Fy - Ny) * (Fy - Ny));
-    ptr_smoothed_point2d->at(i).set_s(end_segment_s + accumulated_s);
-    accumulated_s += end_segment_s;
-    Fx = Nx;
-    Fy = Ny;
+}
+
+void CosThetaReferenceLineSmoother::AddStats(
+    ReferenceLineSmootherStats* const stats) const {
+  if (!last_sqp_solved_) {
+    return;
   }
-  return status == Ipopt::Solve_Succeeded ||
-         status == Ipopt::Solved_To_Acceptable_Level;
+  stats->set_num_smoothed_lines(stats->num_smoothed_lines() + 1);
+  if (last_warm_started_) {
+    stats->set_num_warm_started_lines(stats->num_warm_started_lines() + 1);
+  }
+  if (last_sqp_stats_.converged) {
+    stats->set_num_converged_lines(stats->num_converged_lines() + 1);
+  }
+  stats->set_sqp_iterations(stats->sqp_iterations() +
+                            last_sqp_stats_.sqp_iterations);
+  stats->set_qp_iterations(stats->qp_iterations() +
+                           last_sqp_stats_.qp_iterations);
+  stats->set_solve_time_ms(stats->solve_time_ms() + last_sqp_stats_.time_ms);
 }
 
 common::PathPoint CosThetaReferenceLineSmoother::to_path_point(
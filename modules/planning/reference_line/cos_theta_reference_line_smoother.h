@@ -17,12 +17,15 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "Eigen/Dense"
 
 #include "modules/planning/math/curve_math.h"
 #include "modules/planning/proto/planning.pb.h"
+#include "modules/planning/reference_line/cos_theta_sqp_solver.h"
 #include "modules/planning/reference_line/reference_line.h"
 #include "modules/planning/reference_line/reference_line_smoother.h"
 #include "modules/planning/reference_line/reference_point.h"
@@ -42,17 +45,70 @@ class CosThetaReferenceLineSmoother : public ReferenceLineSmoother {
 
   void SetAnchorPoints(const std::vector<AnchorPoint>&) override;
 
+  void AddStats(ReferenceLineSmootherStats* const stats) const override;
+
  private:
+  // the last points smoothed by sqp on the lanes of one reference line, not
+  // scaled
+  struct WarmStartLine {
+    std::unordered_set<std::string> lane_ids;
+    std::vector<Eigen::Vector2d> points;
+    // value of num_smoothed_ when the line was last used
+    uint64_t last_used = 0;
+  };
+
   bool Smooth(const std::vector<Eigen::Vector2d>& point2d,
               const std::vector<double>& lateral_bounds,
               std::vector<common::PathPoint>* ptr_smoothed_point2d);
 
+  bool IpoptSmooth(const std::vector<Eigen::Vector2d>& scaled_point2d,
+                   const std::vector<double>& lateral_bounds,
+                   std::vector<double>* ptr_x, std::vector<double>* ptr_y);
+
+  bool SqpSmooth(const std::vector<Eigen::Vector2d>& scaled_point2d,
+                 const std::vector<double>& lateral_bounds,
+                 std::vector<double>* ptr_x, std::vector<double>* ptr_y);
+
+  // Get the warm start line smoothed on the first lane of the current
+  // reference line, nullptr if there is none.
+  WarmStartLine* FindWarmStartLine();
+
+  // Keep smoothed_points as the warm start line of the current reference
+  // line, evicting the least recently used lines beyond kMaxWarmStartLines.
+  void UpdateWarmStartLine(
+      const std::vector<Eigen::Vector2d>& scaled_smoothed_points,
+      WarmStartLine* warm_start_line);
+
+  // projects the anchor points onto the previous smoothed line, a point with
+  // no projection within the max deviation keeps its own position.
+  void ProjectOnPreviousSmoothedLine(
+      const std::vector<Eigen::Vector2d>& scaled_point2d,
+      const std::vector<Eigen::Vector2d>& prev_smoothed_points,
+      std::vector<Eigen::Vector2d>* initial_points) const;
+
   common::PathPoint to_path_point(const double x, const double y,
                                   const double x_derivative,
                                   const double y_derivative) const;
 
   std::unique_ptr<ReferenceLineSmoother> reopt_qp_smoother_;
 
+  std::unique_ptr<CosThetaSqpSolver> sqp_solver_;
+
+  static constexpr size_t kMaxWarmStartLines = 4;
+
+  // warm start lines of the recently smoothed reference lines, so that a
+  // warm start never crosses reference lines, e.g. lane change candidates
+  std::vector<WarmStartLine> warm_start_lines_;
+  uint64_t num_smoothed_ = 0;
+
+  // lane ids of the reference line being smoothed, in driving order
+  std::vector<std::string> lane_ids_;
+
+  // sqp statistics of the last Smooth() call
+  bool last_sqp_solved_ = false;
+  bool last_warm_started_ = false;
+  CosThetaSqpStats last_sqp_stats_;
+
   std::vector<AnchorPoint> anchor_points_;
 
   std::vector<AnchorPoint> reopt_anchor_points_;
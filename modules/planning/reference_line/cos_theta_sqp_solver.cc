@@ -0,0 +1,297 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/reference_line/cos_theta_sqp_solver.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "Eigen/Dense"
+
+#include "cyber/common/log.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// every column of P has at most this many rows on and above the diagonal, as
+// a point only couples with the two points before and after it.
+constexpr size_t kBandWidth = 6;
+
+constexpr double kMinSegmentLength = 1.0e-6;
+
+// a step longer than this share of the trust region is on its border
+constexpr double kTrustRegionBorder = 0.9;
+
+// the share of the predicted reduction a step must give to grow the trust
+// region
+constexpr double kGoodStepRatio = 0.75;
+
+Eigen::Vector2d UnitVector(const Eigen::Vector2d& d) {
+  return d / std::max(d.norm(), kMinSegmentLength);
+}
+
+// jacobian of d / |d| with respect to d
+Eigen::Matrix2d UnitVectorJacobian(const Eigen::Vector2d& d) {
+  const double length = std::max(d.norm(), kMinSegmentLength);
+  const Eigen::Vector2d n = d / length;
+  return (Eigen::Matrix2d::Identity() - n * n.transpose()) / length;
+}
+
+}  // namespace
+
+CosThetaSqpSolver::CosThetaSqpSolver(const CosThetaSmootherConfig& config)
+    : config_(config), workspace_("CosThetaSqp") {
+  OSQPSettings settings;
+  osqp_set_default_settings(&settings);
+  settings.eps_abs = 1.0e-05;
+  settings.eps_rel = 1.0e-05;
+  settings.max_iter = 4000;
+  settings.polish = true;
+  settings.verbose = FLAGS_enable_osqp_debug;
+  settings.warm_start = true;
+  workspace_.SetSettings(settings);
+}
+
+double CosThetaSqpSolver::Objective(
+    const std::vector<Eigen::Vector2d>& points,
+    const std::vector<Eigen::Vector2d>& raw_points) const {
+  double objective = 0.0;
+  for (size_t i = 0; i < points.size(); ++i) {
+    objective += (points[i] - raw_points[i]).squaredNorm();
+  }
+  // 1 - cos(theta) differs from the -cos(theta) of the original objective
+  // only by a constant.
+  const double weight = config_.weight_cos_included_angle();
+  for (size_t i = 0; i + 2 < points.size(); ++i) {
+    const Eigen::Vector2d u = UnitVector(points[i + 1] - points[i]);
+    const Eigen::Vector2d v = UnitVector(points[i + 2] - points[i + 1]);
+    objective += weight * (1.0 - u.dot(v));
+  }
+  return objective;
+}
+
+void CosThetaSqpSolver::BuildStepProblem(
+    const std::vector<Eigen::Vector2d>& points,
+    const std::vector<Eigen::Vector2d>& raw_points) {
+  const size_t num_var = points.size() * 2;
+  std::vector<double> band(num_var * kBandWidth, 0.0);
+  const auto add_to_p = [&band](const size_t row, const size_t col,
+                                const double value) {
+    if (row <= col) {
+      band[col * kBandWidth + col - row] += value;
+    }
+  };
+
+  // deviation term |p_i - p_i^0|^2
+  q_.assign(num_var, 0.0);
+  for (size_t i = 0; i < points.size(); ++i) {
+    add_to_p(2 * i, 2 * i, 2.0);
+    add_to_p(2 * i + 1, 2 * i + 1, 2.0);
+    q_[2 * i] = 2.0 * (points[i].x() - raw_points[i].x());
+    q_[2 * i + 1] = 2.0 * (points[i].y() - raw_points[i].y());
+  }
+
+  // smoothness term 0.5 * w * |r_i + J_i * dx|^2 with r_i = v_i - u_i
+  const double weight = config_.weight_cos_included_angle();
+  for (size_t i = 0; i + 2 < points.size(); ++i) {
+    const Eigen::Vector2d d1 = points[i + 1] - points[i];
+    const Eigen::Vector2d d2 = points[i + 2] - points[i + 1];
+    const Eigen::Matrix2d n1 = UnitVectorJacobian(d1);
+    const Eigen::Matrix2d n2 = UnitVectorJacobian(d2);
+    const Eigen::Vector2d r = UnitVector(d2) - UnitVector(d1);
+    // jacobian blocks of r_i with respect to points i, i + 1 and i + 2, all
+    // of them symmetric.
+    const Eigen::Matrix2d blocks[3] = {n1, -(n1 + n2), n2};
+    for (size_t a = 0; a < 3; ++a) {
+      const Eigen::Vector2d gradient = blocks[a] * r;
+      q_[2 * (i + a)] += weight * gradient.x();
+      q_[2 * (i + a) + 1] += weight * gradient.y();
+      for (size_t b = a; b < 3; ++b) {
+        const Eigen::Matrix2d hessian = blocks[a] * blocks[b];
+        for (size_t k = 0; k < 2; ++k) {
+          for (size_t l = 0; l < 2; ++l) {
+            add_to_p(2 * (i + a) + k, 2 * (i + b) + l,
+                     weight * hessian(k, l));
+          }
+        }
+      }
+    }
+  }
+
+  // upper triangular P in csc format, with the same pattern for every step
+  P_data_.clear();
+  P_indices_.clear();
+  P_indptr_.clear();
+  P_indptr_.push_back(0);
+  for (size_t col = 0; col < num_var; ++col) {
+    const size_t point_index = col / 2;
+    const size_t first_row = 2 * (point_index >= 2 ? point_index - 2 : 0);
+    for (size_t row = first_row; row <= col; ++row) {
+      P_indices_.push_back(static_cast<c_int>(row));
+      P_data_.push_back(band[col * kBandWidth + col - row]);
+    }
+    P_indptr_.push_back(static_cast<c_int>(P_indices_.size()));
+  }
+}
+
+double CosThetaSqpSolver::PredictedChange(
+    const std::vector<c_float>& step) const {
+  // 0.5 * step' * P * step + q' * step with the upper triangular P
+  double change = 0.0;
+  for (size_t col = 0; col + 1 < P_indptr_.size(); ++col) {
+    for (c_int k = P_indptr_[col]; k < P_indptr_[col + 1]; ++k) {
+      const size_t row = static_cast<size_t>(P_indices_[k]);
+      const double value = P_data_[k] * step[row] * step[col];
+      change += row == col ? 0.5 * value : value;
+    }
+    change += q_[col] * step[col];
+  }
+  return change;
+}
+
+bool CosThetaSqpSolver::Solve(
+    const std::vector<Eigen::Vector2d>& points,
+    const std::vector<double>& lateral_bounds, const bool fix_start_point,
+    const bool fix_end_point,
+    const std::vector<Eigen::Vector2d>& initial_points,
+    std::vector<Eigen::Vector2d>* smoothed_points) {
+  CHECK_NOTNULL(smoothed_points);
+  CHECK_EQ(points.size(), lateral_bounds.size());
+  if (points.size() < 3) {
+    AERROR << "At least 3 points are needed, got " << points.size();
+    return false;
+  }
+  const auto start_time = std::chrono::steady_clock::now();
+  stats_ = CosThetaSqpStats();
+  const int total_qp_iterations = workspace_.stats().total_iterations;
+
+  // the same boxes as the positional deviation constraints of
+  // CosThetaProbleminterface
+  const size_t num_points = points.size();
+  const size_t num_var = num_points * 2;
+  const double radius_ratio = std::sqrt(2.0);
+  std::vector<Eigen::Vector2d> lower(num_points);
+  std::vector<Eigen::Vector2d> upper(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    double half_width =
+        std::min(lateral_bounds[i], config_.max_point_deviation()) /
+        radius_ratio;
+    if ((i == 0 && fix_start_point) ||
+        (i + 1 == num_points && fix_end_point)) {
+      half_width = config_.relax() / radius_ratio;
+    }
+    lower[i] = points[i].array() - half_width;
+    upper[i] = points[i].array() + half_width;
+  }
+  const auto clamp_to_box = [&lower, &upper](const size_t i,
+                                             const Eigen::Vector2d& point) {
+    return Eigen::Vector2d(point.cwiseMax(lower[i]).cwiseMin(upper[i]));
+  };
+
+  std::vector<Eigen::Vector2d> x(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    x[i] = clamp_to_box(i, initial_points.size() == num_points
+                               ? initial_points[i]
+                               : points[i]);
+  }
+
+  // the step is bounded by identity constraints
+  A_data_.assign(num_var, 1.0);
+  A_indices_.resize(num_var);
+  A_indptr_.resize(num_var + 1);
+  for (size_t i = 0; i < num_var; ++i) {
+    A_indices_[i] = static_cast<c_int>(i);
+    A_indptr_[i] = static_cast<c_int>(i);
+  }
+  A_indptr_[num_var] = static_cast<c_int>(num_var);
+
+  std::vector<c_float> l(num_var);
+  std::vector<c_float> u(num_var);
+  std::vector<Eigen::Vector2d> x_next(num_points);
+  double objective = Objective(x, points);
+  double trust_region = config_.sqp_trust_region();
+  bool need_build = true;
+  for (int iter = 0; iter < config_.sqp_max_iteration(); ++iter) {
+    ++stats_.sqp_iterations;
+    if (need_build) {
+      BuildStepProblem(x, points);
+    }
+    for (size_t i = 0; i < num_points; ++i) {
+      for (size_t k = 0; k < 2; ++k) {
+        l[2 * i + k] = std::max(lower[i][k] - x[i][k], -trust_region);
+        u[2 * i + k] = std::min(upper[i][k] - x[i][k], trust_region);
+      }
+    }
+    if (!workspace_.Solve(num_var, num_var, P_data_, P_indices_, P_indptr_,
+                          A_data_, A_indices_, A_indptr_, q_, l, u)) {
+      AERROR << "Failed to solve the cos theta sqp step at iteration " << iter;
+      return false;
+    }
+    const auto& step = workspace_.primal_solution();
+    double max_step = 0.0;
+    for (size_t i = 0; i < num_points; ++i) {
+      const Eigen::Vector2d delta(step[2 * i], step[2 * i + 1]);
+      x_next[i] = clamp_to_box(i, x[i] + delta);
+      max_step = std::max(max_step, delta.lpNorm<Eigen::Infinity>());
+    }
+    const double next_objective = Objective(x_next, points);
+    need_build = next_objective < objective;
+    if (need_build) {
+      // a step limited by the trust region that gives most of the predicted
+      // reduction could have gone further.
+      const double predicted_reduction = -PredictedChange(step);
+      if (max_step > kTrustRegionBorder * trust_region &&
+          objective - next_objective >
+              kGoodStepRatio * predicted_reduction) {
+        trust_region =
+            std::min(2.0 * trust_region, config_.sqp_trust_region());
+      }
+      x.swap(x_next);
+      objective = next_objective;
+    } else {
+      // the linearization is not trusted this far, retry a shorter step on
+      // the same QP.
+      trust_region = 0.5 * max_step;
+    }
+    if (max_step < config_.sqp_tol()) {
+      stats_.converged = true;
+      break;
+    }
+  }
+
+  *smoothed_points = std::move(x);
+  stats_.qp_iterations =
+      workspace_.stats().total_iterations - total_qp_iterations;
+  const std::chrono::duration<double, std::milli> time_ms =
+      std::chrono::steady_clock::now() - start_time;
+  stats_.time_ms = time_ms.count();
+  ADEBUG << "cos theta sqp: " << stats_.sqp_iterations << " sqp iterations, "
+         << stats_.qp_iterations << " qp iterations, " << stats_.time_ms
+         << " ms, converged: " << stats_.converged;
+  return true;
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <vector>
+
+#include "Eigen/Core"
+
+#include "modules/planning/math/osqp_workspace.h"
+#include "modules/planning/proto/reference_line_smoother_config.pb.h"
+
+namespace apollo {
+namespace planning {
+
+struct CosThetaSqpStats {
+  int sqp_iterations = 0;
+  int qp_iterations = 0;
+  double time_ms = 0.0;
+  bool converged = false;
+};
+
+/*
+ * @brief:
+ * Solves the cos theta smoothing problem of CosThetaProbleminterface,
+ *   min sum |p_i - p_i^0|^2 - w * sum cos(theta_i)
+ * with the same box bounds on every point, by sequential convex programming.
+ *
+ * Since 1 - cos(theta_i) = 0.5 * |u_i - v_i|^2 for the unit vectors u_i, v_i
+ * of the two segments meeting at point i, each iteration linearizes u_i - v_i
+ * (Gauss-Newton) and solves the resulting convex QP for the step within a
+ * trust region. The trust region shrinks after a step that does not reduce
+ * the objective, and grows again after a step on its border that reduces
+ * the objective about as much as the QP predicts. All the QPs share one
+ * sparsity pattern, so a single OSQP workspace is kept and warm started
+ * across iterations and smoothing calls.
+ */
+class CosThetaSqpSolver {
+ public:
+  explicit CosThetaSqpSolver(const CosThetaSmootherConfig& config);
+
+  /*
+   * @brief: smooths points, each within lateral_bounds (and the configured
+   * max deviation) of its raw position. The first and the last point are
+   * only relaxed by the configured relax when fixed. The iterations start
+   * from initial_points if it has one point per raw point, otherwise from the
+   * raw points.
+   */
+  bool Solve(const std::vector<Eigen::Vector2d>& points,
+             const std::vector<double>& lateral_bounds,
+             const bool fix_start_point, const bool fix_end_point,
+             const std::vector<Eigen::Vector2d>& initial_points,
+             std::vector<Eigen::Vector2d>* smoothed_points);
+
+  const CosThetaSqpStats& stats() const { return stats_; }
+
+ private:
+  double Objective(const std::vector<Eigen::Vector2d>& points,
+                   const std::vector<Eigen::Vector2d>& raw_points) const;
+
+  // builds the QP of the step from points, P is upper triangular
+  void BuildStepProblem(const std::vector<Eigen::Vector2d>& points,
+                        const std::vector<Eigen::Vector2d>& raw_points);
+
+  // the change of the objective predicted by the QP of the step
+  double PredictedChange(const std::vector<c_float>& step) const;
+
+ private:
+  CosThetaSmootherConfig config_;
+  OsqpWorkspace workspace_;
+
+  std::vector<c_float> P_data_;
+  std::vector<c_int> P_indices_;
+  std::vector<c_int> P_indptr_;
+  std::vector<c_float> A_data_;
+  std::vector<c_int> A_indices_;
+  std::vector<c_int> A_indptr_;
+  std::vector<c_float> q_;
+
+  CosThetaSqpStats stats_;
+};
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/reference_line/cos_theta_sqp_solver.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+double CosThetaSum(const std::vector<Eigen::Vector2d>& points) {
+  double sum = 0.0;
+  for (size_t i = 0; i + 2 < points.size(); ++i) {
+    const Eigen::Vector2d u = (points[i + 1] - points[i]).normalized();
+    const Eigen::Vector2d v = (points[i + 2] - points[i + 1]).normalized();
+    sum += u.dot(v);
+  }
+  return sum;
+}
+
+// anchor points every 5m on an arc, with a zigzag lateral noise
+std::vector<Eigen::Vector2d> MakeAnchorPoints(const double start_s) {
+  constexpr double kRadius = 100.0;
+  std::vector<Eigen::Vector2d> points;
+  for (int i = 0; i < 30; ++i) {
+    const double s = start_s + 5.0 * i;
+    const double noise = (i % 2 == 0 ? 0.1 : -0.1);
+    const double r = kRadius + noise;
+    points.emplace_back(r * std::sin(s / kRadius),
+                        kRadius - r * std::cos(s / kRadius));
+  }
+  return points;
+}
+
+}  // namespace
+
+TEST(CosThetaSqpSolverTest, smooth_noisy_arc) {
+  CosThetaSmootherConfig config;
+  config.set_max_point_deviation(0.5);
+  config.set_weight_cos_included_angle(10000.0);
+  config.set_relax(0.2);
+  CosThetaSqpSolver solver(config);
+
+  const auto points = MakeAnchorPoints(0.0);
+  const std::vector<double> lateral_bounds(points.size(), 0.3);
+  std::vector<Eigen::Vector2d> smoothed_points;
+  EXPECT_TRUE(solver.Solve(points, lateral_bounds, true, true, {},
+                           &smoothed_points));
+  ASSERT_EQ(smoothed_points.size(), points.size());
+  EXPECT_GT(solver.stats().sqp_iterations, 0);
+  EXPECT_GT(solver.stats().qp_iterations, 0);
+
+  EXPECT_GT(CosThetaSum(smoothed_points), CosThetaSum(points));
+  const double bound = 0.3 / std::sqrt(2.0) + 1e-6;
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_LE((smoothed_points[i] - points[i]).lpNorm<Eigen::Infinity>(),
+              bound);
+  }
+
+  // starting from the solution needs no more iterations
+  const int cold_iterations = solver.stats().sqp_iterations;
+  std::vector<Eigen::Vector2d> warm_points;
+  EXPECT_TRUE(solver.Solve(points, lateral_bounds, true, true,
+                           smoothed_points, &warm_points));
+  EXPECT_LE(solver.stats().sqp_iterations, cold_iterations);
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_NEAR(warm_points[i].x(), smoothed_points[i].x(), 1e-2);
+    EXPECT_NEAR(warm_points[i].y(), smoothed_points[i].y(), 1e-2);
+  }
+}
+
+TEST(CosThetaSqpSolverTest, too_few_points) {
+  CosThetaSmootherConfig config;
+  CosThetaSqpSolver solver(config);
+  std::vector<Eigen::Vector2d> smoothed_points;
+  EXPECT_FALSE(solver.Solve({{0.0, 0.0}, {1.0, 0.0}}, {0.1, 0.1}, false,
+                            false, {}, &smoothed_points));
+}
+
+}  // namespace planning
+}  // namespace apollo
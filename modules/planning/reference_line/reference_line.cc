@@ -404,6 +404,23 @@ bool ReferenceLine::XYToSL(const common::math::Vec2d& xy_point,
   return true;
 }
 
+bool ReferenceLine::XYToSL(const std::vector<common::math::Vec2d>& xy_points,
+                           std::vector<SLPoint>* const sl_points) const {
+  DCHECK_NOTNULL(sl_points);
+  std::vector<double> s;
+  std::vector<double> l;
+  if (!map_path_.GetProjections(xy_points, &s, &l)) {
+    AERROR << "Can't get nearest points from path.";
+    return false;
+  }
+  sl_points->resize(xy_points.size());
+  for (size_t i = 0; i < xy_points.size(); ++i) {
+    (*sl_points)[i].set_s(s[i]);
+    (*sl_points)[i].set_l(l[i]);
+  }
+  return true;
+}
+
 ReferencePoint ReferenceLine::InterpolateWithMatchedIndex(
     const ReferencePoint& p0, const double s0, const ReferencePoint& p1,
     const double s1, const InterpolatedIndex& index) const {
@@ -628,16 +645,25 @@ bool ReferenceLine::GetSLBoundary(const common::math::Box2d& box,
   std::vector<common::math::Vec2d> corners;
   box.GetAllCorners(&corners);
 
+  // project the corners together with the edge mid points in one batch, the
+  // mid point of each edge follows its first corner
+  std::vector<common::math::Vec2d> points;
+  points.reserve(corners.size() * 2);
+  for (std::size_t i = 0; i < corners.size(); ++i) {
+    points.push_back(corners[i]);
+    points.push_back((corners[i] + corners[(i + 1) % corners.size()]) * 0.5);
+  }
+  std::vector<SLPoint> sl_points;
+  if (!XYToSL(points, &sl_points)) {
+    AERROR << "failed to get projection for box: " << box.DebugString()
+           << " on reference line.";
+    return false;
+  }
+
   // the order must be counter-clockwise
   std::vector<SLPoint> sl_corners;
-  for (const auto& point : corners) {
-    SLPoint sl_point;
-    if (!XYToSL(point, &sl_point)) {
-      AERROR << "failed to get projection for point: " << point.DebugString()
-             << " on reference line.";
-      return false;
-    }
-
+  for (std::size_t i = 0; i < corners.size(); ++i) {
+    const auto& sl_point = sl_points[i * 2];
     // TODO(all): move the boundary finding to the end of function,
     // It is not accurate to check only vertices.
     start_s = std::fmin(start_s, sl_point.s());
@@ -645,22 +671,13 @@ bool ReferenceLine::GetSLBoundary(const common::math::Box2d& box,
     start_l = std::fmin(start_l, sl_point.l());
     end_l = std::fmax(end_l, sl_point.l());
 
-    sl_corners.push_back(std::move(sl_point));
+    sl_corners.push_back(sl_point);
   }
 
   for (std::size_t i = 0; i < corners.size(); ++i) {
     auto index0 = i;
     auto index1 = (i + 1) % corners.size();
-    const auto& p0 = corners[index0];
-    const auto& p1 = corners[index1];
-
-    const auto p_mid = (p0 + p1) * 0.5;
-    SLPoint sl_point_mid;
-    if (!XYToSL(p_mid, &sl_point_mid)) {
-      AERROR << "failed to get projection for point: " << p_mid.DebugString()
-             << " on reference line.";
-      return false;
-    }
+    const auto& sl_point_mid = sl_points[i * 2 + 1];
 
     Vec2d v0(sl_corners[index1].s() - sl_corners[index0].s(),
              sl_corners[index1].l() - sl_corners[index0].l());
@@ -694,13 +711,18 @@ bool ReferenceLine::GetSLBoundary(const hdmap::Polygon& polygon,
   double end_s(std::numeric_limits<double>::lowest());
   double start_l(std::numeric_limits<double>::max());
   double end_l(std::numeric_limits<double>::lowest());
+  std::vector<common::math::Vec2d> points;
+  points.reserve(polygon.point_size());
   for (const auto& point : polygon.point()) {
-    SLPoint sl_point;
-    if (!XYToSL(point, &sl_point)) {
-      AERROR << "failed to get projection for point: " << point.DebugString()
-             << " on reference line.";
-      return false;
-    }
+    points.emplace_back(point.x(), point.y());
+  }
+  std::vector<SLPoint> sl_points;
+  if (!XYToSL(points, &sl_points)) {
+    AERROR << "failed to get projection for polygon: "
+           << polygon.ShortDebugString() << " on reference line.";
+    return false;
+  }
+  for (const auto& sl_point : sl_points) {
     start_s = std::fmin(start_s, sl_point.s());
     end_s = std::fmax(end_s, sl_point.s());
     start_l = std::fmin(start_l, sl_point.l());
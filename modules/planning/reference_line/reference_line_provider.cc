@@ -203,6 +203,7 @@ void ReferenceLineProvider::GenerateThread() {
     const double end_time = Clock::NowInSeconds();
     std::lock_guard<std::mutex> lock(reference_lines_mutex_);
     last_calculation_time_ = end_time - start_time;
+    UpdateSmootherStats();
   }
 }
 
@@ -216,6 +217,50 @@ double ReferenceLineProvider::LastTimeDelay() {
   }
 }
 
+double ReferenceLineProvider::LastSmootherTime() {
+  std::lock_guard<std::mutex> lock(reference_lines_mutex_);
+  return last_smoother_time_;
+}
+
+double ReferenceLineProvider::LastSmootherTimeSavedEstimate() {
+  std::lock_guard<std::mutex> lock(reference_lines_mutex_);
+  return last_smoother_time_saved_estimate_;
+}
+
+double ReferenceLineProvider::LastReusedLength() {
+  std::lock_guard<std::mutex> lock(reference_lines_mutex_);
+  return last_reused_length_;
+}
+
+ReferenceLineSmootherStats ReferenceLineProvider::LastSmootherStats() {
+  std::lock_guard<std::mutex> lock(reference_lines_mutex_);
+  return last_smoother_stats_;
+}
+
+void ReferenceLineProvider::ResetSmootherStats() {
+  cycle_smoother_time_ = 0.0;
+  cycle_reused_length_ = 0.0;
+  cycle_smoother_stats_.Clear();
+}
+
+void ReferenceLineProvider::AddReusedLength(const double reused_length) {
+  cycle_reused_length_ += std::fmax(0.0, reused_length);
+}
+
+void ReferenceLineProvider::UpdateSmootherStats() {
+  last_smoother_time_ = cycle_smoother_time_;
+  last_smoother_stats_ = cycle_smoother_stats_;
+  // the saved time is estimated with the average smoother cost per meter,
+  // as if the reused reference lines had been smoothed again.
+  last_reused_length_ = cycle_reused_length_;
+  last_smoother_time_saved_estimate_ =
+      cycle_reused_length_ * smoother_time_per_meter_;
+  ADEBUG << "Reference line smoother time: " << last_smoother_time_ * 1000.0
+         << " ms, reused length: " << last_reused_length_
+         << " m, estimated saved time: "
+         << last_smoother_time_saved_estimate_ * 1000.0 << " ms";
+}
+
 bool ReferenceLineProvider::GetReferenceLines(
     std::list<ReferenceLine> *reference_lines,
     std::list<hdmap::RouteSegments> *segments) {
@@ -246,6 +291,7 @@ bool ReferenceLineProvider::GetReferenceLines(
       UpdateReferenceLine(*reference_lines, *segments);
       double end_time = Clock::NowInSeconds();
       last_calculation_time_ = end_time - start_time;
+      UpdateSmootherStats();
       return true;
     }
   }
@@ -546,6 +592,7 @@ bool ReferenceLineProvider::CreateReferenceLine(
     std::list<hdmap::RouteSegments> *segments) {
   CHECK_NOTNULL(reference_lines);
   CHECK_NOTNULL(segments);
+  ResetSmootherStats();
 
   common::VehicleState vehicle_state;
   {
@@ -639,10 +686,21 @@ bool ReferenceLineProvider::ExtendReferenceLine(const VehicleState &state,
     *segments = *prev_segment;
     segments->SetProperties(segment_properties);
     *reference_line = *prev_ref;
+    AddReusedLength(prev_ref->Length());
     ADEBUG << "Reference line remain " << remain_s
            << ", which is more than required " << look_forward_required_distance
            << " and no need to extend";
-    return true;
+    if (!FLAGS_enable_reference_line_incremental_update) {
+      return true;
+    }
+    // trim the passed head of the reused reference line
+    common::SLPoint sl;
+    if (!reference_line->XYToSL(vec2d, &sl)) {
+      AWARN << "Failed to project point: " << vec2d.DebugString()
+            << " to reused reference line";
+      return true;
+    }
+    return Shrink(sl, reference_line, segments);
   }
   double future_start_s =
       std::max(sl_point.s(), prev_segment_length -
@@ -662,6 +720,7 @@ bool ReferenceLineProvider::ExtendReferenceLine(const VehicleState &state,
     *segments = *prev_segment;
     segments->SetProperties(segment_properties);
     *reference_line = *prev_ref;
+    AddReusedLength(prev_ref->Length());
     ADEBUG << "Could not further extend reference line";
     return true;
   }
@@ -679,6 +738,9 @@ bool ReferenceLineProvider::ExtendReferenceLine(const VehicleState &state,
     AWARN << "Failed to stitch route segments";
     return SmoothRouteSegment(*segments, reference_line);
   }
+  // only the part of the previous reference line before the stitching joint
+  // is kept, the rest has been smoothed again with the new tail.
+  AddReusedLength(prev_ref->Length() - (prev_segment_length - future_start_s));
   *segments = shifted_segments;
   segments->SetProperties(segment_properties);
   common::SLPoint sl;
@@ -849,6 +911,27 @@ bool ReferenceLineProvider::SmoothRouteSegment(const RouteSegments &segments,
   return SmoothReferenceLine(ReferenceLine(path), reference_line);
 }
 
+bool ReferenceLineProvider::RunSmoother(const ReferenceLine &raw_reference_line,
+                                        ReferenceLine *reference_line) {
+  const double start_time = Clock::NowInSeconds();
+  const bool status = smoother_->Smooth(raw_reference_line, reference_line);
+  const double time_diff = Clock::NowInSeconds() - start_time;
+  cycle_smoother_time_ += time_diff;
+  smoother_->AddStats(&cycle_smoother_stats_);
+  const double length = raw_reference_line.Length();
+  if (status && length > common::math::kMathEpsilon) {
+    // exponential moving average of the smoother time per meter
+    constexpr double kAlpha = 0.1;
+    const double time_per_meter = time_diff / length;
+    smoother_time_per_meter_ =
+        smoother_time_per_meter_ > 0.0
+            ? (1.0 - kAlpha) * smoother_time_per_meter_ +
+                  kAlpha * time_per_meter
+            : time_per_meter;
+  }
+  return status;
+}
+
 bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
     const ReferenceLine &prefix_ref, const ReferenceLine &raw_ref,
     ReferenceLine *reference_line) {
@@ -881,7 +964,7 @@ bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
   }
 
   smoother_->SetAnchorPoints(anchor_points);
-  if (!smoother_->Smooth(raw_ref, reference_line)) {
+  if (!RunSmoother(raw_ref, reference_line)) {
     AERROR << "Failed to smooth prefixed reference line with anchor points";
     return false;
   }
@@ -902,7 +985,7 @@ bool ReferenceLineProvider::SmoothReferenceLine(
   std::vector<AnchorPoint> anchor_points;
   GetAnchorPoints(raw_reference_line, &anchor_points);
   smoother_->SetAnchorPoints(anchor_points);
-  if (!smoother_->Smooth(raw_reference_line, reference_line)) {
+  if (!RunSmoother(raw_reference_line, reference_line)) {
     AERROR << "Failed to smooth reference line with anchor points";
     return false;
   }
@@ -82,6 +82,32 @@ class ReferenceLineProvider {
 
   double LastTimeDelay();
 
+  /**
+   * @brief The time (in seconds) spent in the smoother during the last
+   * reference line update.
+   */
+  double LastSmootherTime();
+
+  /**
+   * @brief The smoother time (in seconds) saved during the last reference
+   * line update by reusing previously smoothed reference lines. It is an
+   * estimate: the reused length times the moving average smoother time per
+   * meter.
+   */
+  double LastSmootherTimeSavedEstimate();
+
+  /**
+   * @brief The length (in meters) of the reference lines reused without
+   * smoothing during the last reference line update.
+   */
+  double LastReusedLength();
+
+  /**
+   * @brief The statistics of the iterative smoothers during the last
+   * reference line update.
+   */
+  ReferenceLineSmootherStats LastSmootherStats();
+
   std::vector<routing::LaneWaypoint> FutureRouteWaypoints();
 
  private:
@@ -125,6 +151,23 @@ class ReferenceLineProvider {
   bool SmoothRouteSegment(const hdmap::RouteSegments& segments,
                           ReferenceLine* reference_line);
 
+  /**
+   * @brief Run the smoother on the raw reference line and accumulate the
+   * smoother time of the current cycle.
+   */
+  bool RunSmoother(const ReferenceLine& raw_reference_line,
+                   ReferenceLine* reference_line);
+
+  /**
+   * @brief Record the length of a previously smoothed reference line that is
+   * reused in the current cycle instead of being smoothed again.
+   */
+  void AddReusedLength(const double reused_length);
+
+  void ResetSmootherStats();
+
+  void UpdateSmootherStats();
+
   /**
    * @brief This function creates a smoothed forward reference line
    * based on the given segments.
@@ -177,6 +220,16 @@ class ReferenceLineProvider {
   std::list<hdmap::RouteSegments> route_segments_;
   double last_calculation_time_ = 0.0;
 
+  // smoother statistics
+  double cycle_smoother_time_ = 0.0;
+  double cycle_reused_length_ = 0.0;
+  double smoother_time_per_meter_ = 0.0;
+  double last_smoother_time_ = 0.0;
+  double last_reused_length_ = 0.0;
+  double last_smoother_time_saved_estimate_ = 0.0;
+  ReferenceLineSmootherStats cycle_smoother_stats_;
+  ReferenceLineSmootherStats last_smoother_stats_;
+
   std::queue<std::list<ReferenceLine>> reference_line_history_;
   std::queue<std::list<hdmap::RouteSegments>> route_segments_history_;
 
@@ -22,6 +22,7 @@
 
 #include <vector>
 
+#include "modules/planning/proto/planning.pb.h"
 #include "modules/planning/proto/reference_line_smoother_config.pb.h"
 
 #include "modules/planning/reference_line/reference_line.h"
@@ -53,6 +54,11 @@ class ReferenceLineSmoother {
    */
   virtual bool Smooth(const ReferenceLine&, ReferenceLine* const) = 0;
 
+  /**
+   * Add the statistics of the last Smooth() call, if the smoother has any
+   */
+  virtual void AddStats(ReferenceLineSmootherStats* const stats) const {}
+
   virtual ~ReferenceLineSmoother() = default;
 
  protected:
@@ -21,9 +21,11 @@
 #include "modules/planning/scenarios/lane_follow/lane_follow_stage.h"
 
 #include <limits>
+#include <string>
 #include <utility>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/time/time.h"
 #include "modules/common/util/string_tokenizer.h"
@@ -34,6 +36,7 @@
 #include "modules/planning/common/change_lane_decider.h"
 #include "modules/planning/common/ego_info.h"
 #include "modules/planning/common/frame.h"
+#include "modules/planning/common/latency_histograms.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/constraint_checker/constraint_checker.h"
 #include "modules/planning/tasks/optimizers/dp_poly_path/dp_poly_path_optimizer.h"
@@ -118,14 +121,35 @@ Stage::StageStatus LaneFollowStage::Process(
   ADEBUG << "Number of reference lines:\t"
          << frame->mutable_reference_line_info()->size();
 
+  // the side pass stop fence is shared through PlanningContext, so reference
+  // lines can only be planned independently when it is disabled.
+  const bool plan_concurrently =
+      FLAGS_enable_multi_thread_in_lane_follow_stage &&
+      !FLAGS_enable_nonscenario_side_pass &&
+      frame->mutable_reference_line_info()->size() > 1 &&
+      FrameSharedTaskCount(task_list_) != std::string::npos;
+  std::vector<Status> statuses;
+  if (plan_concurrently) {
+    statuses = PlanOnReferenceLinesConcurrently(planning_start_point, frame);
+  }
+
+  size_t index = 0;
   for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
     if (has_drivable_reference_line) {
       reference_line_info.SetDrivable(false);
+      if (plan_concurrently) {
+        // every remaining line has been planned and marked drivable.
+        continue;
+      }
       break;
     }
 
     auto cur_status =
-        PlanOnReferenceLine(planning_start_point, frame, &reference_line_info);
+        plan_concurrently
+            ? statuses[index]
+            : PlanOnReferenceLine(planning_start_point, frame,
+                                  &reference_line_info);
+    ++index;
 
     if (cur_status.ok()) {
       if (reference_line_info.IsChangeLanePath()) {
@@ -152,9 +176,82 @@ Stage::StageStatus LaneFollowStage::Process(
                                      : StageStatus::ERROR;
 }
 
+std::vector<Status> LaneFollowStage::PlanOnReferenceLinesConcurrently(
+    const TrajectoryPoint& planning_start_point, Frame* frame) {
+  auto* reference_line_infos = frame->mutable_reference_line_info();
+  std::vector<ReferenceLineInfo*> infos;
+  std::vector<std::vector<Task*>> task_lists;
+  for (auto& reference_line_info : *reference_line_infos) {
+    task_lists.push_back(TaskListForReferenceLine(infos.size()));
+    infos.push_back(&reference_line_info);
+  }
+
+  // tasks sharing frame state across reference lines run first, line by
+  // line in reference line order on the calling thread, as they would in
+  // serial planning.
+  const size_t num_shared_tasks = FrameSharedTaskCount(task_list_);
+  std::vector<Status> shared_statuses;
+  for (size_t i = 0; i < infos.size(); ++i) {
+    PrepareReferenceLine(planning_start_point, infos[i]);
+    shared_statuses.push_back(
+        ExecuteTasks(frame, infos[i], task_lists[i], 0, num_shared_tasks));
+  }
+
+  // the remaining tasks run on their own task instances and only write their
+  // own ReferenceLineInfo, so the results do not depend on the order the
+  // reference lines finish in.
+  auto plan = [this, &planning_start_point, frame, &infos, &task_lists,
+               &shared_statuses, num_shared_tasks](const size_t i) {
+    auto ret = shared_statuses[i];
+    if (ret.ok()) {
+      ret = ExecuteTasks(frame, infos[i], task_lists[i], num_shared_tasks,
+                         task_lists[i].size());
+    }
+    return FinishReferenceLine(planning_start_point, infos[i], ret);
+  };
+  std::vector<std::future<Status>> results;
+  for (size_t i = 1; i < infos.size(); ++i) {
+    results.push_back(cyber::Async(plan, i));
+  }
+  std::vector<Status> statuses;
+  statuses.push_back(plan(0));
+  for (auto& result : results) {
+    statuses.push_back(result.get());
+  }
+  return statuses;
+}
+
+size_t LaneFollowStage::FrameSharedTaskCount(
+    const std::vector<Task*>& task_list) {
+  // DeciderRuleBasedStop reads PlanningContext and writes the open space
+  // pre stop state of the frame.
+  auto is_frame_shared = [](const Task* task) {
+    return task->Config().task_type() == TaskConfig::DECIDER_RULE_BASED_STOP;
+  };
+  size_t count = 0;
+  while (count < task_list.size() && is_frame_shared(task_list[count])) {
+    ++count;
+  }
+  for (size_t i = count; i < task_list.size(); ++i) {
+    if (is_frame_shared(task_list[i])) {
+      return std::string::npos;
+    }
+  }
+  return count;
+}
+
 Status LaneFollowStage::PlanOnReferenceLine(
     const TrajectoryPoint& planning_start_point, Frame* frame,
     ReferenceLineInfo* reference_line_info) {
+  PrepareReferenceLine(planning_start_point, reference_line_info);
+  const auto ret = ExecuteTasks(frame, reference_line_info, task_list_, 0,
+                                task_list_.size());
+  return FinishReferenceLine(planning_start_point, reference_line_info, ret);
+}
+
+void LaneFollowStage::PrepareReferenceLine(
+    const TrajectoryPoint& planning_start_point,
+    ReferenceLineInfo* reference_line_info) {
   if (!reference_line_info->IsChangeLanePath()) {
     reference_line_info->AddCost(kStraightForwardLineCost);
   }
@@ -168,12 +265,22 @@ Status LaneFollowStage::PlanOnReferenceLine(
     ADEBUG << "Using dummy hot start for speed vector";
   }
   *heuristic_speed_data = SpeedData(speed_profile);
+}
 
+Status LaneFollowStage::ExecuteTasks(Frame* frame,
+                                     ReferenceLineInfo* reference_line_info,
+                                     const std::vector<Task*>& task_list,
+                                     const size_t begin, const size_t end) {
   auto ret = Status::OK();
 
-  for (auto* optimizer : task_list_) {
+  for (size_t i = begin; i < end; ++i) {
+    auto* optimizer = task_list[i];
     const double start_timestamp = Clock::NowInSeconds();
-    ret = optimizer->Execute(frame, reference_line_info);
+    {
+      LatencyHistograms::Timer timer(LatencyHistograms::TASK,
+                                     Name() + "/" + optimizer->Name());
+      ret = optimizer->Execute(frame, reference_line_info);
+    }
     if (!ret.ok()) {
       AERROR << "Failed to run tasks[" << optimizer->Name()
              << "], Error message: " << ret.error_message();
@@ -188,7 +295,12 @@ Status LaneFollowStage::PlanOnReferenceLine(
 
     RecordDebugInfo(reference_line_info, optimizer->Name(), time_diff_ms);
   }
+  return ret;
+}
 
+Status LaneFollowStage::FinishReferenceLine(
+    const TrajectoryPoint& planning_start_point,
+    ReferenceLineInfo* reference_line_info, const Status& ret) {
   RecordObstacleDebugInfo(reference_line_info);
 
   if (reference_line_info->path_data().Empty()) {
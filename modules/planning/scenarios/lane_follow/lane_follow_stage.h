@@ -53,6 +53,34 @@ class LaneFollowStage : public Stage {
       const common::TrajectoryPoint& planning_start_point, Frame* frame,
       ReferenceLineInfo* reference_line_info);
 
+  /**
+   * @brief Plans on every reference line of the frame at the same time, each
+   * with its own task instances, and returns the status of each line in the
+   * order of the reference lines. The leading tasks that share frame state
+   * run serially first.
+   */
+  std::vector<common::Status> PlanOnReferenceLinesConcurrently(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame);
+
+  /**
+   * @brief Number of leading tasks in the list that share frame state across
+   * reference lines; std::string::npos if such a task follows another task,
+   * in which case reference lines can not be planned concurrently.
+   */
+  static size_t FrameSharedTaskCount(const std::vector<Task*>& task_list);
+
+  void PrepareReferenceLine(const common::TrajectoryPoint& planning_start_point,
+                            ReferenceLineInfo* reference_line_info);
+
+  common::Status ExecuteTasks(Frame* frame,
+                              ReferenceLineInfo* reference_line_info,
+                              const std::vector<Task*>& task_list,
+                              const size_t begin, const size_t end);
+
+  common::Status FinishReferenceLine(
+      const common::TrajectoryPoint& planning_start_point,
+      ReferenceLineInfo* reference_line_info, const common::Status& ret);
+
   void GenerateFallbackPathProfile(const ReferenceLineInfo* reference_line_info,
                                    PathData* path_data);
 
@@ -21,6 +21,7 @@
 #include "modules/planning/scenarios/scenario.h"
 
 #include "cyber/common/file.h"
+#include "modules/planning/common/latency_histograms.h"
 
 namespace apollo {
 namespace planning {
@@ -62,7 +63,13 @@ Scenario::ScenarioStatus Scenario::Process(
     scenario_status_ = STATUS_DONE;
     return scenario_status_;
   }
-  auto ret = current_stage_->Process(planning_init_point, frame);
+  LatencyHistograms::Timer scenario_timer(LatencyHistograms::SCENARIO, name_);
+  Stage::StageStatus ret = Stage::ERROR;
+  {
+    LatencyHistograms::Timer stage_timer(LatencyHistograms::STAGE,
+                                         name_ + "/" + current_stage_->Name());
+    ret = current_stage_->Process(planning_init_point, frame);
+  }
   switch (ret) {
     case Stage::ERROR: {
       AERROR << "Stage '" << current_stage_->Name() << "' returns error";
@@ -23,6 +23,7 @@
 #include <utility>
 
 #include "modules/common/time/time.h"
+#include "modules/planning/common/latency_histograms.h"
 
 namespace apollo {
 namespace planning {
@@ -69,7 +70,12 @@ Status StageSidePass::ExecuteTasks(const TrajectoryPoint& planning_start_point,
                                    ReferenceLineInfo* reference_line_info) {
   for (auto* ptr_task : task_list_) {
     const double start_timestamp = Clock::NowInSeconds();
-    auto task_status = ptr_task->Execute(frame, reference_line_info);
+    Status task_status;
+    {
+      LatencyHistograms::Timer timer(LatencyHistograms::TASK,
+                                     Name() + "/" + ptr_task->Name());
+      task_status = ptr_task->Execute(frame, reference_line_info);
+    }
     if (!task_status.ok()) {
       AERROR << "Failed to run tasks[" << ptr_task->Name()
              << "], Error message: " << task_status.error_message();
@@ -24,6 +24,7 @@
 #include <utility>
 
 #include "modules/common/time/time.h"
+#include "modules/planning/common/latency_histograms.h"
 #include "modules/planning/common/speed_profile_generator.h"
 #include "modules/planning/common/trajectory/publishable_trajectory.h"
 #include "modules/planning/tasks/task_factory.h"
@@ -44,6 +45,12 @@ constexpr double kSpeedOptimizationFallbackCost = 2e4;
 Stage::Stage(const ScenarioConfig::StageConfig& config) : config_(config) {
   name_ = ScenarioConfig::StageType_Name(config_.stage_type());
   next_stage_ = config_.stage_type();
+  CreateTasks(&tasks_, &task_list_);
+}
+
+void Stage::CreateTasks(
+    std::map<TaskConfig::TaskType, std::unique_ptr<Task>>* tasks,
+    std::vector<Task*>* task_list) const {
   std::unordered_map<TaskConfig::TaskType, const TaskConfig*, std::hash<int>>
       config_map;
   for (const auto& task_config : config_.task_config()) {
@@ -54,13 +61,13 @@ Stage::Stage(const ScenarioConfig::StageConfig& config) : config_(config) {
     CHECK(config_map.find(task_type) != config_map.end())
         << "Task: " << TaskConfig::TaskType_Name(task_type)
         << " used but not configured";
-    auto iter = tasks_.find(task_type);
-    if (iter == tasks_.end()) {
+    auto iter = tasks->find(task_type);
+    if (iter == tasks->end()) {
       auto ptr = TaskFactory::CreateTask(*config_map[task_type]);
-      task_list_.push_back(ptr.get());
-      tasks_[task_type] = std::move(ptr);
+      task_list->push_back(ptr.get());
+      (*tasks)[task_type] = std::move(ptr);
     } else {
-      task_list_.push_back(iter->second.get());
+      task_list->push_back(iter->second.get());
     }
   }
 }
@@ -76,6 +83,19 @@ Task* Stage::FindTask(TaskConfig::TaskType task_type) const {
   }
 }
 
+std::vector<Task*> Stage::TaskListForReferenceLine(const size_t index) {
+  if (index == 0) {
+    return task_list_;
+  }
+  while (reference_line_task_lists_.size() < index) {
+    reference_line_tasks_.emplace_back();
+    reference_line_task_lists_.emplace_back();
+    CreateTasks(&reference_line_tasks_.back(),
+                &reference_line_task_lists_.back());
+  }
+  return reference_line_task_lists_[index - 1];
+}
+
 bool Stage::ExecuteTaskOnReferenceLine(
     const common::TrajectoryPoint& planning_start_point, Frame* frame) {
   for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
@@ -86,6 +106,8 @@ bool Stage::ExecuteTaskOnReferenceLine(
 
     auto ret = common::Status::OK();
     for (auto* task : task_list_) {
+      LatencyHistograms::Timer timer(LatencyHistograms::TASK,
+                                     name_ + "/" + task->Name());
       ret = task->Execute(frame, &reference_line_info);
       if (!ret.ok()) {
         AERROR << "Failed to run tasks[" << task->Name()
@@ -119,6 +141,8 @@ bool Stage::ExecuteTaskOnReferenceLine(
 bool Stage::ExecuteTaskOnOpenSpace(Frame* frame) {
   auto ret = common::Status::OK();
   for (auto* task : task_list_) {
+    LatencyHistograms::Timer timer(LatencyHistograms::TASK,
+                                   name_ + "/" + task->Name());
     ret = task->Execute(frame);
     if (!ret.ok()) {
       AERROR << "Failed to run tasks[" << task->Name()
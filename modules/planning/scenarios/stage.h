@@ -86,11 +86,26 @@ class Stage {
 
   bool ExecuteTaskOnOpenSpace(Frame* frame);
 
+  /**
+   * @brief The task list used to plan on the reference line at index. Index 0
+   * is TaskList(); every other index gets task instances of its own, so that
+   * reference lines can be planned concurrently. Not thread safe: fetch the
+   * lists before the concurrent planning starts.
+   */
+  std::vector<Task*> TaskListForReferenceLine(const size_t index);
+
   virtual Stage::StageStatus FinishScenario();
 
+ private:
+  void CreateTasks(std::map<TaskConfig::TaskType, std::unique_ptr<Task>>* tasks,
+                   std::vector<Task*>* task_list) const;
+
  protected:
   std::map<TaskConfig::TaskType, std::unique_ptr<Task>> tasks_;
   std::vector<Task*> task_list_;
+  std::vector<std::map<TaskConfig::TaskType, std::unique_ptr<Task>>>
+      reference_line_tasks_;
+  std::vector<std::vector<Task*>> reference_line_task_lists_;
   ScenarioConfig::StageConfig config_;
   ScenarioConfig::StageType next_stage_;
   void* context_ = nullptr;
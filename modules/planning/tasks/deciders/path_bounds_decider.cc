@@ -62,12 +62,26 @@ Status PathBoundsDecider::Process(
   CHECK_NOTNULL(reference_line_info);
 
   // The decided path bounds should be in the format of: (s, l_min, l_max).
-  PathBoundary fallback_path_boundaries;
-  PathBoundary path_boundaries;
+  // All the variants share the stations of one initialized path boundary
+  // and the lane widths sampled along them in a single sweep.
+  PathBoundary initial_path_boundaries;
+  if (!InitPathBoundary(reference_line_info->reference_line(),
+                        frame->PlanningStartPoint(),
+                        &initial_path_boundaries)) {
+    const std::string msg = "Failed to initialize path boundaries.";
+    AERROR << msg;
+    return Status(ErrorCode::PLANNING_ERROR, msg);
+  }
+  // Only lane borrowing needs the neighbor lanes, and none of the current
+  // path boundary variants borrows a lane.
+  std::vector<LaneSample> lane_samples;
+  SampleLanes(reference_line_info->reference_line(), initial_path_boundaries,
+              false, &lane_samples);
 
   // Generate fallback path boundaries.
-  std::string fallback_path_bounds_msg = GenerateFallbackPathBoundary(
-      frame, reference_line_info, &fallback_path_boundaries);
+  PathBoundary fallback_path_boundaries = initial_path_boundaries;
+  std::string fallback_path_bounds_msg =
+      GenerateFallbackPathBoundary(lane_samples, &fallback_path_boundaries);
   if (fallback_path_bounds_msg != "") {
     return Status(ErrorCode::PLANNING_ERROR, fallback_path_bounds_msg);
   }
@@ -92,8 +106,9 @@ Status PathBoundsDecider::Process(
   }
 
   // Generate path boundaries.
-  std::string path_bounds_msg =
-      GenerateRegularPathBoundary(frame, reference_line_info, &path_boundaries);
+  PathBoundary path_boundaries = std::move(initial_path_boundaries);
+  std::string path_bounds_msg = GenerateRegularPathBoundary(
+      reference_line_info, lane_samples, &path_boundaries);
   if (path_bounds_msg != "") {
     return Status(ErrorCode::PLANNING_ERROR, path_bounds_msg);
   }
@@ -123,24 +138,18 @@ Status PathBoundsDecider::Process(
 }
 
 std::string PathBoundsDecider::GenerateRegularPathBoundary(
-    Frame* frame, ReferenceLineInfo* reference_line_info,
+    ReferenceLineInfo* reference_line_info,
+    const std::vector<LaneSample>& lane_samples,
     std::vector<std::tuple<double, double, double>>* const path_boundaries) {
   // Sanity checks.
-  CHECK_NOTNULL(frame);
   CHECK_NOTNULL(reference_line_info);
+  CHECK_NOTNULL(path_boundaries);
 
-  // 1. Initialize the path boundaries to be an indefinitely large area.
-  if (!InitPathBoundary(reference_line_info->reference_line(),
-                        frame->PlanningStartPoint(), path_boundaries)) {
-    const std::string msg = "Failed to initialize path boundaries.";
-    AERROR << msg;
-    return msg;
-  }
-  // PathBoundsDebugString(*path_boundaries);
+  // 1. The path boundaries are initialized to be an indefinitely large area
+  //    by the caller.
 
   // 2. Decide a rough boundary based on road info and ADC's position
-  if (!GetBoundaryFromLanesAndADC(reference_line_info->reference_line(), 0, 0.1,
-                                  path_boundaries)) {
+  if (!GetBoundaryFromLanesAndADC(lane_samples, 0, 0.1, path_boundaries)) {
     const std::string msg =
         "Failed to decide a rough boundary based on "
         "road information.";
@@ -169,24 +178,16 @@ std::string PathBoundsDecider::GenerateRegularPathBoundary(
 }
 
 std::string PathBoundsDecider::GenerateFallbackPathBoundary(
-    Frame* frame, ReferenceLineInfo* reference_line_info,
+    const std::vector<LaneSample>& lane_samples,
     std::vector<std::tuple<double, double, double>>* const path_boundaries) {
   // Sanity checks.
-  CHECK_NOTNULL(frame);
-  CHECK_NOTNULL(reference_line_info);
+  CHECK_NOTNULL(path_boundaries);
 
-  // 1. Initialize the path boundaries to be an indefinitely large area.
-  if (!InitPathBoundary(reference_line_info->reference_line(),
-                        frame->PlanningStartPoint(), path_boundaries)) {
-    const std::string msg = "Failed to initialize fallback path boundaries.";
-    AERROR << msg;
-    return msg;
-  }
-  // PathBoundsDebugString(*path_boundaries);
+  // 1. The path boundaries are initialized to be an indefinitely large area
+  //    by the caller.
 
   // 2. Decide a rough boundary based on road info and ADC's position
-  if (!GetBoundaryFromLanesAndADC(reference_line_info->reference_line(), 0, 0.5,
-                                  path_boundaries)) {
+  if (!GetBoundaryFromLanesAndADC(lane_samples, 0, 0.5, path_boundaries)) {
     const std::string msg =
         "Failed to decide a rough fallback boundary based on "
         "road information.";
@@ -246,86 +247,118 @@ bool PathBoundsDecider::InitPathBoundary(
   return true;
 }
 
-bool PathBoundsDecider::GetBoundaryFromLanesAndADC(
-    const ReferenceLine& reference_line, int lane_borrowing, double ADC_buffer,
-    std::vector<std::tuple<double, double, double>>* const path_boundaries) {
+void PathBoundsDecider::SampleLanes(
+    const ReferenceLine& reference_line, const PathBoundary& path_boundaries,
+    bool sample_neighbor_lanes, std::vector<LaneSample>* const lane_samples) {
   // Sanity checks.
-  CHECK_NOTNULL(path_boundaries);
-  CHECK(!path_boundaries->empty());
+  CHECK_NOTNULL(lane_samples);
+  lane_samples->clear();
+  lane_samples->reserve(path_boundaries.size());
 
-  // Go through every point, update the boundary based on lane info and
-  // ADC's position.
   double past_lane_left_width = adc_lane_width_ / 2.0;
   double past_lane_right_width = adc_lane_width_ / 2.0;
-  double past_neighbor_lane_width = 0.0;
+  double past_left_neighbor_lane_width = 0.0;
+  double past_right_neighbor_lane_width = 0.0;
 
-  int path_blocked_idx = -1;
-  for (size_t i = 0; i < path_boundaries->size(); ++i) {
-    double curr_s = std::get<0>((*path_boundaries)[i]);
+  for (const auto& path_bound_point : path_boundaries) {
+    double curr_s = std::get<0>(path_bound_point);
+    LaneSample lane_sample;
     // 1. Get the current lane width at current point.
-    double curr_lane_left_width = 0.0;
-    double curr_lane_right_width = 0.0;
-    if (!reference_line.GetLaneWidth(curr_s, &curr_lane_left_width,
-                                     &curr_lane_right_width)) {
+    if (!reference_line.GetLaneWidth(curr_s, &lane_sample.left_width,
+                                     &lane_sample.right_width)) {
       AWARN << "Failed to get lane width at s = " << curr_s;
-      curr_lane_left_width = past_lane_left_width;
-      curr_lane_right_width = past_lane_right_width;
+      lane_sample.left_width = past_lane_left_width;
+      lane_sample.right_width = past_lane_right_width;
     } else {
-      past_lane_left_width = curr_lane_left_width;
-      past_lane_right_width = curr_lane_right_width;
+      past_lane_left_width = lane_sample.left_width;
+      past_lane_right_width = lane_sample.right_width;
     }
 
     // 2. Get the neighbor lane widths at the current point.
-    double curr_neighbor_lane_width = 0.0;
-    hdmap::Lane curr_lane;
-    hdmap::LaneInfoConstPtr lane_info_ptr;
-    if (!GetLaneInfoFromPoint(
-            reference_line.GetReferencePoint(curr_s).x(),
-            reference_line.GetReferencePoint(curr_s).y(), 0.0,
-            reference_line.GetReferencePoint(curr_s).heading(),
-            &lane_info_ptr)) {
-      ADEBUG << "Cannot find the true current lane; therefore, use the "
-                "planning starting point's lane as a substitute.";
-      curr_neighbor_lane_width = past_neighbor_lane_width;
-    } else {
-      curr_lane = lane_info_ptr->lane();
-      hdmap::LaneInfoConstPtr adjacent_lane = nullptr;
-      if (lane_borrowing == 1) {
+    if (sample_neighbor_lanes) {
+      lane_sample.left_neighbor_width = past_left_neighbor_lane_width;
+      lane_sample.right_neighbor_width = past_right_neighbor_lane_width;
+      const auto reference_point = reference_line.GetReferencePoint(curr_s);
+      hdmap::LaneInfoConstPtr lane_info_ptr;
+      if (!GetLaneInfoFromPoint(reference_point.x(), reference_point.y(), 0.0,
+                                reference_point.heading(), &lane_info_ptr)) {
+        ADEBUG << "Cannot find the true current lane; therefore, use the "
+                  "planning starting point's lane as a substitute.";
+      } else {
+        const hdmap::Lane& curr_lane = lane_info_ptr->lane();
         // Borrowing left neighbor lane.
+        hdmap::LaneInfoConstPtr left_lane = nullptr;
         if (curr_lane.left_neighbor_forward_lane_id_size() > 0) {
-          adjacent_lane = HDMapUtil::BaseMapPtr()->GetLaneById(
+          left_lane = HDMapUtil::BaseMapPtr()->GetLaneById(
               curr_lane.left_neighbor_forward_lane_id(0));
-
         } else if (curr_lane.left_neighbor_reverse_lane_id_size() > 0) {
-          adjacent_lane = HDMapUtil::BaseMapPtr()->GetLaneById(
+          left_lane = HDMapUtil::BaseMapPtr()->GetLaneById(
               curr_lane.left_neighbor_reverse_lane_id(0));
         }
-      } else if (lane_borrowing == -1) {
         // Borrowing right neighbor lane.
+        hdmap::LaneInfoConstPtr right_lane = nullptr;
         if (curr_lane.right_neighbor_forward_lane_id_size() > 0) {
-          adjacent_lane = HDMapUtil::BaseMapPtr()->GetLaneById(
+          right_lane = HDMapUtil::BaseMapPtr()->GetLaneById(
               curr_lane.right_neighbor_forward_lane_id(0));
         } else if (curr_lane.right_neighbor_reverse_lane_id_size() > 0) {
-          adjacent_lane = HDMapUtil::BaseMapPtr()->GetLaneById(
+          right_lane = HDMapUtil::BaseMapPtr()->GetLaneById(
               curr_lane.right_neighbor_reverse_lane_id(0));
         }
+        common::math::Vec2d xy_curr_s;
+        common::SLPoint sl_curr_s;
+        sl_curr_s.set_s(curr_s);
+        sl_curr_s.set_l(0.0);
+        reference_line.SLToXY(sl_curr_s, &xy_curr_s);
+        double adjacent_lane_s = 0.0;
+        double adjacent_lane_l = 0.0;
+        if (left_lane == nullptr ||
+            !left_lane->GetProjection(xy_curr_s, &adjacent_lane_s,
+                                      &adjacent_lane_l)) {
+          ADEBUG << "Unable to get the left neighbor lane's width.";
+        } else {
+          lane_sample.left_neighbor_width =
+              left_lane->GetWidth(adjacent_lane_s);
+          past_left_neighbor_lane_width = lane_sample.left_neighbor_width;
+        }
+        if (right_lane == nullptr ||
+            !right_lane->GetProjection(xy_curr_s, &adjacent_lane_s,
+                                       &adjacent_lane_l)) {
+          ADEBUG << "Unable to get the right neighbor lane's width.";
+        } else {
+          lane_sample.right_neighbor_width =
+              right_lane->GetWidth(adjacent_lane_s);
+          past_right_neighbor_lane_width = lane_sample.right_neighbor_width;
+        }
       }
-      common::math::Vec2d xy_curr_s;
-      common::SLPoint sl_curr_s;
-      sl_curr_s.set_s(curr_s);
-      sl_curr_s.set_l(0.0);
-      reference_line.SLToXY(sl_curr_s, &xy_curr_s);
-      double adjacent_lane_s = 0.0;
-      double adjacent_lane_l = 0.0;
-      if (adjacent_lane == nullptr ||
-          !adjacent_lane->GetProjection(xy_curr_s, &adjacent_lane_s,
-                                        &adjacent_lane_l)) {
-        ADEBUG << "Unable to get the neighbor lane's width.";
-        curr_neighbor_lane_width = past_neighbor_lane_width;
-      } else {
-        curr_neighbor_lane_width = adjacent_lane->GetWidth(adjacent_lane_s);
-        past_neighbor_lane_width = curr_neighbor_lane_width;
-      }
+    }
+    lane_samples->push_back(lane_sample);
+  }
+}
+
+bool PathBoundsDecider::GetBoundaryFromLanesAndADC(
+    const std::vector<LaneSample>& lane_samples, int lane_borrowing,
+    double ADC_buffer,
+    std::vector<std::tuple<double, double, double>>* const path_boundaries) {
+  // Sanity checks.
+  CHECK_NOTNULL(path_boundaries);
+  CHECK(!path_boundaries->empty());
+  CHECK_EQ(lane_samples.size(), path_boundaries->size());
+
+  // Go through every point, update the boundary based on lane info and
+  // ADC's position.
+  int path_blocked_idx = -1;
+  for (size_t i = 0; i < path_boundaries->size(); ++i) {
+    // 1. Get the current lane width at current point.
+    const LaneSample& lane_sample = lane_samples[i];
+    double curr_lane_left_width = lane_sample.left_width;
+    double curr_lane_right_width = lane_sample.right_width;
+
+    // 2. Get the neighbor lane widths at the current point.
+    double curr_neighbor_lane_width = 0.0;
+    if (lane_borrowing == 1) {
+      curr_neighbor_lane_width = lane_sample.left_neighbor_width;
+    } else if (lane_borrowing == -1) {
+      curr_neighbor_lane_width = lane_sample.right_neighbor_width;
     }
 
     // 3. Calculate the proper boundary based on lane-width, ADC's position,
@@ -377,7 +410,7 @@ bool PathBoundsDecider::GetBoundaryFromStaticObstacles(
     PathDecision* const path_decision,
     std::vector<std::tuple<double, double, double>>* const path_boundaries) {
   // Preprocessing.
-  auto indexed_obstacles = path_decision->obstacles();
+  const auto& indexed_obstacles = path_decision->obstacles();
   auto sorted_obstacles = SortObstaclesForSweepLine(indexed_obstacles);
   double center_line = adc_frenet_l_;
   size_t obs_idx = 0;
@@ -42,6 +42,14 @@ class PathBoundsDecider : public Decider {
   common::Status Process(Frame* frame,
                          ReferenceLineInfo* reference_line_info) override;
 
+  // Lane widths sampled at one station of the path boundary.
+  struct LaneSample {
+    double left_width = 0.0;
+    double right_width = 0.0;
+    double left_neighbor_width = 0.0;
+    double right_neighbor_width = 0.0;
+  };
+
   /**
    * @brief: The regular path boundary generation considers the ADC itself
    *   and other static environments:
@@ -50,13 +58,15 @@ class PathBoundsDecider : public Decider {
    *   - static obstacles
    *   The philosophy is: static environment must be and can only be taken
    *   care of by the path planning.
-   * @param: frame
    * @param: reference_line_info
-   * @param: The generated regular path_boundary, if there is one.
+   * @param: The lane widths sampled along the path boundary.
+   * @param: The path_boundary initialized by InitPathBoundary; it is refined
+   *   into the regular path_boundary, if there is one.
    * @return: A failure message. If succeeded, return "" (empty string).
    */
   std::string GenerateRegularPathBoundary(
-      Frame* frame, ReferenceLineInfo* reference_line_info,
+      ReferenceLineInfo* reference_line_info,
+      const std::vector<LaneSample>& lane_samples,
       std::vector<std::tuple<double, double, double>>* const path_boundaries);
 
   /**
@@ -71,13 +81,13 @@ class PathBoundsDecider : public Decider {
    *   obstacle. When the fallback path is used, stopping before static
    *   obstacles should be taken care of by the speed decider. Also, it
    *   doesn't consider any lane-borrowing.
-   * @param: frame
-   * @param: reference_line_info
-   * @param: The generated fallback path_boundary, if there is one.
+   * @param: The lane widths sampled along the path boundary.
+   * @param: The path_boundary initialized by InitPathBoundary; it is refined
+   *   into the fallback path_boundary, if there is one.
    * @return: A failure message. If succeeded, return "" (empty string).
    */
   std::string GenerateFallbackPathBoundary(
-      Frame* frame, ReferenceLineInfo* reference_line_info,
+      const std::vector<LaneSample>& lane_samples,
       std::vector<std::tuple<double, double, double>>* const path_boundaries);
 
   bool InitPathBoundary(
@@ -85,8 +95,22 @@ class PathBoundsDecider : public Decider {
       const common::TrajectoryPoint& planning_start_point,
       std::vector<std::tuple<double, double, double>>* const path_boundaries);
 
+  /**
+   * @brief Sample the lane widths at every station of the path boundary in
+   *   one sweep along s, so that all the boundary variants share the
+   *   reference line and map queries.
+   * @param The reference line.
+   * @param The initialized path_boundaries providing the stations.
+   * @param Whether the neighbor lanes are queried for lane borrowing.
+   * @param The lane samples, one per station.
+   */
+  void SampleLanes(
+      const ReferenceLine& reference_line,
+      const std::vector<std::tuple<double, double, double>>& path_boundaries,
+      bool sample_neighbor_lanes, std::vector<LaneSample>* const lane_samples);
+
   bool GetBoundaryFromLanesAndADC(
-      const ReferenceLine& reference_line, int lane_borrowing,
+      const std::vector<LaneSample>& lane_samples, int lane_borrowing,
       double ADC_buffer,
       std::vector<std::tuple<double, double, double>>* const path_boundaries);
 
@@ -60,6 +60,7 @@ void SidePassPathDecider::InitSolver() {
   fem_qp_ = std::move(std::make_unique<Fem1dQpProblem>(
       n, l_init, delta_s_, w,
       config.side_pass_path_decider_config().max_dddl()));
+  fem_qp_->SetWorkspace(&fem_qp_workspace_);
 }
 
 Status SidePassPathDecider::Process(
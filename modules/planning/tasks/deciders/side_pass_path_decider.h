@@ -34,6 +34,7 @@
 #include "modules/planning/common/frame.h"
 #include "modules/planning/common/reference_line_info.h"
 #include "modules/planning/math/finite_element_qp/fem_1d_qp_problem.h"
+#include "modules/planning/math/osqp_workspace.h"
 #include "modules/planning/tasks/deciders/decider.h"
 
 namespace apollo {
@@ -82,6 +83,7 @@ class SidePassPathDecider : public Decider {
   common::TrajectoryPoint adc_planning_start_point_;
   common::FrenetFramePoint adc_frenet_frame_point_;
   std::unique_ptr<Fem1dQpProblem> fem_qp_ = nullptr;
+  OsqpWorkspace fem_qp_workspace_{"SidePassPath"};
   SidePassDirection decided_direction_ = SidePassDirection::LEFT;
   double delta_s_ = 0.0;
   double total_path_length_ = 0.0;
@@ -0,0 +1,73 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/tasks/deciders/speed_bounds_decider/path_station_grid.h"
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::AABoxKDTree2d;
+using apollo::common::math::AABoxKDTreeParams;
+using apollo::common::math::Box2d;
+
+PathStationGrid::PathStationGrid(const std::vector<double>& station_s,
+                                 const std::vector<Box2d>& adc_boxes) {
+  CHECK_EQ(station_s.size(), adc_boxes.size());
+  stations_.reserve(station_s.size());
+  for (size_t i = 0; i < station_s.size(); ++i) {
+    stations_.emplace_back(static_cast<int>(i), station_s[i], adc_boxes[i]);
+  }
+  if (stations_.empty()) {
+    return;
+  }
+  AABoxKDTreeParams params;
+  params.max_leaf_dimension = 5.0;  // meters.
+  params.max_leaf_size = 4;
+  kd_tree_.reset(new AABoxKDTree2d<Station>(stations_, params));
+}
+
+int PathStationGrid::GetFirstOverlapIndex(const Box2d& obstacle_box) const {
+  if (kd_tree_ == nullptr) {
+    return -1;
+  }
+  // A station box overlapping the obstacle box shares a point with it, and
+  // every point of the obstacle box is within half of its diagonal from the
+  // center, so the stations further away than that can not overlap.
+  constexpr double kDistanceBuffer = 1e-6;
+  const auto candidates = kd_tree_->GetObjects(
+      obstacle_box.center(), 0.5 * obstacle_box.diagonal() + kDistanceBuffer);
+
+  int first_index = -1;
+  for (const auto* station : candidates) {
+    if (first_index >= 0 && station->index() > first_index) {
+      continue;
+    }
+    if (station->box().HasOverlap(obstacle_box)) {
+      first_index = station->index();
+    }
+  }
+  return first_index;
+}
+
+}  // namespace planning
+}  // namespace apollo
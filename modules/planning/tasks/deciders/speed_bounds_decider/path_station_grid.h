@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/common/math/box2d.h"
+#include "modules/common/math/vec2d.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class PathStationGrid
+ * @brief The ADC boxes at a sequence of stations along a path. The boxes are
+ * indexed by an axis-aligned bounding box KD-tree, so the first station
+ * colliding with an obstacle box is found from the few stations near the
+ * obstacle instead of testing the obstacle against every station.
+ */
+class PathStationGrid {
+ public:
+  PathStationGrid() = default;
+
+  /**
+   * @param station_s the s of every station, in increasing order
+   * @param adc_boxes the ADC box at every station
+   */
+  PathStationGrid(const std::vector<double>& station_s,
+                  const std::vector<common::math::Box2d>& adc_boxes);
+
+  bool empty() const { return stations_.empty(); }
+
+  size_t size() const { return stations_.size(); }
+
+  double s(const size_t index) const { return stations_[index].s(); }
+
+  /**
+   * @brief Finds the first station whose ADC box overlaps the obstacle box.
+   * @return the index of the station, or -1 if no station overlaps.
+   */
+  int GetFirstOverlapIndex(const common::math::Box2d& obstacle_box) const;
+
+ private:
+  class Station {
+   public:
+    Station(const int index, const double s, const common::math::Box2d& box)
+        : index_(index), s_(s), box_(box), aabox_(box.GetAABox()) {}
+
+    int index() const { return index_; }
+    double s() const { return s_; }
+    const common::math::Box2d& box() const { return box_; }
+    const common::math::AABox2d& aabox() const { return aabox_; }
+
+    double DistanceSquareTo(const common::math::Vec2d& point) const {
+      const double distance = box_.DistanceTo(point);
+      return distance * distance;
+    }
+
+   private:
+    int index_ = 0;
+    double s_ = 0.0;
+    common::math::Box2d box_;
+    common::math::AABox2d aabox_;
+  };
+
+  // the kd-tree keeps pointers to stations_, which is not modified after
+  // construction.
+  std::vector<Station> stations_;
+  std::unique_ptr<common::math::AABoxKDTree2d<Station>> kd_tree_;
+};
+
+}  // namespace planning
+}  // namespace apollo
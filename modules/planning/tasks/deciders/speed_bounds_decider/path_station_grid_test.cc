@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/tasks/deciders/speed_bounds_decider/path_station_grid.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+using apollo::common::math::Vec2d;
+
+namespace {
+
+// stations along an arc, every 0.5 m
+void BuildArcStations(std::vector<double>* station_s,
+                      std::vector<Box2d>* adc_boxes) {
+  constexpr double kRadius = 30.0;
+  for (double s = 0.0; s < 60.0; s += 0.5) {
+    const double theta = s / kRadius;
+    const Vec2d center(kRadius * std::sin(theta),
+                       kRadius * (1.0 - std::cos(theta)));
+    station_s->push_back(s);
+    adc_boxes->emplace_back(center, theta, 5.0, 2.2);
+  }
+}
+
+}  // namespace
+
+TEST(PathStationGridTest, empty) {
+  PathStationGrid grid;
+  EXPECT_TRUE(grid.empty());
+  EXPECT_EQ(-1, grid.GetFirstOverlapIndex(Box2d(Vec2d(0.0, 0.0), 0.0, 1, 1)));
+}
+
+TEST(PathStationGridTest, first_overlap_index) {
+  std::vector<double> station_s;
+  std::vector<Box2d> adc_boxes;
+  BuildArcStations(&station_s, &adc_boxes);
+  PathStationGrid grid(station_s, adc_boxes);
+  ASSERT_EQ(station_s.size(), grid.size());
+  EXPECT_DOUBLE_EQ(station_s[10], grid.s(10));
+
+  int num_overlaps = 0;
+  for (double x = -10.0; x < 60.0; x += 0.7) {
+    for (double y = -10.0; y < 40.0; y += 0.9) {
+      for (const double heading : {0.0, 0.6, -1.3}) {
+        const Box2d obstacle_box(Vec2d(x, y), heading, 4.5, 1.8);
+        int expected = -1;
+        for (size_t i = 0; i < adc_boxes.size(); ++i) {
+          if (adc_boxes[i].HasOverlap(obstacle_box)) {
+            expected = static_cast<int>(i);
+            break;
+          }
+        }
+        EXPECT_EQ(expected, grid.GetFirstOverlapIndex(obstacle_box));
+        if (expected >= 0) {
+          ++num_overlaps;
+        }
+      }
+    }
+  }
+  EXPECT_GT(num_overlaps, 0);
+}
+
+}  // namespace planning
+}  // namespace apollo
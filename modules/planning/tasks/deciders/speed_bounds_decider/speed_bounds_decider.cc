@@ -98,6 +98,7 @@ Status SpeedBoundsDecider::Process(
                                    speed_bounds_config_.total_path_length(),
                                    speed_bounds_config_.total_time(),
                                    reference_line_info_->IsChangeLanePath());
+  boundary_mapper.SetObstacleBoxCache(frame->mutable_obstacle_box_cache());
 
   path_decision->EraseStBoundaries();
   if (boundary_mapper.CreateStBoundary(path_decision).code() ==
@@ -20,15 +20,16 @@
 
 #include "modules/planning/tasks/deciders/speed_bounds_decider/speed_limit_decider.h"
 
+#include <algorithm>
 #include <limits>
 #include <tuple>
+#include <vector>
 
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/planning/proto/decision.pb.h"
 
 #include "cyber/common/log.h"
 #include "modules/common/configs/vehicle_config_helper.h"
-#include "modules/common/util/util.h"
 #include "modules/planning/common/planning_gflags.h"
 
 namespace apollo {
@@ -97,6 +98,40 @@ Status SpeedLimitDecider::GetSpeedLimits(
              frenet_path.back().s());
   }
 
+  // The nudge obstacles and the range of reference line s, for the ADC
+  // center, where the ADC is beside them. They are collected once instead of
+  // scanning all obstacles at every path point.
+  /* ref line:
+   * -------------------------------
+   *    start_s   end_s
+   * ------|  adc   |---------------
+   * ------------|  obstacle |------
+   */
+  struct NudgeObstacle {
+    const Obstacle* obstacle;
+    double start_s;
+    double end_s;
+  };
+  const double collision_safety_range =
+      speed_bounds_config_.collision_safety_range();
+  const double front_buffer =
+      FLAGS_enable_soft_speed_limit ? collision_safety_range : 0.0;
+  std::vector<NudgeObstacle> nudge_obstacles;
+  for (const auto* const_obstacle : obstacles.Items()) {
+    if (const_obstacle->IsVirtual()) {
+      continue;
+    }
+    if (!const_obstacle->LateralDecision().has_nudge()) {
+      continue;
+    }
+    const auto& sl_boundary = const_obstacle->PerceptionSLBoundary();
+    nudge_obstacles.push_back(
+        {const_obstacle,
+         sl_boundary.start_s() - vehicle_param_.front_edge_to_center() -
+             front_buffer,
+         sl_boundary.end_s() + vehicle_param_.back_edge_to_center()});
+  }
+
   for (uint32_t i = 0; i < discretized_path.size(); ++i) {
     const double path_s = discretized_path.at(i).s();
     const double frenet_point_s = frenet_path.at(i).s();
@@ -133,42 +168,12 @@ Status SpeedLimitDecider::GetSpeedLimits(
 
     // (3) speed limit from nudge obstacles
     double nudge_obstacle_speed_limit = std::numeric_limits<double>::max();
-    const double collision_safety_range =
-        speed_bounds_config_.collision_safety_range();
-    for (const auto* const_obstacle : obstacles.Items()) {
-      if (const_obstacle->IsVirtual()) {
+    for (const auto& nudge_obstacle : nudge_obstacles) {
+      if (frenet_point_s < nudge_obstacle.start_s ||
+          frenet_point_s > nudge_obstacle.end_s) {
         continue;
       }
-      if (!const_obstacle->LateralDecision().has_nudge()) {
-        continue;
-      }
-
-      /* ref line:
-       * -------------------------------
-       *    start_s   end_s
-       * ------|  adc   |---------------
-       * ------------|  obstacle |------
-       */
-      const double vehicle_front_s =
-          frenet_point_s + vehicle_param_.front_edge_to_center();
-      const double vehicle_back_s =
-          frenet_point_s - vehicle_param_.back_edge_to_center();
-      const double obstacle_front_s =
-          const_obstacle->PerceptionSLBoundary().end_s();
-      const double obstacle_back_s =
-          const_obstacle->PerceptionSLBoundary().start_s();
-
-      if (FLAGS_enable_soft_speed_limit) {
-        if (vehicle_front_s + collision_safety_range < obstacle_back_s ||
-            vehicle_back_s > obstacle_front_s) {
-          continue;
-        }
-      } else {
-        if (vehicle_front_s < obstacle_back_s ||
-            vehicle_back_s > obstacle_front_s) {
-          continue;
-        }
-      }
+      const auto* const_obstacle = nudge_obstacle.obstacle;
 
       if (FLAGS_enable_soft_speed_limit) {
         double collision_avoidance_speed_ratio = 1.0;
@@ -222,20 +227,14 @@ Status SpeedLimitDecider::GetSpeedLimits(
         }
       }
     }
-    double curr_speed_limit = 0.0;
+    double curr_speed_limit =
+        std::min({speed_limit_on_reference_line, centri_acc_speed_limit,
+                  centri_jerk_speed_limit});
     if (FLAGS_enable_nudge_slowdown && !FLAGS_enable_soft_speed_limit) {
-      curr_speed_limit =
-          std::fmax(speed_bounds_config_.lowest_speed(),
-                    common::util::MinElement(std::vector<double>{
-                        speed_limit_on_reference_line, centri_acc_speed_limit,
-                        centri_jerk_speed_limit, nudge_obstacle_speed_limit}));
-    } else {
-      curr_speed_limit =
-          std::fmax(speed_bounds_config_.lowest_speed(),
-                    common::util::MinElement(std::vector<double>{
-                        speed_limit_on_reference_line, centri_acc_speed_limit,
-                        centri_jerk_speed_limit}));
+      curr_speed_limit = std::min(curr_speed_limit, nudge_obstacle_speed_limit);
     }
+    curr_speed_limit =
+        std::fmax(speed_bounds_config_.lowest_speed(), curr_speed_limit);
     speed_limit_data->AppendSpeedLimit(path_s, curr_speed_limit);
 
     double curr_soft_speed_limit = 0.0;
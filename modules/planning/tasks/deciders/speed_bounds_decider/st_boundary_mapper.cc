@@ -86,6 +86,9 @@ Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
                   "Fail to get params because of too few path points");
   }
 
+  PathSamples path_samples;
+  SamplePath(&path_samples);
+
   Obstacle* stop_obstacle = nullptr;
   ObjectDecisionType stop_decision;
   double min_stop_s = std::numeric_limits<double>::max();
@@ -108,7 +111,7 @@ Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
     }
 
     if (!obstacle->HasLongitudinalDecision()) {
-      if (!MapWithoutDecision(obstacle).ok()) {
+      if (!MapWithoutDecision(path_samples, obstacle).ok()) {
         std::string msg = StrCat("Fail to map obstacle ", obstacle->Id(),
                                  " without decision.");
         AERROR << msg;
@@ -138,7 +141,7 @@ Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
       }
     } else if (decision.has_follow() || decision.has_overtake() ||
                decision.has_yield()) {
-      if (!MapWithDecision(obstacle, decision).ok()) {
+      if (!MapWithDecision(path_samples, obstacle, decision).ok()) {
         AERROR << "Fail to map obstacle " << obstacle->Id()
                << " with decision: " << decision.DebugString();
         return Status(ErrorCode::PLANNING_ERROR,
@@ -209,12 +212,67 @@ bool StBoundaryMapper::MapStopDecision(
   return true;
 }
 
-Status StBoundaryMapper::MapWithoutDecision(Obstacle* obstacle) const {
+void StBoundaryMapper::SamplePath(PathSamples* path_samples) const {
+  const auto& path_points = path_data_.discretized_path();
+  const double buffer = speed_bounds_config_.boundary_buffer();
+
+  std::vector<double> station_s;
+  std::vector<Box2d> adc_boxes;
+  for (const auto& path_point : path_points) {
+    if (path_point.s() > planning_distance_) {
+      break;
+    }
+    station_s.push_back(path_point.s());
+    adc_boxes.push_back(
+        GetAdcBox(path_point.x(), path_point.y(), path_point.theta(), buffer));
+  }
+  path_samples->path_point_grid = PathStationGrid(station_s, adc_boxes);
+
+  const int default_num_point = 50;
+  auto& downsampled_path = path_samples->downsampled_path;
+  if (path_points.size() > 2 * default_num_point) {
+    const auto ratio = path_points.size() / default_num_point;
+    downsampled_path.Reserve(path_points.size() / ratio + 1);
+    for (size_t i = 0; i < path_points.size(); i += ratio) {
+      downsampled_path.Append(path_points[i]);
+    }
+  } else {
+    downsampled_path = PathPointArrays(path_points);
+  }
+  path_samples->path_start_s = downsampled_path.s().front();
+
+  // the coarse search visits the same path stations for every obstacle
+  // trajectory point, so evaluate them and build the ADC boxes only once.
+  const double step_length = vehicle_param_.front_edge_to_center();
+  const double path_len =
+      std::min(FLAGS_max_trajectory_len, downsampled_path.Length());
+  std::vector<double> coarse_path_s;
+  std::vector<double> coarse_s;
+  for (double path_s = 0.0; path_s < path_len; path_s += step_length) {
+    coarse_path_s.push_back(path_s);
+    coarse_s.push_back(path_s + path_samples->path_start_s);
+  }
+  std::vector<Box2d> coarse_adc_boxes;
+  if (!coarse_s.empty()) {
+    PathPointArrays coarse_path;
+    downsampled_path.Evaluate(coarse_s, &coarse_path);
+    coarse_adc_boxes.reserve(coarse_s.size());
+    for (size_t j = 0; j < coarse_path.size(); ++j) {
+      coarse_adc_boxes.push_back(GetAdcBox(coarse_path.x()[j],
+                                           coarse_path.y()[j],
+                                           coarse_path.theta()[j], buffer));
+    }
+  }
+  path_samples->coarse_grid = PathStationGrid(coarse_path_s, coarse_adc_boxes);
+}
+
+Status StBoundaryMapper::MapWithoutDecision(const PathSamples& path_samples,
+                                            Obstacle* obstacle) const {
   std::vector<STPoint> lower_points;
   std::vector<STPoint> upper_points;
 
-  if (!GetOverlapBoundaryPoints(path_data_.discretized_path(), *obstacle,
-                                &upper_points, &lower_points)) {
+  if (!GetOverlapBoundaryPoints(path_samples, *obstacle, &upper_points,
+                                &lower_points)) {
     return Status::OK();
   }
 
@@ -235,19 +293,13 @@ Status StBoundaryMapper::MapWithoutDecision(Obstacle* obstacle) const {
 }
 
 bool StBoundaryMapper::GetOverlapBoundaryPoints(
-    const std::vector<PathPoint>& path_points, const Obstacle& obstacle,
+    const PathSamples& path_samples, const Obstacle& obstacle,
     std::vector<STPoint>* upper_points,
     std::vector<STPoint>* lower_points) const {
   DCHECK_NOTNULL(upper_points);
   DCHECK_NOTNULL(lower_points);
   DCHECK(upper_points->empty());
   DCHECK(lower_points->empty());
-  DCHECK_GT(path_points.size(), 0);
-
-  if (path_points.empty()) {
-    AERROR << "No points in path_data_.discretized_path().";
-    return false;
-  }
 
   const auto& trajectory = obstacle.Trajectory();
   if (trajectory.trajectory_point_size() == 0) {
@@ -256,47 +308,41 @@ bool StBoundaryMapper::GetOverlapBoundaryPoints(
              << "] has NO prediction trajectory."
              << obstacle.Perception().ShortDebugString();
     }
-    for (const auto& curr_point_on_path : path_points) {
-      if (curr_point_on_path.s() > planning_distance_) {
-        break;
-      }
-      const Box2d obs_box = obstacle.PerceptionBoundingBox();
-
-      if (CheckOverlap(curr_point_on_path, obs_box,
-                       speed_bounds_config_.boundary_buffer())) {
-        const double backward_distance = -vehicle_param_.front_edge_to_center();
-        const double forward_distance = vehicle_param_.length() +
-                                        vehicle_param_.width() +
-                                        obs_box.length() + obs_box.width();
-        double low_s =
-            std::fmax(0.0, curr_point_on_path.s() + backward_distance);
-        double high_s = std::fmin(planning_distance_,
-                                  curr_point_on_path.s() + forward_distance);
-        lower_points->emplace_back(low_s, 0.0);
-        lower_points->emplace_back(low_s, planning_time_);
-        upper_points->emplace_back(high_s, 0.0);
-        upper_points->emplace_back(high_s, planning_time_);
-        break;
-      }
+    const Box2d obs_box = obstacle.PerceptionBoundingBox();
+    const auto& path_point_grid = path_samples.path_point_grid;
+    const int index = path_point_grid.GetFirstOverlapIndex(obs_box);
+    if (index >= 0) {
+      const double path_s = path_point_grid.s(index);
+      const double backward_distance = -vehicle_param_.front_edge_to_center();
+      const double forward_distance = vehicle_param_.length() +
+                                      vehicle_param_.width() +
+                                      obs_box.length() + obs_box.width();
+      double low_s = std::fmax(0.0, path_s + backward_distance);
+      double high_s = std::fmin(planning_distance_, path_s + forward_distance);
+      lower_points->emplace_back(low_s, 0.0);
+      lower_points->emplace_back(low_s, planning_time_);
+      upper_points->emplace_back(high_s, 0.0);
+      upper_points->emplace_back(high_s, planning_time_);
     }
   } else {
     const int default_num_point = 50;
-    DiscretizedPath discretized_path;
-    if (path_points.size() > 2 * default_num_point) {
-      const auto ratio = path_points.size() / default_num_point;
-      std::vector<PathPoint> sampled_path_points;
-      for (size_t i = 0; i < path_points.size(); ++i) {
-        if (i % ratio == 0) {
-          sampled_path_points.push_back(path_points[i]);
-        }
-      }
-      discretized_path = DiscretizedPath(sampled_path_points);
+    const auto& discretized_path = path_samples.downsampled_path;
+    const double path_start_s = path_samples.path_start_s;
+    const auto& coarse_grid = path_samples.coarse_grid;
+    const double step_length = vehicle_param_.front_edge_to_center();
+
+    std::vector<Box2d> obstacle_boxes;
+    const std::vector<Box2d>* trajectory_boxes = &obstacle_boxes;
+    if (obstacle_box_cache_ != nullptr) {
+      trajectory_boxes = &obstacle_box_cache_->GetTrajectoryBoxes(obstacle);
     } else {
-      discretized_path = DiscretizedPath(path_points);
+      for (const auto& trajectory_point : trajectory.trajectory_point()) {
+        obstacle_boxes.push_back(obstacle.GetBoundingBox(trajectory_point));
+      }
     }
     for (int i = 0; i < trajectory.trajectory_point_size(); ++i) {
       const auto& trajectory_point = trajectory.trajectory_point(i);
-      const Box2d obs_box = obstacle.GetBoundingBox(trajectory_point);
+      const Box2d& obs_box = (*trajectory_boxes)[i];
 
       double trajectory_point_time = trajectory_point.relative_time();
       constexpr double kNegtiveTimeThreshold = -1.0;
@@ -304,65 +350,59 @@ bool StBoundaryMapper::GetOverlapBoundaryPoints(
         continue;
       }
 
-      const double step_length = vehicle_param_.front_edge_to_center();
-      auto path_len =
-          std::min(FLAGS_max_trajectory_len, discretized_path.Length());
-      for (double path_s = 0.0; path_s < path_len; path_s += step_length) {
-        const auto curr_adc_path_point =
-            discretized_path.Evaluate(path_s + discretized_path.front().s());
-        if (CheckOverlap(curr_adc_path_point, obs_box,
-                         speed_bounds_config_.boundary_buffer())) {
-          // found overlap, start searching with higher resolution
-          const double backward_distance = -step_length;
-          const double forward_distance = vehicle_param_.length() +
-                                          vehicle_param_.width() +
-                                          obs_box.length() + obs_box.width();
-          const double default_min_step = 0.1;  // in meters
-          const double fine_tuning_step_length = std::fmin(
-              default_min_step, discretized_path.Length() / default_num_point);
-
-          bool find_low = false;
-          bool find_high = false;
-          double low_s = std::fmax(0.0, path_s + backward_distance);
-          double high_s =
-              std::fmin(discretized_path.Length(), path_s + forward_distance);
-
-          while (low_s < high_s) {
-            if (find_low && find_high) {
-              break;
-            }
-            if (!find_low) {
-              const auto& point_low = discretized_path.Evaluate(
-                  low_s + discretized_path.front().s());
-              if (!CheckOverlap(point_low, obs_box,
-                                speed_bounds_config_.boundary_buffer())) {
-                low_s += fine_tuning_step_length;
-              } else {
-                find_low = true;
-              }
-            }
-            if (!find_high) {
-              const auto& point_high = discretized_path.Evaluate(
-                  high_s + discretized_path.front().s());
-              if (!CheckOverlap(point_high, obs_box,
-                                speed_bounds_config_.boundary_buffer())) {
-                high_s -= fine_tuning_step_length;
-              } else {
-                find_high = true;
-              }
-            }
+      const int index = coarse_grid.GetFirstOverlapIndex(obs_box);
+      if (index < 0) {
+        continue;
+      }
+      // found overlap, start searching with higher resolution
+      const double path_s = coarse_grid.s(index);
+      const double backward_distance = -step_length;
+      const double forward_distance = vehicle_param_.length() +
+                                      vehicle_param_.width() +
+                                      obs_box.length() + obs_box.width();
+      const double default_min_step = 0.1;  // in meters
+      const double fine_tuning_step_length = std::fmin(
+          default_min_step, discretized_path.Length() / default_num_point);
+
+      bool find_low = false;
+      bool find_high = false;
+      double low_s = std::fmax(0.0, path_s + backward_distance);
+      double high_s =
+          std::fmin(discretized_path.Length(), path_s + forward_distance);
+
+      while (low_s < high_s) {
+        if (find_low && find_high) {
+          break;
+        }
+        if (!find_low) {
+          const auto point_low =
+              discretized_path.Evaluate(low_s + path_start_s);
+          if (!CheckOverlap(point_low, obs_box,
+                            speed_bounds_config_.boundary_buffer())) {
+            low_s += fine_tuning_step_length;
+          } else {
+            find_low = true;
           }
-          if (find_high && find_low) {
-            lower_points->emplace_back(
-                low_s - speed_bounds_config_.point_extension(),
-                trajectory_point_time);
-            upper_points->emplace_back(
-                high_s + speed_bounds_config_.point_extension(),
-                trajectory_point_time);
+        }
+        if (!find_high) {
+          const auto point_high =
+              discretized_path.Evaluate(high_s + path_start_s);
+          if (!CheckOverlap(point_high, obs_box,
+                            speed_bounds_config_.boundary_buffer())) {
+            high_s -= fine_tuning_step_length;
+          } else {
+            find_high = true;
           }
-          break;
         }
       }
+      if (find_high && find_low) {
+        lower_points->emplace_back(
+            low_s - speed_bounds_config_.point_extension(),
+            trajectory_point_time);
+        upper_points->emplace_back(
+            high_s + speed_bounds_config_.point_extension(),
+            trajectory_point_time);
+      }
     }
   }
   DCHECK_EQ(lower_points->size(), upper_points->size());
@@ -370,7 +410,8 @@ bool StBoundaryMapper::GetOverlapBoundaryPoints(
 }
 
 Status StBoundaryMapper::MapWithDecision(
-    Obstacle* obstacle, const ObjectDecisionType& decision) const {
+    const PathSamples& path_samples, Obstacle* obstacle,
+    const ObjectDecisionType& decision) const {
   DCHECK(decision.has_follow() || decision.has_yield() ||
          decision.has_overtake())
       << "decision is " << decision.DebugString()
@@ -379,8 +420,8 @@ Status StBoundaryMapper::MapWithDecision(
   std::vector<STPoint> lower_points;
   std::vector<STPoint> upper_points;
 
-  if (!GetOverlapBoundaryPoints(path_data_.discretized_path(), *obstacle,
-                                &upper_points, &lower_points)) {
+  if (!GetOverlapBoundaryPoints(path_samples, *obstacle, &upper_points,
+                                &lower_points)) {
     return Status::OK();
   }
 
@@ -430,6 +471,13 @@ Status StBoundaryMapper::MapWithDecision(
 bool StBoundaryMapper::CheckOverlap(const PathPoint& path_point,
                                     const Box2d& obs_box,
                                     const double buffer) const {
+  return obs_box.HasOverlap(
+      GetAdcBox(path_point.x(), path_point.y(), path_point.theta(), buffer));
+}
+
+Box2d StBoundaryMapper::GetAdcBox(const double x, const double y,
+                                  const double theta,
+                                  const double buffer) const {
   double left_delta_l = 0.0;
   double right_delta_l = 0.0;
   if (is_change_lane_) {
@@ -448,13 +496,11 @@ bool StBoundaryMapper::CheckOverlap(const PathPoint& path_point,
             (vehicle_param_.left_edge_to_center() + left_delta_l -
              vehicle_param_.right_edge_to_center() + right_delta_l) /
                 2.0)
-          .rotate(path_point.theta());
-  Vec2d center = Vec2d(path_point.x(), path_point.y()) + vec_to_center;
+          .rotate(theta);
+  Vec2d center = Vec2d(x, y) + vec_to_center;
 
-  const Box2d adc_box =
-      Box2d(center, path_point.theta(), vehicle_param_.length() + 2 * buffer,
-            vehicle_param_.width() + 2 * buffer);
-  return obs_box.HasOverlap(adc_box);
+  return Box2d(center, theta, vehicle_param_.length() + 2 * buffer,
+               vehicle_param_.width() + 2 * buffer);
 }
 
 }  // namespace planning
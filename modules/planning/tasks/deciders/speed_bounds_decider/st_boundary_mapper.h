@@ -27,11 +27,14 @@
 #include "modules/planning/proto/speed_bounds_decider_config.pb.h"
 
 #include "modules/common/status/status.h"
+#include "modules/planning/common/obstacle_box_cache.h"
 #include "modules/planning/common/path/path_data.h"
+#include "modules/planning/common/path/path_point_arrays.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/speed/st_boundary.h"
 #include "modules/planning/common/speed_limit.h"
 #include "modules/planning/reference_line/reference_line.h"
+#include "modules/planning/tasks/deciders/speed_bounds_decider/path_station_grid.h"
 
 namespace apollo {
 namespace planning {
@@ -48,29 +51,62 @@ class StBoundaryMapper {
 
   apollo::common::Status CreateStBoundary(PathDecision* path_decision) const;
 
+  void SetObstacleBoxCache(ObstacleBoxCache* obstacle_box_cache) {
+    obstacle_box_cache_ = obstacle_box_cache;
+  }
+
  private:
   FRIEND_TEST(StBoundaryMapperTest, check_overlap_test);
+
+  /**
+   * The path sampled once and shared by all obstacles mapped in one
+   * CreateStBoundary() call.
+   */
+  struct PathSamples {
+    // the discretized path, downsampled to about 50 points
+    PathPointArrays downsampled_path;
+    double path_start_s = 0.0;
+    // ADC boxes at the path points within the planning distance, with s of
+    // the path points
+    PathStationGrid path_point_grid;
+    // ADC boxes every front_edge_to_center along the downsampled path, with s
+    // relative to the path start
+    PathStationGrid coarse_grid;
+  };
+
+  void SamplePath(PathSamples* path_samples) const;
+
   bool CheckOverlap(const apollo::common::PathPoint& path_point,
                     const apollo::common::math::Box2d& obs_box,
                     const double buffer) const;
 
+  /**
+   * Returns the ADC box, expanded by buffer, when the ADC is at (x, y) with
+   * heading theta on the path.
+   */
+  apollo::common::math::Box2d GetAdcBox(const double x, const double y,
+                                        const double theta,
+                                        const double buffer) const;
+
   /**
    * Creates valid st boundary upper_points and lower_points
    * If return true, upper_points.size() > 1 and
    * upper_points.size() = lower_points.size()
    */
-  bool GetOverlapBoundaryPoints(
-      const std::vector<apollo::common::PathPoint>& path_points,
-      const Obstacle& obstacle, std::vector<STPoint>* upper_points,
-      std::vector<STPoint>* lower_points) const;
+  bool GetOverlapBoundaryPoints(const PathSamples& path_samples,
+                                const Obstacle& obstacle,
+                                std::vector<STPoint>* upper_points,
+                                std::vector<STPoint>* lower_points) const;
 
-  apollo::common::Status MapWithoutDecision(Obstacle* obstacle) const;
+  apollo::common::Status MapWithoutDecision(const PathSamples& path_samples,
+                                            Obstacle* obstacle) const;
 
   bool MapStopDecision(Obstacle* stop_obstacle,
                        const ObjectDecisionType& decision) const;
 
   apollo::common::Status MapWithDecision(
-      Obstacle* obstacle, const ObjectDecisionType& decision) const;
+      const PathSamples& path_samples, Obstacle* obstacle,
+      const ObjectDecisionType& decision) const;
 
  private:
   const SLBoundary& adc_sl_boundary_;
@@ -81,6 +117,7 @@ class StBoundaryMapper {
   const double planning_distance_;
   const double planning_time_;
   bool is_change_lane_ = false;
+  ObstacleBoxCache* obstacle_box_cache_ = nullptr;
 };
 
 }  // namespace planning
@@ -47,6 +47,7 @@ Status DpPolyPathOptimizer::Process(const SpeedData &speed_data,
   dp_road_graph.SetDebugLogger(reference_line_info_->mutable_debug());
   dp_road_graph.SetWaypointSampler(
       new WaypointSampler(dp_poly_path_config.waypoint_sampler_config()));
+  dp_road_graph.SetObstacleBoxCache(frame_->mutable_obstacle_box_cache());
 
   if (!dp_road_graph.FindPathTunnel(
           init_point,
@@ -30,16 +30,18 @@ namespace apollo {
 namespace planning {
 namespace {
 constexpr double kInf = std::numeric_limits<double>::infinity();
-}
+
+// resolution and offset of the accel and jerk cost tables
+constexpr double kAccelEpsilon = 0.1;
+constexpr size_t kAccelShift = 100;
+constexpr double kJerkEpsilon = 0.1;
+constexpr size_t kJerkShift = 200;
+}  // namespace
 
 DpStCost::DpStCost(const DpStSpeedConfig& config, const double total_time,
                    const std::vector<const Obstacle*>& obstacles,
                    const common::TrajectoryPoint& init_point)
     : config_(config), obstacles_(obstacles), init_point_(init_point) {
-  int index = 0;
-  for (auto& obstacle : obstacles) {
-    boundary_map_[obstacle->st_boundary().id()] = index++;
-  }
   unit_t_ = total_time / config_.matrix_dimension_t();
 
   AddToKeepClearRange(obstacles);
@@ -48,8 +50,18 @@ DpStCost::DpStCost(const DpStSpeedConfig& config, const double total_time,
   for (auto& vec : boundary_cost_) {
     vec.resize(config_.matrix_dimension_t(), std::make_pair(-1.0, -1.0));
   }
-  accel_cost_.fill(-1.0);
-  jerk_cost_.fill(-1.0);
+
+  // the tables are filled up front so that the cost functions are read-only
+  for (size_t i = 0; i < accel_cost_.size(); ++i) {
+    accel_cost_[i] = ComputeAccelCost(
+        (static_cast<double>(i) - static_cast<double>(kAccelShift)) *
+        kAccelEpsilon);
+  }
+  for (size_t i = 0; i < jerk_cost_.size(); ++i) {
+    jerk_cost_[i] = ComputeJerkCost(
+        (static_cast<double>(i) - static_cast<double>(kJerkShift)) *
+        kJerkEpsilon);
+  }
 }
 
 void DpStCost::AddToKeepClearRange(
@@ -103,17 +115,35 @@ bool DpStCost::InKeepClearRange(double s) const {
   return false;
 }
 
-double DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) {
+void DpStCost::PrepareObstacleCost(const uint32_t index_t, const double t) {
+  if (index_t >= static_cast<uint32_t>(config_.matrix_dimension_t())) {
+    return;
+  }
+  for (size_t i = 0; i < obstacles_.size(); ++i) {
+    const auto& boundary = obstacles_[i]->st_boundary();
+    if (t < boundary.min_t() || t > boundary.max_t()) {
+      continue;
+    }
+    double s_upper = 0.0;
+    double s_lower = 0.0;
+    boundary.GetBoundarySRange(t, &s_upper, &s_lower);
+    boundary_cost_[i][index_t] = std::make_pair(s_upper, s_lower);
+  }
+}
+
+double DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) const {
   const double s = st_graph_point.point().s();
   const double t = st_graph_point.point().t();
+  const uint32_t index_t = st_graph_point.index_t();
 
   double cost = 0.0;
-  for (const auto* obstacle : obstacles_) {
+  for (size_t i = 0; i < obstacles_.size(); ++i) {
+    const auto* obstacle = obstacles_[i];
     if (!obstacle->IsBlockingObstacle()) {
       continue;
     }
 
-    auto boundary = obstacle->st_boundary();
+    const auto& boundary = obstacle->st_boundary();
     const double kIgnoreDistance = 200.0;
     if (boundary.min_s() > kIgnoreDistance) {
       continue;
@@ -128,14 +158,12 @@ double DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) {
     double s_upper = 0.0;
     double s_lower = 0.0;
 
-    int boundary_index = boundary_map_[boundary.id()];
-    if (boundary_cost_[boundary_index][st_graph_point.index_t()].first < 0.0) {
-      boundary.GetBoundarySRange(t, &s_upper, &s_lower);
-      boundary_cost_[boundary_index][st_graph_point.index_t()] =
-          std::make_pair(s_upper, s_lower);
+    if (index_t < boundary_cost_[i].size() &&
+        boundary_cost_[i][index_t].first >= 0.0) {
+      s_upper = boundary_cost_[i][index_t].first;
+      s_lower = boundary_cost_[i][index_t].second;
     } else {
-      s_upper = boundary_cost_[boundary_index][st_graph_point.index_t()].first;
-      s_lower = boundary_cost_[boundary_index][st_graph_point.index_t()].second;
+      boundary.GetBoundarySRange(t, &s_upper, &s_lower);
     }
     if (s < s_lower) {
       constexpr double kSafeTimeBuffer = 3.0;
@@ -203,83 +231,72 @@ double DpStCost::GetSpeedCost(const STPoint& first, const STPoint& second,
   return cost;
 }
 
-double DpStCost::GetAccelCost(const double accel) {
+double DpStCost::ComputeAccelCost(const double accel) const {
+  const double accel_sq = accel * accel;
+  double max_acc = config_.max_acceleration();
+  double max_dec = config_.max_deceleration();
+  double accel_penalty = config_.accel_penalty();
+  double decel_penalty = config_.decel_penalty();
+
   double cost = 0.0;
-  constexpr double kEpsilon = 0.1;
-  constexpr size_t kShift = 100;
-  const size_t accel_key = static_cast<size_t>(accel / kEpsilon + 0.5 + kShift);
-  DCHECK_LT(accel_key, accel_cost_.size());
-  if (accel_key >= accel_cost_.size()) {
-    return kInf;
+  if (accel > 0.0) {
+    cost = accel_penalty * accel_sq;
+  } else {
+    cost = decel_penalty * accel_sq;
   }
+  cost += accel_sq * decel_penalty * decel_penalty /
+              (1 + std::exp(1.0 * (accel - max_dec))) +
+          accel_sq * accel_penalty * accel_penalty /
+              (1 + std::exp(-1.0 * (accel - max_acc)));
+  return cost;
+}
 
-  if (accel_cost_.at(accel_key) < 0.0) {
-    const double accel_sq = accel * accel;
-    double max_acc = config_.max_acceleration();
-    double max_dec = config_.max_deceleration();
-    double accel_penalty = config_.accel_penalty();
-    double decel_penalty = config_.decel_penalty();
-
-    if (accel > 0.0) {
-      cost = accel_penalty * accel_sq;
-    } else {
-      cost = decel_penalty * accel_sq;
-    }
-    cost += accel_sq * decel_penalty * decel_penalty /
-                (1 + std::exp(1.0 * (accel - max_dec))) +
-            accel_sq * accel_penalty * accel_penalty /
-                (1 + std::exp(-1.0 * (accel - max_acc)));
-    accel_cost_.at(accel_key) = cost;
-  } else {
-    cost = accel_cost_.at(accel_key);
+double DpStCost::GetAccelCost(const double accel) const {
+  const double key = accel / kAccelEpsilon + 0.5 + kAccelShift;
+  DCHECK_GE(key, 0.0);
+  DCHECK_LT(key, accel_cost_.size());
+  if (key < 0.0 || key >= accel_cost_.size()) {
+    return kInf;
   }
-  return cost * unit_t_;
+  return accel_cost_[static_cast<size_t>(key)] * unit_t_;
 }
 
 double DpStCost::GetAccelCostByThreePoints(const STPoint& first,
                                            const STPoint& second,
-                                           const STPoint& third) {
+                                           const STPoint& third) const {
   double accel = (first.s() + third.s() - 2 * second.s()) / (unit_t_ * unit_t_);
   return GetAccelCost(accel);
 }
 
 double DpStCost::GetAccelCostByTwoPoints(const double pre_speed,
                                          const STPoint& pre_point,
-                                         const STPoint& curr_point) {
+                                         const STPoint& curr_point) const {
   double current_speed = (curr_point.s() - pre_point.s()) / unit_t_;
   double accel = (current_speed - pre_speed) / unit_t_;
   return GetAccelCost(accel);
 }
 
-double DpStCost::JerkCost(const double jerk) {
-  double cost = 0.0;
-  constexpr double kEpsilon = 0.1;
-  constexpr size_t kShift = 200;
-  const size_t jerk_key = static_cast<size_t>(jerk / kEpsilon + 0.5 + kShift);
-  if (jerk_key >= jerk_cost_.size()) {
-    return kInf;
+double DpStCost::ComputeJerkCost(const double jerk) const {
+  const double jerk_sq = jerk * jerk;
+  if (jerk > 0) {
+    return config_.positive_jerk_coeff() * jerk_sq * unit_t_;
   }
+  return config_.negative_jerk_coeff() * jerk_sq * unit_t_;
+}
 
-  if (jerk_cost_.at(jerk_key) < 0.0) {
-    double jerk_sq = jerk * jerk;
-    if (jerk > 0) {
-      cost = config_.positive_jerk_coeff() * jerk_sq * unit_t_;
-    } else {
-      cost = config_.negative_jerk_coeff() * jerk_sq * unit_t_;
-    }
-    jerk_cost_.at(jerk_key) = cost;
-  } else {
-    cost = jerk_cost_.at(jerk_key);
+double DpStCost::JerkCost(const double jerk) const {
+  const double key = jerk / kJerkEpsilon + 0.5 + kJerkShift;
+  if (key < 0.0 || key >= jerk_cost_.size()) {
+    return kInf;
   }
-
   // TODO(All): normalize to unit_t_
-  return cost;
+  return jerk_cost_[static_cast<size_t>(key)];
 }
 
 double DpStCost::GetJerkCostByFourPoints(const STPoint& first,
                                          const STPoint& second,
                                          const STPoint& third,
-                                         const STPoint& fourth) {
+                                         const STPoint& fourth) const {
   double jerk = (fourth.s() - 3 * third.s() + 3 * second.s() - first.s()) /
                 (unit_t_ * unit_t_ * unit_t_);
   return JerkCost(jerk);
@@ -288,7 +305,7 @@ double DpStCost::GetJerkCostByFourPoints(const STPoint& first,
 double DpStCost::GetJerkCostByTwoPoints(const double pre_speed,
                                         const double pre_acc,
                                         const STPoint& pre_point,
-                                        const STPoint& curr_point) {
+                                        const STPoint& curr_point) const {
   const double curr_speed = (curr_point.s() - pre_point.s()) / unit_t_;
   const double curr_accel = (curr_speed - pre_speed) / unit_t_;
   const double jerk = (curr_accel - pre_acc) / unit_t_;
@@ -298,7 +315,7 @@ double DpStCost::GetJerkCostByTwoPoints(const double pre_speed,
 double DpStCost::GetJerkCostByThreePoints(const double first_speed,
                                           const STPoint& first,
                                           const STPoint& second,
-                                          const STPoint& third) {
+                                          const STPoint& third) const {
   const double pre_speed = (second.s() - first.s()) / unit_t_;
   const double pre_acc = (pre_speed - first_speed) / unit_t_;
   const double curr_speed = (third.s() - second.s()) / unit_t_;
@@ -20,8 +20,7 @@
 
 #pragma once
 
-#include <string>
-#include <unordered_map>
+#include <array>
 #include <utility>
 #include <vector>
 
@@ -43,7 +42,12 @@ class DpStCost {
            const std::vector<const Obstacle*>& obstacles,
            const common::TrajectoryPoint& init_point);
 
-  double GetObstacleCost(const StGraphPoint& point);
+  // Caches the s range of every boundary at the time of column index_t. Once
+  // a column is prepared, GetObstacleCost() of its points only reads shared
+  // state and can be called concurrently.
+  void PrepareObstacleCost(const uint32_t index_t, const double t);
+
+  double GetObstacleCost(const StGraphPoint& point) const;
 
   double GetReferenceCost(const STPoint& point,
                           const STPoint& reference_point) const;
@@ -53,24 +57,28 @@ class DpStCost {
                       const double soft_speed_limit) const;
 
   double GetAccelCostByTwoPoints(const double pre_speed, const STPoint& first,
-                                 const STPoint& second);
+                                 const STPoint& second) const;
   double GetAccelCostByThreePoints(const STPoint& first, const STPoint& second,
-                                   const STPoint& third);
+                                   const STPoint& third) const;
 
   double GetJerkCostByTwoPoints(const double pre_speed, const double pre_acc,
                                 const STPoint& pre_point,
-                                const STPoint& curr_point);
+                                const STPoint& curr_point) const;
   double GetJerkCostByThreePoints(const double first_speed,
                                   const STPoint& first_point,
                                   const STPoint& second_point,
-                                  const STPoint& third_point);
+                                  const STPoint& third_point) const;
 
   double GetJerkCostByFourPoints(const STPoint& first, const STPoint& second,
-                                 const STPoint& third, const STPoint& fourth);
+                                 const STPoint& third,
+                                 const STPoint& fourth) const;
 
  private:
-  double GetAccelCost(const double accel);
-  double JerkCost(const double jerk);
+  double GetAccelCost(const double accel) const;
+  double JerkCost(const double jerk) const;
+
+  double ComputeAccelCost(const double accel) const;
+  double ComputeJerkCost(const double jerk) const;
 
   void AddToKeepClearRange(const std::vector<const Obstacle*>& obstacles);
   static void SortAndMergeRange(
@@ -83,11 +91,13 @@ class DpStCost {
 
   double unit_t_ = 0.0;
 
-  std::unordered_map<std::string, int> boundary_map_;
+  // boundary_cost_[obstacle index][index_t]: (s_upper, s_lower) of the
+  // obstacle boundary, negative if not prepared
   std::vector<std::vector<std::pair<double, double>>> boundary_cost_;
 
   std::vector<std::pair<double, double>> keep_clear_range_;
 
+  // cost tables sampled every 0.1 m/s^2 and 0.1 m/s^3
   std::array<double, 200> accel_cost_;
   std::array<double, 400> jerk_cost_;
 };
@@ -44,6 +44,10 @@ namespace {
 
 constexpr double kInf = std::numeric_limits<double>::infinity();
 
+// Rows of one column evaluated by one task. A single row is far cheaper than
+// scheduling a task, so rows are batched to amortize the overhead.
+constexpr uint32_t kRowsPerTask = 16;
+
 bool CheckOverlapOnDpStGraph(const std::vector<const STBoundary*>& boundaries,
                              const StGraphPoint& p1, const StGraphPoint& p2) {
   const common::math::LineSegment2d seg(p1.point(), p2.point());
@@ -143,21 +147,30 @@ Status DpStGraph::Search(SpeedData* const speed_data) {
 }
 
 Status DpStGraph::InitCostTable() {
-  uint32_t dim_s = dp_st_speed_config_.matrix_dimension_s();
-  uint32_t dim_t = dp_st_speed_config_.matrix_dimension_t();
-  DCHECK_GT(dim_s, 2);
-  DCHECK_GT(dim_t, 2);
-  cost_table_ = std::vector<std::vector<StGraphPoint>>(
-      dim_t, std::vector<StGraphPoint>(dim_s, StGraphPoint()));
+  dim_s_ = dp_st_speed_config_.matrix_dimension_s();
+  dim_t_ = dp_st_speed_config_.matrix_dimension_t();
+  DCHECK_GT(dim_s_, 2);
+  DCHECK_GT(dim_t_, 2);
+  cost_table_.assign(static_cast<size_t>(dim_t_) * dim_s_, StGraphPoint());
 
   double curr_t = 0.0;
-  for (uint32_t i = 0; i < cost_table_.size(); ++i, curr_t += unit_t_) {
-    auto& cost_table_i = cost_table_[i];
+  for (uint32_t i = 0; i < dim_t_; ++i, curr_t += unit_t_) {
     double curr_s = 0.0;
-    for (uint32_t j = 0; j < cost_table_i.size(); ++j, curr_s += unit_s_) {
-      cost_table_i[j].Init(i, j, STPoint(curr_s, curr_t));
+    for (uint32_t j = 0; j < dim_s_; ++j, curr_s += unit_s_) {
+      CostAt(i, j).Init(i, j, STPoint(curr_s, curr_t));
     }
   }
+
+  speed_limit_by_row_.resize(dim_s_);
+  soft_speed_limit_by_row_.resize(dim_s_);
+  const auto& speed_limit = st_graph_data_.speed_limit();
+  for (uint32_t j = 0; j < dim_s_; ++j) {
+    speed_limit_by_row_[j] = speed_limit.GetSpeedLimitByS(unit_s_ * j);
+    soft_speed_limit_by_row_[j] =
+        FLAGS_enable_soft_speed_limit
+            ? speed_limit.GetSoftSpeedLimitByS(unit_s_ * j)
+            : speed_limit_by_row_[j];
+  }
   return Status::OK();
 }
 
@@ -168,32 +181,40 @@ Status DpStGraph::CalculateTotalCost() {
   size_t next_highest_row = 0;
   size_t next_lowest_row = 0;
 
-  for (size_t c = 0; c < cost_table_.size(); ++c) {
+  for (uint32_t c = 0; c < dim_t_; ++c) {
     size_t highest_row = 0;
-    auto lowest_row = cost_table_.back().size() - 1;
+    size_t lowest_row = dim_s_ - 1;
 
     int count = static_cast<int>(next_highest_row) -
                 static_cast<int>(next_lowest_row) + 1;
     if (count > 0) {
-      std::vector<std::future<void>> results;
-      for (size_t r = next_lowest_row; r <= next_highest_row; ++r) {
-        auto msg = std::make_shared<StGraphMessage>(c, r);
-        if (FLAGS_enable_multi_thread_in_dp_st_graph) {
-          results.push_back(
-              cyber::Async(&DpStGraph::CalculateCostAt, this, msg));
-        } else {
-          CalculateCostAt(msg);
+      const uint32_t begin_r = static_cast<uint32_t>(next_lowest_row);
+      const uint32_t end_r = static_cast<uint32_t>(next_highest_row) + 1;
+      dp_st_cost_.PrepareObstacleCost(c, CostAt(c, 0).point().t());
+      // no nested fan-out when the reference lines are already planned on
+      // the task pool
+      if (FLAGS_enable_multi_thread_in_dp_st_graph &&
+          !FLAGS_enable_multi_thread_in_lane_follow_stage &&
+          static_cast<uint32_t>(count) > kRowsPerTask) {
+        // the first batch runs on the calling thread
+        std::vector<std::future<void>> results;
+        for (uint32_t r = begin_r + kRowsPerTask; r < end_r;
+             r += kRowsPerTask) {
+          results.push_back(cyber::Async(&DpStGraph::CalculateCostInRows, this,
+                                         c, r,
+                                         std::min(r + kRowsPerTask, end_r)));
         }
-      }
-      if (FLAGS_enable_multi_thread_in_dp_st_graph) {
+        CalculateCostInRows(c, begin_r, begin_r + kRowsPerTask);
         for (auto& result : results) {
           result.get();
         }
+      } else {
+        CalculateCostInRows(c, begin_r, end_r);
       }
     }
 
     for (size_t r = next_lowest_row; r <= next_highest_row; ++r) {
-      const auto& cost_cr = cost_table_[c][r];
+      const auto& cost_cr = CostAt(c, static_cast<uint32_t>(r));
       if (cost_cr.total_cost() < std::numeric_limits<double>::infinity()) {
         size_t h_r = 0;
         size_t l_r = 0;
@@ -209,8 +230,15 @@ Status DpStGraph::CalculateTotalCost() {
   return Status::OK();
 }
 
+void DpStGraph::CalculateCostInRows(const uint32_t c, const uint32_t begin_r,
+                                    const uint32_t end_r) {
+  for (uint32_t r = begin_r; r < end_r; ++r) {
+    CalculateCostAt(c, r);
+  }
+}
+
 void DpStGraph::GetRowRange(const StGraphPoint& point, size_t* next_highest_row,
-                            size_t* next_lowest_row) {
+                            size_t* next_lowest_row) const {
   double v0 = 0.0;
   if (!point.pre_point()) {
     v0 = init_point_.v();
@@ -218,7 +246,7 @@ void DpStGraph::GetRowRange(const StGraphPoint& point, size_t* next_highest_row,
     v0 = (point.index_s() - point.pre_point()->index_s()) * unit_s_ / unit_t_;
   }
 
-  const auto max_s_size = cost_table_.back().size() - 1;
+  const auto max_s_size = dim_s_ - 1;
 
   const double speed_coeff = unit_t_ * unit_t_;
 
@@ -241,28 +269,22 @@ void DpStGraph::GetRowRange(const StGraphPoint& point, size_t* next_highest_row,
   }
 }
 
-void DpStGraph::CalculateCostAt(const std::shared_ptr<StGraphMessage>& msg) {
-  const uint32_t c = msg->c;
-  const uint32_t r = msg->r;
-  auto& cost_cr = cost_table_[c][r];
+void DpStGraph::CalculateCostAt(const uint32_t c, const uint32_t r) {
+  auto& cost_cr = CostAt(c, r);
   cost_cr.SetObstacleCost(dp_st_cost_.GetObstacleCost(cost_cr));
   if (cost_cr.obstacle_cost() > std::numeric_limits<double>::max()) {
     return;
   }
 
-  const auto& cost_init = cost_table_[0][0];
+  const auto& cost_init = CostAt(0, 0);
   if (c == 0) {
     DCHECK_EQ(r, 0) << "Incorrect. Row should be 0 with col = 0. row: " << r;
     cost_cr.SetTotalCost(0.0);
     return;
   }
 
-  const double speed_limit =
-      st_graph_data_.speed_limit().GetSpeedLimitByS(unit_s_ * r);
-  const double soft_speed_limit =
-      FLAGS_enable_soft_speed_limit
-          ? st_graph_data_.speed_limit().GetSoftSpeedLimitByS(unit_s_ * r)
-          : speed_limit;
+  const double speed_limit = speed_limit_by_row_[r];
+  const double soft_speed_limit = soft_speed_limit_by_row_[r];
 
   if (c == 1) {
     const double acc = (r * unit_s_ / unit_t_ - init_point_.v()) / unit_t_;
@@ -288,7 +310,7 @@ void DpStGraph::CalculateCostAt(const std::shared_ptr<StGraphMessage>& msg) {
                             (1 + kSpeedRangeBuffer) * unit_t_ / unit_s_);
   const uint32_t r_low = (max_s_diff < r ? r - max_s_diff : 0);
 
-  const auto& pre_col = cost_table_[c - 1];
+  const StGraphPoint* pre_col = &CostAt(c - 1, 0);
 
   if (c == 2) {
     for (uint32_t r_pre = r_low; r_pre <= r; ++r_pre) {
@@ -335,7 +357,7 @@ void DpStGraph::CalculateCostAt(const std::shared_ptr<StGraphMessage>& msg) {
     }
 
     uint32_t r_prepre = pre_col[r_pre].pre_point()->index_s();
-    const StGraphPoint& prepre_graph_point = cost_table_[c - 2][r_prepre];
+    const StGraphPoint& prepre_graph_point = CostAt(c - 2, r_prepre);
     if (std::isinf(prepre_graph_point.total_cost())) {
       continue;
     }
@@ -361,7 +383,8 @@ void DpStGraph::CalculateCostAt(const std::shared_ptr<StGraphMessage>& msg) {
 Status DpStGraph::RetrieveSpeedProfile(SpeedData* const speed_data) {
   double min_cost = std::numeric_limits<double>::infinity();
   const StGraphPoint* best_end_point = nullptr;
-  for (const StGraphPoint& cur_point : cost_table_.back()) {
+  for (uint32_t r = 0; r < dim_s_; ++r) {
+    const StGraphPoint& cur_point = CostAt(dim_t_ - 1, r);
     if (!std::isinf(cur_point.total_cost()) &&
         cur_point.total_cost() < min_cost) {
       best_end_point = &cur_point;
@@ -369,8 +392,8 @@ Status DpStGraph::RetrieveSpeedProfile(SpeedData* const speed_data) {
     }
   }
 
-  for (const auto& row : cost_table_) {
-    const StGraphPoint& cur_point = row.back();
+  for (uint32_t c = 0; c < dim_t_; ++c) {
+    const StGraphPoint& cur_point = CostAt(c, dim_s_ - 1);
     if (!std::isinf(cur_point.total_cost()) &&
         cur_point.total_cost() < min_cost) {
       best_end_point = &cur_point;
@@ -416,7 +439,7 @@ Status DpStGraph::RetrieveSpeedProfile(SpeedData* const speed_data) {
 double DpStGraph::CalculateEdgeCost(const STPoint& first, const STPoint& second,
                                     const STPoint& third, const STPoint& forth,
                                     const double speed_limit,
-                                    const double soft_speed_limit) {
+                                    const double soft_speed_limit) const {
   return dp_st_cost_.GetSpeedCost(third, forth, speed_limit, soft_speed_limit) +
          dp_st_cost_.GetAccelCostByThreePoints(second, third, forth) +
          dp_st_cost_.GetJerkCostByFourPoints(first, second, third, forth);
@@ -424,11 +447,12 @@ double DpStGraph::CalculateEdgeCost(const STPoint& first, const STPoint& second,
 
 double DpStGraph::CalculateEdgeCostForSecondCol(const uint32_t row,
                                                 const double speed_limit,
-                                                const double soft_speed_limit) {
+                                                const double soft_speed_limit)
+    const {
   double init_speed = init_point_.v();
   double init_acc = init_point_.a();
-  const STPoint& pre_point = cost_table_[0][0].point();
-  const STPoint& curr_point = cost_table_[1][row].point();
+  const STPoint& pre_point = CostAt(0, 0).point();
+  const STPoint& curr_point = CostAt(1, row).point();
   return dp_st_cost_.GetSpeedCost(pre_point, curr_point, speed_limit,
                                   soft_speed_limit) +
          dp_st_cost_.GetAccelCostByTwoPoints(init_speed, pre_point,
@@ -440,11 +464,12 @@ double DpStGraph::CalculateEdgeCostForSecondCol(const uint32_t row,
 double DpStGraph::CalculateEdgeCostForThirdCol(const uint32_t curr_row,
                                                const uint32_t pre_row,
                                                const double speed_limit,
-                                               const double soft_speed_limit) {
+                                               const double soft_speed_limit)
+    const {
   double init_speed = init_point_.v();
-  const STPoint& first = cost_table_[0][0].point();
-  const STPoint& second = cost_table_[1][pre_row].point();
-  const STPoint& third = cost_table_[2][curr_row].point();
+  const STPoint& first = CostAt(0, 0).point();
+  const STPoint& second = CostAt(1, pre_row).point();
+  const STPoint& third = CostAt(2, curr_row).point();
   return dp_st_cost_.GetSpeedCost(second, third, speed_limit,
                                   soft_speed_limit) +
          dp_st_cost_.GetAccelCostByThreePoints(first, second, third) +
@@ -20,7 +20,6 @@
 
 #pragma once
 
-#include <memory>
 #include <vector>
 
 #include "modules/common/configs/proto/vehicle_config.pb.h"
@@ -57,28 +56,34 @@ class DpStGraph {
 
   apollo::common::Status CalculateTotalCost();
 
-  // defined for cyber task
-  struct StGraphMessage {
-    StGraphMessage(const uint32_t c_, const int32_t r_) : c(c_), r(r_) {}
-    uint32_t c;
-    uint32_t r;
-  };
-  void CalculateCostAt(const std::shared_ptr<StGraphMessage>& msg);
+  // calculates the cost of rows [begin_r, end_r) in column c. Different rows
+  // of the same column only read the previous columns and can be run in
+  // parallel.
+  void CalculateCostInRows(const uint32_t c, const uint32_t begin_r,
+                           const uint32_t end_r);
+  void CalculateCostAt(const uint32_t c, const uint32_t r);
 
   double CalculateEdgeCost(const STPoint& first, const STPoint& second,
                            const STPoint& third, const STPoint& forth,
                            const double speed_limit,
-                           const double soft_speed_limit);
+                           const double soft_speed_limit) const;
   double CalculateEdgeCostForSecondCol(const uint32_t row,
                                        const double speed_limit,
-                                       const double soft_speed_limit);
+                                       const double soft_speed_limit) const;
   double CalculateEdgeCostForThirdCol(const uint32_t curr_r,
                                       const uint32_t pre_r,
                                       const double speed_limit,
-                                      const double soft_speed_limit);
+                                      const double soft_speed_limit) const;
 
   void GetRowRange(const StGraphPoint& point, size_t* highest_row,
-                   size_t* lowest_row);
+                   size_t* lowest_row) const;
+
+  StGraphPoint& CostAt(const uint32_t c, const uint32_t r) {
+    return cost_table_[c * dim_s_ + r];
+  }
+  const StGraphPoint& CostAt(const uint32_t c, const uint32_t r) const {
+    return cost_table_[c * dim_s_ + r];
+  }
 
  private:
   const StGraphData& st_graph_data_;
@@ -104,9 +109,16 @@ class DpStGraph {
   double unit_s_ = 0.0;
   double unit_t_ = 0.0;
 
-  // cost_table_[t][s]
+  uint32_t dim_t_ = 0;
+  uint32_t dim_s_ = 0;
+
+  // cost_table_[t * dim_s_ + s], one contiguous block per column
   // row: s, col: t --- NOTICE: Please do NOT change.
-  std::vector<std::vector<StGraphPoint>> cost_table_;
+  std::vector<StGraphPoint> cost_table_;
+
+  // speed limits of each row, they only depend on s
+  std::vector<double> speed_limit_by_row_;
+  std::vector<double> soft_speed_limit_by_row_;
 };
 
 }  // namespace planning
@@ -19,6 +19,8 @@
  **/
 #include "modules/planning/tasks/optimizers/dp_st_speed/dp_st_graph.h"
 
+#include <chrono>
+
 #include "gtest/gtest.h"
 
 #include "modules/common/proto/pnc_point.pb.h"
@@ -81,6 +83,24 @@ class DpStGraphTest : public ::testing::Test {
 
   virtual void TearDown() {}
 
+  // adds an obstacle whose st boundary spans [lower_s, upper_s] at t0 and
+  // moves with the given speed until t1
+  void AddObstacle(const std::string& id, const double lower_s,
+                   const double upper_s, const double t0, const double t1,
+                   const double speed) {
+    Obstacle obstacle;
+    obstacle.SetId(id);
+    obstacle.SetBlockingObstacle(true);
+    std::vector<std::pair<STPoint, STPoint>> point_pairs;
+    for (double t = t0; t <= t1 + 1e-6; t += 0.5) {
+      const double ds = speed * (t - t0);
+      point_pairs.emplace_back(STPoint(lower_s + ds, t),
+                               STPoint(upper_s + ds, t));
+    }
+    obstacle.SetStBoundary(STBoundary(point_pairs));
+    obstacle_list_.push_back(obstacle);
+  }
+
  protected:
   std::list<Obstacle> obstacle_list_;
 
@@ -147,5 +167,59 @@ TEST_F(DpStGraphTest, simple) {
   EXPECT_TRUE(ret.ok());
 }
 
+TEST_F(DpStGraphTest, multi_thread_benchmark) {
+  // a slow leading vehicle, a crossing vehicle and a vehicle stopped ahead
+  AddObstacle("leading", 40.0, 45.0, 0.0, 7.0, 3.0);
+  AddObstacle("crossing", 25.0, 30.0, 2.0, 3.0, 0.0);
+  AddObstacle("stopped", 100.0, 105.0, 0.0, 7.0, 0.0);
+
+  std::vector<const Obstacle*> obstacles;
+  std::vector<const STBoundary*> boundaries;
+  for (const auto& obstacle : obstacle_list_) {
+    obstacles.push_back(&obstacle);
+    boundaries.push_back(&obstacle.st_boundary());
+  }
+
+  init_point_.set_v(10.0);
+  init_point_.set_a(0.0);
+  planning_internal::STGraphDebug st_graph_debug;
+  st_graph_data_ = StGraphData();
+  st_graph_data_.LoadData(boundaries, init_point_, speed_limit_, 150.0, 150.0,
+                          7.0, &st_graph_debug);
+
+  // a finer grid than the default so that the columns are worth splitting
+  dp_config_.set_matrix_dimension_s(300);
+  dp_config_.set_matrix_dimension_t(8);
+
+  constexpr int kNumRuns = 20;
+  auto run = [&](const bool multi_thread, SpeedData* speed_data) {
+    FLAGS_enable_multi_thread_in_dp_st_graph = multi_thread;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kNumRuns; ++i) {
+      DpStGraph dp_st_graph(st_graph_data_, dp_config_, obstacles, init_point_,
+                            adc_sl_boundary_);
+      EXPECT_TRUE(dp_st_graph.Search(speed_data).ok());
+    }
+    const std::chrono::duration<double, std::milli> diff =
+        std::chrono::steady_clock::now() - start;
+    return diff.count() / kNumRuns;
+  };
+
+  SpeedData single_thread_speed;
+  const double single_thread_ms = run(false, &single_thread_speed);
+  SpeedData multi_thread_speed;
+  const double multi_thread_ms = run(true, &multi_thread_speed);
+  FLAGS_enable_multi_thread_in_dp_st_graph = false;
+
+  // the chunked tasks must not change the result
+  ASSERT_EQ(single_thread_speed.size(), multi_thread_speed.size());
+  for (size_t i = 0; i < single_thread_speed.size(); ++i) {
+    EXPECT_DOUBLE_EQ(single_thread_speed[i].s(), multi_thread_speed[i].s());
+    EXPECT_DOUBLE_EQ(single_thread_speed[i].t(), multi_thread_speed[i].t());
+  }
+  AINFO << "dp st graph search, single thread: " << single_thread_ms
+        << " ms, multi thread: " << multi_thread_ms << " ms.";
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -20,10 +20,12 @@
 
 #include "modules/planning/tasks/optimizers/piecewise_jerk_path/piecewise_jerk_path_optimizer.h"
 
+#include <future>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "cyber/task/task.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/common/trajectory1d/piecewise_jerk_trajectory1d.h"
 #include "modules/planning/math/finite_element_qp/fem_1d_qp_problem.h"
@@ -44,6 +46,8 @@ common::Status PiecewiseJerkPathOptimizer::Process(
     const SpeedData& speed_data, const ReferenceLine& reference_line,
     const common::TrajectoryPoint& init_point, PathData* const path_data) {
   const auto init_frenet_state = reference_line.ToFrenetFrame(init_point);
+  auto* workspaces =
+      GetReferenceLineWorkspaces(reference_line_info_->Lanes().Id());
 
   const auto& piecewise_jerk_path_config = config_.piecewise_jerk_path_config();
   std::array<double, 5> w = {piecewise_jerk_path_config.l_weight(),
@@ -51,69 +55,127 @@ common::Status PiecewiseJerkPathOptimizer::Process(
                              piecewise_jerk_path_config.ddl_weight(),
                              piecewise_jerk_path_config.dddl_weight(), 0.0};
 
-  {
-    std::vector<std::pair<double, double>> lat_boundaries;
-    double start_s = 0.0;
-    double delta_s = 0.0;
-    reference_line_info_->GetPathBoundaries(&lat_boundaries, &start_s,
-                                            &delta_s);
-    if (lat_boundaries.size() >= 2) {
-      std::vector<double> opt_l;
-      std::vector<double> opt_dl;
-      std::vector<double> opt_ddl;
-
-      bool res_opt = OptimizePath(init_frenet_state, delta_s, lat_boundaries, w,
-                                  &opt_l, &opt_dl, &opt_ddl);
-
-      if (res_opt) {
-        auto frenet_frame_path =
-            ToPiecewiseJerkPath(opt_l, opt_dl, opt_ddl, delta_s, start_s);
-
-        path_data->SetReferenceLine(&reference_line);
-        path_data->SetFrenetPath(FrenetFramePath(frenet_frame_path));
-        return Status::OK();
-      }
-    }
+  std::vector<std::pair<double, double>> lat_boundaries;
+  double start_s = 0.0;
+  double delta_s = 0.0;
+  reference_line_info_->GetPathBoundaries(&lat_boundaries, &start_s, &delta_s);
+
+  std::vector<std::pair<double, double>> fallback_lat_boundaries;
+  double fallback_start_s = 0.0;
+  double fallback_delta_s = 0.0;
+  reference_line_info_->GetFallbackPathBoundaries(
+      &fallback_lat_boundaries, &fallback_start_s, &fallback_delta_s);
+
+  // The regular and the fallback problems own separate workspaces, so the
+  // fallback path can be solved alongside the regular one instead of after
+  // it fails. When the lane follow stage already plans the reference lines
+  // on the task pool, this task runs on a pool worker and waiting there for
+  // another pool task could starve the pool, so both are solved inline.
+  FrenetFramePath fallback_frenet_frame_path;
+  std::future<bool> fallback_result;
+  if (FLAGS_enable_multi_thread_in_piecewise_jerk_path_optimizer &&
+      !FLAGS_enable_multi_thread_in_lane_follow_stage &&
+      lat_boundaries.size() >= 2 && fallback_lat_boundaries.size() > 1) {
+    fallback_result = cyber::Async([&]() {
+      return SolvePath(reference_line, init_frenet_state, w,
+                       fallback_lat_boundaries, fallback_start_s,
+                       fallback_delta_s, &workspaces->fallback,
+                       &fallback_frenet_frame_path);
+    });
   }
 
-  {
-    std::vector<std::pair<double, double>> lat_boundaries;
-    double start_s = 0.0;
-    double delta_s = 0.0;
-    reference_line_info_->GetFallbackPathBoundaries(&lat_boundaries, &start_s,
-                                                    &delta_s);
-    CHECK_GT(lat_boundaries.size(), 1);
-
-    std::vector<double> opt_l;
-    std::vector<double> opt_dl;
-    std::vector<double> opt_ddl;
-
-    bool res_opt = OptimizePath(init_frenet_state, delta_s, lat_boundaries, w,
-                                &opt_l, &opt_dl, &opt_ddl);
-
-    if (res_opt) {
-      auto frenet_frame_path =
-          ToPiecewiseJerkPath(opt_l, opt_dl, opt_ddl, delta_s, start_s);
-
+  if (lat_boundaries.size() >= 2) {
+    FrenetFramePath frenet_frame_path;
+    if (SolvePath(reference_line, init_frenet_state, w, lat_boundaries,
+                  start_s, delta_s, &workspaces->regular,
+                  &frenet_frame_path)) {
+      if (fallback_result.valid()) {
+        fallback_result.wait();
+      }
       path_data->SetReferenceLine(&reference_line);
-      path_data->SetFrenetPath(FrenetFramePath(frenet_frame_path));
+      path_data->SetFrenetPath(std::move(frenet_frame_path));
       return Status::OK();
     }
   }
+
+  bool res_fallback = false;
+  if (fallback_result.valid()) {
+    res_fallback = fallback_result.get();
+  } else {
+    CHECK_GT(fallback_lat_boundaries.size(), 1);
+    res_fallback = SolvePath(reference_line, init_frenet_state, w,
+                             fallback_lat_boundaries, fallback_start_s,
+                             fallback_delta_s, &workspaces->fallback,
+                             &fallback_frenet_frame_path);
+  }
+  if (res_fallback) {
+    path_data->SetReferenceLine(&reference_line);
+    path_data->SetFrenetPath(std::move(fallback_frenet_frame_path));
+    return Status::OK();
+  }
   return Status(ErrorCode::PLANNING_ERROR,
                 "Path Optimizer failed to generate path");
 }
 
+PiecewiseJerkPathOptimizer::ReferenceLineWorkspaces*
+PiecewiseJerkPathOptimizer::GetReferenceLineWorkspaces(
+    const std::string& reference_line_id) {
+  ++num_processed_;
+  auto& workspaces = reference_line_workspaces_[reference_line_id];
+  if (workspaces == nullptr) {
+    while (reference_line_workspaces_.size() > kMaxReferenceLineWorkspaces) {
+      auto lru = reference_line_workspaces_.end();
+      for (auto it = reference_line_workspaces_.begin();
+           it != reference_line_workspaces_.end(); ++it) {
+        if (it->second != nullptr &&
+            (lru == reference_line_workspaces_.end() ||
+             it->second->last_used < lru->second->last_used)) {
+          lru = it;
+        }
+      }
+      reference_line_workspaces_.erase(lru);
+    }
+    workspaces.reset(new ReferenceLineWorkspaces());
+  }
+  workspaces->last_used = num_processed_;
+  return workspaces.get();
+}
+
+bool PiecewiseJerkPathOptimizer::SolvePath(
+    const ReferenceLine& reference_line,
+    const std::pair<std::array<double, 3>, std::array<double, 3>>&
+        init_frenet_state,
+    const std::array<double, 5>& w,
+    const std::vector<std::pair<double, double>>& lat_boundaries,
+    const double start_s, const double delta_s, PathWorkspace* path_workspace,
+    FrenetFramePath* const frenet_frame_path) {
+  std::vector<double> opt_l;
+  std::vector<double> opt_dl;
+  std::vector<double> opt_ddl;
+
+  ShiftWarmStart(reference_line, start_s, delta_s, path_workspace);
+  if (!OptimizePath(init_frenet_state, delta_s, lat_boundaries, w,
+                    &path_workspace->workspace, &opt_l, &opt_dl, &opt_ddl)) {
+    return false;
+  }
+  UpdateLastStartPoint(reference_line, start_s, path_workspace);
+  *frenet_frame_path =
+      ToPiecewiseJerkPath(opt_l, opt_dl, opt_ddl, delta_s, start_s);
+  return true;
+}
+
 bool PiecewiseJerkPathOptimizer::OptimizePath(
     const std::pair<const std::array<double, 3>, const std::array<double, 3>>&
         init_state,
     const double delta_s,
     const std::vector<std::pair<double, double>>& lat_boundaries,
-    const std::array<double, 5>& w, std::vector<double>* x,
-    std::vector<double>* dx, std::vector<double>* ddx) {
+    const std::array<double, 5>& w, OsqpWorkspace* workspace,
+    std::vector<double>* x, std::vector<double>* dx,
+    std::vector<double>* ddx) {
   std::unique_ptr<Fem1dQpProblem> fem_1d_qp(
       new Fem1dQpProblem(lat_boundaries.size(), init_state.second, delta_s, w,
                          FLAGS_lateral_jerk_bound));
+  fem_1d_qp->SetWorkspace(workspace);
 
   auto start_time = std::chrono::system_clock::now();
 
@@ -148,6 +210,34 @@ bool PiecewiseJerkPathOptimizer::OptimizePath(
   return true;
 }
 
+void PiecewiseJerkPathOptimizer::ShiftWarmStart(
+    const ReferenceLine& reference_line, const double start_s,
+    const double delta_s, PathWorkspace* path_workspace) const {
+  if (!path_workspace->has_last_start_point || delta_s <= 0.0) {
+    return;
+  }
+  // the knots of the last path that the new path starts from
+  common::SLPoint last_start_sl;
+  if (!reference_line.XYToSL(path_workspace->last_start_point,
+                             &last_start_sl)) {
+    return;
+  }
+  const int shift =
+      static_cast<int>(std::round((start_s - last_start_sl.s()) / delta_s));
+  // blocks of l, dl and ddl
+  path_workspace->workspace.ShiftWarmStart(3, shift);
+}
+
+void PiecewiseJerkPathOptimizer::UpdateLastStartPoint(
+    const ReferenceLine& reference_line, const double start_s,
+    PathWorkspace* path_workspace) const {
+  common::SLPoint start_sl;
+  start_sl.set_s(start_s);
+  start_sl.set_l(0.0);
+  path_workspace->has_last_start_point =
+      reference_line.SLToXY(start_sl, &path_workspace->last_start_point);
+}
+
 FrenetFramePath PiecewiseJerkPathOptimizer::ToPiecewiseJerkPath(
     const std::vector<double>& x, const std::vector<double>& dx,
     const std::vector<double>& ddx, const double delta_s,
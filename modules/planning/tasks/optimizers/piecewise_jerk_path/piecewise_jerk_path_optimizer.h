@@ -20,9 +20,14 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "modules/common/math/vec2d.h"
+#include "modules/planning/math/osqp_workspace.h"
 #include "modules/planning/tasks/optimizers/path_optimizer.h"
 
 namespace apollo {
@@ -40,13 +45,55 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
                          const common::TrajectoryPoint& init_point,
                          PathData* const path_data) override;
 
+  // the qp workspace of one path problem, kept across planning cycles
+  struct PathWorkspace {
+    explicit PathWorkspace(const std::string& name) : workspace(name) {}
+    OsqpWorkspace workspace;
+    // start point of the last optimized path, to shift the warm start
+    bool has_last_start_point = false;
+    common::math::Vec2d last_start_point;
+  };
+
+  // the workspaces of the regular and fallback problems on one reference
+  // line, so that a warm start never crosses reference lines
+  struct ReferenceLineWorkspaces {
+    PathWorkspace regular{"PiecewiseJerkPath"};
+    PathWorkspace fallback{"PiecewiseJerkFallbackPath"};
+    // value of num_processed_ when the workspaces were last used
+    uint64_t last_used = 0;
+  };
+
+  // Get the workspaces of a reference line by its route segments id, evicting
+  // the least recently used ones beyond kMaxReferenceLineWorkspaces.
+  ReferenceLineWorkspaces* GetReferenceLineWorkspaces(
+      const std::string& reference_line_id);
+
+  // Solve one path boundary variant on its workspace.
+  bool SolvePath(const ReferenceLine& reference_line,
+                 const std::pair<std::array<double, 3>, std::array<double, 3>>&
+                     init_frenet_state,
+                 const std::array<double, 5>& w,
+                 const std::vector<std::pair<double, double>>& lat_boundaries,
+                 const double start_s, const double delta_s,
+                 PathWorkspace* path_workspace,
+                 FrenetFramePath* const frenet_frame_path);
+
   bool OptimizePath(
       const std::pair<const std::array<double, 3>, const std::array<double, 3>>&
           init_state,
       const double delta_s,
       const std::vector<std::pair<double, double>>& lat_boundaries,
-      const std::array<double, 5>& w, std::vector<double>* ptr_x,
-      std::vector<double>* ptr_dx, std::vector<double>* ptr_ddx);
+      const std::array<double, 5>& w, OsqpWorkspace* workspace,
+      std::vector<double>* ptr_x, std::vector<double>* ptr_dx,
+      std::vector<double>* ptr_ddx);
+
+  void ShiftWarmStart(const ReferenceLine& reference_line,
+                      const double start_s, const double delta_s,
+                      PathWorkspace* path_workspace) const;
+
+  void UpdateLastStartPoint(const ReferenceLine& reference_line,
+                            const double start_s,
+                            PathWorkspace* path_workspace) const;
 
   FrenetFramePath ToPiecewiseJerkPath(const std::vector<double>& l,
                                       const std::vector<double>& dl,
@@ -57,6 +104,13 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
   double AdjustLateralDerivativeBounds(const double s_dot, const double dl,
                                        const double ddl,
                                        const double l_dot_bounds) const;
+
+ private:
+  static constexpr size_t kMaxReferenceLineWorkspaces = 4;
+
+  std::unordered_map<std::string, std::unique_ptr<ReferenceLineWorkspaces>>
+      reference_line_workspaces_;
+  uint64_t num_processed_ = 0;
 };
 
 }  // namespace planning
@@ -245,6 +245,7 @@ Status QpPiecewiseJerkPathOptimizer::Process(
   constexpr double kMaxLThirdOrderDerivative = 2.0;
   std::unique_ptr<Fem1dQpProblem> fem_1d_qp(new Fem1dQpProblem(
       n, init_lateral_state, qp_delta_s, w, kMaxLThirdOrderDerivative));
+  fem_1d_qp->SetWorkspace(&qp_workspace_);
 
   auto start_time = std::chrono::system_clock::now();
 
@@ -27,6 +27,7 @@
 
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/planning/proto/planning_config.pb.h"
+#include "modules/planning/math/osqp_workspace.h"
 #include "modules/planning/proto/qp_piecewise_jerk_path_config.pb.h"
 #include "modules/planning/tasks/optimizers/path_optimizer.h"
 
@@ -53,6 +54,9 @@ class QpPiecewiseJerkPathOptimizer : public PathOptimizer {
   std::vector<std::tuple<double, double, double>>
   GetLateralSecondOrderDerivativeBounds(
       const common::TrajectoryPoint& init_point, const double qp_delta_s);
+
+ private:
+  OsqpWorkspace qp_workspace_{"QpPiecewiseJerkPath"};
 };
 
 }  // namespace planning
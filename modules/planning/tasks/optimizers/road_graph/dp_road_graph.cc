@@ -20,6 +20,8 @@
 
 #include "modules/planning/tasks/optimizers/road_graph/dp_road_graph.h"
 
+#include <algorithm>
+#include <functional>
 #include <utility>
 
 #include "cyber/task/task.h"
@@ -41,6 +43,12 @@
 namespace apollo {
 namespace planning {
 
+namespace {
+// Nodes of one level updated by one task. Scheduling a task per node costs
+// more than evaluating the node, so nodes are batched.
+constexpr size_t kNodesPerTask = 4;
+}  // namespace
+
 DpRoadGraph::DpRoadGraph(const DpPolyPathConfig &config,
                          const ReferenceLineInfo &reference_line_info,
                          const SpeedData &speed_data)
@@ -127,9 +135,12 @@ bool DpRoadGraph::GenerateMinCostPath(
   TrajectoryCost trajectory_cost(
       config_, reference_line_, reference_line_info_.IsChangeLanePath(),
       obstacles, vehicle_config.vehicle_param(), speed_data_, init_sl_point_,
-      reference_line_info_.AdcSlBoundary());
+      reference_line_info_.AdcSlBoundary(), obstacle_box_cache_);
 
-  std::list<std::list<DpRoadGraphNode>> graph_nodes;
+  // one contiguous block of nodes per level. Each block is filled before its
+  // nodes are linked to, so the pointers to previous nodes stay valid.
+  std::vector<std::vector<DpRoadGraphNode>> graph_nodes;
+  graph_nodes.reserve(path_waypoints.size());
 
   // find one point from first row
   const auto &first_row = path_waypoints.front();
@@ -143,35 +154,45 @@ bool DpRoadGraph::GenerateMinCostPath(
   graph_nodes.emplace_back();
   graph_nodes.back().emplace_back(first_row[nearest_i], nullptr,
                                   ComparableCost());
-  auto &front = graph_nodes.front().front();
-  size_t total_level = path_waypoints.size();
+  const auto *front = &graph_nodes.front().front();
+  const uint32_t total_level = static_cast<uint32_t>(path_waypoints.size());
 
-  for (size_t level = 1; level < path_waypoints.size(); ++level) {
+  for (uint32_t level = 1; level < total_level; ++level) {
     const auto &prev_dp_nodes = graph_nodes.back();
     const auto &level_points = path_waypoints[level];
 
-    graph_nodes.emplace_back();
-    std::vector<std::future<void>> results;
-
-    for (size_t i = 0; i < level_points.size(); ++i) {
-      const auto &cur_point = level_points[i];
-
-      graph_nodes.back().emplace_back(cur_point, nullptr);
-
-      auto msg = std::make_shared<RoadGraphMessage>(
-          prev_dp_nodes, level, total_level, &trajectory_cost, &front,
-          &(graph_nodes.back().back()));
-
-      if (FLAGS_enable_multi_thread_in_dp_poly_path) {
-        results.emplace_back(cyber::Async(&DpRoadGraph::UpdateNode, this, msg));
-      } else {
-        UpdateNode(msg);
-      }
+    std::vector<DpRoadGraphNode> level_nodes;
+    level_nodes.reserve(level_points.size());
+    for (const auto &cur_point : level_points) {
+      level_nodes.emplace_back(cur_point, nullptr);
     }
-    if (FLAGS_enable_multi_thread_in_dp_poly_path) {
+    graph_nodes.push_back(std::move(level_nodes));
+    auto &cur_dp_nodes = graph_nodes.back();
+    const size_t num_nodes = cur_dp_nodes.size();
+    DpRoadGraphNode *nodes = cur_dp_nodes.data();
+
+    // no nested fan-out when the reference lines are already planned on
+    // the task pool
+    if (FLAGS_enable_multi_thread_in_dp_poly_path &&
+        !FLAGS_enable_multi_thread_in_lane_follow_stage &&
+        num_nodes > kNodesPerTask) {
+      // the first batch runs on the calling thread
+      std::vector<std::future<void>> results;
+      for (size_t i = kNodesPerTask; i < num_nodes; i += kNodesPerTask) {
+        const size_t end = std::min(i + kNodesPerTask, num_nodes);
+        results.push_back(cyber::Async(&DpRoadGraph::UpdateNodes, this,
+                                       std::cref(prev_dp_nodes), level,
+                                       total_level, &trajectory_cost, front,
+                                       nodes + i, nodes + end));
+      }
+      UpdateNodes(prev_dp_nodes, level, total_level, &trajectory_cost, front,
+                  nodes, nodes + kNodesPerTask);
       for (auto &result : results) {
         result.get();
       }
+    } else {
+      UpdateNodes(prev_dp_nodes, level, total_level, &trajectory_cost, front,
+                  nodes, nodes + num_nodes);
     }
   }
 
@@ -203,17 +224,31 @@ bool DpRoadGraph::GenerateMinCostPath(
   return true;
 }
 
-void DpRoadGraph::UpdateNode(const std::shared_ptr<RoadGraphMessage> &msg) {
-  DCHECK_NOTNULL(msg);
-  DCHECK_NOTNULL(msg->trajectory_cost);
-  DCHECK_NOTNULL(msg->front);
-  DCHECK_NOTNULL(msg->cur_node);
-  for (const auto &prev_dp_node : msg->prev_nodes) {
+void DpRoadGraph::UpdateNodes(const std::vector<DpRoadGraphNode> &prev_nodes,
+                              const uint32_t level, const uint32_t total_level,
+                              TrajectoryCost *trajectory_cost,
+                              const DpRoadGraphNode *front,
+                              DpRoadGraphNode *begin, DpRoadGraphNode *end) {
+  for (auto *cur_node = begin; cur_node != end; ++cur_node) {
+    UpdateNode(prev_nodes, level, total_level, trajectory_cost, front,
+               cur_node);
+  }
+}
+
+void DpRoadGraph::UpdateNode(const std::vector<DpRoadGraphNode> &prev_nodes,
+                             const uint32_t level, const uint32_t total_level,
+                             TrajectoryCost *trajectory_cost,
+                             const DpRoadGraphNode *front,
+                             DpRoadGraphNode *cur_node) {
+  DCHECK_NOTNULL(trajectory_cost);
+  DCHECK_NOTNULL(front);
+  DCHECK_NOTNULL(cur_node);
+  for (const auto &prev_dp_node : prev_nodes) {
     const auto &prev_sl_point = prev_dp_node.sl_point;
-    const auto &cur_point = msg->cur_node->sl_point;
+    const auto &cur_point = cur_node->sl_point;
     double init_dl = 0.0;
     double init_ddl = 0.0;
-    if (msg->level == 1) {
+    if (level == 1) {
       init_dl = init_frenet_frame_point_.dl();
       init_ddl = init_frenet_frame_point_.ddl();
     }
@@ -225,27 +260,26 @@ void DpRoadGraph::UpdateNode(const std::shared_ptr<RoadGraphMessage> &msg) {
       continue;
     }
     const auto cost =
-        msg->trajectory_cost->Calculate(curve, prev_sl_point.s(), cur_point.s(),
-                                        msg->level, msg->total_level) +
+        trajectory_cost->Calculate(curve, prev_sl_point.s(), cur_point.s(),
+                                   level, total_level) +
         prev_dp_node.min_cost;
 
-    msg->cur_node->UpdateCost(&prev_dp_node, curve, cost);
+    cur_node->UpdateCost(&prev_dp_node, curve, cost);
   }
 
   // try to connect the current point with the first point directly
-  if (reference_line_info_.IsChangeLanePath() && msg->level >= 2) {
+  if (reference_line_info_.IsChangeLanePath() && level >= 2) {
     const double init_dl = init_frenet_frame_point_.dl();
     const double init_ddl = init_frenet_frame_point_.ddl();
     QuinticPolynomialCurve1d curve(
-        init_sl_point_.l(), init_dl, init_ddl, msg->cur_node->sl_point.l(), 0.0,
-        0.0, msg->cur_node->sl_point.s() - init_sl_point_.s());
+        init_sl_point_.l(), init_dl, init_ddl, cur_node->sl_point.l(), 0.0, 0.0,
+        cur_node->sl_point.s() - init_sl_point_.s());
     if (!IsValidCurve(curve)) {
       return;
     }
-    const auto cost = msg->trajectory_cost->Calculate(
-        curve, init_sl_point_.s(), msg->cur_node->sl_point.s(), msg->level,
-        msg->total_level);
-    msg->cur_node->UpdateCost(msg->front, curve, cost);
+    const auto cost = trajectory_cost->Calculate(
+        curve, init_sl_point_.s(), cur_node->sl_point.s(), level, total_level);
+    cur_node->UpdateCost(front, curve, cost);
   }
 }
 
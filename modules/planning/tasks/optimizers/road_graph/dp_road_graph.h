@@ -21,7 +21,6 @@
 #pragma once
 
 #include <limits>
-#include <list>
 #include <memory>
 #include <vector>
 
@@ -30,6 +29,7 @@
 
 #include "modules/common/status/status.h"
 #include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/obstacle_box_cache.h"
 #include "modules/planning/common/path/path_data.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/reference_line_info.h"
@@ -63,6 +63,10 @@ class DpRoadGraph {
     waypoint_sampler_.reset(waypoint_sampler);
   }
 
+  void SetObstacleBoxCache(ObstacleBoxCache *obstacle_box_cache) {
+    obstacle_box_cache_ = obstacle_box_cache;
+  }
+
  private:
   /**
    * an private inner struct for the dp algorithm
@@ -107,25 +111,18 @@ class DpRoadGraph {
                     const double end_s, const uint32_t curr_level,
                     const uint32_t total_level, ComparableCost *cost);
 
-  struct RoadGraphMessage {
-    RoadGraphMessage(const std::list<DpRoadGraphNode> &_prev_nodes,
-                     const uint32_t _level, const uint32_t _total_level,
-                     TrajectoryCost *_trajectory_cost, DpRoadGraphNode *_front,
-                     DpRoadGraphNode *_cur_node)
-        : prev_nodes(_prev_nodes),
-          level(_level),
-          total_level(_total_level),
-          trajectory_cost(_trajectory_cost),
-          front(_front),
-          cur_node(_cur_node) {}
-    const std::list<DpRoadGraphNode> &prev_nodes;
-    const uint32_t level;
-    const uint32_t total_level;
-    TrajectoryCost *trajectory_cost = nullptr;
-    DpRoadGraphNode *front = nullptr;
-    DpRoadGraphNode *cur_node = nullptr;
-  };
-  void UpdateNode(const std::shared_ptr<RoadGraphMessage> &msg);
+  // updates the nodes [begin, end) of one level from all nodes of the
+  // previous level. Nodes of the same level are independent and can be
+  // updated in parallel.
+  void UpdateNodes(const std::vector<DpRoadGraphNode> &prev_nodes,
+                   const uint32_t level, const uint32_t total_level,
+                   TrajectoryCost *trajectory_cost,
+                   const DpRoadGraphNode *front, DpRoadGraphNode *begin,
+                   DpRoadGraphNode *end);
+  void UpdateNode(const std::vector<DpRoadGraphNode> &prev_nodes,
+                  const uint32_t level, const uint32_t total_level,
+                  TrajectoryCost *trajectory_cost,
+                  const DpRoadGraphNode *front, DpRoadGraphNode *cur_node);
 
  private:
   DpPolyPathConfig config_;
@@ -136,6 +133,7 @@ class DpRoadGraph {
   common::SLPoint init_sl_point_;
   common::FrenetFramePoint init_frenet_frame_point_;
   apollo::planning_internal::Debug *planning_debug_ = nullptr;
+  ObstacleBoxCache *obstacle_box_cache_ = nullptr;
 
   ObjectSidePass sidepass_;
 
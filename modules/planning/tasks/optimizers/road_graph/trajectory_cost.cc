@@ -45,7 +45,8 @@ TrajectoryCost::TrajectoryCost(const DpPolyPathConfig &config,
                                const common::VehicleParam &vehicle_param,
                                const SpeedData &heuristic_speed_data,
                                const common::SLPoint &init_sl_point,
-                               const SLBoundary &adc_sl_boundary)
+                               const SLBoundary &adc_sl_boundary,
+                               ObstacleBoxCache *obstacle_box_cache)
     : config_(config),
       reference_line_(&reference_line),
       is_change_lane_path_(is_change_lane_path),
@@ -91,10 +92,14 @@ TrajectoryCost::TrajectoryCost(const DpPolyPathConfig &config,
     } else {
       std::vector<Box2d> box_by_time;
       for (uint32_t t = 0; t <= num_of_time_stamps_; ++t) {
-        TrajectoryPoint trajectory_point =
-            ptr_obstacle->GetPointAtTime(t * config.eval_time_interval());
-
-        Box2d obstacle_box = ptr_obstacle->GetBoundingBox(trajectory_point);
+        const double relative_time = t * config.eval_time_interval();
+        // the same boxes are needed by every reference line of the frame.
+        const Box2d obstacle_box =
+            obstacle_box_cache
+                ? obstacle_box_cache->GetBoundingBoxAtTime(*ptr_obstacle,
+                                                           relative_time)
+                : ptr_obstacle->GetBoundingBox(
+                      ptr_obstacle->GetPointAtTime(relative_time));
         constexpr double kBuff = 0.5;
         Box2d expanded_obstacle_box =
             Box2d(obstacle_box.center(), obstacle_box.heading(),
@@ -27,6 +27,7 @@
 
 #include "modules/common/math/box2d.h"
 #include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/obstacle_box_cache.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/speed/speed_data.h"
 #include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
@@ -46,7 +47,8 @@ class TrajectoryCost {
                  const common::VehicleParam &vehicle_param,
                  const SpeedData &heuristic_speed_data,
                  const common::SLPoint &init_sl_point,
-                 const SLBoundary &adc_sl_boundary);
+                 const SLBoundary &adc_sl_boundary,
+                 ObstacleBoxCache *obstacle_box_cache = nullptr);
   ComparableCost Calculate(const QuinticPolynomialCurve1d &curve,
                            const double start_s, const double end_s,
                            const uint32_t curr_level,
@@ -179,6 +179,7 @@ void MessageProcess::OnPerception(
 
   // Get predicted obstacles
   *prediction_obstacles = PredictorManager::Instance()->prediction_obstacles();
+  EvaluatorManager::Instance()->GetLatency(prediction_obstacles);
 }
 
 void MessageProcess::OnLocalization(
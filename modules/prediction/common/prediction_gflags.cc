@@ -191,6 +191,13 @@ DEFINE_double(default_l_if_no_obstacle_in_lane_sequence, 10.0,
               "The default l value if no obstacle in the lane sequence.");
 DEFINE_bool(enable_build_current_frame_env, false,
             "If build current frame environment");
+DEFINE_bool(enable_batch_evaluation, false,
+            "If gather all obstacles of an evaluator in a frame and run "
+            "its network once on the whole batch");
+DEFINE_bool(enable_multi_thread_in_prediction, false,
+            "Enable multiple thread to evaluate and predict obstacles.");
+DEFINE_int32(prediction_thread_num, 4,
+             "Max number of threads sharing the obstacles of a frame.");
 
 // Obstacle trajectory
 DEFINE_bool(enable_cruise_regression, false,
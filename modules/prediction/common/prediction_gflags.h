@@ -118,6 +118,9 @@ DECLARE_double(time_to_center_if_not_reach);
 DECLARE_double(default_s_if_no_obstacle_in_lane_sequence);
 DECLARE_double(default_l_if_no_obstacle_in_lane_sequence);
 DECLARE_bool(enable_build_current_frame_env);
+DECLARE_bool(enable_batch_evaluation);
+DECLARE_bool(enable_multi_thread_in_prediction);
+DECLARE_int32(prediction_thread_num);
 
 // Obstacle trajectory
 DECLARE_bool(enable_cruise_regression);
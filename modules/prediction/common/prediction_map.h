@@ -28,7 +28,9 @@ namespace prediction {
 class PredictionMap {
  public:
   /**
-   * @brief Check if map is ready
+   * @brief Check if map is ready. The base map is loaded lazily by the first
+   *        call; once it returned true, lookups only read the map and are
+   *        safe to run from several threads.
    * @return True if map is ready
    */
   static bool Ready();
@@ -16,6 +16,10 @@
 
 #include "modules/prediction/common/prediction_map.h"
 
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "modules/prediction/common/kml_map_based_test.h"
 #include "modules/prediction/common/prediction_gflags.h"
 
@@ -273,5 +277,67 @@ TEST_F(PredictionMapTest, lane_turn_type) {
   EXPECT_EQ(3, PredictionMap::LaneTurnType("l5"));
 }
 
+TEST_F(PredictionMapTest, concurrent_lookups) {
+  // the evaluator and predictor workers look the map up concurrently once
+  // Ready() returned true on the calling thread
+  ASSERT_TRUE(PredictionMap::Ready());
+
+  struct Lookup {
+    double s = 0.0;
+    double l = 0.0;
+    Eigen::Vector2d smooth_point;
+    double heading = 0.0;
+    std::vector<std::string> nearby_lane_ids;
+  };
+  auto lookup = [](const int i) {
+    Lookup result;
+    const Eigen::Vector2d point(124.85931, 340.0 + 0.1 * i);
+    PredictionMap::GetProjection(point, PredictionMap::LaneById("l20"),
+                                 &result.s, &result.l);
+    PredictionMap::SmoothPointFromLane("l20", 0.5 * i, 0.0,
+                                       &result.smooth_point, &result.heading);
+    std::vector<std::shared_ptr<const LaneInfo>> nearby_lanes;
+    PredictionMap::NearbyLanesByCurrentLanes(
+        point, -0.061427808505166936, 5.0, {}, FLAGS_max_num_nearby_lane,
+        &nearby_lanes);
+    for (const auto& lane : nearby_lanes) {
+      result.nearby_lane_ids.push_back(lane->id().id());
+    }
+    return result;
+  };
+
+  constexpr int kNumLookups = 200;
+  std::vector<Lookup> expected;
+  for (int i = 0; i < kNumLookups; ++i) {
+    expected.push_back(lookup(i));
+  }
+
+  constexpr int kNumThreads = 4;
+  std::vector<std::vector<Lookup>> results(kNumThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&lookup, &results, t]() {
+      for (int i = 0; i < kNumLookups; ++i) {
+        results[t].push_back(lookup(i));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& thread_results : results) {
+    ASSERT_EQ(expected.size(), thread_results.size());
+    for (int i = 0; i < kNumLookups; ++i) {
+      EXPECT_EQ(expected[i].s, thread_results[i].s);
+      EXPECT_EQ(expected[i].l, thread_results[i].l);
+      EXPECT_EQ(expected[i].smooth_point, thread_results[i].smooth_point);
+      EXPECT_EQ(expected[i].heading, thread_results[i].heading);
+      EXPECT_EQ(expected[i].nearby_lane_ids,
+                thread_results[i].nearby_lane_ids);
+    }
+  }
+}
+
 }  // namespace prediction
 }  // namespace apollo
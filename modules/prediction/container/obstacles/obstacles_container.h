@@ -83,7 +83,8 @@ class ObstaclesContainer : public Container {
   void BuildJunctionFeature();
 
   /**
-   * @brief Get obstacle pointer
+   * @brief Get obstacle pointer. The lookup does not update the LRU order,
+   *        so the evaluator and predictor workers may call it concurrently.
    * @param Obstacle ID
    * @return Obstacle pointer
    */
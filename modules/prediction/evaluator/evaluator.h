@@ -65,6 +65,17 @@ class Evaluator {
     Evaluate(obstacle);
   }
 
+  /**
+   * @brief Evaluate all obstacles assigned to this evaluator in one frame;
+   *        evaluators backed by a network override it to batch inference
+   * @param vector of obstacle pointers
+   */
+  virtual void EvaluateBatch(const std::vector<Obstacle*>& obstacles) {
+    for (Obstacle* obstacle : obstacles) {
+      Evaluate(obstacle);
+    }
+  }
+
   /**
    * @brief Get the name of evaluator
    */
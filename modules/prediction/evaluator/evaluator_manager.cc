@@ -17,11 +17,21 @@
 #include "modules/prediction/evaluator/evaluator_manager.h"
 
 #include <algorithm>
+#include <future>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "torch/torch.h"
+
+#include "cyber/task/task.h"
 #include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/common/time/time.h"
 #include "modules/prediction/common/feature_output.h"
 #include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_map.h"
 #include "modules/prediction/common/prediction_system_gflags.h"
 #include "modules/prediction/container/container_manager.h"
 #include "modules/prediction/container/obstacles/obstacles_container.h"
@@ -39,10 +49,21 @@ namespace apollo {
 namespace prediction {
 
 using apollo::common::adapter::AdapterConfig;
+using apollo::common::time::Clock;
 using apollo::perception::PerceptionObstacle;
 
 namespace {
 
+void AddLatency(const std::string& name, const int num_obstacles,
+                const double time_ms,
+                std::map<std::string, EvaluatorLatency>* latency) {
+  auto& evaluator_latency = (*latency)[name];
+  evaluator_latency.set_name(name);
+  evaluator_latency.set_num_obstacles(evaluator_latency.num_obstacles() +
+                                      num_obstacles);
+  evaluator_latency.set_time_ms(evaluator_latency.time_ms() + time_ms);
+}
+
 bool IsTrainable(const Feature& feature) {
   if (feature.id() == -1) {
     return false;
@@ -138,7 +159,13 @@ void EvaluatorManager::Run() {
     BuildCurrentFrameEnv();
   }
 
-  std::vector<Obstacle*> dynamic_env;
+  {
+    std::lock_guard<std::mutex> lock(latency_mutex_);
+    latency_.clear();
+  }
+
+  const double start_time = Clock::NowInSeconds();
+  std::vector<Obstacle*> obstacles;
   for (int id : obstacles_container->curr_frame_predictable_obstacle_ids()) {
     if (id < 0) {
       ADEBUG << "The obstacle has invalid id [" << id << "].";
@@ -154,22 +181,160 @@ void EvaluatorManager::Run() {
       continue;
     }
 
-    EvaluateObstacle(obstacle, dynamic_env);
+    obstacles.push_back(obstacle);
   }
+
+  const size_t num_workers = NumWorkers(obstacles.size());
+  if (num_workers > 1) {
+    PrepareWorkerEvaluators(num_workers);
+    // Contiguous shards, the first one runs on the calling thread.
+    const size_t shard_size =
+        (obstacles.size() + num_workers - 1) / num_workers;
+    std::vector<std::vector<Obstacle*>> shards;
+    for (size_t i = 0; i < obstacles.size(); i += shard_size) {
+      const size_t end = std::min(i + shard_size, obstacles.size());
+      shards.emplace_back(obstacles.begin() + i, obstacles.begin() + end);
+    }
+    std::vector<std::future<void>> results;
+    for (size_t i = 1; i < shards.size(); ++i) {
+      results.push_back(cyber::Async([this, &shards, i]() {
+        // torch keeps the intra-op thread number per thread, and the
+        // evaluators only set it on the thread loading their models. Cap it
+        // on the workers too, so that the shards do not oversubscribe cores.
+        torch::set_num_threads(1);
+        EvaluateObstacles(shards[i], &worker_evaluators_[i - 1]);
+      }));
+    }
+    EvaluateObstacles(shards.front(), &evaluators_);
+    for (auto& result : results) {
+      result.get();
+    }
+  } else {
+    EvaluateObstacles(obstacles, &evaluators_);
+  }
+  ADEBUG << "Evaluated " << obstacles.size() << " obstacles with "
+         << num_workers << " threads in "
+         << (Clock::NowInSeconds() - start_time) * 1000.0 << " ms.";
 }
 
-void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle,
-                                        std::vector<Obstacle*> dynamic_env) {
+void EvaluatorManager::EvaluateObstacles(
+    const std::vector<Obstacle*>& obstacles, EvaluatorMap* evaluators) {
+  std::vector<Obstacle*> dynamic_env;
+  // Obstacles grouped by evaluator, in the order evaluators are first met.
+  std::vector<Evaluator*> batch_evaluators;
+  std::unordered_map<Evaluator*, std::vector<Obstacle*>> batches;
+  // Latency of this thread, merged into the frame latency once at the end.
+  std::map<std::string, EvaluatorLatency> latency;
+  for (Obstacle* obstacle : obstacles) {
+    Evaluator* evaluator = SelectEvaluator(obstacle, evaluators);
+    if (evaluator == nullptr) {
+      continue;
+    }
+    if (evaluator->GetName() == "LANE_SCANNING_EVALUATOR" ||
+        !FLAGS_enable_batch_evaluation) {
+      const double evaluate_start_time = Clock::NowInSeconds();
+      if (evaluator->GetName() == "LANE_SCANNING_EVALUATOR") {
+        // For evaluators that need surrounding obstacles' info.
+        evaluator->Evaluate(obstacle, dynamic_env);
+      } else {
+        evaluator->Evaluate(obstacle);
+      }
+      AddLatency(evaluator->GetName(), 1,
+                 (Clock::NowInSeconds() - evaluate_start_time) * 1000.0,
+                 &latency);
+      continue;
+    }
+    auto& batch = batches[evaluator];
+    if (batch.empty()) {
+      batch_evaluators.push_back(evaluator);
+    }
+    batch.push_back(obstacle);
+  }
+
+  for (Evaluator* evaluator : batch_evaluators) {
+    const auto& batch = batches[evaluator];
+    const double batch_start_time = Clock::NowInSeconds();
+    evaluator->EvaluateBatch(batch);
+    const double batch_time_ms =
+        (Clock::NowInSeconds() - batch_start_time) * 1000.0;
+    ADEBUG << evaluator->GetName() << " evaluated " << batch.size()
+           << " obstacles in " << batch_time_ms << " ms.";
+    AddLatency(evaluator->GetName(), static_cast<int>(batch.size()),
+               batch_time_ms, &latency);
+  }
+  MergeLatency(latency);
+}
+
+void EvaluatorManager::MergeLatency(
+    const std::map<std::string, EvaluatorLatency>& latency) {
+  std::lock_guard<std::mutex> lock(latency_mutex_);
+  for (const auto& entry : latency) {
+    AddLatency(entry.first, entry.second.num_obstacles(),
+               entry.second.time_ms(), &latency_);
+  }
+}
+
+void EvaluatorManager::GetLatency(
+    PredictionObstacles* prediction_obstacles) const {
+  std::lock_guard<std::mutex> lock(latency_mutex_);
+  for (const auto& entry : latency_) {
+    *prediction_obstacles->add_evaluator_latency() = entry.second;
+  }
+}
+
+size_t EvaluatorManager::NumWorkers(const size_t num_obstacles) const {
+  if (!FLAGS_enable_multi_thread_in_prediction ||
+      FLAGS_prediction_thread_num <= 1 || num_obstacles <= 1) {
+    return 1;
+  }
+  // Learning data is written to a global buffer in offline modes.
+  if (FLAGS_prediction_offline_mode != 0) {
+    return 1;
+  }
+  // The base map is loaded lazily; it must be resolved on the calling thread
+  // so that map lookups from the workers are read-only.
+  if (!PredictionMap::Ready()) {
+    return 1;
+  }
+  // RNN evaluators share a single network instance.
+  for (const auto type :
+       {vehicle_on_lane_evaluator_, vehicle_in_junction_evaluator_,
+        cyclist_on_lane_evaluator_, default_on_lane_evaluator_}) {
+    if (type == ObstacleConf::RNN_EVALUATOR) {
+      return 1;
+    }
+  }
+  return std::min(num_obstacles,
+                  static_cast<size_t>(FLAGS_prediction_thread_num));
+}
+
+void EvaluatorManager::PrepareWorkerEvaluators(const size_t num_workers) {
+  while (worker_evaluators_.size() + 1 < num_workers) {
+    EvaluatorMap evaluators;
+    for (const auto& entry : evaluators_) {
+      evaluators[entry.first] = CreateEvaluator(entry.first);
+    }
+    worker_evaluators_.push_back(std::move(evaluators));
+  }
+}
+
+Evaluator* EvaluatorManager::SelectEvaluator(Obstacle* obstacle,
+                                             EvaluatorMap* evaluators) {
+  auto get_evaluator = [evaluators](const ObstacleConf::EvaluatorType& type)
+      -> Evaluator* {
+    auto it = evaluators->find(type);
+    return it != evaluators->end() ? it->second.get() : nullptr;
+  };
   Evaluator* evaluator = nullptr;
   // Select different evaluators depending on the obstacle's type.
   switch (obstacle->type()) {
     case PerceptionObstacle::VEHICLE: {
       if (obstacle->HasJunctionFeatureWithExits() &&
           !obstacle->IsCloseToJunctionExit()) {
-        evaluator = GetEvaluator(vehicle_in_junction_evaluator_);
+        evaluator = get_evaluator(vehicle_in_junction_evaluator_);
         CHECK_NOTNULL(evaluator);
       } else if (obstacle->IsOnLane()) {
-        evaluator = GetEvaluator(vehicle_on_lane_evaluator_);
+        evaluator = get_evaluator(vehicle_on_lane_evaluator_);
         CHECK_NOTNULL(evaluator);
       } else {
         ADEBUG << "Obstacle: " << obstacle->id()
@@ -179,7 +344,7 @@ void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle,
     }
     case PerceptionObstacle::BICYCLE: {
       if (obstacle->IsOnLane()) {
-        evaluator = GetEvaluator(cyclist_on_lane_evaluator_);
+        evaluator = get_evaluator(cyclist_on_lane_evaluator_);
         CHECK_NOTNULL(evaluator);
       }
       break;
@@ -189,12 +354,18 @@ void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle,
     }
     default: {
       if (obstacle->IsOnLane()) {
-        evaluator = GetEvaluator(default_on_lane_evaluator_);
+        evaluator = get_evaluator(default_on_lane_evaluator_);
         CHECK_NOTNULL(evaluator);
       }
       break;
     }
   }
+  return evaluator;
+}
+
+void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle,
+                                        std::vector<Obstacle*> dynamic_env) {
+  Evaluator* evaluator = SelectEvaluator(obstacle, &evaluators_);
 
   // Evaluate using the selected evaluator.
   if (evaluator != nullptr) {
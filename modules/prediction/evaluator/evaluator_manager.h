@@ -23,11 +23,14 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include "cyber/common/macros.h"
 #include "modules/prediction/evaluator/evaluator.h"
 #include "modules/prediction/proto/prediction_conf.pb.h"
+#include "modules/prediction/proto/prediction_obstacle.pb.h"
 
 /**
  * @namespace apollo::prediction
@@ -60,6 +63,12 @@ class EvaluatorManager {
    */
   void Run();
 
+  /**
+   * @brief Add the latency of every evaluator run by the last Run()
+   * @param Prediction obstacles to add the latency to
+   */
+  void GetLatency(PredictionObstacles* prediction_obstacles) const;
+
   void EvaluateObstacle(Obstacle* obstacle, std::vector<Obstacle*> dynamic_env);
 
   void EvaluateObstacle(Obstacle* obstacle);
@@ -67,6 +76,45 @@ class EvaluatorManager {
  private:
   void BuildCurrentFrameEnv();
 
+  using EvaluatorMap =
+      std::map<ObstacleConf::EvaluatorType, std::unique_ptr<Evaluator>>;
+
+  /**
+   * @brief Select the evaluator of an obstacle by its type and position
+   * @param Obstacle pointer
+   * @param Evaluators to select from
+   * @return Pointer to the evaluator, nullptr if it is not evaluated
+   */
+  Evaluator* SelectEvaluator(Obstacle* obstacle, EvaluatorMap* evaluators);
+
+  /**
+   * @brief Evaluate obstacles with a set of evaluators, batching the
+   *        obstacles of each evaluator if enabled
+   * @param Obstacle pointers
+   * @param Evaluators used by the calling thread
+   */
+  void EvaluateObstacles(const std::vector<Obstacle*>& obstacles,
+                         EvaluatorMap* evaluators);
+
+  /**
+   * @brief Number of threads to share the obstacles of a frame
+   * @param Number of obstacles to evaluate
+   * @return 1 if the obstacles have to be evaluated on the calling thread
+   */
+  size_t NumWorkers(const size_t num_obstacles) const;
+
+  /**
+   * @brief Make sure every worker thread owns a set of evaluators
+   * @param Number of threads including the calling one
+   */
+  void PrepareWorkerEvaluators(const size_t num_workers);
+
+  /**
+   * @brief Add the latency recorded by one thread to the frame latency
+   * @param Latency by evaluator name
+   */
+  void MergeLatency(const std::map<std::string, EvaluatorLatency>& latency);
+
   /**
    * @brief Register an evaluator by type
    * @param Evaluator type
@@ -87,7 +135,15 @@ class EvaluatorManager {
   void RegisterEvaluators();
 
  private:
-  std::map<ObstacleConf::EvaluatorType, std::unique_ptr<Evaluator>> evaluators_;
+  EvaluatorMap evaluators_;
+
+  // Evaluators of the worker threads other than the calling one; evaluators
+  // keep scratch state, so they are never shared across threads.
+  std::vector<EvaluatorMap> worker_evaluators_;
+
+  // Latency of the evaluators in the last frame, by evaluator name.
+  mutable std::mutex latency_mutex_;
+  std::map<std::string, EvaluatorLatency> latency_;
 
   ObstacleConf::EvaluatorType vehicle_on_lane_evaluator_ =
       ObstacleConf::CRUISE_MLP_EVALUATOR;
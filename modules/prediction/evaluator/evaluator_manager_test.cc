@@ -64,6 +64,16 @@ TEST_F(EvaluatorManagerTest, General) {
   for (const auto& lane_sequence : lane_graph.lane_sequence()) {
     EXPECT_TRUE(lane_sequence.has_probability());
   }
+
+  PredictionObstacles prediction_obstacles;
+  EvaluatorManager::Instance()->GetLatency(&prediction_obstacles);
+  int num_evaluated = 0;
+  for (const auto& latency : prediction_obstacles.evaluator_latency()) {
+    EXPECT_FALSE(latency.name().empty());
+    EXPECT_GE(latency.time_ms(), 0.0);
+    num_evaluated += latency.num_obstacles();
+  }
+  EXPECT_LE(num_evaluated, perception_obstacles_.perception_obstacle_size());
 }
 
 }  // namespace prediction
@@ -51,8 +51,25 @@ CruiseMLPEvaluator::CruiseMLPEvaluator() : device_(torch::kCPU) {
 void CruiseMLPEvaluator::Clear() {}
 
 void CruiseMLPEvaluator::Evaluate(Obstacle* obstacle_ptr) {
-  // Sanity checks.
+  EvaluateBatch({obstacle_ptr});
+}
+
+void CruiseMLPEvaluator::EvaluateBatch(
+    const std::vector<Obstacle*>& obstacles) {
   Clear();
+  InferenceBatch go_batch;
+  InferenceBatch cutin_batch;
+  for (Obstacle* obstacle_ptr : obstacles) {
+    AppendLaneSequences(obstacle_ptr, &go_batch, &cutin_batch);
+  }
+  ModelInference(go_batch, torch_go_model_ptr_);
+  ModelInference(cutin_batch, torch_cutin_model_ptr_);
+}
+
+void CruiseMLPEvaluator::AppendLaneSequences(Obstacle* obstacle_ptr,
+                                             InferenceBatch* go_batch,
+                                             InferenceBatch* cutin_batch) {
+  // Sanity checks.
   CHECK_NOTNULL(obstacle_ptr);
   int id = obstacle_ptr->id();
   if (!obstacle_ptr->latest_feature().IsInitialized()) {
@@ -78,7 +95,8 @@ void CruiseMLPEvaluator::Evaluate(Obstacle* obstacle_ptr) {
          << " lane sequences with probabilities:";
   // For every possible lane sequence, extract features that are needed
   // to feed into our trained model.
-  // Then compute the likelihood of the obstacle moving onto that laneseq.
+  // The likelihood of the obstacle moving onto that laneseq is computed
+  // later for the whole batch.
   for (int i = 0; i < lane_graph_ptr->lane_sequence_size(); ++i) {
     LaneSequence* lane_sequence_ptr = lane_graph_ptr->mutable_lane_sequence(i);
     CHECK_NOTNULL(lane_sequence_ptr);
@@ -99,19 +117,11 @@ void CruiseMLPEvaluator::Evaluate(Obstacle* obstacle_ptr) {
       return;  // Skip Compute probability for offline mode
     }
 
-    std::vector<torch::jit::IValue> torch_inputs;
-    int input_dim = static_cast<int>(
-        OBSTACLE_FEATURE_SIZE + SINGLE_LANE_FEATURE_SIZE * LANE_POINTS_SIZE);
-    torch::Tensor torch_input = torch::zeros({1, input_dim});
-    for (size_t i = 0; i < feature_values.size(); ++i) {
-      torch_input[0][i] = static_cast<float>(feature_values[i]);
-    }
-    torch_inputs.push_back(torch_input.to(device_));
-    if (lane_sequence_ptr->vehicle_on_lane()) {
-      ModelInference(torch_inputs, torch_go_model_ptr_, lane_sequence_ptr);
-    } else {
-      ModelInference(torch_inputs, torch_cutin_model_ptr_, lane_sequence_ptr);
-    }
+    InferenceBatch* batch =
+        lane_sequence_ptr->vehicle_on_lane() ? go_batch : cutin_batch;
+    batch->features.insert(batch->features.end(), feature_values.begin(),
+                           feature_values.end());
+    batch->lane_sequences.push_back(lane_sequence_ptr);
   }
 }
 
@@ -540,16 +550,37 @@ void CruiseMLPEvaluator::LoadModels() {
 }
 
 void CruiseMLPEvaluator::ModelInference(
-    const std::vector<torch::jit::IValue>& torch_inputs,
-    std::shared_ptr<torch::jit::script::Module> torch_model_ptr,
-    LaneSequence* lane_sequence_ptr) {
+    const InferenceBatch& batch,
+    std::shared_ptr<torch::jit::script::Module> torch_model_ptr) {
+  if (batch.lane_sequences.empty()) {
+    return;
+  }
+  CHECK_NOTNULL(torch_model_ptr);
+  int64_t batch_size = static_cast<int64_t>(batch.lane_sequences.size());
+  int64_t input_dim = static_cast<int64_t>(
+      OBSTACLE_FEATURE_SIZE + SINGLE_LANE_FEATURE_SIZE * LANE_POINTS_SIZE);
+  CHECK_EQ(batch.features.size(),
+           static_cast<size_t>(batch_size * input_dim));
+  // The blob is only borrowed for the duration of the forward pass.
+  torch::Tensor torch_input =
+      torch::from_blob(const_cast<float*>(batch.features.data()),
+                       {batch_size, input_dim}, torch::kFloat);
+  std::vector<torch::jit::IValue> torch_inputs;
+  torch_inputs.push_back(torch_input.to(device_));
   auto torch_output_tuple = torch_model_ptr->forward(torch_inputs).toTuple();
-  auto probability_tensor = torch_output_tuple->elements()[0].toTensor();
-  auto finish_time_tensor = torch_output_tuple->elements()[1].toTensor();
-  lane_sequence_ptr->set_probability(Sigmoid(
-      static_cast<double>(probability_tensor.accessor<float, 2>()[0][0])));
-  lane_sequence_ptr->set_time_to_lane_center(
-      static_cast<double>(finish_time_tensor.accessor<float, 2>()[0][0]));
+  auto probability_tensor =
+      torch_output_tuple->elements()[0].toTensor().to(torch::kCPU);
+  auto finish_time_tensor =
+      torch_output_tuple->elements()[1].toTensor().to(torch::kCPU);
+  auto probability = probability_tensor.accessor<float, 2>();
+  auto finish_time = finish_time_tensor.accessor<float, 2>();
+  for (int64_t i = 0; i < batch_size; ++i) {
+    LaneSequence* lane_sequence_ptr = batch.lane_sequences[i];
+    lane_sequence_ptr->set_probability(
+        Sigmoid(static_cast<double>(probability[i][0])));
+    lane_sequence_ptr->set_time_to_lane_center(
+        static_cast<double>(finish_time[i][0]));
+  }
 }
 
 }  // namespace prediction
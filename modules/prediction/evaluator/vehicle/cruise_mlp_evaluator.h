@@ -47,6 +47,13 @@ class CruiseMLPEvaluator : public Evaluator {
    */
   void Evaluate(Obstacle* obstacle_ptr) override;
 
+  /**
+   * @brief Override EvaluateBatch; all lane sequences of the obstacles are
+   *        fed to the go and cutin models in one forward pass each
+   * @param vector of obstacle pointers
+   */
+  void EvaluateBatch(const std::vector<Obstacle*>& obstacles) override;
+
   /**
    * @brief Extract feature vector
    * @param Obstacle pointer
@@ -64,6 +71,25 @@ class CruiseMLPEvaluator : public Evaluator {
   void Clear();
 
  private:
+  /**
+   * @brief Features of lane sequences fed to one model, row-major with one
+   *        row per lane sequence
+   */
+  struct InferenceBatch {
+    std::vector<float> features;
+    std::vector<LaneSequence*> lane_sequences;
+  };
+
+  /**
+   * @brief Extract features of all lane sequences of an obstacle and append
+   *        them to the batch of the model that scores them
+   * @param Obstacle pointer
+   *        Batch of the go model
+   *        Batch of the cutin model
+   */
+  void AppendLaneSequences(Obstacle* obstacle_ptr, InferenceBatch* go_batch,
+                           InferenceBatch* cutin_batch);
+
   /**
    * @brief Set obstacle feature vector
    * @param Obstacle pointer
@@ -97,10 +123,15 @@ class CruiseMLPEvaluator : public Evaluator {
    */
   void LoadModels();
 
+  /**
+   * @brief Run one forward pass over a batch and write the probability and
+   *        time to lane center back to its lane sequences
+   * @param Batch of lane sequences
+   *        Model pointer
+   */
   void ModelInference(
-      const std::vector<torch::jit::IValue>& torch_inputs,
-      std::shared_ptr<torch::jit::script::Module> torch_model_ptr,
-      LaneSequence* lane_sequence_ptr);
+      const InferenceBatch& batch,
+      std::shared_ptr<torch::jit::script::Module> torch_model_ptr);
 
  private:
   static const size_t OBSTACLE_FEATURE_SIZE = 23 + 5 * 9;
@@ -16,6 +16,8 @@
 
 #include "modules/prediction/evaluator/vehicle/cruise_mlp_evaluator.h"
 
+#include <vector>
+
 #include "cyber/common/file.h"
 #include "modules/prediction/common/kml_map_based_test.h"
 #include "modules/prediction/container/obstacles/obstacles_container.h"
@@ -56,5 +58,41 @@ TEST_F(CruiseMLPEvaluatorTest, OnLaneCase) {
   cruise_mlp_evaluator.Clear();
 }
 
+TEST_F(CruiseMLPEvaluatorTest, BatchMatchesSingleEvaluation) {
+  CruiseMLPEvaluator cruise_mlp_evaluator;
+  ObstaclesContainer single_container;
+  single_container.Insert(perception_obstacles_);
+  single_container.BuildLaneGraph();
+  Obstacle* single_obstacle_ptr = single_container.GetObstacle(1);
+  EXPECT_TRUE(single_obstacle_ptr != nullptr);
+  cruise_mlp_evaluator.Evaluate(single_obstacle_ptr);
+
+  ObstaclesContainer first_container;
+  first_container.Insert(perception_obstacles_);
+  first_container.BuildLaneGraph();
+  ObstaclesContainer second_container;
+  second_container.Insert(perception_obstacles_);
+  second_container.BuildLaneGraph();
+  std::vector<Obstacle*> obstacles = {first_container.GetObstacle(1),
+                                      second_container.GetObstacle(1)};
+  cruise_mlp_evaluator.EvaluateBatch(obstacles);
+
+  const LaneGraph& expected_lane_graph =
+      single_obstacle_ptr->latest_feature().lane().lane_graph();
+  for (const Obstacle* obstacle_ptr : obstacles) {
+    const LaneGraph& lane_graph =
+        obstacle_ptr->latest_feature().lane().lane_graph();
+    EXPECT_EQ(lane_graph.lane_sequence_size(),
+              expected_lane_graph.lane_sequence_size());
+    for (int i = 0; i < lane_graph.lane_sequence_size(); ++i) {
+      const LaneSequence& lane_sequence = lane_graph.lane_sequence(i);
+      const LaneSequence& expected = expected_lane_graph.lane_sequence(i);
+      EXPECT_NEAR(lane_sequence.probability(), expected.probability(), 1e-6);
+      EXPECT_NEAR(lane_sequence.time_to_lane_center(),
+                  expected.time_to_lane_center(), 1e-6);
+    }
+  }
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -59,57 +59,97 @@ JunctionMLPEvaluator::JunctionMLPEvaluator() : device_(torch::kCPU) {
 void JunctionMLPEvaluator::Clear() {}
 
 void JunctionMLPEvaluator::Evaluate(Obstacle* obstacle_ptr) {
-  // Sanity checks.
+  EvaluateBatch({obstacle_ptr});
+}
+
+void JunctionMLPEvaluator::EvaluateBatch(
+    const std::vector<Obstacle*>& obstacles) {
   Clear();
+  int64_t input_dim = static_cast<int64_t>(
+      OBSTACLE_FEATURE_SIZE + EGO_VEHICLE_FEATURE_SIZE + JUNCTION_FEATURE_SIZE);
+  // Obstacles with multiple junction exits are scored by the model together,
+  // one row of batch_features each.
+  std::vector<Obstacle*> batch_obstacles;
+  std::vector<float> batch_features;
+  for (Obstacle* obstacle_ptr : obstacles) {
+    std::vector<double> feature_values;
+    if (!PrepareFeatureValues(obstacle_ptr, &feature_values)) {
+      continue;
+    }
+    if (obstacle_ptr->latest_feature().junction_feature().junction_exit_size() >
+        1) {
+      batch_features.insert(batch_features.end(), feature_values.begin(),
+                            feature_values.end());
+      batch_obstacles.push_back(obstacle_ptr);
+      continue;
+    }
+    std::vector<double> probability;
+    for (int i = 0; i < 12; ++i) {
+      probability.push_back(feature_values[OBSTACLE_FEATURE_SIZE +
+                                           EGO_VEHICLE_FEATURE_SIZE + 8 * i]);
+    }
+    SetProbability(obstacle_ptr, probability);
+  }
+  if (batch_obstacles.empty()) {
+    return;
+  }
+
+  CHECK_NOTNULL(torch_model_ptr_);
+  int64_t batch_size = static_cast<int64_t>(batch_obstacles.size());
+  // The blob is only borrowed for the duration of the forward pass.
+  torch::Tensor torch_input = torch::from_blob(
+      batch_features.data(), {batch_size, input_dim}, torch::kFloat);
+  std::vector<torch::jit::IValue> torch_inputs;
+  torch_inputs.push_back(torch_input.to(device_));
+  at::Tensor torch_output_tensor =
+      torch_model_ptr_->forward(torch_inputs).toTensor().to(torch::kCPU);
+  auto torch_output = torch_output_tensor.accessor<float, 2>();
+  for (int64_t i = 0; i < batch_size; ++i) {
+    std::vector<double> probability;
+    for (int j = 0; j < torch_output.size(1); ++j) {
+      probability.push_back(static_cast<double>(torch_output[i][j]));
+    }
+    SetProbability(batch_obstacles[i], probability);
+  }
+}
+
+bool JunctionMLPEvaluator::PrepareFeatureValues(
+    Obstacle* obstacle_ptr, std::vector<double>* feature_values) {
+  // Sanity checks.
   CHECK_NOTNULL(obstacle_ptr);
   int id = obstacle_ptr->id();
   if (!obstacle_ptr->latest_feature().IsInitialized()) {
     AERROR << "Obstacle [" << id << "] has no latest feature.";
-    return;
+    return false;
   }
-  Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
-  CHECK_NOTNULL(latest_feature_ptr);
+  const Feature& latest_feature = obstacle_ptr->latest_feature();
 
   // Assume obstacle is NOT closed to any junction exit
-  if (!latest_feature_ptr->has_junction_feature() ||
-      latest_feature_ptr->junction_feature().junction_exit_size() < 1) {
+  if (!latest_feature.has_junction_feature() ||
+      latest_feature.junction_feature().junction_exit_size() < 1) {
     ADEBUG << "Obstacle [" << id << "] has no junction_exit.";
-    return;
+    return false;
   }
 
-  std::vector<double> feature_values;
-  ExtractFeatureValues(obstacle_ptr, &feature_values);
+  ExtractFeatureValues(obstacle_ptr, feature_values);
 
   // Insert features to DataForLearning
   if (FLAGS_prediction_offline_mode == 2) {
-    FeatureOutput::InsertDataForLearning(*latest_feature_ptr, feature_values,
+    FeatureOutput::InsertDataForLearning(latest_feature, *feature_values,
                                          "junction");
     ADEBUG << "Save extracted features for learning locally.";
-    return;  // Skip Compute probability for offline mode
-  }
-  std::vector<torch::jit::IValue> torch_inputs;
-  int input_dim = static_cast<int>(
-      OBSTACLE_FEATURE_SIZE + EGO_VEHICLE_FEATURE_SIZE + JUNCTION_FEATURE_SIZE);
-  torch::Tensor torch_input = torch::zeros({1, input_dim});
-  for (size_t i = 0; i < feature_values.size(); ++i) {
-    torch_input[0][i] = static_cast<float>(feature_values[i]);
-  }
-  torch_inputs.push_back(torch_input.to(device_));
-  std::vector<double> probability;
-  if (latest_feature_ptr->junction_feature().junction_exit_size() > 1) {
-    CHECK_NOTNULL(torch_model_ptr_);
-    at::Tensor torch_output_tensor =
-        torch_model_ptr_->forward(torch_inputs).toTensor();
-    auto torch_output = torch_output_tensor.accessor<float, 2>();
-    for (int i = 0; i < torch_output.size(1); ++i) {
-      probability.push_back(static_cast<double>(torch_output[0][i]));
-    }
-  } else {
-    for (int i = 0; i < 12; ++i) {
-      probability.push_back(feature_values[OBSTACLE_FEATURE_SIZE +
-                                           EGO_VEHICLE_FEATURE_SIZE + 8 * i]);
-    }
+    return false;  // Skip Compute probability for offline mode
   }
+  return feature_values->size() == OBSTACLE_FEATURE_SIZE +
+                                       EGO_VEHICLE_FEATURE_SIZE +
+                                       JUNCTION_FEATURE_SIZE;
+}
+
+void JunctionMLPEvaluator::SetProbability(
+    Obstacle* obstacle_ptr, const std::vector<double>& probability) {
+  int id = obstacle_ptr->id();
+  Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
+  CHECK_NOTNULL(latest_feature_ptr);
   for (double prob : probability) {
     latest_feature_ptr->mutable_junction_feature()
         ->add_junction_mlp_probability(prob);
@@ -52,6 +52,13 @@ class JunctionMLPEvaluator : public Evaluator {
    */
   void Evaluate(Obstacle* obstacle_ptr) override;
 
+  /**
+   * @brief Override EvaluateBatch; obstacles with more than one junction
+   *        exit are fed to the model in one forward pass
+   * @param vector of obstacle pointers
+   */
+  void EvaluateBatch(const std::vector<Obstacle*>& obstacles) override;
+
   /**
    * @brief Extract feature vector
    * @param Obstacle pointer
@@ -66,6 +73,24 @@ class JunctionMLPEvaluator : public Evaluator {
   std::string GetName() override { return "JUNCTION_MLP_EVALUATOR"; }
 
  private:
+  /**
+   * @brief Check the obstacle and extract its feature vector
+   * @param Obstacle pointer
+   *        Feature container in a vector for receiving the feature values
+   * @return True if the obstacle needs junction exit probabilities
+   */
+  bool PrepareFeatureValues(Obstacle* obstacle_ptr,
+                            std::vector<double>* feature_values);
+
+  /**
+   * @brief Set junction mlp probabilities of the obstacle and assign them
+   *        to its lane sequences through the junction exits
+   * @param Obstacle pointer
+   *        Probabilities of the 12 fan areas
+   */
+  void SetProbability(Obstacle* obstacle_ptr,
+                      const std::vector<double>& probability);
+
   /**
    * @brief Set obstacle feature vector
    * @param Obstacle pointer
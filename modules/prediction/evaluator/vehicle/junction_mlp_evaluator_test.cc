@@ -16,6 +16,8 @@
 
 #include "modules/prediction/evaluator/vehicle/junction_mlp_evaluator.h"
 
+#include <vector>
+
 #include "cyber/common/file.h"
 #include "modules/prediction/common/junction_analyzer.h"
 #include "modules/prediction/common/kml_map_based_test.h"
@@ -64,5 +66,41 @@ TEST_F(JunctionMLPEvaluatorTest, InJunctionCase) {
   junction_mlp_evaluator.Clear();
 }
 
+TEST_F(JunctionMLPEvaluatorTest, BatchMatchesSingleEvaluation) {
+  JunctionMLPEvaluator junction_mlp_evaluator;
+  ObstaclesContainer single_container;
+  single_container.Insert(perception_obstacles_);
+  single_container.BuildJunctionFeature();
+  Obstacle* single_obstacle_ptr = single_container.GetObstacle(1);
+  EXPECT_TRUE(single_obstacle_ptr != nullptr);
+  junction_mlp_evaluator.Evaluate(single_obstacle_ptr);
+
+  ObstaclesContainer first_container;
+  first_container.Insert(perception_obstacles_);
+  first_container.BuildJunctionFeature();
+  ObstaclesContainer second_container;
+  second_container.Insert(perception_obstacles_);
+  second_container.BuildJunctionFeature();
+  std::vector<Obstacle*> obstacles = {first_container.GetObstacle(1),
+                                      second_container.GetObstacle(1)};
+  junction_mlp_evaluator.EvaluateBatch(obstacles);
+
+  const JunctionFeature& expected_junction_feature =
+      single_obstacle_ptr->latest_feature().junction_feature();
+  EXPECT_EQ(expected_junction_feature.junction_mlp_probability_size(), 12);
+  for (const Obstacle* obstacle_ptr : obstacles) {
+    const JunctionFeature& junction_feature =
+        obstacle_ptr->latest_feature().junction_feature();
+    EXPECT_EQ(junction_feature.junction_mlp_probability_size(),
+              expected_junction_feature.junction_mlp_probability_size());
+    for (int i = 0; i < junction_feature.junction_mlp_probability_size();
+         ++i) {
+      EXPECT_NEAR(junction_feature.junction_mlp_probability(i),
+                  expected_junction_feature.junction_mlp_probability(i), 1e-6);
+    }
+  }
+  junction_mlp_evaluator.Clear();
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -16,8 +16,16 @@
 
 #include "modules/prediction/predictor/predictor_manager.h"
 
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <utility>
+
+#include "cyber/task/task.h"
+#include "modules/common/time/time.h"
 #include "modules/prediction/common/feature_output.h"
 #include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_map.h"
 #include "modules/prediction/common/prediction_system_gflags.h"
 #include "modules/prediction/container/container_manager.h"
 #include "modules/prediction/container/obstacles/obstacles_container.h"
@@ -32,6 +40,7 @@ namespace apollo {
 namespace prediction {
 
 using apollo::common::adapter::AdapterConfig;
+using apollo::common::time::Clock;
 using apollo::perception::PerceptionObstacle;
 
 PredictorManager::PredictorManager() { RegisterPredictors(); }
@@ -138,84 +147,179 @@ void PredictorManager::Run() {
           AdapterConfig::PLANNING_TRAJECTORY);
 
   CHECK_NOTNULL(obstacles_container);
-  for (const int id : obstacles_container->curr_frame_obstacle_ids()) {
+  const double start_time = Clock::NowInSeconds();
+  // One slot per obstacle keeps the output in perception order whichever
+  // thread predicts the obstacle.
+  std::vector<PredictionObstacle> prediction_obstacles;
+  std::vector<Obstacle*> predictable_obstacles;
+  std::vector<PredictionObstacle*> predictable_outputs;
+  const std::vector<int> obstacle_ids =
+      obstacles_container->curr_frame_obstacle_ids();
+  prediction_obstacles.reserve(obstacle_ids.size());
+  for (const int id : obstacle_ids) {
     if (id < 0) {
       ADEBUG << "The obstacle has invalid id [" << id << "].";
       continue;
     }
 
-    PredictionObstacle prediction_obstacle;
+    prediction_obstacles.emplace_back();
+    PredictionObstacle* prediction_obstacle = &prediction_obstacles.back();
     Obstacle* obstacle = obstacles_container->GetObstacle(id);
 
-    PerceptionObstacle perception_obstacle =
+    const PerceptionObstacle& perception_obstacle =
         obstacles_container->GetPerceptionObstacle(id);
     // if obstacle == nullptr, that means obstacle is not predictable
     // Checkout the logic of non-predictable in obstacle.cc
     if (obstacle != nullptr) {
-      PredictObstacle(obstacle, &prediction_obstacle, adc_trajectory_container);
+      predictable_obstacles.push_back(obstacle);
+      predictable_outputs.push_back(prediction_obstacle);
     } else {  // obstacle == nullptr
-      prediction_obstacle.set_timestamp(perception_obstacle.timestamp());
-      prediction_obstacle.set_is_static(true);
+      prediction_obstacle->set_timestamp(perception_obstacle.timestamp());
+      prediction_obstacle->set_is_static(true);
     }
 
-    prediction_obstacle.set_predicted_period(
+    prediction_obstacle->set_predicted_period(
         FLAGS_prediction_trajectory_time_length);
-    prediction_obstacle.mutable_perception_obstacle()->CopyFrom(
+    prediction_obstacle->mutable_perception_obstacle()->CopyFrom(
         perception_obstacle);
+  }
+
+  const size_t num_obstacles = predictable_obstacles.size();
+  const size_t num_workers = NumWorkers(num_obstacles);
+  if (num_workers > 1) {
+    PrepareWorkerPredictors(num_workers);
+    // Contiguous shards, the first one runs on the calling thread.
+    const size_t shard_size = (num_obstacles + num_workers - 1) / num_workers;
+    std::vector<std::future<void>> results;
+    for (size_t i = shard_size, k = 0; i < num_obstacles;
+         i += shard_size, ++k) {
+      const size_t end = std::min(i + shard_size, num_obstacles);
+      results.push_back(cyber::Async(
+          &PredictorManager::PredictObstacles, this,
+          std::cref(predictable_obstacles), std::cref(predictable_outputs), i,
+          end, adc_trajectory_container, &worker_predictors_[k]));
+    }
+    PredictObstacles(predictable_obstacles, predictable_outputs, 0,
+                     std::min(shard_size, num_obstacles),
+                     adc_trajectory_container, &predictors_);
+    for (auto& result : results) {
+      result.get();
+    }
+  } else {
+    PredictObstacles(predictable_obstacles, predictable_outputs, 0,
+                     num_obstacles, adc_trajectory_container, &predictors_);
+  }
+
+  for (auto& prediction_obstacle : prediction_obstacles) {
+    prediction_obstacles_.add_prediction_obstacle()->Swap(
+        &prediction_obstacle);
+  }
+  ADEBUG << "Predicted " << num_obstacles << " obstacles with "
+         << num_workers << " threads in "
+         << (Clock::NowInSeconds() - start_time) * 1000.0 << " ms.";
+}
 
-    prediction_obstacles_.add_prediction_obstacle()->CopyFrom(
-        prediction_obstacle);
+void PredictorManager::PredictObstacles(
+    const std::vector<Obstacle*>& obstacles,
+    const std::vector<PredictionObstacle*>& prediction_obstacles,
+    const size_t begin, const size_t end,
+    ADCTrajectoryContainer* adc_trajectory_container,
+    PredictorMap* predictors) {
+  for (size_t i = begin; i < end; ++i) {
+    PredictObstacle(obstacles[i], prediction_obstacles[i],
+                    adc_trajectory_container, predictors);
+  }
+}
+
+size_t PredictorManager::NumWorkers(const size_t num_obstacles) const {
+  if (!FLAGS_enable_multi_thread_in_prediction ||
+      FLAGS_prediction_thread_num <= 1 || num_obstacles <= 1) {
+    return 1;
+  }
+  // Prediction results are written to a global buffer in offline modes.
+  if (FLAGS_prediction_offline_mode != 0) {
+    return 1;
+  }
+  // The base map is loaded lazily; it must be resolved on the calling thread
+  // so that map lookups from the workers are read-only.
+  if (!PredictionMap::Ready()) {
+    return 1;
+  }
+  return std::min(num_obstacles,
+                  static_cast<size_t>(FLAGS_prediction_thread_num));
+}
+
+void PredictorManager::PrepareWorkerPredictors(const size_t num_workers) {
+  while (worker_predictors_.size() + 1 < num_workers) {
+    PredictorMap predictors;
+    for (const auto& entry : predictors_) {
+      predictors[entry.first] = CreatePredictor(entry.first);
+    }
+    worker_predictors_.push_back(std::move(predictors));
   }
 }
 
 void PredictorManager::PredictObstacle(
     Obstacle* obstacle, PredictionObstacle* const prediction_obstacle,
     ADCTrajectoryContainer* adc_trajectory_container) {
+  PredictObstacle(obstacle, prediction_obstacle, adc_trajectory_container,
+                  &predictors_);
+}
+
+void PredictorManager::PredictObstacle(
+    Obstacle* obstacle, PredictionObstacle* const prediction_obstacle,
+    ADCTrajectoryContainer* adc_trajectory_container,
+    PredictorMap* predictors) {
+  auto get_predictor = [predictors](const ObstacleConf::PredictorType& type)
+      -> Predictor* {
+    auto it = predictors->find(type);
+    return it != predictors->end() ? it->second.get() : nullptr;
+  };
   CHECK_NOTNULL(obstacle);
   Predictor* predictor = nullptr;
   prediction_obstacle->set_timestamp(obstacle->timestamp());
   if (obstacle->ToIgnore()) {
     ADEBUG << "Ignore obstacle [" << obstacle->id() << "]";
-    predictor = GetPredictor(ObstacleConf::EMPTY_PREDICTOR);
+    predictor = get_predictor(ObstacleConf::EMPTY_PREDICTOR);
     prediction_obstacle->mutable_priority()->set_priority(
         ObstaclePriority::IGNORE);
   } else if (obstacle->IsStill()) {
     ADEBUG << "Still obstacle [" << obstacle->id() << "]";
-    predictor = GetPredictor(ObstacleConf::EMPTY_PREDICTOR);
+    predictor = get_predictor(ObstacleConf::EMPTY_PREDICTOR);
   } else {
     switch (obstacle->type()) {
       case PerceptionObstacle::VEHICLE: {
         if (obstacle->HasJunctionFeatureWithExits() &&
             !obstacle->IsCloseToJunctionExit()) {
-          predictor = GetPredictor(vehicle_in_junction_predictor_);
+          predictor = get_predictor(vehicle_in_junction_predictor_);
           CHECK_NOTNULL(predictor);
         } else if (obstacle->IsOnLane()) {
-          predictor = GetPredictor(vehicle_on_lane_predictor_);
+          predictor = get_predictor(vehicle_on_lane_predictor_);
           CHECK_NOTNULL(predictor);
         } else {
-          predictor = GetPredictor(vehicle_off_lane_predictor_);
+          predictor = get_predictor(vehicle_off_lane_predictor_);
           CHECK_NOTNULL(predictor);
         }
         break;
       }
       case PerceptionObstacle::PEDESTRIAN: {
-        predictor = GetPredictor(pedestrian_predictor_);
+        predictor = get_predictor(pedestrian_predictor_);
         break;
       }
       case PerceptionObstacle::BICYCLE: {
         if (obstacle->IsOnLane()) {
-          predictor = GetPredictor(cyclist_on_lane_predictor_);
+          predictor = get_predictor(cyclist_on_lane_predictor_);
           // TODO(kechxu) add a specific predictor in junction
         } else {
-          predictor = GetPredictor(cyclist_off_lane_predictor_);
+          predictor = get_predictor(cyclist_off_lane_predictor_);
         }
         break;
       }
       default: {
         if (obstacle->IsOnLane()) {
-          predictor = GetPredictor(default_on_lane_predictor_);
+          predictor = get_predictor(default_on_lane_predictor_);
         } else {
-          predictor = GetPredictor(default_off_lane_predictor_);
+          predictor = get_predictor(default_off_lane_predictor_);
         }
         break;
       }
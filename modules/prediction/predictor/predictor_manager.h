@@ -23,6 +23,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "modules/prediction/predictor/predictor.h"
 #include "modules/prediction/proto/prediction_conf.pb.h"
@@ -75,6 +76,50 @@ class PredictorManager {
   const PredictionObstacles& prediction_obstacles();
 
  private:
+  using PredictorMap =
+      std::map<ObstacleConf::PredictorType, std::unique_ptr<Predictor>>;
+
+  /**
+   * @brief Predict a single obstacle with a set of predictors
+   * @param A pointer to the specific obstacle
+   * @param A pointer to prediction_obstacle
+   * @param A pointer to adc_trajectory_container
+   * @param Predictors used by the calling thread
+   */
+  void PredictObstacle(Obstacle* obstacle,
+                       PredictionObstacle* const prediction_obstacle,
+                       ADCTrajectoryContainer* adc_trajectory_container,
+                       PredictorMap* predictors);
+
+  /**
+   * @brief Predict the obstacles in [begin, end)
+   * @param Obstacle pointers
+   * @param Prediction obstacles to fill, one per obstacle
+   * @param Index of the first obstacle
+   * @param Index past the last obstacle
+   * @param A pointer to adc_trajectory_container
+   * @param Predictors used by the calling thread
+   */
+  void PredictObstacles(
+      const std::vector<Obstacle*>& obstacles,
+      const std::vector<PredictionObstacle*>& prediction_obstacles,
+      const size_t begin, const size_t end,
+      ADCTrajectoryContainer* adc_trajectory_container,
+      PredictorMap* predictors);
+
+  /**
+   * @brief Number of threads to share the obstacles of a frame
+   * @param Number of obstacles to predict
+   * @return 1 if the obstacles have to be predicted on the calling thread
+   */
+  size_t NumWorkers(const size_t num_obstacles) const;
+
+  /**
+   * @brief Make sure every worker thread owns a set of predictors
+   * @param Number of threads including the calling one
+   */
+  void PrepareWorkerPredictors(const size_t num_workers);
+
   /**
    * @brief Register a predictor by type
    * @param Predictor type
@@ -95,7 +140,11 @@ class PredictorManager {
   void RegisterPredictors();
 
  private:
-  std::map<ObstacleConf::PredictorType, std::unique_ptr<Predictor>> predictors_;
+  PredictorMap predictors_;
+
+  // Predictors of the worker threads other than the calling one; predictors
+  // hold the trajectories of the obstacle being predicted.
+  std::vector<PredictorMap> worker_predictors_;
 
   ObstacleConf::PredictorType vehicle_on_lane_predictor_ =
       ObstacleConf::LANE_SEQUENCE_PREDICTOR;
@@ -16,7 +16,11 @@
 
 #include "modules/prediction/predictor/predictor_manager.h"
 
+#include <vector>
+
 #include "cyber/common/file.h"
+#include "modules/common/time/time.h"
+#include "modules/common/util/util.h"
 #include "modules/prediction/common/kml_map_based_test.h"
 #include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/container/container_manager.h"
@@ -27,6 +31,7 @@ namespace apollo {
 namespace prediction {
 
 using apollo::common::adapter::AdapterConfig;
+using apollo::common::time::Clock;
 
 class PredictorManagerTest : public KMLMapBasedTest {
  public:
@@ -68,5 +73,69 @@ TEST_F(PredictorManagerTest, General) {
   EXPECT_EQ(prediction_obstacles.prediction_obstacle_size(), 1);
 }
 
+TEST_F(PredictorManagerTest, MultiThread) {
+  const bool enable_trim_prediction_trajectory =
+      FLAGS_enable_trim_prediction_trajectory;
+  const bool enable_multi_thread_in_prediction =
+      FLAGS_enable_multi_thread_in_prediction;
+  const int prediction_thread_num = FLAGS_prediction_thread_num;
+  FLAGS_enable_trim_prediction_trajectory = false;
+  std::string file =
+      "modules/prediction/testdata/perception_vehicles_pedestrians.pb.txt";
+  apollo::perception::PerceptionObstacles perception_obstacles;
+  CHECK(cyber::common::GetProtoFromFile(file, &perception_obstacles));
+  std::string conf_file = "modules/prediction/testdata/adapter_conf.pb.txt";
+  CHECK(cyber::common::GetProtoFromFile(conf_file, &adapter_conf_));
+
+  // Runs the whole frame on fresh containers and returns the output.
+  auto run_frame = [this, &perception_obstacles](double* time_ms) {
+    ContainerManager::Instance()->Init(adapter_conf_);
+    EvaluatorManager::Instance()->Init(prediction_conf_);
+    PredictorManager::Instance()->Init(prediction_conf_);
+    auto obstacles_container =
+        ContainerManager::Instance()->GetContainer<ObstaclesContainer>(
+            AdapterConfig::PERCEPTION_OBSTACLES);
+    CHECK_NOTNULL(obstacles_container);
+    obstacles_container->Insert(perception_obstacles);
+    const double start_time = Clock::NowInSeconds();
+    EvaluatorManager::Instance()->Run();
+    PredictorManager::Instance()->Run();
+    *time_ms = (Clock::NowInSeconds() - start_time) * 1000.0;
+    return PredictorManager::Instance()->prediction_obstacles();
+  };
+
+  FLAGS_enable_multi_thread_in_prediction = false;
+  double serial_time_ms = 0.0;
+  const PredictionObstacles serial_obstacles = run_frame(&serial_time_ms);
+
+  FLAGS_enable_multi_thread_in_prediction = true;
+  FLAGS_prediction_thread_num = 3;
+  double multi_thread_time_ms = 0.0;
+  const PredictionObstacles multi_thread_obstacles =
+      run_frame(&multi_thread_time_ms);
+  AINFO << "Predicted " << serial_obstacles.prediction_obstacle_size()
+        << " obstacles serially in " << serial_time_ms << " ms, with "
+        << FLAGS_prediction_thread_num << " threads in "
+        << multi_thread_time_ms << " ms.";
+
+  FLAGS_enable_trim_prediction_trajectory = enable_trim_prediction_trajectory;
+  FLAGS_enable_multi_thread_in_prediction = enable_multi_thread_in_prediction;
+  FLAGS_prediction_thread_num = prediction_thread_num;
+
+  // Every obstacle gets the same trajectories as in the serial run, in the
+  // same order, whatever thread predicted it.
+  EXPECT_GT(serial_obstacles.prediction_obstacle_size(), 1);
+  ASSERT_EQ(serial_obstacles.prediction_obstacle_size(),
+            multi_thread_obstacles.prediction_obstacle_size());
+  for (int i = 0; i < serial_obstacles.prediction_obstacle_size(); ++i) {
+    const auto& expected = serial_obstacles.prediction_obstacle(i);
+    const auto& actual = multi_thread_obstacles.prediction_obstacle(i);
+    EXPECT_EQ(expected.perception_obstacle().id(),
+              actual.perception_obstacle().id());
+    EXPECT_TRUE(common::util::IsProtoEqual(expected, actual))
+        << "obstacle " << expected.perception_obstacle().id();
+  }
+}
+
 }  // namespace prediction
 }  // namespace apollo
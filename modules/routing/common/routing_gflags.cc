@@ -32,3 +32,21 @@ DEFINE_bool(enable_change_lane_in_result, true,
 
 DEFINE_uint32(routing_response_history_interval_ms, 1000,
               "ms, emit routing resposne for this time interval");
+
+DEFINE_bool(enable_routing_landmark_heuristic, true,
+            "use the landmark (ALT) heuristic in A* search when the landmark "
+            "table is available next to the routing map");
+
+DEFINE_bool(enable_routing_cache, true,
+            "reuse the routing result of a previous request with the same "
+            "waypoints and black list");
+
+DEFINE_uint32(routing_cache_size, 16, "the number of cached routing results");
+
+DEFINE_bool(enable_routing_warm_start, false,
+            "reuse the last routing result when only the start point moves "
+            "along the last route, or a lane off the last route is newly "
+            "blacklisted");
+
+DEFINE_int32(routing_landmark_num, 16,
+             "number of landmarks generated by topo_creator, 0 to disable");
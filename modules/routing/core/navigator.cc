@@ -16,6 +16,12 @@
 
 #include "modules/routing/core/navigator.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <unordered_set>
+
 #include "cyber/common/file.h"
 #include "modules/routing/common/routing_gflags.h"
 #include "modules/routing/graph/sub_topo_graph.h"
@@ -81,6 +87,36 @@ void SetErrorCode(const common::ErrorCode& error_code_id,
   }
 }
 
+bool IsSameWaypoint(const LaneWaypoint& waypoint,
+                    const LaneWaypoint& other_waypoint) {
+  constexpr double kWaypointSEpsilon = 1e-3;
+  return waypoint.id() == other_waypoint.id() &&
+         std::fabs(waypoint.s() - other_waypoint.s()) < kWaypointSEpsilon;
+}
+
+// Whether all the black lanes and roads of the request are still black in the
+// new request.
+bool IsBlackListIncluded(const RoutingRequest& request,
+                         const RoutingRequest& new_request) {
+  std::unordered_set<std::string> black_lanes;
+  for (const auto& lane : new_request.blacklisted_lane()) {
+    black_lanes.insert(lane.ShortDebugString());
+  }
+  for (const auto& lane : request.blacklisted_lane()) {
+    if (black_lanes.count(lane.ShortDebugString()) == 0) {
+      return false;
+    }
+  }
+  const auto& new_roads = new_request.blacklisted_road();
+  for (const auto& road : request.blacklisted_road()) {
+    if (std::find(new_roads.begin(), new_roads.end(), road) ==
+        new_roads.end()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void PrintDebugData(const std::vector<NodeWithRange>& nodes) {
   AINFO << "Route lane id\tis virtual\tstart s\tend s";
   for (const auto& node : nodes) {
@@ -92,7 +128,8 @@ void PrintDebugData(const std::vector<NodeWithRange>& nodes) {
 
 }  // namespace
 
-Navigator::Navigator(const std::string& topo_file_path) {
+Navigator::Navigator(const std::string& topo_file_path)
+    : route_cache_(FLAGS_routing_cache_size) {
   Graph graph;
   if (!cyber::common::GetProtoFromFile(topo_file_path, &graph)) {
     AERROR << "Failed to read topology graph from " << topo_file_path;
@@ -105,6 +142,23 @@ Navigator::Navigator(const std::string& topo_file_path) {
           << topo_file_path;
     return;
   }
+  if (FLAGS_enable_routing_landmark_heuristic) {
+    const auto landmark_file_path =
+        TopoLandmark::GetLandmarkFilePath(topo_file_path);
+    LandmarkTable landmark_table;
+    if (cyber::common::PathExists(landmark_file_path) &&
+        cyber::common::GetProtoFromFile(landmark_file_path, &landmark_table)) {
+      landmark_.reset(new TopoLandmark());
+      if (!landmark_->Load(landmark_table, graph_.get())) {
+        AWARN << "Failed to load landmarks from " << landmark_file_path
+              << ", fall back to A* without landmarks.";
+        landmark_.reset();
+      }
+    } else {
+      AINFO << "No landmark file found at " << landmark_file_path
+            << ", use A* without landmarks.";
+    }
+  }
   black_list_generator_.reset(new BlackListRangeGenerator);
   result_generator_.reset(new ResultGenerator);
   is_ready_ = true;
@@ -115,6 +169,10 @@ Navigator::~Navigator() {}
 
 bool Navigator::IsReady() const { return is_ready_; }
 
+const NavigatorStatistics& Navigator::Statistics() const {
+  return statistics_;
+}
+
 void Navigator::Clear() { topo_range_manager_.Clear(); }
 
 bool Navigator::Init(const RoutingRequest& request, const TopoGraph* graph,
@@ -152,9 +210,13 @@ bool Navigator::MergeRoute(
 bool Navigator::SearchRouteByStrategy(
     const TopoGraph* graph, const std::vector<const TopoNode*>& way_nodes,
     const std::vector<double>& way_s,
-    std::vector<NodeWithRange>* const result_nodes) const {
-  std::unique_ptr<Strategy> strategy_ptr;
-  strategy_ptr.reset(new AStarStrategy(FLAGS_enable_change_lane_in_result));
+    std::vector<NodeWithRange>* const result_nodes) {
+  // the strategy is kept across requests so that its per node arrays are
+  // only allocated once
+  if (strategy_ == nullptr) {
+    strategy_.reset(new AStarStrategy(FLAGS_enable_change_lane_in_result,
+                                      landmark_.get()));
+  }
 
   result_nodes->clear();
   std::vector<NodeWithRange> node_vec;
@@ -183,8 +245,8 @@ bool Navigator::SearchRouteByStrategy(
     }
 
     std::vector<NodeWithRange> cur_result_nodes;
-    if (!strategy_ptr->Search(graph, &sub_graph, start, end,
-                              &cur_result_nodes)) {
+    if (!strategy_->Search(graph, &sub_graph, start, end,
+                           &cur_result_nodes)) {
       AERROR << "Failed to search route with waypoint from " << start->LaneId()
              << " to " << end->LaneId();
       return false;
@@ -201,8 +263,139 @@ bool Navigator::SearchRouteByStrategy(
   return true;
 }
 
+bool Navigator::ReuseLastRoute(
+    const RoutingRequest& request,
+    const std::vector<const TopoNode*>& way_nodes,
+    const std::vector<double>& way_s,
+    std::vector<NodeWithRange>* const result_nodes) const {
+  if (last_result_nodes_.empty() || way_nodes.size() < 2) {
+    return false;
+  }
+  // the waypoints after the start point must be the same as the tail of the
+  // last request, the passed waypoints may have been dropped.
+  const int waypoint_num = request.waypoint_size();
+  const int last_waypoint_num = last_request_.waypoint_size();
+  if (waypoint_num > last_waypoint_num) {
+    return false;
+  }
+  for (int i = 1; i < waypoint_num; ++i) {
+    if (!IsSameWaypoint(
+            request.waypoint(i),
+            last_request_.waypoint(last_waypoint_num - waypoint_num + i))) {
+      return false;
+    }
+  }
+  // a released black lane may lead to a better route, so search again.
+  if (!IsBlackListIncluded(last_request_, request)) {
+    return false;
+  }
+
+  // the start must be on the first remaining pass of the route over its
+  // lane. A looping route may pass the lane again later, and matching that
+  // pass would skip the loop.
+  const auto* start_node = way_nodes.front();
+  const double start_s = way_s.front();
+  auto start_iter = std::find_if(
+      last_result_nodes_.begin(), last_result_nodes_.end(),
+      [start_node](const NodeWithRange& node) {
+        return node.GetTopoNode() == start_node;
+      });
+  if (start_iter == last_result_nodes_.end() ||
+      start_s < start_iter->StartS() || start_s > start_iter->EndS()) {
+    return false;
+  }
+
+  // the start may have moved too close to the first lane change
+  const auto next_iter = std::next(start_iter);
+  if (next_iter != last_result_nodes_.end()) {
+    const auto* edge =
+        start_iter->GetTopoNode()->GetOutEdgeTo(next_iter->GetTopoNode());
+    if (edge == nullptr ||
+        (edge->Type() != TopoEdgeType::TET_FORWARD &&
+         start_iter->EndS() - start_s < FLAGS_min_length_for_lane_change)) {
+      ADEBUG << "Too short to change lane from " << start_iter->LaneId()
+             << " at s " << start_s;
+      return false;
+    }
+  }
+
+  // the remaining route must not pass any black range
+  for (auto iter = start_iter; iter != last_result_nodes_.end(); ++iter) {
+    const double start = iter == start_iter ? start_s : iter->StartS();
+    const auto* black_ranges = topo_range_manager_.Find(iter->GetTopoNode());
+    if (black_ranges == nullptr) {
+      continue;
+    }
+    for (const auto& range : *black_ranges) {
+      if (range.StartS() <= iter->EndS() && range.EndS() >= start) {
+        ADEBUG << "Last route is blocked by black lane " << iter->LaneId();
+        return false;
+      }
+    }
+  }
+  result_nodes->assign(start_iter, last_result_nodes_.end());
+  result_nodes->front().SetStartS(start_s);
+  return true;
+}
+
+bool Navigator::SearchRouteWithCache(
+    const RoutingRequest& request,
+    const std::vector<const TopoNode*>& way_nodes,
+    const std::vector<double>& way_s,
+    std::vector<NodeWithRange>* const result_nodes) {
+  if (FLAGS_enable_routing_cache &&
+      route_cache_.Get(RouteCache::GetKey(request), result_nodes)) {
+    ++statistics_.cache_hit_count;
+    AINFO << "Use cached routing result.";
+    return true;
+  }
+  if (FLAGS_enable_routing_cache) {
+    ++statistics_.cache_miss_count;
+  }
+  if (FLAGS_enable_routing_warm_start &&
+      ReuseLastRoute(request, way_nodes, way_s, result_nodes)) {
+    ++statistics_.warm_start_count;
+    AINFO << "Reuse last routing result from the new start point.";
+    return true;
+  }
+  ++statistics_.search_count;
+  return SearchRouteByStrategy(graph_.get(), way_nodes, way_s, result_nodes);
+}
+
+void Navigator::UpdateStatistics(const double latency_ms,
+                                 const bool success) {
+  ++statistics_.request_count;
+  if (!success) {
+    ++statistics_.failure_count;
+  }
+  statistics_.last_latency_ms = latency_ms;
+  statistics_.max_latency_ms = std::max(statistics_.max_latency_ms, latency_ms);
+  statistics_.total_latency_ms += latency_ms;
+}
+
 bool Navigator::SearchRoute(const RoutingRequest& request,
                             RoutingResponse* const response) {
+  const auto start_time = std::chrono::steady_clock::now();
+  const bool success = SearchRouteWithoutStatistics(request, response);
+  const std::chrono::duration<double, std::milli> latency =
+      std::chrono::steady_clock::now() - start_time;
+  // failed requests are counted too, a slow failure is still a slow request
+  UpdateStatistics(latency.count(), success);
+  auto* statistics = response->mutable_statistics();
+  statistics->set_latency_ms(statistics_.last_latency_ms);
+  statistics->set_max_latency_ms(statistics_.max_latency_ms);
+  statistics->set_total_latency_ms(statistics_.total_latency_ms);
+  statistics->set_request_count(statistics_.request_count);
+  statistics->set_failure_count(statistics_.failure_count);
+  statistics->set_cache_hit_count(statistics_.cache_hit_count);
+  statistics->set_cache_miss_count(statistics_.cache_miss_count);
+  statistics->set_warm_start_count(statistics_.warm_start_count);
+  statistics->set_search_count(statistics_.search_count);
+  return success;
+}
+
+bool Navigator::SearchRouteWithoutStatistics(const RoutingRequest& request,
+                                             RoutingResponse* const response) {
   if (!ShowRequestInfo(request, graph_.get())) {
     SetErrorCode(ErrorCode::ROUTING_ERROR_REQUEST,
                  "Error encountered when reading request point!",
@@ -224,7 +417,7 @@ bool Navigator::SearchRoute(const RoutingRequest& request,
   }
 
   std::vector<NodeWithRange> result_nodes;
-  if (!SearchRouteByStrategy(graph_.get(), way_nodes, way_s, &result_nodes)) {
+  if (!SearchRouteWithCache(request, way_nodes, way_s, &result_nodes)) {
     SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE,
                  "Failed to find route with request!",
                  response->mutable_status());
@@ -248,6 +441,12 @@ bool Navigator::SearchRoute(const RoutingRequest& request,
   }
   SetErrorCode(ErrorCode::OK, "Success!", response->mutable_status());
 
+  if (FLAGS_enable_routing_cache) {
+    route_cache_.Put(RouteCache::GetKey(request), result_nodes);
+  }
+  last_request_ = request;
+  last_result_nodes_ = result_nodes;
+
   PrintDebugData(result_nodes);
   return true;
 }
@@ -22,10 +22,25 @@
 
 #include "modules/routing/core/black_list_range_generator.h"
 #include "modules/routing/core/result_generator.h"
+#include "modules/routing/core/route_cache.h"
+#include "modules/routing/graph/topo_landmark.h"
+#include "modules/routing/strategy/strategy.h"
 
 namespace apollo {
 namespace routing {
 
+struct NavigatorStatistics {
+  uint64_t request_count = 0;
+  uint64_t failure_count = 0;
+  uint64_t cache_hit_count = 0;
+  uint64_t cache_miss_count = 0;
+  uint64_t warm_start_count = 0;
+  uint64_t search_count = 0;
+  double last_latency_ms = 0.0;
+  double max_latency_ms = 0.0;
+  double total_latency_ms = 0.0;
+};
+
 class Navigator {
  public:
   explicit Navigator(const std::string& topo_file_path);
@@ -36,6 +51,8 @@ class Navigator {
   bool SearchRoute(const RoutingRequest& request,
                    RoutingResponse* const response);
 
+  const NavigatorStatistics& Statistics() const;
+
  private:
   bool Init(const RoutingRequest& request, const TopoGraph* graph,
             std::vector<const TopoNode*>* const way_nodes,
@@ -46,19 +63,45 @@ class Navigator {
   bool SearchRouteByStrategy(
       const TopoGraph* graph, const std::vector<const TopoNode*>& way_nodes,
       const std::vector<double>& way_s,
-      std::vector<NodeWithRange>* const result_nodes) const;
+      std::vector<NodeWithRange>* const result_nodes);
 
   bool MergeRoute(const std::vector<NodeWithRange>& node_vec,
                   std::vector<NodeWithRange>* const result_node_vec) const;
 
+  bool SearchRouteWithCache(const RoutingRequest& request,
+                            const std::vector<const TopoNode*>& way_nodes,
+                            const std::vector<double>& way_s,
+                            std::vector<NodeWithRange>* const result_nodes);
+
+  // Reuse the last route if the start point has moved along it, the other
+  // waypoints are unchanged and the route passes no newly blacklisted range.
+  // The start must be on the first remaining pass over its lane, and still
+  // leave enough length for a lane change right after it.
+  bool ReuseLastRoute(const RoutingRequest& request,
+                      const std::vector<const TopoNode*>& way_nodes,
+                      const std::vector<double>& way_s,
+                      std::vector<NodeWithRange>* const result_nodes) const;
+
+  bool SearchRouteWithoutStatistics(const RoutingRequest& request,
+                                    RoutingResponse* const response);
+
+  void UpdateStatistics(const double latency_ms, const bool success);
+
  private:
   bool is_ready_ = false;
   std::unique_ptr<TopoGraph> graph_;
+  std::unique_ptr<TopoLandmark> landmark_;
+  std::unique_ptr<Strategy> strategy_;
 
   TopoRangeManager topo_range_manager_;
 
   std::unique_ptr<BlackListRangeGenerator> black_list_generator_;
   std::unique_ptr<ResultGenerator> result_generator_;
+
+  RouteCache route_cache_;
+  RoutingRequest last_request_;
+  std::vector<NodeWithRange> last_result_nodes_;
+  NavigatorStatistics statistics_;
 };
 
 }  // namespace routing
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/routing/core/route_cache.h"
+
+#include <iomanip>
+#include <sstream>
+
+namespace apollo {
+namespace routing {
+
+RouteCache::RouteCache(const size_t capacity) : capacity_(capacity) {}
+
+std::string RouteCache::GetKey(const RoutingRequest& request) {
+  std::ostringstream key;
+  key << std::fixed << std::setprecision(3);
+  for (const auto& waypoint : request.waypoint()) {
+    key << "w:" << waypoint.id() << ',' << waypoint.s() << ';';
+  }
+  for (const auto& lane : request.blacklisted_lane()) {
+    key << "bl:" << lane.id() << ',' << lane.start_s() << ',' << lane.end_s()
+        << ';';
+  }
+  for (const auto& road : request.blacklisted_road()) {
+    key << "br:" << road << ';';
+  }
+  return key.str();
+}
+
+bool RouteCache::Get(const std::string& key,
+                     std::vector<NodeWithRange>* const result_nodes) {
+  const auto iter = cache_map_.find(key);
+  if (iter == cache_map_.end()) {
+    ++miss_count_;
+    return false;
+  }
+  ++hit_count_;
+  cache_list_.splice(cache_list_.begin(), cache_list_, iter->second);
+  *result_nodes = iter->second->second;
+  return true;
+}
+
+void RouteCache::Put(const std::string& key,
+                     const std::vector<NodeWithRange>& result_nodes) {
+  if (capacity_ == 0) {
+    return;
+  }
+  const auto iter = cache_map_.find(key);
+  if (iter != cache_map_.end()) {
+    iter->second->second = result_nodes;
+    cache_list_.splice(cache_list_.begin(), cache_list_, iter->second);
+    return;
+  }
+  cache_list_.emplace_front(key, result_nodes);
+  cache_map_[key] = cache_list_.begin();
+  if (cache_list_.size() > capacity_) {
+    cache_map_.erase(cache_list_.back().first);
+    cache_list_.pop_back();
+  }
+}
+
+void RouteCache::Clear() {
+  cache_list_.clear();
+  cache_map_.clear();
+}
+
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,66 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "modules/routing/graph/node_with_range.h"
+#include "modules/routing/proto/routing.pb.h"
+
+namespace apollo {
+namespace routing {
+
+// A least recently used cache of routing results keyed by the waypoints and
+// the black list of a routing request.
+class RouteCache {
+ public:
+  explicit RouteCache(const size_t capacity);
+  ~RouteCache() = default;
+
+  static std::string GetKey(const RoutingRequest& request);
+
+  bool Get(const std::string& key,
+           std::vector<NodeWithRange>* const result_nodes);
+
+  void Put(const std::string& key,
+           const std::vector<NodeWithRange>& result_nodes);
+
+  void Clear();
+
+  size_t Size() const { return cache_list_.size(); }
+  uint64_t HitCount() const { return hit_count_; }
+  uint64_t MissCount() const { return miss_count_; }
+
+ private:
+  using CacheItem = std::pair<std::string, std::vector<NodeWithRange>>;
+
+  size_t capacity_ = 0;
+  // the most recently used item is at the front
+  std::list<CacheItem> cache_list_;
+  std::unordered_map<std::string, std::list<CacheItem>::iterator> cache_map_;
+  uint64_t hit_count_ = 0;
+  uint64_t miss_count_ = 0;
+};
+
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/routing/core/route_cache.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "modules/routing/graph/topo_graph.h"
+#include "modules/routing/graph/topo_test_utils.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+RoutingRequest GetRequest(const double start_s) {
+  RoutingRequest request;
+  auto* start = request.add_waypoint();
+  start->set_id(TEST_L1);
+  start->set_s(start_s);
+  auto* end = request.add_waypoint();
+  end->set_id(TEST_L5);
+  end->set_s(TEST_END_S);
+  return request;
+}
+
+}  // namespace
+
+TEST(RouteCacheTestSuit, request_key) {
+  const auto request = GetRequest(10.0);
+  EXPECT_EQ(RouteCache::GetKey(request), RouteCache::GetKey(GetRequest(10.0)));
+  EXPECT_NE(RouteCache::GetKey(request), RouteCache::GetKey(GetRequest(20.0)));
+
+  auto black_request = request;
+  auto* black_lane = black_request.add_blacklisted_lane();
+  black_lane->set_id(TEST_L3);
+  black_lane->set_start_s(TEST_START_S);
+  black_lane->set_end_s(TEST_END_S);
+  EXPECT_NE(RouteCache::GetKey(request), RouteCache::GetKey(black_request));
+
+  auto black_road_request = request;
+  black_road_request.add_blacklisted_road(TEST_R2);
+  EXPECT_NE(RouteCache::GetKey(request),
+            RouteCache::GetKey(black_road_request));
+}
+
+TEST(RouteCacheTestSuit, least_recently_used) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  const auto* node_1 = topo_graph.GetNode(TEST_L1);
+  const auto* node_3 = topo_graph.GetNode(TEST_L3);
+  ASSERT_TRUE(node_1 != nullptr);
+  ASSERT_TRUE(node_3 != nullptr);
+
+  RouteCache cache(2);
+  std::vector<NodeWithRange> result_nodes;
+  EXPECT_FALSE(cache.Get("a", &result_nodes));
+  EXPECT_EQ(1, cache.MissCount());
+
+  cache.Put("a", {NodeWithRange(node_1, TEST_START_S, TEST_END_S)});
+  cache.Put("b", {NodeWithRange(node_3, TEST_START_S, TEST_END_S)});
+  ASSERT_TRUE(cache.Get("a", &result_nodes));
+  ASSERT_EQ(1, result_nodes.size());
+  EXPECT_EQ(node_1, result_nodes.front().GetTopoNode());
+  EXPECT_EQ(1, cache.HitCount());
+
+  // "b" is the least recently used one and is evicted.
+  cache.Put("c", {NodeWithRange(node_3, TEST_START_S, TEST_END_S)});
+  EXPECT_EQ(2, cache.Size());
+  EXPECT_FALSE(cache.Get("b", &result_nodes));
+  EXPECT_TRUE(cache.Get("a", &result_nodes));
+  EXPECT_TRUE(cache.Get("c", &result_nodes));
+
+  cache.Clear();
+  EXPECT_EQ(0, cache.Size());
+  EXPECT_FALSE(cache.Get("a", &result_nodes));
+}
+
+}  // namespace routing
+}  // namespace apollo
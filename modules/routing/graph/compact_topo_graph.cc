@@ -0,0 +1,71 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/routing/graph/compact_topo_graph.h"
+
+#include <algorithm>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+CompactTopoEdge ToCompactEdge(const TopoEdge* edge) {
+  CompactTopoEdge compact_edge;
+  compact_edge.to_index = edge->ToNode()->Index();
+  compact_edge.type = edge->Type();
+  compact_edge.topo_edge = edge;
+  return compact_edge;
+}
+
+}  // namespace
+
+void CompactTopoGraph::Clear() {
+  out_offsets_.clear();
+  out_edges_.clear();
+}
+
+bool CompactTopoGraph::Build(const std::vector<const TopoNode*>& nodes) {
+  Clear();
+  const int node_num = static_cast<int>(nodes.size());
+  out_offsets_.reserve(node_num + 1);
+  out_offsets_.push_back(0);
+  for (int i = 0; i < node_num; ++i) {
+    const auto* node = nodes[i];
+    if (node == nullptr || node->Index() != i) {
+      AERROR << "Invalid node index " << i << " for compact topo graph.";
+      Clear();
+      return false;
+    }
+    const size_t out_begin = out_edges_.size();
+    for (const auto* edge : node->OutToAllEdge()) {
+      out_edges_.push_back(ToCompactEdge(edge));
+    }
+    // keep a deterministic order regardless of the hash set order
+    std::sort(out_edges_.begin() + out_begin, out_edges_.end(),
+              [](const CompactTopoEdge& lhs, const CompactTopoEdge& rhs) {
+                return lhs.to_index < rhs.to_index;
+              });
+    out_offsets_.push_back(static_cast<int>(out_edges_.size()));
+  }
+  return true;
+}
+
+}  // namespace routing
+}  // namespace apollo
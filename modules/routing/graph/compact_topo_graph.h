@@ -0,0 +1,66 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#pragma once
+
+#include <vector>
+
+#include "modules/routing/graph/topo_node.h"
+
+namespace apollo {
+namespace routing {
+
+struct CompactTopoEdge {
+  int to_index = -1;
+  TopoEdgeType type = TET_FORWARD;
+  const TopoEdge* topo_edge = nullptr;
+};
+
+// Compressed sparse row (CSR) representation of the out edges of a topo
+// graph. Nodes are referred by their integer index, and the out edges of all
+// the nodes are stored in one flat array, sorted by node index. It is an
+// index over the TopoNode/TopoEdge storage, not a replacement of it.
+class CompactTopoGraph {
+ public:
+  CompactTopoGraph() = default;
+  ~CompactTopoGraph() = default;
+
+  // nodes[i]->Index() must be i.
+  bool Build(const std::vector<const TopoNode*>& nodes);
+  void Clear();
+
+  int NodeNum() const {
+    return out_offsets_.empty() ? 0
+                                : static_cast<int>(out_offsets_.size()) - 1;
+  }
+  int EdgeNum() const { return static_cast<int>(out_edges_.size()); }
+
+  const CompactTopoEdge* OutEdgeBegin(const int index) const {
+    return out_edges_.data() + out_offsets_[index];
+  }
+  const CompactTopoEdge* OutEdgeEnd(const int index) const {
+    return out_edges_.data() + out_offsets_[index + 1];
+  }
+
+ private:
+  // out edges of node i are in [out_offsets_[i], out_offsets_[i + 1])
+  std::vector<int> out_offsets_;
+  std::vector<CompactTopoEdge> out_edges_;
+};
+
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/routing/graph/compact_topo_graph.h"
+
+#include "gtest/gtest.h"
+#include "modules/routing/graph/sub_topo_graph.h"
+#include "modules/routing/graph/topo_graph.h"
+#include "modules/routing/graph/topo_test_utils.h"
+
+namespace apollo {
+namespace routing {
+
+TEST(CompactTopoGraphTestSuit, build_from_topo_graph) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+
+  const auto& compact_graph = topo_graph.CompactGraph();
+  ASSERT_EQ(graph.node_size(), compact_graph.NodeNum());
+  ASSERT_EQ(graph.edge_size(), compact_graph.EdgeNum());
+
+  for (const auto& pb_node : graph.node()) {
+    const auto* node = topo_graph.GetNode(pb_node.lane_id());
+    ASSERT_TRUE(node != nullptr);
+    const int i = node->Index();
+    ASSERT_GE(i, 0);
+    ASSERT_LT(i, compact_graph.NodeNum());
+    EXPECT_EQ(node->OutToAllEdge().size(),
+              compact_graph.OutEdgeEnd(i) - compact_graph.OutEdgeBegin(i));
+    for (const auto* edge = compact_graph.OutEdgeBegin(i);
+         edge != compact_graph.OutEdgeEnd(i); ++edge) {
+      EXPECT_EQ(node, edge->topo_edge->FromNode());
+      EXPECT_EQ(edge->topo_edge->ToNode()->Index(), edge->to_index);
+      EXPECT_EQ(edge->topo_edge->Type(), edge->type);
+    }
+  }
+
+  const auto* node_1 = topo_graph.GetNode(TEST_L1);
+  const auto* node_3 = topo_graph.GetNode(TEST_L3);
+  ASSERT_TRUE(node_1 != nullptr);
+  ASSERT_TRUE(node_3 != nullptr);
+  bool found_forward_edge = false;
+  for (const auto* edge = compact_graph.OutEdgeBegin(node_1->Index());
+       edge != compact_graph.OutEdgeEnd(node_1->Index()); ++edge) {
+    if (edge->to_index == node_3->Index()) {
+      found_forward_edge = true;
+      EXPECT_EQ(TET_FORWARD, edge->type);
+    }
+  }
+  EXPECT_TRUE(found_forward_edge);
+}
+
+TEST(CompactTopoGraphTestSuit, sub_node_index) {
+  Graph graph;
+  GetGraph2ForTest(&graph);
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+
+  const TopoNode* node_2 = topo_graph.GetNode(TEST_L2);
+  ASSERT_TRUE(node_2 != nullptr);
+  std::unordered_map<const TopoNode*, std::vector<NodeSRange>> range_list;
+  range_list[node_2].emplace_back(20.0, 50.0);
+  SubTopoGraph sub_topo_graph(range_list);
+  ASSERT_EQ(2, sub_topo_graph.SubNodeNum());
+
+  const auto* sub_node_1 = sub_topo_graph.GetSubNodeWithS(node_2, 10.0);
+  const auto* sub_node_2 = sub_topo_graph.GetSubNodeWithS(node_2, 80.0);
+  ASSERT_TRUE(sub_node_1 != nullptr);
+  ASSERT_TRUE(sub_node_2 != nullptr);
+  EXPECT_TRUE(sub_node_1->IsSubNode());
+  // sub nodes share the pb node of their origin node instead of copying it
+  EXPECT_EQ(&node_2->PbNode(), &sub_node_1->PbNode());
+  EXPECT_NE(sub_node_1->Index(), sub_node_2->Index());
+  EXPECT_GE(sub_node_1->Index(), 0);
+  EXPECT_LT(sub_node_1->Index(), sub_topo_graph.SubNodeNum());
+  EXPECT_GE(sub_node_2->Index(), 0);
+  EXPECT_LT(sub_node_2->Index(), sub_topo_graph.SubNodeNum());
+}
+
+}  // namespace routing
+}  // namespace apollo
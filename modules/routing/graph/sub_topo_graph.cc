@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <utility>
 
+#include "cyber/common/log.h"
 #include "modules/routing/graph/range_utils.h"
 
 namespace apollo {
@@ -116,7 +117,7 @@ void SubTopoGraph::GetSubInEdgesIntoSubGraph(
     std::unordered_set<const TopoEdge*>* const sub_edges) const {
   const auto* from_node = edge->FromNode();
   const auto* to_node = edge->ToNode();
-  std::unordered_set<TopoNode*> sub_nodes;
+  std::vector<TopoNode*> sub_nodes;
   if (from_node->IsSubNode() || to_node->IsSubNode() ||
       !GetSubNodes(to_node, &sub_nodes)) {
     sub_edges->insert(edge);
@@ -136,7 +137,7 @@ void SubTopoGraph::GetSubOutEdgesIntoSubGraph(
     std::unordered_set<const TopoEdge*>* const sub_edges) const {
   const auto* from_node = edge->FromNode();
   const auto* to_node = edge->ToNode();
-  std::unordered_set<TopoNode*> sub_nodes;
+  std::vector<TopoNode*> sub_nodes;
   if (from_node->IsSubNode() || to_node->IsSubNode() ||
       !GetSubNodes(from_node, &sub_nodes)) {
     sub_edges->insert(edge);
@@ -153,11 +154,11 @@ void SubTopoGraph::GetSubOutEdgesIntoSubGraph(
 
 const TopoNode* SubTopoGraph::GetSubNodeWithS(const TopoNode* topo_node,
                                               double s) const {
-  const auto& map_iter = sub_node_range_sorted_map_.find(topo_node);
-  if (map_iter == sub_node_range_sorted_map_.end()) {
+  const int slot = GetSubNodeSlot(topo_node);
+  if (slot < 0) {
     return topo_node;
   }
-  const auto& sorted_vec = map_iter->second;
+  const auto& sorted_vec = sub_node_ranges_[slot];
   // sorted vec can't be empty!
   int index = BinarySearchForStartS(sorted_vec, s);
   if (index < 0) {
@@ -166,12 +167,25 @@ const TopoNode* SubTopoGraph::GetSubNodeWithS(const TopoNode* topo_node,
   return sorted_vec[index].GetTopoNode();
 }
 
+int SubTopoGraph::SubNodeNum() const {
+  return static_cast<int>(topo_nodes_.size());
+}
+
 void SubTopoGraph::InitSubNodeByValidRange(
     const TopoNode* topo_node, const std::vector<NodeSRange>& valid_range) {
   // Attention: no matter topo node has valid_range or not,
   // create map value first;
-  auto& sub_node_vec = sub_node_range_sorted_map_[topo_node];
-  auto& sub_node_set = sub_node_map_[topo_node];
+  const int index = topo_node->Index();
+  CHECK_GE(index, 0) << "Topo node " << topo_node->LaneId()
+                     << " is not indexed";
+  if (index >= static_cast<int>(sub_node_slots_.size())) {
+    sub_node_slots_.resize(index + 1, -1);
+  }
+  if (sub_node_slots_[index] < 0) {
+    sub_node_slots_[index] = static_cast<int>(sub_node_ranges_.size());
+    sub_node_ranges_.emplace_back();
+  }
+  auto& sub_node_vec = sub_node_ranges_[sub_node_slots_[index]];
 
   std::vector<TopoNode*> sub_node_sorted_vec;
   for (const auto& range : valid_range) {
@@ -180,8 +194,8 @@ void SubTopoGraph::InitSubNodeByValidRange(
     }
     std::shared_ptr<TopoNode> sub_topo_node_ptr;
     sub_topo_node_ptr.reset(new TopoNode(topo_node, range));
+    sub_topo_node_ptr->SetIndex(static_cast<int>(topo_nodes_.size()));
     sub_node_vec.emplace_back(sub_topo_node_ptr.get(), range);
-    sub_node_set.insert(sub_topo_node_ptr.get());
     sub_node_sorted_vec.push_back(sub_topo_node_ptr.get());
     topo_nodes_.push_back(std::move(sub_topo_node_ptr));
   }
@@ -205,7 +219,7 @@ void SubTopoGraph::InitSubNodeByValidRange(
 }
 
 void SubTopoGraph::InitSubEdge(const TopoNode* topo_node) {
-  std::unordered_set<TopoNode*> sub_nodes;
+  std::vector<TopoNode*> sub_nodes;
   if (!GetSubNodes(topo_node, &sub_nodes)) {
     return;
   }
@@ -219,7 +233,7 @@ void SubTopoGraph::InitSubEdge(const TopoNode* topo_node) {
 void SubTopoGraph::InitInSubNodeSubEdge(
     TopoNode* const sub_node,
     const std::unordered_set<const TopoEdge*> origin_edge) {
-  std::unordered_set<TopoNode*> other_sub_nodes;
+  std::vector<TopoNode*> other_sub_nodes;
   for (const auto* in_edge : origin_edge) {
     if (GetSubNodes(in_edge->FromNode(), &other_sub_nodes)) {
       for (auto* sub_from_node : other_sub_nodes) {
@@ -246,7 +260,7 @@ void SubTopoGraph::InitInSubNodeSubEdge(
 void SubTopoGraph::InitOutSubNodeSubEdge(
     TopoNode* const sub_node,
     const std::unordered_set<const TopoEdge*> origin_edge) {
-  std::unordered_set<TopoNode*> other_sub_nodes;
+  std::vector<TopoNode*> other_sub_nodes;
   for (const auto* out_edge : origin_edge) {
     if (GetSubNodes(out_edge->ToNode(), &other_sub_nodes)) {
       for (auto* sub_to_node : other_sub_nodes) {
@@ -270,20 +284,33 @@ void SubTopoGraph::InitOutSubNodeSubEdge(
   }
 }
 
-bool SubTopoGraph::GetSubNodes(
-    const TopoNode* node,
-    std::unordered_set<TopoNode*>* const sub_nodes) const {
-  const auto& iter = sub_node_map_.find(node);
-  if (iter == sub_node_map_.end()) {
+int SubTopoGraph::GetSubNodeSlot(const TopoNode* node) const {
+  if (node->IsSubNode()) {
+    return -1;
+  }
+  const int index = node->Index();
+  if (index < 0 || index >= static_cast<int>(sub_node_slots_.size())) {
+    return -1;
+  }
+  return sub_node_slots_[index];
+}
+
+bool SubTopoGraph::GetSubNodes(const TopoNode* node,
+                               std::vector<TopoNode*>* const sub_nodes) const {
+  const int slot = GetSubNodeSlot(node);
+  if (slot < 0) {
     return false;
   }
   sub_nodes->clear();
-  sub_nodes->insert(iter->second.begin(), iter->second.end());
+  for (const auto& sub_node : sub_node_ranges_[slot]) {
+    // sub nodes are indexed by their position in topo_nodes_
+    sub_nodes->push_back(topo_nodes_[sub_node.GetTopoNode()->Index()].get());
+  }
   return true;
 }
 
 void SubTopoGraph::AddPotentialEdge(const TopoNode* topo_node) {
-  std::unordered_set<TopoNode*> sub_nodes;
+  std::vector<TopoNode*> sub_nodes;
   if (!GetSubNodes(topo_node, &sub_nodes)) {
     return;
   }
@@ -296,7 +323,7 @@ void SubTopoGraph::AddPotentialEdge(const TopoNode* topo_node) {
 void SubTopoGraph::AddPotentialInEdge(
     TopoNode* const sub_node,
     const std::unordered_set<const TopoEdge*> origin_edge) {
-  std::unordered_set<TopoNode*> other_sub_nodes;
+  std::vector<TopoNode*> other_sub_nodes;
   for (const auto* in_edge : origin_edge) {
     if (GetSubNodes(in_edge->FromNode(), &other_sub_nodes)) {
       for (auto* sub_from_node : other_sub_nodes) {
@@ -329,7 +356,7 @@ void SubTopoGraph::AddPotentialInEdge(
 void SubTopoGraph::AddPotentialOutEdge(
     TopoNode* const sub_node,
     const std::unordered_set<const TopoEdge*> origin_edge) {
-  std::unordered_set<TopoNode*> other_sub_nodes;
+  std::vector<TopoNode*> other_sub_nodes;
   for (const auto* out_edge : origin_edge) {
     if (GetSubNodes(out_edge->ToNode(), &other_sub_nodes)) {
       for (auto* sub_to_node : other_sub_nodes) {
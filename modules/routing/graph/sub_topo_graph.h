@@ -69,6 +69,9 @@ class SubTopoGraph {
 
   const TopoNode* GetSubNodeWithS(const TopoNode* topo_node, double s) const;
 
+  // Sub nodes are indexed in [0, SubNodeNum()).
+  int SubNodeNum() const;
+
  private:
   void InitSubNodeByValidRange(const TopoNode* topo_node,
                                const std::vector<NodeSRange>& valid_range);
@@ -81,8 +84,10 @@ class SubTopoGraph {
       TopoNode* const sub_node,
       const std::unordered_set<const TopoEdge*> origin_edge);
 
+  // the slot of the sub nodes of an origin node, -1 if it has none
+  int GetSubNodeSlot(const TopoNode* node) const;
   bool GetSubNodes(const TopoNode* node,
-                   std::unordered_set<TopoNode*>* const sub_nodes) const;
+                   std::vector<TopoNode*>* const sub_nodes) const;
 
   void AddPotentialEdge(const TopoNode* topo_node);
   void AddPotentialInEdge(
@@ -95,10 +100,10 @@ class SubTopoGraph {
  private:
   std::vector<std::shared_ptr<TopoNode>> topo_nodes_;
   std::vector<std::shared_ptr<TopoEdge>> topo_edges_;
-  std::unordered_map<const TopoNode*, std::vector<NodeWithRange>>
-      sub_node_range_sorted_map_;
-  std::unordered_map<const TopoNode*, std::unordered_set<TopoNode*>>
-      sub_node_map_;
+  // indexed by the index of the origin node in its topo graph
+  std::vector<int> sub_node_slots_;
+  // the sub nodes of each slot, sorted by s
+  std::vector<std::vector<NodeWithRange>> sub_node_ranges_;
 };
 
 }  // namespace routing
@@ -25,6 +25,8 @@ void TopoGraph::Clear() {
   topo_nodes_.clear();
   topo_edges_.clear();
   node_index_map_.clear();
+  road_node_map_.clear();
+  compact_graph_.Clear();
 }
 
 bool TopoGraph::LoadNodes(const Graph& graph) {
@@ -36,6 +38,7 @@ bool TopoGraph::LoadNodes(const Graph& graph) {
     node_index_map_[node.lane_id()] = static_cast<int>(topo_nodes_.size());
     std::shared_ptr<TopoNode> topo_node;
     topo_node.reset(new TopoNode(node));
+    topo_node->SetIndex(static_cast<int>(topo_nodes_.size()));
     road_node_map_[node.road_id()].insert(topo_node.get());
     topo_nodes_.push_back(std::move(topo_node));
   }
@@ -80,6 +83,15 @@ bool TopoGraph::LoadGraph(const Graph& graph) {
     AERROR << "Failed to load edges from topology graph.";
     return false;
   }
+  std::vector<const TopoNode*> nodes;
+  nodes.reserve(topo_nodes_.size());
+  for (const auto& topo_node : topo_nodes_) {
+    nodes.push_back(topo_node.get());
+  }
+  if (!compact_graph_.Build(nodes)) {
+    AERROR << "Failed to build compact topology graph.";
+    return false;
+  }
   AINFO << "Load Topo data succesful.";
   return true;
 }
@@ -96,6 +108,12 @@ const TopoNode* TopoGraph::GetNode(const std::string& id) const {
   return topo_nodes_[iter->second].get();
 }
 
+int TopoGraph::NodeNum() const { return static_cast<int>(topo_nodes_.size()); }
+
+const CompactTopoGraph& TopoGraph::CompactGraph() const {
+  return compact_graph_;
+}
+
 void TopoGraph::GetNodesByRoadId(
     const std::string& road_id,
     std::unordered_set<const TopoNode*>* const node_in_road) const {
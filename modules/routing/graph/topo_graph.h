@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "cyber/common/log.h"
+#include "modules/routing/graph/compact_topo_graph.h"
 #include "modules/routing/graph/topo_node.h"
 
 namespace apollo {
@@ -38,6 +39,8 @@ class TopoGraph {
   const std::string& MapVersion() const;
   const std::string& MapDistrict() const;
   const TopoNode* GetNode(const std::string& id) const;
+  int NodeNum() const;
+  const CompactTopoGraph& CompactGraph() const;
   void GetNodesByRoadId(
       const std::string& road_id,
       std::unordered_set<const TopoNode*>* const node_in_road) const;
@@ -55,6 +58,7 @@ class TopoGraph {
   std::unordered_map<std::string, int> node_index_map_;
   std::unordered_map<std::string, std::unordered_set<const TopoNode*> >
       road_node_map_;
+  CompactTopoGraph compact_graph_;
 };
 
 }  // namespace routing
@@ -0,0 +1,290 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/routing/graph/topo_landmark.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+constexpr double kUnreachableCost = -1.0;
+
+struct Arc {
+  size_t to = 0;
+  double cost = 0.0;
+};
+
+using AdjacencyList = std::vector<std::vector<Arc>>;
+
+// The A* search cost of an arc is c(u, v) = edge + cost(v) for a forward
+// edge and edge + (cost(v) - cost(u)) / 2 for a lane change edge, which is
+// negative for a lane change into a much cheaper lane. Dijkstra runs on the
+// reduced cost c(u, v) + p(u) - p(v) with the node potential
+// p(v) = cost(v) / 2 instead, which is never negative:
+//   forward:     edge + (cost(u) + cost(v)) / 2
+//   lane change: edge
+// The reduced cost of any path is its cost plus p(from) - p(to), so the
+// shortest paths are the same.
+double GetReducedArcCost(const Edge& edge, const Node& from_node,
+                         const Node& to_node) {
+  if (edge.direction_type() == Edge::FORWARD) {
+    return edge.cost() + (from_node.cost() + to_node.cost()) / 2.0;
+  }
+  return edge.cost();
+}
+
+double GetPotential(const TopoNode* node) {
+  return node->OriginNode()->Cost() / 2.0;
+}
+
+void Dijkstra(const AdjacencyList& adjacency_list, const size_t source,
+              std::vector<double>* const costs) {
+  costs->assign(adjacency_list.size(), std::numeric_limits<double>::max());
+  using QueueItem = std::pair<double, size_t>;
+  std::priority_queue<QueueItem, std::vector<QueueItem>,
+                      std::greater<QueueItem>>
+      open_queue;
+  (*costs)[source] = 0.0;
+  open_queue.emplace(0.0, source);
+  while (!open_queue.empty()) {
+    const auto item = open_queue.top();
+    open_queue.pop();
+    if (item.first > (*costs)[item.second]) {
+      continue;
+    }
+    for (const auto& arc : adjacency_list[item.second]) {
+      const double cost = item.first + arc.cost;
+      if (cost < (*costs)[arc.to]) {
+        (*costs)[arc.to] = cost;
+        open_queue.emplace(cost, arc.to);
+      }
+    }
+  }
+}
+
+bool IsReachable(const double cost) {
+  return cost < std::numeric_limits<double>::max();
+}
+
+}  // namespace
+
+bool TopoLandmark::Build(const Graph& graph, const int landmark_num,
+                         LandmarkTable* const table) {
+  CHECK_NOTNULL(table);
+  table->Clear();
+  const size_t node_num = graph.node_size();
+  if (node_num == 0 || landmark_num <= 0) {
+    AERROR << "Invalid graph or landmark number for building landmarks.";
+    return false;
+  }
+
+  std::unordered_map<std::string, size_t> node_index_map;
+  for (size_t i = 0; i < node_num; ++i) {
+    node_index_map[graph.node(static_cast<int>(i)).lane_id()] = i;
+  }
+  AdjacencyList forward_list(node_num);
+  AdjacencyList backward_list(node_num);
+  for (const auto& edge : graph.edge()) {
+    const auto from_iter = node_index_map.find(edge.from_lane_id());
+    const auto to_iter = node_index_map.find(edge.to_lane_id());
+    if (from_iter == node_index_map.end() || to_iter == node_index_map.end()) {
+      AERROR << "Edge " << edge.from_lane_id() << " -> " << edge.to_lane_id()
+             << " has no corresponding node.";
+      return false;
+    }
+    const double cost = GetReducedArcCost(
+        edge, graph.node(static_cast<int>(from_iter->second)),
+        graph.node(static_cast<int>(to_iter->second)));
+    // only a negative edge or node cost in the map gives a negative reduced
+    // cost, which Dijkstra cannot handle.
+    if (cost < 0.0) {
+      AWARN << "Edge " << edge.from_lane_id() << " -> " << edge.to_lane_id()
+            << " has negative reduced cost " << cost
+            << ", landmarks would not give a lower bound.";
+      return false;
+    }
+    forward_list[from_iter->second].push_back({to_iter->second, cost});
+    backward_list[to_iter->second].push_back({from_iter->second, cost});
+  }
+
+  const size_t num = std::min(static_cast<size_t>(landmark_num), node_num);
+  std::vector<std::vector<double>> costs_from(num);
+  std::vector<std::vector<double>> costs_to(num);
+
+  // the first landmark is the farthest node from an arbitrary seed node.
+  std::vector<double> seed_costs;
+  Dijkstra(forward_list, 0, &seed_costs);
+  size_t landmark = 0;
+  for (size_t i = 0; i < node_num; ++i) {
+    if (IsReachable(seed_costs[i]) && seed_costs[i] > seed_costs[landmark]) {
+      landmark = i;
+    }
+  }
+
+  // the distance of each node to its nearest selected landmark
+  std::vector<double> min_costs(node_num, std::numeric_limits<double>::max());
+  for (size_t k = 0; k < num; ++k) {
+    table->add_landmark_lane_id(
+        graph.node(static_cast<int>(landmark)).lane_id());
+    Dijkstra(forward_list, landmark, &costs_from[k]);
+    Dijkstra(backward_list, landmark, &costs_to[k]);
+    min_costs[landmark] = 0.0;
+    for (size_t i = 0; i < node_num; ++i) {
+      double cost = 0.0;
+      if (IsReachable(costs_from[k][i])) {
+        cost += costs_from[k][i];
+      }
+      if (IsReachable(costs_to[k][i])) {
+        cost += costs_to[k][i];
+      }
+      if (IsReachable(costs_from[k][i]) || IsReachable(costs_to[k][i])) {
+        min_costs[i] = std::min(min_costs[i], cost);
+      }
+    }
+    // nodes not connected to any landmark yet are preferred.
+    landmark = static_cast<size_t>(
+        std::max_element(min_costs.begin(), min_costs.end()) -
+        min_costs.begin());
+    if (min_costs[landmark] <= 0.0) {
+      break;
+    }
+  }
+
+  table->set_hdmap_version(graph.hdmap_version());
+  const size_t selected_num = table->landmark_lane_id_size();
+  for (size_t i = 0; i < node_num; ++i) {
+    auto* node_cost = table->add_node();
+    node_cost->set_lane_id(graph.node(static_cast<int>(i)).lane_id());
+    for (size_t k = 0; k < selected_num; ++k) {
+      node_cost->add_cost_from_landmark(IsReachable(costs_from[k][i])
+                                            ? costs_from[k][i]
+                                            : kUnreachableCost);
+      node_cost->add_cost_to_landmark(
+          IsReachable(costs_to[k][i]) ? costs_to[k][i] : kUnreachableCost);
+    }
+  }
+  AINFO << "Built " << selected_num << " landmarks for " << node_num
+        << " nodes.";
+  return true;
+}
+
+std::string TopoLandmark::GetLandmarkFilePath(
+    const std::string& topo_file_path) {
+  const auto type_pos = topo_file_path.find_last_of('.');
+  const auto dir_pos = topo_file_path.find_last_of('/');
+  if (type_pos == std::string::npos ||
+      (dir_pos != std::string::npos && type_pos < dir_pos)) {
+    return topo_file_path + "_landmark.bin";
+  }
+  return topo_file_path.substr(0, type_pos) + "_landmark.bin";
+}
+
+bool TopoLandmark::Load(const LandmarkTable& table, const TopoGraph* graph) {
+  CHECK_NOTNULL(graph);
+  landmark_num_ = 0;
+  node_offsets_.assign(graph->NodeNum(), -1);
+  cost_from_landmark_.clear();
+  cost_to_landmark_.clear();
+
+  if (table.hdmap_version() != graph->MapVersion()) {
+    AERROR << "Landmark table map version " << table.hdmap_version()
+           << " does not match routing map version " << graph->MapVersion();
+    return false;
+  }
+  const size_t num = table.landmark_lane_id_size();
+  if (num == 0) {
+    AERROR << "No landmark found in landmark table.";
+    return false;
+  }
+  cost_from_landmark_.reserve(table.node_size() * num);
+  cost_to_landmark_.reserve(table.node_size() * num);
+  for (const auto& node_cost : table.node()) {
+    const auto* topo_node = graph->GetNode(node_cost.lane_id());
+    if (topo_node == nullptr) {
+      AWARN << "Landmark node " << node_cost.lane_id()
+            << " is not found in topo graph.";
+      continue;
+    }
+    if (static_cast<size_t>(node_cost.cost_from_landmark_size()) != num ||
+        static_cast<size_t>(node_cost.cost_to_landmark_size()) != num) {
+      AERROR << "Landmark cost size of node " << node_cost.lane_id()
+             << " is invalid.";
+      node_offsets_.clear();
+      cost_from_landmark_.clear();
+      cost_to_landmark_.clear();
+      return false;
+    }
+    node_offsets_[topo_node->Index()] =
+        static_cast<int>(cost_from_landmark_.size() / num);
+    cost_from_landmark_.insert(cost_from_landmark_.end(),
+                               node_cost.cost_from_landmark().begin(),
+                               node_cost.cost_from_landmark().end());
+    cost_to_landmark_.insert(cost_to_landmark_.end(),
+                             node_cost.cost_to_landmark().begin(),
+                             node_cost.cost_to_landmark().end());
+  }
+  landmark_num_ = num;
+  AINFO << "Loaded " << num << " landmarks for " << table.node_size()
+        << " nodes.";
+  return true;
+}
+
+double TopoLandmark::HeuristicCost(const TopoNode* src_node,
+                                   const TopoNode* dest_node) const {
+  // the landmark costs bound the reduced cost, which is the cost plus
+  // p(src) - p(dest), so the bound on the cost may be negative.
+  const double potential_diff =
+      GetPotential(dest_node) - GetPotential(src_node);
+  const int src_index = src_node->OriginNode()->Index();
+  const int dest_index = dest_node->OriginNode()->Index();
+  if (src_index < 0 || dest_index < 0 ||
+      src_index >= static_cast<int>(node_offsets_.size()) ||
+      dest_index >= static_cast<int>(node_offsets_.size()) ||
+      node_offsets_[src_index] < 0 || node_offsets_[dest_index] < 0) {
+    return potential_diff;
+  }
+  const size_t src_offset = node_offsets_[src_index] * landmark_num_;
+  const size_t dest_offset = node_offsets_[dest_index] * landmark_num_;
+  double cost = 0.0;
+  for (size_t i = 0; i < landmark_num_; ++i) {
+    // cost(landmark, dest) <= cost(landmark, src) + cost(src, dest)
+    const double from_src = cost_from_landmark_[src_offset + i];
+    const double from_dest = cost_from_landmark_[dest_offset + i];
+    if (from_src >= 0.0 && from_dest >= 0.0) {
+      cost = std::max(cost, from_dest - from_src);
+    }
+    // cost(src, landmark) <= cost(src, dest) + cost(dest, landmark)
+    const double to_src = cost_to_landmark_[src_offset + i];
+    const double to_dest = cost_to_landmark_[dest_offset + i];
+    if (to_src >= 0.0 && to_dest >= 0.0) {
+      cost = std::max(cost, to_src - to_dest);
+    }
+  }
+  return cost + potential_diff;
+}
+
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,69 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "modules/routing/graph/topo_graph.h"
+#include "modules/routing/proto/topo_graph.pb.h"
+
+namespace apollo {
+namespace routing {
+
+// ALT (A*, landmarks and triangle inequality) heuristic over the topo graph.
+// The costs between every node and a few landmark nodes are precomputed on
+// the full graph by topo_creator. Removing edges or splitting nodes (e.g. by
+// black list ranges or lane change restrictions) can only increase the real
+// cost, so the heuristic stays a lower bound on any sub graph.
+// A lane change into a cheaper lane has a negative cost, so the table keeps
+// the reduced costs with the node potential cost(v) / 2 (see the .cc file),
+// which are never negative, and HeuristicCost() maps the bound back. The
+// heuristic is consistent but may be negative.
+class TopoLandmark {
+ public:
+  TopoLandmark() = default;
+  ~TopoLandmark() = default;
+
+  // Select landmarks with the farthest-point strategy and compute the reduced
+  // costs from and to every landmark with Dijkstra.
+  static bool Build(const Graph& graph, const int landmark_num,
+                    LandmarkTable* const table);
+
+  // The landmark table is stored next to the routing map, e.g.
+  // routing_map.bin -> routing_map_landmark.bin
+  static std::string GetLandmarkFilePath(const std::string& topo_file_path);
+
+  bool Load(const LandmarkTable& table, const TopoGraph* graph);
+
+  bool IsReady() const { return landmark_num_ > 0; }
+
+  double HeuristicCost(const TopoNode* src_node,
+                       const TopoNode* dest_node) const;
+
+ private:
+  size_t landmark_num_ = 0;
+  // offset of each topo graph node in the cost arrays, -1 if not found
+  std::vector<int> node_offsets_;
+  // node index * landmark_num_ + landmark index
+  std::vector<double> cost_from_landmark_;
+  std::vector<double> cost_to_landmark_;
+};
+
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,176 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/routing/graph/topo_landmark.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "modules/routing/graph/topo_test_utils.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+// all pairs costs with the same edge cost definition as A* search.
+void GetAllPairsCosts(const Graph& graph,
+                      std::vector<std::vector<double>>* costs) {
+  const int n = graph.node_size();
+  std::unordered_map<std::string, int> index_map;
+  for (int i = 0; i < n; ++i) {
+    index_map[graph.node(i).lane_id()] = i;
+  }
+  costs->assign(n, std::vector<double>(n, std::numeric_limits<double>::max()));
+  for (int i = 0; i < n; ++i) {
+    (*costs)[i][i] = 0.0;
+  }
+  for (const auto& edge : graph.edge()) {
+    const int from = index_map[edge.from_lane_id()];
+    const int to = index_map[edge.to_lane_id()];
+    double cost = edge.cost() + graph.node(to).cost();
+    if (edge.direction_type() != Edge::FORWARD) {
+      cost -= (graph.node(from).cost() + graph.node(to).cost()) / 2.0;
+    }
+    (*costs)[from][to] = std::min((*costs)[from][to], cost);
+  }
+  for (int k = 0; k < n; ++k) {
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        if ((*costs)[i][k] < std::numeric_limits<double>::max() &&
+            (*costs)[k][j] < std::numeric_limits<double>::max()) {
+          (*costs)[i][j] =
+              std::min((*costs)[i][j], (*costs)[i][k] + (*costs)[k][j]);
+        }
+      }
+    }
+  }
+}
+
+// the heuristic must not exceed the cost of the cheapest path between any
+// two nodes.
+void ExpectLowerBound(const Graph& graph, const TopoGraph& topo_graph,
+                      const TopoLandmark& landmark) {
+  std::vector<std::vector<double>> costs;
+  GetAllPairsCosts(graph, &costs);
+  for (int i = 0; i < graph.node_size(); ++i) {
+    const auto* src_node = topo_graph.GetNode(graph.node(i).lane_id());
+    ASSERT_TRUE(src_node != nullptr);
+    for (int j = 0; j < graph.node_size(); ++j) {
+      const auto* dest_node = topo_graph.GetNode(graph.node(j).lane_id());
+      ASSERT_TRUE(dest_node != nullptr);
+      EXPECT_LE(landmark.HeuristicCost(src_node, dest_node),
+                costs[i][j] + 1e-9)
+          << graph.node(i).lane_id() << " -> " << graph.node(j).lane_id();
+    }
+  }
+}
+
+}  // namespace
+
+TEST(TopoLandmarkTestSuit, build_and_load) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+
+  LandmarkTable table;
+  ASSERT_TRUE(TopoLandmark::Build(graph, 4, &table));
+  ASSERT_EQ(TEST_MAP_VERSION, table.hdmap_version());
+  ASSERT_GE(table.landmark_lane_id_size(), 1);
+  ASSERT_LE(table.landmark_lane_id_size(), 4);
+  ASSERT_EQ(graph.node_size(), table.node_size());
+
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  TopoLandmark landmark;
+  ASSERT_FALSE(landmark.IsReady());
+  ASSERT_TRUE(landmark.Load(table, &topo_graph));
+  ASSERT_TRUE(landmark.IsReady());
+
+  table.set_hdmap_version("invalid_version");
+  TopoLandmark invalid_landmark;
+  ASSERT_FALSE(invalid_landmark.Load(table, &topo_graph));
+  ASSERT_FALSE(invalid_landmark.IsReady());
+}
+
+TEST(TopoLandmarkTestSuit, heuristic_is_lower_bound) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+
+  LandmarkTable table;
+  ASSERT_TRUE(TopoLandmark::Build(graph, 2, &table));
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  TopoLandmark landmark;
+  ASSERT_TRUE(landmark.Load(table, &topo_graph));
+
+  ExpectLowerBound(graph, topo_graph, landmark);
+  const auto* node_1 = topo_graph.GetNode(TEST_L1);
+  const auto* node_5 = topo_graph.GetNode(TEST_L5);
+  EXPECT_GT(landmark.HeuristicCost(node_1, node_5), 0.0);
+  EXPECT_DOUBLE_EQ(0.0, landmark.HeuristicCost(node_5, node_5));
+}
+
+TEST(TopoLandmarkTestSuit, negative_arc_cost) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  // the lane change from L1 to the much cheaper L2 costs less than zero
+  ASSERT_EQ(TEST_L1, graph.node(0).lane_id());
+  ASSERT_EQ(TEST_L2, graph.node(1).lane_id());
+  ASSERT_EQ(TEST_L1, graph.edge(0).from_lane_id());
+  graph.mutable_node(0)->set_cost(graph.node(1).cost() +
+                                  4.0 * graph.edge(0).cost() + 1.0);
+
+  LandmarkTable table;
+  ASSERT_TRUE(TopoLandmark::Build(graph, 2, &table));
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  TopoLandmark landmark;
+  ASSERT_TRUE(landmark.Load(table, &topo_graph));
+
+  ExpectLowerBound(graph, topo_graph, landmark);
+  // the cheapest path from L1 to L2 is the lane change, which costs less
+  // than zero, so the heuristic is negative too.
+  const auto* node_1 = topo_graph.GetNode(TEST_L1);
+  const auto* node_2 = topo_graph.GetNode(TEST_L2);
+  EXPECT_LT(landmark.HeuristicCost(node_1, node_2), 0.0);
+}
+
+TEST(TopoLandmarkTestSuit, negative_edge_cost) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  // a negative edge cost is an error in the map, no potential fixes it.
+  graph.mutable_edge(0)->set_cost(-1.0);
+
+  LandmarkTable table;
+  EXPECT_FALSE(TopoLandmark::Build(graph, 2, &table));
+}
+
+TEST(TopoLandmarkTestSuit, landmark_file_path) {
+  EXPECT_EQ("/apollo/map/routing_map_landmark.bin",
+            TopoLandmark::GetLandmarkFilePath("/apollo/map/routing_map.bin"));
+  EXPECT_EQ("/apollo/map/routing_map_landmark.bin",
+            TopoLandmark::GetLandmarkFilePath("/apollo/map/routing_map.txt"));
+  EXPECT_EQ("/apollo/map.d/routing_map_landmark.bin",
+            TopoLandmark::GetLandmarkFilePath("/apollo/map.d/routing_map"));
+}
+
+}  // namespace routing
+}  // namespace apollo
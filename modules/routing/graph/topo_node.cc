@@ -94,19 +94,21 @@ bool TopoNode::IsOutRangeEnough(const std::vector<NodeSRange>& range_vec,
 }
 
 TopoNode::TopoNode(const Node& node)
-    : pb_node_(node), start_s_(0.0), end_s_(pb_node_.length()) {
-  CHECK(pb_node_.length() > kLenghtEpsilon)
-      << "Node length is invalid in pb: " << pb_node_.DebugString();
+    : pb_node_(std::make_shared<Node>(node)),
+      start_s_(0.0),
+      end_s_(pb_node_->length()) {
+  CHECK(pb_node_->length() > kLenghtEpsilon)
+      << "Node length is invalid in pb: " << pb_node_->DebugString();
   Init();
   origin_node_ = this;
 }
 
 TopoNode::TopoNode(const TopoNode* topo_node, const NodeSRange& range)
-    : TopoNode(topo_node->PbNode()) {
-  origin_node_ = topo_node;
-  start_s_ = range.StartS();
-  end_s_ = range.EndS();
+    : pb_node_(topo_node->pb_node_),
+      start_s_(range.StartS()),
+      end_s_(range.EndS()) {
   Init();
+  origin_node_ = topo_node;
 }
 
 TopoNode::~TopoNode() {}
@@ -115,14 +117,14 @@ void TopoNode::Init() {
   if (!FindAnchorPoint()) {
     AWARN << "Be attention!!! Find anchor point failed for lane: " << LaneId();
   }
-  ConvertOutRange(pb_node_.left_out(), start_s_, end_s_,
+  ConvertOutRange(pb_node_->left_out(), start_s_, end_s_,
                   &left_out_sorted_range_, &left_prefer_range_index_);
 
   is_left_range_enough_ =
       (left_prefer_range_index_ >= 0) &&
       left_out_sorted_range_[left_prefer_range_index_].IsEnoughForChangeLane();
 
-  ConvertOutRange(pb_node_.right_out(), start_s_, end_s_,
+  ConvertOutRange(pb_node_->right_out(), start_s_, end_s_,
                   &right_out_sorted_range_, &right_prefer_range_index_);
   is_right_range_enough_ = (right_prefer_range_index_ >= 0) &&
                            right_out_sorted_range_[right_prefer_range_index_]
@@ -150,20 +152,20 @@ void TopoNode::SetAnchorPoint(const common::PointENU& anchor_point) {
   anchor_point_ = anchor_point;
 }
 
-const Node& TopoNode::PbNode() const { return pb_node_; }
+const Node& TopoNode::PbNode() const { return *pb_node_; }
 
-double TopoNode::Length() const { return pb_node_.length(); }
+double TopoNode::Length() const { return pb_node_->length(); }
 
-double TopoNode::Cost() const { return pb_node_.cost(); }
+double TopoNode::Cost() const { return pb_node_->cost(); }
 
-bool TopoNode::IsVirtual() const { return pb_node_.is_virtual(); }
+bool TopoNode::IsVirtual() const { return pb_node_->is_virtual(); }
 
-const std::string& TopoNode::LaneId() const { return pb_node_.lane_id(); }
+const std::string& TopoNode::LaneId() const { return pb_node_->lane_id(); }
 
-const std::string& TopoNode::RoadId() const { return pb_node_.road_id(); }
+const std::string& TopoNode::RoadId() const { return pb_node_->road_id(); }
 
 const hdmap::Curve& TopoNode::CentralCurve() const {
-  return pb_node_.central_curve();
+  return pb_node_->central_curve();
 }
 
 const common::PointENU& TopoNode::AnchorPoint() const { return anchor_point_; }
@@ -234,6 +236,10 @@ double TopoNode::EndS() const { return end_s_; }
 
 bool TopoNode::IsSubNode() const { return OriginNode() != this; }
 
+int TopoNode::Index() const { return index_; }
+
+void TopoNode::SetIndex(const int index) { index_ = index; }
+
 bool TopoNode::IsOverlapEnough(const TopoNode* sub_node,
                                const TopoEdge* edge_for_type) const {
   if (edge_for_type->Type() == TET_LEFT) {
@@ -310,32 +316,44 @@ bool TopoNode::IsOutToSucEdgeValid() const {
 
 TopoEdge::TopoEdge(const Edge& edge, const TopoNode* from_node,
                    const TopoNode* to_node)
-    : pb_edge_(edge), from_node_(from_node), to_node_(to_node) {}
+    : cost_(edge.cost()), from_node_(from_node), to_node_(to_node) {
+  if (edge.direction_type() == Edge::LEFT) {
+    type_ = TET_LEFT;
+  } else if (edge.direction_type() == Edge::RIGHT) {
+    type_ = TET_RIGHT;
+  }
+}
 
 TopoEdge::~TopoEdge() {}
 
-const Edge& TopoEdge::PbEdge() const { return pb_edge_; }
+Edge TopoEdge::PbEdge() const {
+  Edge edge;
+  edge.set_from_lane_id(FromLaneId());
+  edge.set_to_lane_id(ToLaneId());
+  edge.set_cost(cost_);
+  if (type_ == TET_LEFT) {
+    edge.set_direction_type(Edge::LEFT);
+  } else if (type_ == TET_RIGHT) {
+    edge.set_direction_type(Edge::RIGHT);
+  } else {
+    edge.set_direction_type(Edge::FORWARD);
+  }
+  return edge;
+}
 
-double TopoEdge::Cost() const { return pb_edge_.cost(); }
+double TopoEdge::Cost() const { return cost_; }
 
 const TopoNode* TopoEdge::FromNode() const { return from_node_; }
 
 const TopoNode* TopoEdge::ToNode() const { return to_node_; }
 
 const std::string& TopoEdge::FromLaneId() const {
-  return pb_edge_.from_lane_id();
+  return from_node_->LaneId();
 }
 
-const std::string& TopoEdge::ToLaneId() const { return pb_edge_.to_lane_id(); }
+const std::string& TopoEdge::ToLaneId() const { return to_node_->LaneId(); }
+
+TopoEdgeType TopoEdge::Type() const { return type_; }
 
-TopoEdgeType TopoEdge::Type() const {
-  if (pb_edge_.direction_type() == Edge::LEFT) {
-    return TET_LEFT;
-  }
-  if (pb_edge_.direction_type() == Edge::RIGHT) {
-    return TET_RIGHT;
-  }
-  return TET_FORWARD;
-}
 }  // namespace routing
 }  // namespace apollo
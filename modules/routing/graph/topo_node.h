@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -66,6 +67,11 @@ class TopoNode {
   const TopoEdge* GetInEdgeFrom(const TopoNode* from_node) const;
   const TopoEdge* GetOutEdgeTo(const TopoNode* to_node) const;
 
+  // The index of an origin node in its topo graph, or the index of a sub node
+  // in its sub topo graph.
+  int Index() const;
+  void SetIndex(const int index);
+
   const TopoNode* OriginNode() const;
   double StartS() const;
   double EndS() const;
@@ -82,8 +88,10 @@ class TopoNode {
   bool FindAnchorPoint();
   void SetAnchorPoint(const common::PointENU& anchor_point);
 
-  Node pb_node_;
+  // sub nodes share the pb node of their origin node
+  std::shared_ptr<const Node> pb_node_;
   common::PointENU anchor_point_;
+  int index_ = -1;
 
   double start_s_;
   double end_s_;
@@ -125,7 +133,7 @@ class TopoEdge {
 
   ~TopoEdge();
 
-  const Edge& PbEdge() const;
+  Edge PbEdge() const;
   double Cost() const;
   const std::string& FromLaneId() const;
   const std::string& ToLaneId() const;
@@ -135,7 +143,9 @@ class TopoEdge {
   const TopoNode* ToNode() const;
 
  private:
-  Edge pb_edge_;
+  // the lane ids are those of the from and to nodes, not copied per edge
+  double cost_ = 0.0;
+  TopoEdgeType type_ = TET_FORWARD;
   const TopoNode* from_node_ = nullptr;
   const TopoNode* to_node_ = nullptr;
 };
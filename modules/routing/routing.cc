@@ -98,6 +98,15 @@ bool Routing::Process(const std::shared_ptr<RoutingRequest>& routing_request,
                                 routing_response->status().msg());
     return false;
   }
+  const auto& statistics = navigator_ptr_->Statistics();
+  AINFO << "Routing latency: " << statistics.last_latency_ms
+        << " ms, max latency: " << statistics.max_latency_ms
+        << " ms, cache hit: " << statistics.cache_hit_count
+        << ", cache miss: " << statistics.cache_miss_count
+        << ", warm start: " << statistics.warm_start_count
+        << ", full search: " << statistics.search_count
+        << ", failed: " << statistics.failure_count << "/"
+        << statistics.request_count;
   monitor_logger_buffer_.INFO("Routing success!");
   return true;
 }
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <limits>
 #include <queue>
+#include <unordered_set>
 
 #include "modules/routing/common/routing_gflags.h"
 #include "modules/routing/graph/sub_topo_graph.h"
@@ -27,6 +28,15 @@ namespace apollo {
 namespace routing {
 namespace {
 
+enum NodeState : uint8_t {
+  NS_UNVISITED = 0,
+  NS_OPEN = 1,
+  NS_CLOSED = 2,
+};
+
+// enter s is never negative
+constexpr double kInvalidEnterS = -1.0;
+
 struct SearchNode {
   const TopoNode* topo_node = nullptr;
   double f = std::numeric_limits<double>::max();
@@ -174,24 +184,15 @@ bool AdjustLaneChange(std::vector<const TopoNode*>* const result_node_vec) {
   return true;
 }
 
-bool Reconstruct(
-    const std::unordered_map<const TopoNode*, const TopoNode*>& came_from,
-    const TopoNode* dest_node, std::vector<NodeWithRange>* result_nodes) {
-  std::vector<const TopoNode*> result_node_vec;
-  result_node_vec.push_back(dest_node);
-
-  auto iter = came_from.find(dest_node);
-  while (iter != came_from.end()) {
-    result_node_vec.push_back(iter->second);
-    iter = came_from.find(iter->second);
-  }
-  std::reverse(result_node_vec.begin(), result_node_vec.end());
-  if (!AdjustLaneChange(&result_node_vec)) {
+bool Reconstruct(std::vector<const TopoNode*>* const result_node_vec,
+                 std::vector<NodeWithRange>* result_nodes) {
+  std::reverse(result_node_vec->begin(), result_node_vec->end());
+  if (!AdjustLaneChange(result_node_vec)) {
     AERROR << "Failed to adjust lane change";
     return false;
   }
   result_nodes->clear();
-  for (const auto* node : result_node_vec) {
+  for (const auto* node : *result_node_vec) {
     result_nodes->emplace_back(node->OriginNode(), node->StartS(),
                                node->EndS());
   }
@@ -200,19 +201,48 @@ bool Reconstruct(
 
 }  // namespace
 
-AStarStrategy::AStarStrategy(bool enable_change)
-    : change_lane_enabled_(enable_change) {}
+AStarStrategy::AStarStrategy(bool enable_change,
+                             const TopoLandmark* landmark)
+    : change_lane_enabled_(enable_change), landmark_(landmark) {}
 
 void AStarStrategy::Clear() {
-  closed_set_.clear();
-  open_set_.clear();
-  came_from_.clear();
-  enter_s_.clear();
-  g_score_.clear();
+  for (const int index : reached_indices_) {
+    node_state_[index] = NS_UNVISITED;
+    came_from_[index] = nullptr;
+    g_score_[index] = 0.0;
+    enter_s_[index] = kInvalidEnterS;
+  }
+  reached_indices_.clear();
+  origin_node_num_ = 0;
+  node_num_ = 0;
+}
+
+void AStarStrategy::Init(const TopoGraph* graph,
+                         const SubTopoGraph* sub_graph) {
+  origin_node_num_ = graph->NodeNum();
+  node_num_ = origin_node_num_ + sub_graph->SubNodeNum();
+  if (node_num_ > static_cast<int>(node_state_.size())) {
+    node_state_.resize(node_num_, NS_UNVISITED);
+    came_from_.resize(node_num_, nullptr);
+    g_score_.resize(node_num_, 0.0);
+    enter_s_.resize(node_num_, kInvalidEnterS);
+  }
+}
+
+int AStarStrategy::GetIndex(const TopoNode* node) const {
+  const int index = node->IsSubNode() ? origin_node_num_ + node->Index()
+                                      : node->Index();
+  CHECK_GE(index, 0) << "Topo node " << node->LaneId() << " is not indexed";
+  CHECK_LT(index, node_num_)
+      << "Topo node " << node->LaneId() << " is out of the search graph";
+  return index;
 }
 
 double AStarStrategy::HeuristicCost(const TopoNode* src_node,
                                     const TopoNode* dest_node) {
+  if (landmark_ != nullptr && landmark_->IsReady()) {
+    return landmark_->HeuristicCost(src_node, dest_node);
+  }
   const auto& src_point = src_node->AnchorPoint();
   const auto& dest_point = dest_node->AnchorPoint();
   double distance = fabs(src_point.x() - dest_point.x()) +
@@ -225,6 +255,7 @@ bool AStarStrategy::Search(const TopoGraph* graph,
                            const TopoNode* src_node, const TopoNode* dest_node,
                            std::vector<NodeWithRange>* const result_nodes) {
   Clear();
+  Init(graph, sub_graph);
   AINFO << "Start A* search algorithm.";
 
   std::priority_queue<SearchNode> open_set_detail;
@@ -233,72 +264,95 @@ bool AStarStrategy::Search(const TopoGraph* graph,
   src_search_node.f = HeuristicCost(src_node, dest_node);
   open_set_detail.push(src_search_node);
 
-  open_set_.insert(src_node);
-  g_score_[src_node] = 0.0;
-  enter_s_[src_node] = src_node->StartS();
+  const int src_index = GetIndex(src_node);
+  reached_indices_.push_back(src_index);
+  node_state_[src_index] = NS_OPEN;
+  g_score_[src_index] = 0.0;
+  enter_s_[src_index] = src_node->StartS();
 
+  const auto& compact_graph = graph->CompactGraph();
   SearchNode current_node;
   std::unordered_set<const TopoEdge*> next_edge_set;
   std::unordered_set<const TopoEdge*> sub_edge_set;
   while (!open_set_detail.empty()) {
     current_node = open_set_detail.top();
     const auto* from_node = current_node.topo_node;
+    const int from_index = GetIndex(from_node);
     if (current_node.topo_node == dest_node) {
-      if (!Reconstruct(came_from_, from_node, result_nodes)) {
+      std::vector<const TopoNode*> result_node_vec;
+      for (const auto* node = from_node; node != nullptr;
+           node = came_from_[GetIndex(node)]) {
+        result_node_vec.push_back(node);
+      }
+      if (!Reconstruct(&result_node_vec, result_nodes)) {
         AERROR << "Failed to reconstruct route.";
         return false;
       }
       return true;
     }
-    open_set_.erase(from_node);
     open_set_detail.pop();
 
-    if (closed_set_.count(from_node) != 0) {
+    if (node_state_[from_index] == NS_CLOSED) {
       // if showed before, just skip...
       continue;
     }
-    closed_set_.emplace(from_node);
+    node_state_[from_index] = NS_CLOSED;
 
     // if residual_s is less than FLAGS_min_length_for_lane_change, only move
     // forward
-    const auto& neighbor_edges =
-        (GetResidualS(from_node) > FLAGS_min_length_for_lane_change &&
-         change_lane_enabled_)
-            ? from_node->OutToAllEdge()
-            : from_node->OutToSucEdge();
+    const bool enable_lane_change =
+        GetResidualS(from_node) > FLAGS_min_length_for_lane_change &&
+        change_lane_enabled_;
     double tentative_g_score = 0.0;
     next_edge_set.clear();
-    for (const auto* edge : neighbor_edges) {
-      sub_edge_set.clear();
-      sub_graph->GetSubInEdgesIntoSubGraph(edge, &sub_edge_set);
-      next_edge_set.insert(sub_edge_set.begin(), sub_edge_set.end());
+    if (from_node->IsSubNode()) {
+      const auto& neighbor_edges = enable_lane_change
+                                       ? from_node->OutToAllEdge()
+                                       : from_node->OutToSucEdge();
+      for (const auto* edge : neighbor_edges) {
+        sub_edge_set.clear();
+        sub_graph->GetSubInEdgesIntoSubGraph(edge, &sub_edge_set);
+        next_edge_set.insert(sub_edge_set.begin(), sub_edge_set.end());
+      }
+    } else {
+      // out edges of origin nodes are contiguous in the compact graph
+      const auto* edge_end = compact_graph.OutEdgeEnd(from_index);
+      for (const auto* edge = compact_graph.OutEdgeBegin(from_index);
+           edge != edge_end; ++edge) {
+        if (!enable_lane_change && edge->type != TopoEdgeType::TET_FORWARD) {
+          continue;
+        }
+        sub_edge_set.clear();
+        sub_graph->GetSubInEdgesIntoSubGraph(edge->topo_edge, &sub_edge_set);
+        next_edge_set.insert(sub_edge_set.begin(), sub_edge_set.end());
+      }
     }
 
     for (const auto* edge : next_edge_set) {
       const auto* to_node = edge->ToNode();
-      if (closed_set_.count(to_node) == 1) {
+      const int to_index = GetIndex(to_node);
+      if (node_state_[to_index] == NS_CLOSED) {
         continue;
       }
       if (GetResidualS(edge, to_node) < FLAGS_min_length_for_lane_change) {
         continue;
       }
-      tentative_g_score =
-          g_score_[current_node.topo_node] + GetCostToNeighbor(edge);
+      tentative_g_score = g_score_[from_index] + GetCostToNeighbor(edge);
       if (edge->Type() != TopoEdgeType::TET_FORWARD) {
         tentative_g_score -=
             (edge->FromNode()->Cost() + edge->ToNode()->Cost()) / 2;
       }
-      double f = tentative_g_score + HeuristicCost(to_node, dest_node);
-      if (open_set_.count(to_node) != 0 && f >= g_score_[to_node]) {
+      if (node_state_[to_index] == NS_OPEN &&
+          tentative_g_score >= g_score_[to_index]) {
         continue;
       }
       // if to_node is reached by forward, reset enter_s to start_s
       if (edge->Type() == TopoEdgeType::TET_FORWARD) {
-        enter_s_[to_node] = to_node->StartS();
+        enter_s_[to_index] = to_node->StartS();
       } else {
         // else, add enter_s with FLAGS_min_length_for_lane_change
         double to_node_enter_s =
-            (enter_s_[from_node] + FLAGS_min_length_for_lane_change) /
+            (enter_s_[from_index] + FLAGS_min_length_for_lane_change) /
             from_node->Length() * to_node->Length();
         // enter s could be larger than end_s but should be less than length
         to_node_enter_s = std::min(to_node_enter_s, to_node->Length());
@@ -306,17 +360,18 @@ bool AStarStrategy::Search(const TopoGraph* graph,
         if (to_node_enter_s > to_node->EndS() && to_node == dest_node) {
           continue;
         }
-        enter_s_[to_node] = to_node_enter_s;
+        enter_s_[to_index] = to_node_enter_s;
       }
 
-      g_score_[to_node] = f;
+      g_score_[to_index] = tentative_g_score;
       SearchNode next_node(to_node);
-      next_node.f = f;
+      next_node.f = tentative_g_score + HeuristicCost(to_node, dest_node);
       open_set_detail.push(next_node);
-      came_from_[to_node] = from_node;
-      if (open_set_.count(to_node) == 0) {
-        open_set_.insert(to_node);
+      came_from_[to_index] = from_node;
+      if (node_state_[to_index] == NS_UNVISITED) {
+        reached_indices_.push_back(to_index);
       }
+      node_state_[to_index] = NS_OPEN;
     }
   }
   AERROR << "Failed to find goal lane with id: " << dest_node->LaneId();
@@ -325,12 +380,12 @@ bool AStarStrategy::Search(const TopoGraph* graph,
 
 double AStarStrategy::GetResidualS(const TopoNode* node) {
   double start_s = node->StartS();
-  const auto iter = enter_s_.find(node);
-  if (iter != enter_s_.end()) {
-    if (iter->second > node->EndS()) {
+  const double enter_s = enter_s_[GetIndex(node)];
+  if (enter_s != kInvalidEnterS) {
+    if (enter_s > node->EndS()) {
       return 0.0;
     }
-    start_s = iter->second;
+    start_s = enter_s;
   } else {
     AWARN << "lane " << node->LaneId() << "(" << node->StartS() << ", "
           << node->EndS() << "not found in enter_s map";
@@ -356,9 +411,9 @@ double AStarStrategy::GetResidualS(const TopoEdge* edge,
   }
   double start_s = to_node->StartS();
   const auto* from_node = edge->FromNode();
-  const auto iter = enter_s_.find(from_node);
-  if (iter != enter_s_.end()) {
-    double temp_s = iter->second / from_node->Length() * to_node->Length();
+  const double enter_s = enter_s_[GetIndex(from_node)];
+  if (enter_s != kInvalidEnterS) {
+    double temp_s = enter_s / from_node->Length() * to_node->Length();
     start_s = std::max(start_s, temp_s);
   } else {
     AWARN << "lane " << from_node->LaneId() << "(" << from_node->StartS()
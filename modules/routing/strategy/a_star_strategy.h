@@ -16,10 +16,10 @@
 
 #pragma once
 
-#include <unordered_map>
-#include <unordered_set>
+#include <cstdint>
 #include <vector>
 
+#include "modules/routing/graph/topo_landmark.h"
 #include "modules/routing/strategy/strategy.h"
 
 namespace apollo {
@@ -27,7 +27,8 @@ namespace routing {
 
 class AStarStrategy : public Strategy {
  public:
-  explicit AStarStrategy(bool enable_change);
+  explicit AStarStrategy(bool enable_change,
+                         const TopoLandmark* landmark = nullptr);
   ~AStarStrategy() = default;
 
   virtual bool Search(const TopoGraph* graph, const SubTopoGraph* sub_graph,
@@ -36,17 +37,26 @@ class AStarStrategy : public Strategy {
 
  private:
   void Clear();
+  void Init(const TopoGraph* graph, const SubTopoGraph* sub_graph);
+  int GetIndex(const TopoNode* node) const;
   double HeuristicCost(const TopoNode* src_node, const TopoNode* dest_node);
   double GetResidualS(const TopoNode* node);
   double GetResidualS(const TopoEdge* edge, const TopoNode* to_node);
 
  private:
   bool change_lane_enabled_;
-  std::unordered_set<const TopoNode*> open_set_;
-  std::unordered_set<const TopoNode*> closed_set_;
-  std::unordered_map<const TopoNode*, const TopoNode*> came_from_;
-  std::unordered_map<const TopoNode*, double> g_score_;
-  std::unordered_map<const TopoNode*, double> enter_s_;
+  // optional precomputed landmarks for a tighter heuristic
+  const TopoLandmark* landmark_ = nullptr;
+  // origin nodes are indexed in [0, origin_node_num_), and sub nodes are
+  // indexed after them. The arrays below only grow, and a search resets the
+  // nodes it reached instead of the whole arrays.
+  int origin_node_num_ = 0;
+  int node_num_ = 0;
+  std::vector<int> reached_indices_;
+  std::vector<uint8_t> node_state_;
+  std::vector<const TopoNode*> came_from_;
+  std::vector<double> g_score_;
+  std::vector<double> enter_s_;
 };
 
 }  // namespace routing
@@ -0,0 +1,248 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/strategy/a_star_strategy.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "modules/routing/graph/sub_topo_graph.h"
+#include "modules/routing/graph/topo_graph.h"
+#include "modules/routing/graph/topo_landmark.h"
+#include "modules/routing/graph/topo_test_utils.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+using BlackMap = std::unordered_map<const TopoNode*, std::vector<NodeSRange>>;
+
+// lane id and range of every node of a route, e.g. "L1[0,100] L3[0,100]"
+std::string RouteToString(const std::vector<NodeWithRange>& route) {
+  std::string result;
+  for (const auto& node : route) {
+    if (!result.empty()) {
+      result += " ";
+    }
+    result += node.LaneId() + "[" +
+              std::to_string(static_cast<int>(node.StartS())) + "," +
+              std::to_string(static_cast<int>(node.EndS())) + "]";
+  }
+  return result;
+}
+
+void AddNode(const std::string& lane_id, const double x, const double y,
+             const double cost, Graph* graph) {
+  auto* node = graph->add_node();
+  GetNodeForTest(node, lane_id, TEST_R1);
+  node->set_cost(cost);
+  // a single point central curve, which is then the anchor point
+  auto* point = node->mutable_central_curve()
+                    ->add_segment()
+                    ->mutable_line_segment()
+                    ->add_point();
+  point->set_x(x);
+  point->set_y(y);
+}
+
+// the lanes of graph 3 laid out as three roads of two lanes. A lane costs
+// at least its length, so that the default heuristic is a lower bound, and
+// the right lanes cost more so that every route has a single cheapest path.
+void GetRouteGraphForTest(const Graph& graph_3, Graph* graph) {
+  graph->set_hdmap_version(TEST_MAP_VERSION);
+  AddNode(TEST_L1, 50.0, 0.0, TEST_LANE_LENGTH, graph);
+  AddNode(TEST_L2, 50.0, -3.5, 1.1 * TEST_LANE_LENGTH, graph);
+  AddNode(TEST_L3, 150.0, 0.0, TEST_LANE_LENGTH, graph);
+  AddNode(TEST_L4, 150.0, -3.5, 1.1 * TEST_LANE_LENGTH, graph);
+  AddNode(TEST_L5, 250.0, 0.0, TEST_LANE_LENGTH, graph);
+  AddNode(TEST_L6, 250.0, -3.5, 1.1 * TEST_LANE_LENGTH, graph);
+  *graph->mutable_edge() = graph_3.edge();
+}
+
+}  // namespace
+
+class AStarStrategyTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    GetGraph3ForTest(&graph_);
+    ASSERT_TRUE(topo_graph_.LoadGraph(graph_));
+  }
+
+ protected:
+  bool Search(AStarStrategy* strategy, const BlackMap& black_map,
+              const std::string& src_lane_id, const double src_s,
+              const std::string& dest_lane_id, const double dest_s,
+              std::vector<NodeWithRange>* const route) {
+    SubTopoGraph sub_graph(black_map);
+    const auto* src_node =
+        sub_graph.GetSubNodeWithS(topo_graph_.GetNode(src_lane_id), src_s);
+    const auto* dest_node =
+        sub_graph.GetSubNodeWithS(topo_graph_.GetNode(dest_lane_id), dest_s);
+    if (src_node == nullptr || dest_node == nullptr) {
+      return false;
+    }
+    return strategy->Search(&topo_graph_, &sub_graph, src_node, dest_node,
+                            route);
+  }
+
+  bool Search(AStarStrategy* strategy, const std::string& src_lane_id,
+              const std::string& dest_lane_id, std::string* const route) {
+    std::vector<NodeWithRange> nodes;
+    if (!Search(strategy, BlackMap(), src_lane_id, 0.0, dest_lane_id,
+                TEST_LANE_LENGTH, &nodes)) {
+      return false;
+    }
+    *route = RouteToString(nodes);
+    return true;
+  }
+
+  Graph graph_;
+  TopoGraph topo_graph_;
+};
+
+TEST_F(AStarStrategyTest, reused_strategy) {
+  BlackMap black_map;
+  black_map[topo_graph_.GetNode(TEST_L3)].emplace_back(40.0, 60.0);
+  black_map[topo_graph_.GetNode(TEST_L5)].emplace_back(10.0, 20.0);
+
+  // a strategy used for many searches only resets the nodes it reached, so
+  // every search must give the same route as a new strategy.
+  AStarStrategy reused_strategy(true);
+  for (int i = 0; i < 3; ++i) {
+    std::vector<NodeWithRange> route;
+    ASSERT_TRUE(Search(&reused_strategy, BlackMap(), TEST_L1, 0.0, TEST_L6,
+                       TEST_LANE_LENGTH, &route));
+    AStarStrategy new_strategy(true);
+    std::vector<NodeWithRange> expected_route;
+    ASSERT_TRUE(Search(&new_strategy, BlackMap(), TEST_L1, 0.0, TEST_L6,
+                       TEST_LANE_LENGTH, &expected_route));
+    EXPECT_EQ(RouteToString(expected_route), RouteToString(route));
+
+    ASSERT_TRUE(Search(&reused_strategy, black_map, TEST_L1, 0.0, TEST_L6,
+                       TEST_LANE_LENGTH, &route));
+    AStarStrategy black_strategy(true);
+    ASSERT_TRUE(Search(&black_strategy, black_map, TEST_L1, 0.0, TEST_L6,
+                       TEST_LANE_LENGTH, &expected_route));
+    EXPECT_EQ(RouteToString(expected_route), RouteToString(route));
+  }
+}
+
+TEST_F(AStarStrategyTest, routes) {
+  Graph graph;
+  GetRouteGraphForTest(graph_, &graph);
+  ASSERT_TRUE(topo_graph_.LoadGraph(graph));
+
+  // cheapest routes between every pair of lanes, an empty route means no
+  // route. When g_score_ kept f costs, the routes from L2 to L3..L6 and from
+  // L4 to L5 and L6 stayed on the right lanes although changing to the
+  // cheaper left lanes costs less.
+  const std::vector<std::vector<std::string>> expected_routes = {
+      {TEST_L1, TEST_L2, "L1[0,100] L2[0,100]"},
+      {TEST_L1, TEST_L3, "L1[0,100] L3[0,100]"},
+      {TEST_L1, TEST_L4, "L1[0,100] L3[0,100] L4[0,100]"},
+      {TEST_L1, TEST_L5, "L1[0,100] L3[0,100] L5[0,100]"},
+      {TEST_L1, TEST_L6, "L1[0,100] L3[0,100] L5[0,100] L6[0,100]"},
+      {TEST_L2, TEST_L1, "L2[0,100] L1[0,100]"},
+      {TEST_L2, TEST_L3, "L2[0,100] L1[0,100] L3[0,100]"},
+      {TEST_L2, TEST_L4, "L2[0,100] L1[0,100] L3[0,100] L4[0,100]"},
+      {TEST_L2, TEST_L5, "L2[0,100] L1[0,100] L3[0,100] L5[0,100]"},
+      {TEST_L2, TEST_L6, "L2[0,100] L1[0,100] L3[0,100] L5[0,100] L6[0,100]"},
+      {TEST_L3, TEST_L1, ""},
+      {TEST_L3, TEST_L2, ""},
+      {TEST_L3, TEST_L4, "L3[0,100] L4[0,100]"},
+      {TEST_L3, TEST_L5, "L3[0,100] L5[0,100]"},
+      {TEST_L3, TEST_L6, "L3[0,100] L5[0,100] L6[0,100]"},
+      {TEST_L4, TEST_L1, ""},
+      {TEST_L4, TEST_L2, ""},
+      {TEST_L4, TEST_L3, "L4[0,100] L3[0,100]"},
+      {TEST_L4, TEST_L5, "L4[0,100] L3[0,100] L5[0,100]"},
+      {TEST_L4, TEST_L6, "L4[0,100] L3[0,100] L5[0,100] L6[0,100]"},
+      {TEST_L5, TEST_L1, ""},
+      {TEST_L5, TEST_L2, ""},
+      {TEST_L5, TEST_L3, ""},
+      {TEST_L5, TEST_L4, ""},
+      {TEST_L5, TEST_L6, "L5[0,100] L6[0,100]"},
+      {TEST_L6, TEST_L1, ""},
+      {TEST_L6, TEST_L2, ""},
+      {TEST_L6, TEST_L3, ""},
+      {TEST_L6, TEST_L4, ""},
+      {TEST_L6, TEST_L5, "L6[0,100] L5[0,100]"},
+  };
+  AStarStrategy strategy(true);
+  for (const auto& expected : expected_routes) {
+    std::string route;
+    EXPECT_EQ(!expected[2].empty(),
+              Search(&strategy, expected[0], expected[1], &route))
+        << expected[0] << " -> " << expected[1];
+    EXPECT_EQ(expected[2], route) << expected[0] << " -> " << expected[1];
+  }
+}
+
+TEST_F(AStarStrategyTest, cheapest_route_with_uneven_heuristic) {
+  // S reaches D through A or B. The route through A is cheaper, but A is
+  // farther from D than B, so its heuristic is larger. When g_score_ kept
+  // f costs, the heuristic of A was added to the cost of reaching D
+  // through A and the route through B was returned.
+  Graph graph;
+  graph.set_hdmap_version(TEST_MAP_VERSION);
+  AddNode("S", 25.0, 60.0, 10.0, &graph);
+  AddNode("A", 0.0, 100.0, 10.0, &graph);
+  AddNode("B", 50.0, 90.0, 20.0, &graph);
+  AddNode("D", 50.0, 100.0, 100.0, &graph);
+  GetEdgeForTest(graph.add_edge(), "S", "A", Edge::FORWARD);
+  GetEdgeForTest(graph.add_edge(), "S", "B", Edge::FORWARD);
+  GetEdgeForTest(graph.add_edge(), "A", "D", Edge::FORWARD);
+  GetEdgeForTest(graph.add_edge(), "B", "D", Edge::FORWARD);
+  ASSERT_TRUE(topo_graph_.LoadGraph(graph));
+
+  AStarStrategy strategy(true);
+  std::string route;
+  ASSERT_TRUE(Search(&strategy, "S", "D", &route));
+  EXPECT_EQ("S[0,100] A[0,100] D[0,100]", route);
+}
+
+TEST_F(AStarStrategyTest, landmark_routes) {
+  Graph graph;
+  GetRouteGraphForTest(graph_, &graph);
+  // the lane changes into the cheaper left lanes cost less than zero
+  ASSERT_TRUE(topo_graph_.LoadGraph(graph));
+  LandmarkTable table;
+  ASSERT_TRUE(TopoLandmark::Build(graph, 2, &table));
+  TopoLandmark landmark;
+  ASSERT_TRUE(landmark.Load(table, &topo_graph_));
+
+  // the landmark heuristic is another lower bound, so it must give the same
+  // cheapest routes as the default heuristic.
+  AStarStrategy strategy(true);
+  AStarStrategy landmark_strategy(true, &landmark);
+  for (const auto& src : graph.node()) {
+    for (const auto& dest : graph.node()) {
+      std::string route;
+      std::string landmark_route;
+      EXPECT_EQ(Search(&strategy, src.lane_id(), dest.lane_id(), &route),
+                Search(&landmark_strategy, src.lane_id(), dest.lane_id(),
+                       &landmark_route));
+      EXPECT_EQ(route, landmark_route)
+          << src.lane_id() << " -> " << dest.lane_id();
+    }
+  }
+}
+
+}  // namespace routing
+}  // namespace apollo
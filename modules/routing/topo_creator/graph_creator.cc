@@ -24,6 +24,7 @@
 #include "modules/common/util/string_util.h"
 #include "modules/map/hdmap/adapter/opendrive_adapter.h"
 #include "modules/routing/common/routing_gflags.h"
+#include "modules/routing/graph/topo_landmark.h"
 #include "modules/routing/topo_creator/edge_creator.h"
 #include "modules/routing/topo_creator/node_creator.h"
 
@@ -161,6 +162,26 @@ bool GraphCreator::Create() {
     return false;
   }
   AINFO << "Bin file is dumped successfully. Path: " << bin_file;
+
+  if (FLAGS_routing_landmark_num > 0) {
+    LandmarkTable landmark_table;
+    // the landmark heuristic is optional, routing falls back to the
+    // default heuristic without the landmark file.
+    if (TopoLandmark::Build(graph_, FLAGS_routing_landmark_num,
+                            &landmark_table)) {
+      const std::string landmark_file =
+          TopoLandmark::GetLandmarkFilePath(bin_file);
+      if (!cyber::common::SetProtoToBinaryFile(landmark_table,
+                                               landmark_file)) {
+        AERROR << "Failed to dump landmark data into file " << landmark_file;
+        return false;
+      }
+      AINFO << "Landmark file is dumped successfully. Path: "
+            << landmark_file;
+    } else {
+      AWARN << "Routing landmarks are not built for this map.";
+    }
+  }
   return true;
 }
 